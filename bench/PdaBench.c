@@ -0,0 +1,540 @@
+/*
+ * Nombre del archivo: PdaBench.c
+ * Versión: 0.1
+ * Descripción:
+ *  Banco de pruebas de rendimiento de la API de estadísticas de MP, con resultados en JSON.
+ *
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo bajo los términos de la
+ * Licencia Pública General GNU publicada por la Free Software Foundation, ya sea la versión 3 de la
+ * Licencia, o (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil, pero SIN NINGUNA GARANTÍA; sin
+ * siquiera la garantía implícita de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU junto con este programa.
+ * Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ */
+
+/**
+ * @file PdaBench.c
+ * @brief Mide el rendimiento de las funciones de la API sobre conjuntos de datos sintéticos.
+ *
+ * Uso: bench.elf [--sizes 1K,1M,...] [--invalid 0,0.1,...] [--warmup W] [--reps R]
+ *                [--output archivo.json]
+ *
+ * Para cada tamaño (sufijos K, M y G decimales, de 1K a 1G) y cada proporción de datos inválidos
+ * se genera un conjunto reproducible y se mide cada función: calculateAverage, findMaxValue,
+ * findMinValue, calculateStandardDeviation y computeParticulateStats con el núcleo elegido
+ * automáticamente, y pdaReduceWith con cada núcleo soportado por la CPU.
+ *
+ * Cada medición repite la función las veces necesarias para durar al menos BENCH_MIN_SAMPLE_NS,
+ * de modo que la resolución del reloj no domine en los conjuntos chicos. Las primeras W
+ * mediciones se descartan como calentamiento (caché, TLB, frecuencia de la CPU) y de las R
+ * restantes se informan el mínimo, la mediana y el promedio de ns/dato; GB/s y ciclos/dato se
+ * calculan sobre la mediana.
+ *
+ * Los ciclos se leen del contador de ciclos del núcleo con perf_event_open. Si el sistema no lo
+ * permite se usa rdtsc, que cuenta ciclos a la frecuencia nominal y no a la real, y en otras
+ * arquitecturas se informan como null. El campo "cycleSource" del JSON indica la fuente usada.
+ */
+
+/* === Headers files inclusions =============================================================== */
+
+#define _GNU_SOURCE // Para clock_gettime y syscall con -std=c11
+
+#include "ParticulateDataAnalyzer.h"
+#include "PdaKernels.h"
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h> // Para __rdtsc
+#endif
+
+/* === Macros definitions ====================================================================== */
+
+/**
+ * @brief Versión del formato del JSON, para detectar cambios al comparar entre versiones.
+ */
+#define BENCH_SCHEMA_VERSION 1
+
+/**
+ * @brief Duración mínima de una medición, en nanosegundos.
+ */
+#define BENCH_MIN_SAMPLE_NS 2000000.0
+
+/**
+ * @brief Cantidad máxima de tamaños y de proporciones de inválidos en la línea de comandos.
+ */
+#define BENCH_MAX_LIST 32
+
+/**
+ * @brief Cantidad máxima de repeticiones medidas.
+ */
+#define BENCH_MAX_REPS 1000
+
+/**
+ * @brief Semilla del generador de datos sintéticos.
+ */
+#define BENCH_SEED 2023u
+
+/* === Private data type declarations ========================================================== */
+
+/**
+ * @brief Fuente del conteo de ciclos.
+ */
+typedef enum {
+    CYCLES_NONE = 0, /**< Sin contador de ciclos. */
+    CYCLES_PERF,     /**< Contador de ciclos del núcleo (perf_event_open). */
+    CYCLES_RDTSC,    /**< Contador de marca de tiempo de x86. */
+} CycleSource;
+
+/**
+ * @brief Función medida: recibe el conjunto y retorna un valor que impide eliminar la llamada.
+ */
+typedef double (*BenchFunction)(const float * data, size_t n_data);
+
+/**
+ * @brief Caso de medición.
+ */
+typedef struct {
+    const char * name;      /**< Nombre de la función, tal como aparece en el JSON. */
+    BenchFunction function; /**< Función a medir. */
+    bool intLength;         /**< Verdadero si la función recibe la cantidad como int. */
+} BenchCase;
+
+/**
+ * @brief Opciones de la línea de comandos.
+ */
+typedef struct {
+    size_t sizes[BENCH_MAX_LIST];   /**< Tamaños de los conjuntos. */
+    size_t sizeCount;               /**< Cantidad de tamaños. */
+    double invalid[BENCH_MAX_LIST]; /**< Proporciones de datos inválidos. */
+    size_t invalidCount;            /**< Cantidad de proporciones. */
+    unsigned warmup;                /**< Mediciones descartadas. */
+    unsigned reps;                  /**< Mediciones informadas. */
+    const char * output;            /**< Archivo de salida, o NULL para la salida estándar. */
+} BenchOptions;
+
+/**
+ * @brief Resultado de un caso de medición.
+ */
+typedef struct {
+    size_t iterations;    /**< Llamadas por medición. */
+    double nsMin;         /**< Mínimo de ns/dato. */
+    double nsMedian;      /**< Mediana de ns/dato. */
+    double nsMean;        /**< Promedio de ns/dato. */
+    double cyclesMedian;  /**< Mediana de ciclos/dato, negativa si no hay contador. */
+} BenchResult;
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/// @brief Destino de los resultados de las funciones medidas, para que no se eliminen.
+static volatile double benchSink;
+
+/// @brief Núcleo usado por runReduce.
+static PdaKernelId benchKernel;
+
+/// @brief Fuente del conteo de ciclos elegida al inicio.
+static CycleSource cycleSource;
+
+/// @brief Descriptor del contador de perf_event_open.
+static int perfFd = -1;
+
+/// @brief Estado del generador pseudoaleatorio.
+static uint32_t randomState;
+
+/// @brief Nombres de las fuentes de ciclos, indexados por CycleSource.
+static const char * const cycleSourceNames[] = {"none", "perf", "rdtsc"};
+
+/* === Private function implementation ========================================================= */
+
+/**
+ * @brief Mide calculateAverage.
+ */
+static double runAverage(const float * data, size_t n_data) {
+    return calculateAverage((float *)data, (int)n_data);
+}
+
+/**
+ * @brief Mide findMaxValue.
+ */
+static double runMax(const float * data, size_t n_data) {
+    return findMaxValue((float *)data, (int)n_data);
+}
+
+/**
+ * @brief Mide findMinValue.
+ */
+static double runMin(const float * data, size_t n_data) {
+    return findMinValue((float *)data, (int)n_data);
+}
+
+/**
+ * @brief Mide calculateStandardDeviation.
+ */
+static double runStdDev(const float * data, size_t n_data) {
+    return calculateStandardDeviation((float *)data, (int)n_data);
+}
+
+/**
+ * @brief Mide computeParticulateStats.
+ */
+static double runStats(const float * data, size_t n_data) {
+    PdaStats stats;
+    computeParticulateStats(data, n_data, &stats);
+    return stats.mean + stats.stdDev;
+}
+
+/**
+ * @brief Mide pdaReduceWith con el núcleo benchKernel.
+ */
+static double runReduce(const float * data, size_t n_data) {
+    PdaReduction reduction;
+    pdaReduceWith(benchKernel, data, n_data, 0.0, &reduction);
+    return reduction.sum;
+}
+
+/// @brief Casos medidos con el núcleo elegido automáticamente.
+static const BenchCase benchCases[] = {
+    {"calculateAverage", runAverage, true},
+    {"findMaxValue", runMax, true},
+    {"findMinValue", runMin, true},
+    {"calculateStandardDeviation", runStdDev, true},
+    {"computeParticulateStats", runStats, false},
+};
+
+/**
+ * @brief Generador congruencial lineal, para que los conjuntos sean reproducibles.
+ */
+static uint32_t nextRandom(void) {
+    randomState = randomState * 1664525u + 1013904223u;
+    return randomState >> 8;
+}
+
+/**
+ * @brief Genera un conjunto sintético con una proporción dada de datos inválidos.
+ *
+ * Los datos válidos son uniformes en [1, 300) µg/m³; los inválidos alternan entre cero, un valor
+ * negativo y uno mayor que MP_MAX_VALUE, como los que entregan los sensores reales.
+ *
+ * @param data Array donde se almacena el conjunto.
+ * @param n_data Número de elementos a generar.
+ * @param invalidRatio Proporción de datos inválidos, entre 0 y 1.
+ */
+static void generateData(float * data, size_t n_data, double invalidRatio) {
+    static const float invalidValues[] = {0.0f, -5.0f, 600.0f};
+    uint32_t threshold = (uint32_t)(invalidRatio * (1u << 24));
+    randomState = BENCH_SEED;
+    for (size_t i = 0; i < n_data; i++) {
+        if (nextRandom() < threshold)
+            data[i] = invalidValues[i % 3];
+        else
+            data[i] = 1.0f + (float)(nextRandom() % 29900u) / 100.0f;
+    }
+}
+
+/**
+ * @brief Lee el reloj monotónico en nanosegundos.
+ */
+static double nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/**
+ * @brief Abre el contador de ciclos, con perf_event_open si está disponible y si no con rdtsc.
+ */
+static void openCycleCounter(void) {
+#ifdef __linux__
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_CPU_CYCLES;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    perfFd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    if (perfFd >= 0) {
+        cycleSource = CYCLES_PERF;
+        return;
+    }
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+    cycleSource = CYCLES_RDTSC;
+#else
+    cycleSource = CYCLES_NONE;
+#endif
+}
+
+/**
+ * @brief Lee el contador de ciclos elegido por openCycleCounter.
+ */
+static uint64_t readCycles(void) {
+#ifdef __linux__
+    if (cycleSource == CYCLES_PERF) {
+        uint64_t count = 0;
+        if (read(perfFd, &count, sizeof(count)) != (ssize_t)sizeof(count))
+            return 0;
+        return count;
+    }
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+    if (cycleSource == CYCLES_RDTSC)
+        return __rdtsc();
+#endif
+    return 0;
+}
+
+/**
+ * @brief Compara dos double para qsort.
+ */
+static int compareDouble(const void * a, const void * b) {
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Mediana de un array, que queda ordenado.
+ */
+static double median(double * values, size_t count) {
+    qsort(values, count, sizeof(double), compareDouble);
+    if (count % 2)
+        return values[count / 2];
+    return (values[count / 2 - 1] + values[count / 2]) / 2.0;
+}
+
+/**
+ * @brief Mide una función con calentamiento y repeticiones.
+ *
+ * @param function Función a medir.
+ * @param data Conjunto de datos.
+ * @param n_data Número de elementos del conjunto.
+ * @param options Cantidad de mediciones de calentamiento y de repeticiones.
+ * @param result Estructura donde se almacena el resultado.
+ */
+static void measure(BenchFunction function, const float * data, size_t n_data,
+                    const BenchOptions * options, BenchResult * result) {
+    static double ns[BENCH_MAX_REPS];
+    static double cycles[BENCH_MAX_REPS];
+
+    double start = nowNs();
+    benchSink = function(data, n_data);
+    double once = nowNs() - start;
+    size_t iterations = 1;
+    if (once < BENCH_MIN_SAMPLE_NS)
+        iterations = (size_t)(BENCH_MIN_SAMPLE_NS / (once > 1.0 ? once : 1.0)) + 1;
+
+    double perSample = (double)iterations * (double)n_data;
+    double total = 0.0;
+    for (unsigned rep = 0; rep < options->warmup + options->reps; rep++) {
+        uint64_t cycleStart = readCycles();
+        start = nowNs();
+        for (size_t i = 0; i < iterations; i++)
+            benchSink = function(data, n_data);
+        double elapsed = nowNs() - start;
+        uint64_t cycleCount = readCycles() - cycleStart;
+        if (rep < options->warmup)
+            continue;
+        ns[rep - options->warmup] = elapsed / perSample;
+        cycles[rep - options->warmup] = (double)cycleCount / perSample;
+        total += elapsed / perSample;
+    }
+
+    result->iterations = iterations;
+    result->nsMean = total / options->reps;
+    result->nsMedian = median(ns, options->reps);
+    result->nsMin = ns[0];
+    result->cyclesMedian = (cycleSource == CYCLES_NONE) ? -1.0 : median(cycles, options->reps);
+}
+
+/**
+ * @brief Escribe un resultado como objeto JSON.
+ */
+static void writeResult(FILE * out, bool * first, const char * name, PdaKernelId kernel,
+                        size_t n_data, double invalidRatio, const BenchOptions * options,
+                        const BenchResult * result) {
+    double gbPerSecond = (double)sizeof(float) / result->nsMedian;
+    fprintf(out, "%s\n    {\"function\": \"%s\", \"kernel\": \"%s\", \"samples\": %zu, ",
+            *first ? "" : ",", name, pdaKernelName(kernel), n_data);
+    fprintf(out, "\"invalidRatio\": %.4f, \"repetitions\": %u, \"iterations\": %zu,\n",
+            invalidRatio, options->reps, result->iterations);
+    fprintf(out, "     \"nsPerSample\": {\"min\": %.6f, \"median\": %.6f, \"mean\": %.6f}, ",
+            result->nsMin, result->nsMedian, result->nsMean);
+    fprintf(out, "\"gbPerSecond\": %.4f, \"cyclesPerSample\": ", gbPerSecond);
+    if (result->cyclesMedian < 0.0)
+        fprintf(out, "null}");
+    else
+        fprintf(out, "%.4f}", result->cyclesMedian);
+    *first = false;
+}
+
+/**
+ * @brief Interpreta una lista de tamaños separados por comas, con sufijos K, M y G.
+ *
+ * @return Verdadero si la lista es válida.
+ */
+static bool parseSizes(const char * text, BenchOptions * options) {
+    options->sizeCount = 0;
+    while (*text != '\0' && options->sizeCount < BENCH_MAX_LIST) {
+        char * end;
+        unsigned long long value = strtoull(text, &end, 10);
+        if (end == text)
+            return false;
+        if (*end == 'K' || *end == 'k')
+            value *= 1000ull, end++;
+        else if (*end == 'M' || *end == 'm')
+            value *= 1000000ull, end++;
+        else if (*end == 'G' || *end == 'g')
+            value *= 1000000000ull, end++;
+        if (value == 0 || value > SIZE_MAX / sizeof(float) || (*end != ',' && *end != '\0'))
+            return false;
+        options->sizes[options->sizeCount++] = (size_t)value;
+        text = (*end == ',') ? end + 1 : end;
+    }
+    return options->sizeCount > 0;
+}
+
+/**
+ * @brief Interpreta una lista de proporciones de datos inválidos separadas por comas.
+ *
+ * @return Verdadero si la lista es válida.
+ */
+static bool parseRatios(const char * text, BenchOptions * options) {
+    options->invalidCount = 0;
+    while (*text != '\0' && options->invalidCount < BENCH_MAX_LIST) {
+        char * end;
+        double value = strtod(text, &end);
+        if (end == text || !(value >= 0.0 && value <= 1.0) || (*end != ',' && *end != '\0'))
+            return false;
+        options->invalid[options->invalidCount++] = value;
+        text = (*end == ',') ? end + 1 : end;
+    }
+    return options->invalidCount > 0;
+}
+
+/**
+ * @brief Interpreta la línea de comandos.
+ *
+ * @return Verdadero si todas las opciones son válidas.
+ */
+static bool parseOptions(int argc, char * argv[], BenchOptions * options) {
+    static const size_t defaultSizes[] = {1000, 100000, 10000000};
+    memcpy(options->sizes, defaultSizes, sizeof(defaultSizes));
+    options->sizeCount = sizeof(defaultSizes) / sizeof(defaultSizes[0]);
+    options->invalid[0] = 0.0;
+    options->invalid[1] = 0.1;
+    options->invalidCount = 2;
+    options->warmup = 3;
+    options->reps = 11;
+    options->output = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--sizes") == 0 && hasValue) {
+            if (!parseSizes(argv[++i], options))
+                return false;
+        } else if (strcmp(argv[i], "--invalid") == 0 && hasValue) {
+            if (!parseRatios(argv[++i], options))
+                return false;
+        } else if (strcmp(argv[i], "--warmup") == 0 && hasValue) {
+            options->warmup = (unsigned)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--reps") == 0 && hasValue) {
+            options->reps = (unsigned)strtoul(argv[++i], NULL, 10);
+            if (options->reps == 0 || options->reps > BENCH_MAX_REPS)
+                return false;
+        } else if (strcmp(argv[i], "--output") == 0 && hasValue) {
+            options->output = argv[++i];
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* === Public function implementation ========================================================== */
+
+int main(int argc, char * argv[]) {
+    BenchOptions options;
+    if (!parseOptions(argc, argv, &options)) {
+        fprintf(stderr, "Uso: %s [--sizes 1K,1M,1G] [--invalid 0,0.1] [--warmup W] [--reps R] "
+                        "[--output archivo.json]\n",
+                argv[0]);
+        return EXIT_FAILURE;
+    }
+    FILE * out = (options.output == NULL) ? stdout : fopen(options.output, "w");
+    if (out == NULL) {
+        perror(options.output);
+        return EXIT_FAILURE;
+    }
+
+    openCycleCounter();
+    PdaKernelId autoKernel = pdaActiveKernel();
+    fprintf(out, "{\n  \"schemaVersion\": %d,\n  \"compiler\": \"%s\",\n", BENCH_SCHEMA_VERSION,
+            __VERSION__);
+    fprintf(out, "  \"autoKernel\": \"%s\",\n  \"cycleSource\": \"%s\",\n",
+            pdaKernelName(autoKernel), cycleSourceNames[cycleSource]);
+    fprintf(out, "  \"warmup\": %u,\n  \"results\": [", options.warmup);
+
+    bool first = true;
+    for (size_t s = 0; s < options.sizeCount; s++) {
+        size_t n_data = options.sizes[s];
+        float * data = malloc(n_data * sizeof(float));
+        if (data == NULL) {
+            fprintf(stderr, "Sin memoria para %zu datos; se omite\n", n_data);
+            continue;
+        }
+        for (size_t r = 0; r < options.invalidCount; r++) {
+            BenchResult result;
+            generateData(data, n_data, options.invalid[r]);
+            fprintf(stderr, "%zu datos, %.0f%% inválidos\n", n_data, options.invalid[r] * 100.0);
+            for (size_t c = 0; c < sizeof(benchCases) / sizeof(benchCases[0]); c++) {
+                if (benchCases[c].intLength && n_data > INT_MAX)
+                    continue;
+                measure(benchCases[c].function, data, n_data, &options, &result);
+                writeResult(out, &first, benchCases[c].name, autoKernel, n_data,
+                            options.invalid[r], &options, &result);
+            }
+            for (int k = 0; k < PDA_KERNEL_COUNT; k++) {
+                if (!pdaKernelSupported((PdaKernelId)k))
+                    continue;
+                benchKernel = (PdaKernelId)k;
+                measure(runReduce, data, n_data, &options, &result);
+                writeResult(out, &first, "pdaReduceWith", benchKernel, n_data, options.invalid[r],
+                            &options, &result);
+            }
+        }
+        free(data);
+    }
+    fprintf(out, "\n  ]\n}\n");
+
+    if (out != stdout)
+        fclose(out);
+    return EXIT_SUCCESS;
+}
+
+/* === End of documentation ==================================================================== */
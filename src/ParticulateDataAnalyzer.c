@@ -39,6 +39,10 @@
  * - findMaxValue: Encuentra el valor máximo de los datos validados de MP.
  * - findMinValue: Encuentra el valor mínimo de los datos validados de MP.
  * - calculateStandardDeviation: Calcula la desviación estándar de los valores de MP.
+ * - computeParticulateStats: Calcula todas las estadísticas anteriores en una sola pasada.
+ * - calculateAverage64 y demás variantes 64: Las mismas funciones con longitud size_t.
+ *
+ * Compiladas con PDA_INSTRUMENT, todas las funciones registran sus llamadas en PdaInstrument.h.
  *
  * La API es aplicable en sistemas de monitoreo de calidad de aire para análisis
  * en entornos interiores y exteriores.
@@ -47,6 +51,8 @@
 /* === Headers files inclusions =============================================================== */
 
 #include "ParticulateDataAnalyzer.h"
+#include "PdaKernels.h"
+#include "PdaInstrument.h"
 #include <stddef.h> // Para NULL
 #include <stdbool.h>
 
@@ -93,6 +99,11 @@
  */
 #define MIN_VALUE_SQRT_TOLERANCE 0
 
+/**
+ * @brief Límite superior mínimo para la búsqueda binaria de la raíz cuadrada
+ */
+#define SQRT_UNIT 1.0
+
 /**
  * @brief valor inicial suma
  */
@@ -113,6 +124,17 @@
  */
 #define NOT_DIV_NUM 0
 
+/**
+ * @brief Calcula las estadísticas de una llamada y, con PDA_INSTRUMENT, la registra a nombre de la
+ *        función pública indicada.
+ */
+#ifdef PDA_INSTRUMENT
+#define INSTRUMENTED_STATS(function, data, n_data, stats)                                         \
+    instrumentedStats(function, data, n_data, stats)
+#else
+#define INSTRUMENTED_STATS(function, data, n_data, stats) reduceStats(data, n_data, stats, NULL)
+#endif
+
 /* === Private data type declarations ========================================================== */
 
 /* === Private variable declarations =========================================================== */
@@ -125,19 +147,6 @@
 
 /* === Private function implementation ========================================================= */
 
-/**
- * @brief Verifica si un dato está dentro del rango válido de concentración de MP.
- *
- * Determina si un valor individual de material particulado (MP) cae dentro de los límites
- * predefinidos establecidos por MP_MIN_VALUE y MP_MAX_VALUE.
- *
- * @param data Valor de MP a verificar.
- * @return Verdadero si el valor está dentro del rango; falso en caso contrario.
- */
-bool maskIsDataTrue(float data) {
-    return (data > MP_MIN_VALUE && data < MP_MAX_VALUE);
-}
-
 /**
  * @brief Comprueba si un array de datos está vacío o no inicializado.
  *
@@ -167,7 +176,8 @@ double sqrt_binary_search(double x) {
     if (x <= 0)
         return 0;
 
-    double low = MIN_VALUE_SQRT_TOLERANCE, high = x, mid, guess;
+    // para 0 < x < 1 la raíz es mayor que x, por lo que el límite superior debe ser al menos 1
+    double low = MIN_VALUE_SQRT_TOLERANCE, high = (x < SQRT_UNIT) ? SQRT_UNIT : x, mid, guess;
     double tolerance = TOLERANCE_SQRT_MET;
 
     while (high - low > tolerance) {
@@ -183,8 +193,104 @@ double sqrt_binary_search(double x) {
     return (low + high) / DIV2;
 }
 
+/**
+ * @brief Convierte el tamaño recibido por la API clásica en una longitud sin signo.
+ *
+ * @param n_data Número de elementos informado por el usuario.
+ * @return n_data si es positivo; CERODATA en caso contrario.
+ */
+static size_t arrayLength(int n_data) {
+    return (n_data > CERODATA) ? (size_t)n_data : CERODATA;
+}
+
+/**
+ * @brief Calcula todas las estadísticas de un conjunto de datos en una sola pasada.
+ *
+ * Es el cuerpo de computeParticulateStats. Con PDA_INSTRUMENT, además suma a aboveMinCount la
+ * cantidad de datos mayores que MP_MIN_VALUE, que separa los descartes bajos de los altos.
+ *
+ * @param data Array de valores flotantes.
+ * @param n_data Número de elementos en el array.
+ * @param stats Estructura donde se almacenan los resultados.
+ * @param aboveMinCount Contador de datos mayores que MP_MIN_VALUE; sin PDA_INSTRUMENT no se usa.
+ * @return Verdadero si hay al menos un dato válido; falso en caso contrario.
+ */
+static bool reduceStats(const float * data, size_t n_data, PdaStats * stats,
+                        size_t * aboveMinCount) {
+    if (stats == NULL)
+        return false;
+
+    if (n_data == CERODATA || data == NULL)
+        return pdaStatsFromMoments(CERODATA, INI_VALID_COUNT, INI_SUM, INI_SUM_OF_SQUARE, INI_SUM,
+                                   INI_SUM, stats); // Manejo de array vacío
+
+    // el primer dato válido se usa como referencia para las sumas desplazadas
+    size_t first = START_LOCATION;
+    while (first < n_data && !maskIsDataTrue(data[first]))
+        first++;
+#ifdef PDA_INSTRUMENT
+    for (size_t i = START_LOCATION; i < first; i++)
+        *aboveMinCount += data[i] > MP_MIN_VALUE;
+#else
+    (void)aboveMinCount;
+#endif
+    if (first == n_data)
+        return pdaStatsFromMoments(n_data, INI_VALID_COUNT, INI_SUM, INI_SUM_OF_SQUARE, INI_SUM,
+                                   INI_SUM, stats); // todos los datos son inválidos
+
+    PdaReduction reduction;
+    double shift = data[first];
+    pdaReduce(data + first, n_data - first, shift, &reduction);
+#ifdef PDA_INSTRUMENT
+    *aboveMinCount += reduction.aboveMinCount;
+#endif
+
+    double n = (double)reduction.validCount;
+    double mean = shift + reduction.sum / n;
+    double m2 = reduction.sumOfSquares - reduction.sum * reduction.sum / n;
+    return pdaStatsFromMoments(n_data, reduction.validCount, mean, m2, reduction.min,
+                               reduction.max, stats);
+}
+
+#ifdef PDA_INSTRUMENT
+/**
+ * @brief Calcula las estadísticas y registra la llamada a nombre de una función pública.
+ *
+ * @param function Función pública que recibió la llamada.
+ * @param data Array de valores flotantes.
+ * @param n_data Número de elementos en el array.
+ * @param stats Estructura donde se almacenan los resultados.
+ * @return Verdadero si hay al menos un dato válido; falso en caso contrario.
+ */
+static bool instrumentedStats(PdaInstrFunction function, const float * data, size_t n_data,
+                              PdaStats * stats) {
+    uint64_t start = pdaInstrStart();
+    size_t aboveMinCount = INI_VALID_COUNT;
+    bool found = reduceStats(data, n_data, stats, &aboveMinCount);
+    size_t scanned = (data == NULL || stats == NULL) ? CERODATA : n_data;
+    size_t validCount = (scanned == CERODATA) ? INI_VALID_COUNT : stats->validCount;
+    pdaInstrRecord(function, start, scanned, scanned - aboveMinCount,
+                   aboveMinCount - validCount);
+    return found;
+}
+#endif
+
 /* === Public function implementation ========================================================== */
 
+/**
+ * @brief Verifica si un dato está dentro del rango válido de concentración de MP.
+ *
+ * Determina si un valor individual de material particulado (MP) cae dentro de los límites
+ * predefinidos establecidos por MP_MIN_VALUE y MP_MAX_VALUE.
+ *
+ * @param data Valor de MP a verificar.
+ * @return Verdadero si el valor está dentro del rango; falso en caso contrario.
+ */
+bool maskIsDataTrue(float data) {
+    return (data > MP_MIN_VALUE && data < MP_MAX_VALUE);
+}
+
+
 /**
  * @brief Calcula el promedio de un conjunto de datos, excluyendo valores fuera de rango.
  *
@@ -199,31 +305,16 @@ double sqrt_binary_search(double x) {
  */
 
 float calculateAverage(float data[], int n_data) {
-    if (isArrayEmpty(data, n_data))
-        return MSN_VOID_ARRAY_VALUE; // Manejo de array vacío
-    float sum = INI_SUM;
-    int rest = INI_REST; // numero de valor descontado del n total cuando
-    for (int i = 0; i < n_data; i++) {
-        if (maskIsDataTrue(data[i])) { // salta valores negativos o iguales a 0
-            sum += data[i];
-        } else {
-            rest++; // valores no validados
-        }
-    }
-    n_data = n_data - rest; // recalcula el valor de n en función de valores no validados
-
-    if (n_data > NOT_DIV_NUM) { // verifica no estar dividiendo por un número negativo o 0
-        return sum / (n_data);  // retorna promedio
-    } else {
-        return MSN_VOID_ARRAY_VALUE; // retorna un mensaje de error por array nulo
-    }
+    PdaStats stats;
+    INSTRUMENTED_STATS(PDA_INSTR_CALCULATE_AVERAGE, data, arrayLength(n_data), &stats);
+    return stats.mean;
 }
 
 /**
  * @brief Encuentra el valor máximo en un conjunto de datos validados.
  *
- * Itera a través del array para encontrar el máximo de los valores que cumplen con la validación
- * establecida por maskIsDataTrue. Ignora valores inválidos.
+ * Obtiene el máximo de los valores que cumplen con la validación establecida por
+ * maskIsDataTrue. Ignora valores inválidos.
  *
  * @param data Array de valores flotantes.
  * @param n_data Número de elementos en el array.
@@ -232,26 +323,16 @@ float calculateAverage(float data[], int n_data) {
  */
 
 float findMaxValue(float data[], int n_data) {
-    if (isArrayEmpty(data, n_data))
-        return MSN_VOID_ARRAY_VALUE; // Manejo de array vacío
-    float value = data[START_LOCATION];
-    int location = START_LOCATION;
-    for (int i = 1; i < n_data; i++) {
-        if (maskIsDataTrue(data[i])) { // salta valores negativos o iguales a 0
-            if (value < data[i]) {
-                value = data[i];
-                location = i;
-            }
-        }
-    }
-    return value;
-};
+    PdaStats stats;
+    INSTRUMENTED_STATS(PDA_INSTR_FIND_MAX_VALUE, data, arrayLength(n_data), &stats);
+    return stats.max;
+}
 
 /**
  * @brief Encuentra el valor mínimo en un conjunto de datos validados.
  *
- * Similar a findMaxValue, esta función recorre el array para identificar el mínimo de los valores
- * que pasan la validación de maskIsDataTrue.
+ * Similar a findMaxValue, obtiene el mínimo de los valores que pasan la validación de
+ * maskIsDataTrue.
  *
  * @param data Array de valores flotantes.
  * @param n_data Número de elementos en el array.
@@ -260,59 +341,152 @@ float findMaxValue(float data[], int n_data) {
  */
 
 float findMinValue(float data[], int n_data) {
-    if (isArrayEmpty(data, n_data))
-        return MSN_VOID_ARRAY_VALUE; // Manejo de array vacío
-    float value = data[START_LOCATION];
-    int location = START_LOCATION;
-    for (int i = 1; i < n_data; i++) {
-        if (maskIsDataTrue(data[i])) { // salta valores negativos o iguales a 0
-            if (value > data[i]) {
-                value = data[i];
-                location = i;
-            }
-        }
-    }
-    return value;
-};
+    PdaStats stats;
+    INSTRUMENTED_STATS(PDA_INSTR_FIND_MIN_VALUE, data, arrayLength(n_data), &stats);
+    return stats.min;
+}
 
 /**
  * @brief Calcula la desviación estándar de un conjunto de datos validados.
  *
- * Determina la desviación estándar de los valores en el array que son validados por maskIsDataTrue.
- * Utiliza la media calculada de los datos y la suma de los cuadrados de las diferencias para
- * obtener la desviación estándar.
+ * Determina la desviación estándar muestral de los valores en el array que son validados por
+ * maskIsDataTrue, a partir de la media y la suma de cuadrados obtenidas en una sola pasada.
  *
  * @param data Array de valores flotantes.
  * @param n Número de elementos en el array.
- * @return La desviación estándar de los valores válidos o 0 si hay menos de dos elementos válidos
- *         o el array está vacío.
+ * @return La desviación estándar de los valores válidos, MSN_VOID_ARRAY_VALUE si el array está
+ *         vacío, MSN_DS_NOTDEFINI si n <= 1 o MSN_NOT_DATA si hay menos de dos datos válidos.
  */
 
 float calculateStandardDeviation(float data[], int n) {
-    if (isArrayEmpty(data, n))
-        return MSN_VOID_ARRAY_VALUE; // Manejo de array vacío
+    PdaStats stats;
+    INSTRUMENTED_STATS(PDA_INSTR_CALCULATE_STANDARD_DEVIATION, data, arrayLength(n), &stats);
+    return stats.stdDev;
+}
 
-    if (n <= DS_NOTDEFINI)
-        return MSN_DS_NOTDEFINI; // La desviación estándar no está definida para n <= 1
+/**
+ * @brief Calcula el promedio de un conjunto de datos con longitud size_t.
+ *
+ * @param data Array de valores flotantes.
+ * @param n_data Número de elementos en el array.
+ * @return El promedio de los valores válidos o MSN_VOID_ARRAY_VALUE.
+ */
 
-    int validCount = INI_VALID_COUNT; // Contador para el número de valores validados
-    float mean = calculateAverage(data, n);
-    float sumOfSquares = INI_SUM_OF_SQUARE;
+float calculateAverage64(const float * data, size_t n_data) {
+    PdaStats stats;
+    INSTRUMENTED_STATS(PDA_INSTR_CALCULATE_AVERAGE, data, n_data, &stats);
+    return stats.mean;
+}
 
-    for (int i = 0; i < n; i++) {
-        if (maskIsDataTrue(data[i])) {
-            sumOfSquares += (data[i] - mean) * (data[i] - mean);
-            validCount++; // Incrementa solo para datos validados
-        }
+/**
+ * @brief Encuentra el valor máximo de un conjunto de datos con longitud size_t.
+ *
+ * @param data Array de valores flotantes.
+ * @param n_data Número de elementos en el array.
+ * @return El valor máximo de los valores válidos o MSN_VOID_ARRAY_VALUE.
+ */
+
+float findMaxValue64(const float * data, size_t n_data) {
+    PdaStats stats;
+    INSTRUMENTED_STATS(PDA_INSTR_FIND_MAX_VALUE, data, n_data, &stats);
+    return stats.max;
+}
+
+/**
+ * @brief Encuentra el valor mínimo de un conjunto de datos con longitud size_t.
+ *
+ * @param data Array de valores flotantes.
+ * @param n_data Número de elementos en el array.
+ * @return El valor mínimo de los valores válidos o MSN_VOID_ARRAY_VALUE.
+ */
+
+float findMinValue64(const float * data, size_t n_data) {
+    PdaStats stats;
+    INSTRUMENTED_STATS(PDA_INSTR_FIND_MIN_VALUE, data, n_data, &stats);
+    return stats.min;
+}
+
+/**
+ * @brief Calcula la desviación estándar de un conjunto de datos con longitud size_t.
+ *
+ * @param data Array de valores flotantes.
+ * @param n_data Número de elementos en el array.
+ * @return La desviación estándar o el código de error que corresponde.
+ */
+
+float calculateStandardDeviation64(const float * data, size_t n_data) {
+    PdaStats stats;
+    INSTRUMENTED_STATS(PDA_INSTR_CALCULATE_STANDARD_DEVIATION, data, n_data, &stats);
+    return stats.stdDev;
+}
+
+/**
+ * @brief Calcula todas las estadísticas de un conjunto de datos en una sola pasada.
+ *
+ * Cada dato se lee una sola vez mediante el núcleo de reducción vectorizado seleccionado por
+ * pdaReduce. Las sumas se acumulan en doble precisión y desplazadas respecto del primer dato
+ * válido, de modo que la varianza se obtiene de la suma de cuadrados sin cancelación
+ * catastrófica.
+ *
+ * @param data Array de valores flotantes.
+ * @param n_data Número de elementos en el array.
+ * @param stats Estructura donde se almacenan los resultados.
+ * @return Verdadero si hay al menos un dato válido; falso en caso contrario.
+ */
+
+bool computeParticulateStats(const float * data, size_t n_data, PdaStats * stats) {
+    return INSTRUMENTED_STATS(PDA_INSTR_COMPUTE_PARTICULATE_STATS, data, n_data, stats);
+}
+
+/**
+ * @brief Completa una estructura PdaStats a partir de los momentos de un conjunto de datos.
+ *
+ * Centraliza los valores de error de la API: MSN_VOID_ARRAY_VALUE sin datos válidos,
+ * MSN_DS_NOTDEFINI si el total de datos es menor o igual a 1 y MSN_NOT_DATA si hay menos de dos
+ * datos válidos.
+ *
+ * @param totalCount Total de datos recibidos, válidos e inválidos.
+ * @param validCount Cantidad de datos válidos.
+ * @param mean Promedio de los datos válidos.
+ * @param m2 Suma de cuadrados de las diferencias respecto del promedio.
+ * @param min Mínimo de los datos válidos.
+ * @param max Máximo de los datos válidos.
+ * @param stats Estructura donde se almacenan los resultados.
+ * @return Verdadero si hay al menos un dato válido; falso en caso contrario.
+ */
+
+bool pdaStatsFromMoments(size_t totalCount, size_t validCount, double mean, double m2, float min,
+                         float max, PdaStats * stats) {
+    if (stats == NULL)
+        return false;
+
+    stats->validCount = validCount;
+    stats->rejectedCount = totalCount - validCount;
+
+    if (totalCount == CERODATA)
+        stats->stdDev = MSN_VOID_ARRAY_VALUE; // Manejo de array vacío
+    else if (totalCount <= DS_NOTDEFINI)
+        stats->stdDev = MSN_DS_NOTDEFINI; // La desviación estándar no está definida para n <= 1
+    else
+        stats->stdDev = MSN_NOT_DATA;
+
+    if (validCount == INI_VALID_COUNT) {
+        stats->mean = MSN_VOID_ARRAY_VALUE;
+        stats->min = MSN_VOID_ARRAY_VALUE;
+        stats->max = MSN_VOID_ARRAY_VALUE;
+        return false;
     }
 
+    stats->mean = mean;
+    stats->min = min;
+    stats->max = max;
+
     // Calcula la desviación estándar solo si hay suficientes datos validados
-    if (validCount > MIN_VALID_COUNT) {
-        return sqrt_binary_search(sumOfSquares / (validCount - 1));
-    } else {
-        return MSN_NOT_DATA; // Retorna -777 si no hay suficientes datos para calcular la desviación
-                             // estándar
+    if (totalCount > DS_NOTDEFINI && validCount > MIN_VALID_COUNT) {
+        double variance = m2 / (validCount - 1);
+        stats->stdDev = sqrt_binary_search(variance);
     }
+    return true;
 }
 
 /* === End of documentation ==================================================================== */
@@ -28,6 +28,8 @@
  */
 
 #include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
 
 #ifndef PARTICULATEDATAANALYZER_H
 #define PARTICULATEDATAANALYZER_H
@@ -42,6 +44,9 @@
  * - findMaxValue: Identifica el valor máximo en los datos.
  * - findMinValue: Identifica el valor mínimo en los datos.
  * - calculateStandardDeviation: Calcula la desviación estándar.
+ * - computeParticulateStats: Calcula todas las estadísticas anteriores en una sola pasada.
+ * - calculateAverage64, findMaxValue64, findMinValue64, calculateStandardDeviation64: Variantes
+ *   con longitud size_t para archivos de más de 2^31 datos.
  *
  * Adecuado para sistemas de monitoreo de calidad del aire.
  */
@@ -82,10 +87,36 @@ extern "C" {
 
 /* === Public data type declarations =========================================================== */
 
+/**
+ * @brief Resumen estadístico de un conjunto de datos de MP calculado en una sola pasada.
+ *
+ * Los campos que no pueden calcularse contienen los mismos valores de error que retornan las
+ * funciones individuales (MSN_VOID_ARRAY_VALUE, MSN_DS_NOTDEFINI o MSN_NOT_DATA).
+ */
+typedef struct {
+    float mean;           /**< Promedio de los datos válidos. */
+    float min;            /**< Valor mínimo de los datos válidos. */
+    float max;            /**< Valor máximo de los datos válidos. */
+    float stdDev;         /**< Desviación estándar muestral de los datos válidos. */
+    size_t validCount;    /**< Cantidad de datos que cumplen maskIsDataTrue. */
+    size_t rejectedCount; /**< Cantidad de datos descartados por estar fuera de rango. */
+} PdaStats;
+
 /* === Public variable declarations ============================================================ */
 
 /* === Public function declarations ============================================================ */
 
+/**
+ * @brief Verifica si un dato está dentro del rango válido de concentración de MP.
+ *
+ * Criterio de validez común a todas las funciones de la biblioteca: un dato es válido si es
+ * mayor que MP_MIN_VALUE y menor que MP_MAX_VALUE.
+ *
+ * @param data Valor de MP a verificar.
+ * @return Verdadero si el valor está dentro del rango; falso en caso contrario.
+ */
+bool maskIsDataTrue(float data);
+
 /**
  * @brief Calcula el promedio de un conjunto de datos.
  *
@@ -142,6 +173,79 @@ float findMinValue(float data[], int n_data);
  */
 float calculateStandardDeviation(float data[], int n);
 
+/**
+ * @brief Variante de calculateAverage con longitud size_t.
+ *
+ * Las sumas se acumulan en doble precisión por bloques combinados por pares (ver pdaReduce), por
+ * lo que el resultado no se degrada al crecer el conjunto de datos.
+ *
+ * @param data Un array de datos flotantes.
+ * @param n_data El número de elementos en el array.
+ * @return El promedio de los valores válidos o MSN_VOID_ARRAY_VALUE.
+ */
+float calculateAverage64(const float * data, size_t n_data);
+
+/**
+ * @brief Variante de findMaxValue con longitud size_t.
+ *
+ * @param data Un array de datos flotantes.
+ * @param n_data El número de elementos en el array.
+ * @return El valor máximo de los datos válidos o MSN_VOID_ARRAY_VALUE.
+ */
+float findMaxValue64(const float * data, size_t n_data);
+
+/**
+ * @brief Variante de findMinValue con longitud size_t.
+ *
+ * @param data Un array de datos flotantes.
+ * @param n_data El número de elementos en el array.
+ * @return El valor mínimo de los datos válidos o MSN_VOID_ARRAY_VALUE.
+ */
+float findMinValue64(const float * data, size_t n_data);
+
+/**
+ * @brief Variante de calculateStandardDeviation con longitud size_t.
+ *
+ * @param data Un array de datos flotantes.
+ * @param n_data El número de elementos en el array.
+ * @return La desviación estándar, MSN_VOID_ARRAY_VALUE, MSN_DS_NOTDEFINI o MSN_NOT_DATA, con
+ *         las mismas reglas que calculateStandardDeviation.
+ */
+float calculateStandardDeviation64(const float * data, size_t n_data);
+
+/**
+ * @brief Calcula promedio, mínimo, máximo y desviación estándar en una sola pasada.
+ *
+ * Recorre el array una única vez aplicando el criterio de validez de maskIsDataTrue y completa
+ * la estructura PdaStats con todas las estadísticas. Las funciones calculateAverage,
+ * findMaxValue, findMinValue y calculateStandardDeviation se implementan sobre esta función.
+ *
+ * @param data Un array de datos flotantes.
+ * @param n_data El número de elementos en el array.
+ * @param stats Estructura donde se almacenan los resultados.
+ * @return Verdadero si se encontró al menos un dato válido; falso si el array está vacío, todos
+ *         los datos son inválidos o stats es NULL.
+ */
+bool computeParticulateStats(const float * data, size_t n_data, PdaStats * stats);
+
+/**
+ * @brief Completa una estructura PdaStats a partir de los momentos de un conjunto de datos.
+ *
+ * Permite que los módulos que acumulan estadísticas de forma incremental reporten los mismos
+ * valores de error que las funciones sobre arrays.
+ *
+ * @param totalCount Total de datos recibidos, válidos e inválidos.
+ * @param validCount Cantidad de datos válidos.
+ * @param mean Promedio de los datos válidos.
+ * @param m2 Suma de cuadrados de las diferencias respecto del promedio.
+ * @param min Mínimo de los datos válidos.
+ * @param max Máximo de los datos válidos.
+ * @param stats Estructura donde se almacenan los resultados.
+ * @return Verdadero si hay al menos un dato válido; falso en caso contrario.
+ */
+bool pdaStatsFromMoments(size_t totalCount, size_t validCount, double mean, double m2, float min,
+                         float max, PdaStats * stats);
+
 /* === End of documentation ==================================================================== */
 
 #ifdef __cplusplus
@@ -0,0 +1,294 @@
+/*
+ * Nombre del archivo: Pda.hpp
+ * Versión: 0.1
+ * Descripción:
+ *  Capa C++17 de solo cabecera sobre la biblioteca, con el tipo de los datos y el rango de
+ *  validez como parámetros de plantilla.
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <iterator> // Para std::data y std::size
+#include <type_traits>
+#include "ParticulateDataAnalyzer.h"
+#include "PdaAccumulator.h"
+#include "PdaKernels.h"
+#include "PdaQuantized.h"
+
+#ifndef PDA_HPP
+#define PDA_HPP
+
+/**
+ * @file Pda.hpp
+ * @brief Estadísticas de MP para C++17 con tipo de dato y rango de validez fijados al compilar.
+ *
+ * - pda::Range: Rango de validez en décimas de µg/m³, como tipo.
+ * - pda::MpRange: El rango de maskIsDataTrue (MP_MIN_VALUE, MP_MAX_VALUE).
+ * - pda::accumulate: Agrega un array a un PdaAccumulator.
+ * - pda::stats: Estadísticas de un array o de un contenedor contiguo (std::vector, std::array,
+ *   std::span, arrays de C).
+ *
+ * Los datos pueden ser float, double o std::uint16_t; estos últimos se interpretan como códigos
+ * en décimas (PdaQ16, ver PdaQuantized.h). El rango de validez es un parámetro de plantilla, por
+ * lo que cada sensor puede usar su propio rango sin costo: cada combinación de tipo y rango
+ * instancia su propio núcleo, completamente en línea, con los límites como constantes y sin
+ * ninguna decisión en tiempo de ejecución dentro del ciclo. Por ejemplo:
+ *
+ *     using Pm10Range = pda::Range<1, 6000>; // (0,1; 600) µg/m³
+ *     PdaStats pm25 = pda::stats(samples);   // pda::MpRange
+ *     PdaStats pm10 = pda::stats<Pm10Range>(pm10Samples);
+ *
+ * Una política de validez es cualquier tipo con funciones estáticas constexpr valid(T) para los
+ * tipos de dato que se usen con ella; pda::Range es la política predefinida.
+ *
+ * Los datos se reducen por bloques de PDA_REDUCE_BLOCK, cada uno con sumas desplazadas respecto
+ * de su primer dato válido (enteras y exactas para los códigos), y los bloques se combinan con
+ * pdaAccMerge. Los resultados usan los mismos valores de error que computeParticulateStats; con
+ * pda::MpRange coinciden con computeParticulateStats dentro de PDA_KERNEL_TOLERANCE y son
+ * idénticos a computeParticulateStatsQ16 para los códigos. Las funciones de esta capa no se
+ * registran en PdaInstrument.h. Las pruebas están en test/test_Pda.cpp (make test-cpp).
+ */
+
+/* === Headers files inclusions ================================================================ */
+
+/* === Public macros definitions =============================================================== */
+
+/* === Public data type declarations =========================================================== */
+
+namespace pda {
+
+/**
+ * @brief Rango de validez en décimas de µg/m³.
+ *
+ * Un dato flotante es válido si es mayor que LowTenths / 10 y menor que HighTenths / 10, el mismo
+ * criterio abierto que maskIsDataTrue. Un código es válido si no es PDA_Q16_NO_DATA y está entre
+ * LowTenths y HighTenths - 1, igual que pdaQ16IsValid con el rango por defecto.
+ *
+ * @tparam LowTenths Límite inferior, en décimas.
+ * @tparam HighTenths Límite superior, en décimas.
+ */
+template <int LowTenths, int HighTenths> struct Range {
+    static_assert(0 <= LowTenths && LowTenths < HighTenths && HighTenths <= UINT16_MAX,
+                  "pda::Range requiere 0 <= LowTenths < HighTenths <= UINT16_MAX");
+
+    /// @brief Límite inferior en µg/m³, excluido.
+    static constexpr double lower = LowTenths / static_cast<double>(PDA_Q16_SCALE);
+
+    /// @brief Límite superior en µg/m³, excluido.
+    static constexpr double upper = HighTenths / static_cast<double>(PDA_Q16_SCALE);
+
+    /// @brief Primer código válido.
+    static constexpr int firstCode = LowTenths > PDA_Q16_MIN ? LowTenths : PDA_Q16_MIN;
+
+    /**
+     * @brief Verifica si un dato está dentro del rango.
+     */
+    static constexpr bool valid(double value) noexcept {
+        return value > lower && value < upper;
+    }
+
+    /**
+     * @brief Verifica si un dato está dentro del rango, comparado en doble precisión como en
+     *        maskIsDataTrue.
+     */
+    static constexpr bool valid(float value) noexcept {
+        return valid(static_cast<double>(value));
+    }
+
+    /**
+     * @brief Verifica si un código en décimas está dentro del rango.
+     */
+    static constexpr bool valid(std::uint16_t code) noexcept {
+        return static_cast<std::uint16_t>(code - firstCode) < HighTenths - firstCode;
+    }
+};
+
+/**
+ * @brief Rango de validez de maskIsDataTrue y de pdaQ16IsValid.
+ */
+using MpRange = Range<PDA_Q16_MIN, PDA_Q16_MAX + 1>;
+
+static_assert(MpRange::lower == MP_MIN_VALUE && MpRange::upper == MP_MAX_VALUE,
+              "pda::MpRange debe coincidir con MP_MIN_VALUE y MP_MAX_VALUE");
+
+/**
+ * @brief Indica si T es un tipo de dato admitido: float, double o std::uint16_t (décimas).
+ */
+template <typename T>
+inline constexpr bool isElement = std::is_same_v<T, float> || std::is_same_v<T, double> ||
+                                  std::is_same_v<T, std::uint16_t>;
+
+/* === Public function declarations ============================================================ */
+
+namespace detail {
+
+/**
+ * @brief Reduce un bloque de códigos en décimas con sumas enteras exactas.
+ *
+ * @param codes Bloque de códigos.
+ * @param n_data Cantidad de códigos, a lo sumo PDA_REDUCE_BLOCK.
+ * @return Acumulador con los datos del bloque.
+ */
+template <typename Policy>
+inline PdaAccumulator reduceCodes(const std::uint16_t * codes, std::size_t n_data) noexcept {
+    std::size_t validCount = 0;
+    std::uint64_t sum = 0;
+    std::uint64_t sumOfSquares = 0;
+    std::uint16_t low = UINT16_MAX;
+    std::uint16_t high = 0;
+    for (std::size_t i = 0; i < n_data; i++) {
+        std::uint16_t code = codes[i];
+        bool valid = Policy::valid(code);
+        std::uint64_t term = valid ? code : 0;
+        sum += term;
+        sumOfSquares += term * term;
+        validCount += valid;
+        low = (valid && code < low) ? code : low;
+        high = (valid && code > high) ? code : high;
+    }
+
+    PdaAccumulator block;
+    pdaAccInit(&block);
+    block.rejectedCount = n_data - validCount;
+    if (validCount == 0)
+        return block;
+    std::uint64_t n = validCount;
+    double scale = PDA_Q16_SCALE;
+    block.validCount = validCount;
+    block.mean = static_cast<double>(sum) / static_cast<double>(n) / scale;
+    block.m2 = static_cast<double>(n * sumOfSquares - sum * sum) / static_cast<double>(n) /
+               (scale * scale);
+    block.min = static_cast<float>(low / scale);
+    block.max = static_cast<float>(high / scale);
+    return block;
+}
+
+/**
+ * @brief Reduce un bloque de datos flotantes con sumas desplazadas respecto de su primer dato
+ *        válido.
+ *
+ * @param data Bloque de datos.
+ * @param n_data Cantidad de datos, a lo sumo PDA_REDUCE_BLOCK.
+ * @return Acumulador con los datos del bloque.
+ */
+template <typename Policy, typename T>
+inline PdaAccumulator reduceValues(const T * data, std::size_t n_data) noexcept {
+    PdaAccumulator block;
+    pdaAccInit(&block);
+    std::size_t first = 0;
+    while (first < n_data && !Policy::valid(data[first]))
+        first++;
+    if (first == n_data) {
+        block.rejectedCount = n_data;
+        return block;
+    }
+
+    double shift = data[first];
+    std::size_t validCount = 0;
+    double sum = 0.0;
+    double sumOfSquares = 0.0;
+    T low = data[first];
+    T high = data[first];
+    for (std::size_t i = first; i < n_data; i++) {
+        T value = data[i];
+        bool valid = Policy::valid(value);
+        double delta = valid ? static_cast<double>(value) - shift : 0.0;
+        sum += delta;
+        sumOfSquares += delta * delta;
+        validCount += valid;
+        low = (valid && value < low) ? value : low;
+        high = (valid && value > high) ? value : high;
+    }
+
+    double n = static_cast<double>(validCount);
+    block.validCount = validCount;
+    block.rejectedCount = n_data - validCount;
+    block.mean = shift + sum / n;
+    block.m2 = sumOfSquares - sum * sum / n;
+    block.min = static_cast<float>(low);
+    block.max = static_cast<float>(high);
+    return block;
+}
+
+} // namespace detail
+
+/**
+ * @brief Agrega un array a un acumulador, validando cada dato con Policy.
+ *
+ * @tparam Policy Política de validez; por defecto pda::MpRange.
+ * @param acc Acumulador.
+ * @param data Array de datos float, double o std::uint16_t (décimas).
+ * @param n_data Número de elementos en el array.
+ */
+template <typename Policy = MpRange, typename T>
+inline void accumulate(PdaAccumulator & acc, const T * data, std::size_t n_data) noexcept {
+    static_assert(isElement<T>, "pda: el tipo de dato debe ser float, double o std::uint16_t");
+    if (data == nullptr)
+        return;
+    for (std::size_t done = 0; done < n_data; done += PDA_REDUCE_BLOCK) {
+        std::size_t count = (n_data - done < PDA_REDUCE_BLOCK) ? n_data - done : PDA_REDUCE_BLOCK;
+        PdaAccumulator block;
+        if constexpr (std::is_same_v<T, std::uint16_t>)
+            block = detail::reduceCodes<Policy>(data + done, count);
+        else
+            block = detail::reduceValues<Policy>(data + done, count);
+        pdaAccMerge(&acc, &block);
+    }
+}
+
+/**
+ * @brief Calcula las estadísticas de un array, validando cada dato con Policy.
+ *
+ * @tparam Policy Política de validez; por defecto pda::MpRange.
+ * @param data Array de datos float, double o std::uint16_t (décimas).
+ * @param n_data Número de elementos en el array.
+ * @return Estadísticas, con los valores de error de computeParticulateStats.
+ */
+template <typename Policy = MpRange, typename T>
+inline PdaStats stats(const T * data, std::size_t n_data) noexcept {
+    PdaAccumulator acc;
+    pdaAccInit(&acc);
+    accumulate<Policy>(acc, data, n_data);
+    PdaStats result;
+    pdaAccQuery(&acc, &result);
+    return result;
+}
+
+/**
+ * @brief Calcula las estadísticas de un contenedor contiguo, validando cada dato con Policy.
+ *
+ * @tparam Policy Política de validez; por defecto pda::MpRange.
+ * @param data Contenedor con std::data y std::size: std::vector, std::array, std::span o un
+ *             array de C.
+ * @return Estadísticas, con los valores de error de computeParticulateStats.
+ */
+template <typename Policy = MpRange, typename Container>
+inline auto stats(const Container & data) noexcept
+    -> decltype(std::data(data), std::size(data), PdaStats{}) {
+    return stats<Policy>(std::data(data), std::size(data));
+}
+
+} // namespace pda
+
+/* === End of documentation ==================================================================== */
+
+#endif /* PDA_HPP */
@@ -0,0 +1,207 @@
+/*
+ * Nombre del archivo: PdaAccumulator.c
+ * Versión: 0.1
+ * Descripción:
+ *  Acumulador de estadísticas en flujo continuo (método de Welford) para datos de material
+ *  particulado que llegan muestra a muestra.
+ *
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo bajo los términos de la
+ * Licencia Pública General GNU publicada por la Free Software Foundation, ya sea la versión 3 de la
+ * Licencia, o (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil, pero SIN NINGUNA GARANTÍA; sin
+ * siquiera la garantía implícita de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU junto con este programa.
+ * Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ */
+
+/**
+ * @file PdaAccumulator.c
+ * @brief Implementación del acumulador incremental de estadísticas.
+ *
+ * Cada dato individual actualiza promedio y M2 con la recurrencia de Welford. Los bloques se
+ * reducen con pdaReduce y se incorporan con la fórmula de combinación de Chan et al., que es
+ * exacta para promedio y M2.
+ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "PdaAccumulator.h"
+#include "PdaKernels.h"
+#include <math.h> // Para INFINITY
+
+/* === Macros definitions ====================================================================== */
+
+/**
+ * @brief valor inicial de contador de datos
+ */
+#define INI_VALID_COUNT 0
+
+/**
+ * @brief valor inicial de promedio y M2
+ */
+#define INI_SUM 0.0
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/* === Private function implementation ========================================================= */
+
+/* === Public function implementation ========================================================== */
+
+/**
+ * @brief Inicializa un acumulador sin datos.
+ *
+ * El mínimo y el máximo se inicializan en +infinito y -infinito para que el primer dato válido
+ * los reemplace sin comparaciones especiales.
+ *
+ * @param acc Acumulador a inicializar.
+ */
+void pdaAccInit(PdaAccumulator * acc) {
+    if (acc == NULL)
+        return;
+    acc->validCount = INI_VALID_COUNT;
+    acc->rejectedCount = INI_VALID_COUNT;
+    acc->mean = INI_SUM;
+    acc->m2 = INI_SUM;
+    acc->min = INFINITY;
+    acc->max = -INFINITY;
+}
+
+/**
+ * @brief Agrega un dato al acumulador con la recurrencia de Welford.
+ *
+ * @param acc Acumulador.
+ * @param value Dato de MP.
+ * @return Verdadero si el dato es válido y fue acumulado; falso si fue descartado.
+ */
+bool pdaAccPush(PdaAccumulator * acc, float value) {
+    if (acc == NULL)
+        return false;
+    if (!maskIsDataTrue(value)) {
+        acc->rejectedCount++;
+        return false;
+    }
+    acc->validCount++;
+    double delta = (double)value - acc->mean;
+    acc->mean += delta / acc->validCount;
+    acc->m2 += delta * ((double)value - acc->mean);
+    if (value < acc->min)
+        acc->min = value;
+    if (value > acc->max)
+        acc->max = value;
+    return true;
+}
+
+/**
+ * @brief Agrega un bloque de datos reduciéndolo con el núcleo vectorizado activo.
+ *
+ * Las sumas del bloque se desplazan respecto del promedio acumulado (o del primer dato válido
+ * si el acumulador está vacío) y el resultado se combina con pdaAccMerge.
+ *
+ * @param acc Acumulador.
+ * @param data Array de datos flotantes.
+ * @param n_data Número de elementos en el array.
+ */
+void pdaAccPushBatch(PdaAccumulator * acc, const float * data, size_t n_data) {
+    if (acc == NULL || data == NULL || n_data == INI_VALID_COUNT)
+        return;
+
+    double shift = acc->mean;
+    if (acc->validCount == INI_VALID_COUNT) {
+        size_t first = INI_VALID_COUNT;
+        while (first < n_data && !maskIsDataTrue(data[first]))
+            first++;
+        acc->rejectedCount += first;
+        if (first == n_data)
+            return; // el bloque no tiene datos válidos
+        data += first;
+        n_data -= first;
+        shift = data[INI_VALID_COUNT];
+    }
+
+    PdaReduction reduction;
+    pdaReduce(data, n_data, shift, &reduction);
+
+    PdaAccumulator batch;
+    pdaAccInit(&batch);
+    batch.rejectedCount = n_data - reduction.validCount;
+    if (reduction.validCount > INI_VALID_COUNT) {
+        double n = (double)reduction.validCount;
+        batch.validCount = reduction.validCount;
+        batch.mean = shift + reduction.sum / n;
+        batch.m2 = reduction.sumOfSquares - reduction.sum * reduction.sum / n;
+        if (batch.m2 < INI_SUM)
+            batch.m2 = INI_SUM; // descarta residuos negativos de redondeo
+        batch.min = reduction.min;
+        batch.max = reduction.max;
+    }
+    pdaAccMerge(acc, &batch);
+}
+
+/**
+ * @brief Combina dos acumuladores con la fórmula de Chan et al.
+ *
+ * Con n = nA + nB y delta = meanB - meanA:
+ * mean = meanA + delta * nB / n y M2 = M2A + M2B + delta^2 * nA * nB / n.
+ *
+ * @param acc Acumulador destino.
+ * @param other Acumulador a incorporar.
+ */
+void pdaAccMerge(PdaAccumulator * acc, const PdaAccumulator * other) {
+    if (acc == NULL || other == NULL)
+        return;
+
+    acc->rejectedCount += other->rejectedCount;
+    if (other->validCount == INI_VALID_COUNT)
+        return;
+    if (acc->validCount == INI_VALID_COUNT) {
+        size_t rejected = acc->rejectedCount;
+        *acc = *other;
+        acc->rejectedCount = rejected;
+        return;
+    }
+
+    double nA = (double)acc->validCount;
+    double nB = (double)other->validCount;
+    double n = nA + nB;
+    double delta = other->mean - acc->mean;
+    acc->mean += delta * nB / n;
+    acc->m2 += other->m2 + delta * delta * nA * nB / n;
+    acc->validCount += other->validCount;
+    if (other->min < acc->min)
+        acc->min = other->min;
+    if (other->max > acc->max)
+        acc->max = other->max;
+}
+
+/**
+ * @brief Obtiene las estadísticas acumuladas.
+ *
+ * @param acc Acumulador.
+ * @param stats Estructura donde se almacenan los resultados.
+ * @return Verdadero si hay al menos un dato válido; falso en caso contrario.
+ */
+bool pdaAccQuery(const PdaAccumulator * acc, PdaStats * stats) {
+    if (acc == NULL)
+        return false;
+    return pdaStatsFromMoments(acc->validCount + acc->rejectedCount, acc->validCount, acc->mean,
+                               acc->m2, acc->min, acc->max, stats);
+}
+
+/* === End of documentation ==================================================================== */
@@ -0,0 +1,133 @@
+/*
+ * Nombre del archivo: PdaAccumulator.h
+ * Versión: 0.1
+ * Descripción:
+ *  Acumulador de estadísticas en flujo continuo (método de Welford) para datos de material
+ *  particulado que llegan muestra a muestra.
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "ParticulateDataAnalyzer.h"
+
+#ifndef PDAACCUMULATOR_H
+#define PDAACCUMULATOR_H
+
+/**
+ * @file PdaAccumulator.h
+ * @brief Acumulador incremental de promedio, varianza, mínimo y máximo en memoria O(1).
+ *
+ * Permite procesar flujos de datos sin almacenar el período de promediado completo:
+ * - pdaAccInit: Inicializa el acumulador.
+ * - pdaAccPush: Agrega un dato.
+ * - pdaAccPushBatch: Agrega un bloque de datos usando los núcleos vectorizados.
+ * - pdaAccMerge: Combina dos acumuladores.
+ * - pdaAccQuery: Obtiene las estadísticas acumuladas.
+ *
+ * Los datos se validan con maskIsDataTrue; el promedio y la varianza se actualizan con el método
+ * de Welford, que evita la cancelación catastrófica de la suma de cuadrados directa.
+ */
+
+/* === Headers files inclusions ================================================================ */
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+/* === Public data type declarations =========================================================== */
+
+/**
+ * @brief Estado de un acumulador de estadísticas.
+ */
+typedef struct {
+    size_t validCount;    /**< Cantidad de datos válidos acumulados. */
+    size_t rejectedCount; /**< Cantidad de datos descartados por estar fuera de rango. */
+    double mean;          /**< Promedio de los datos válidos. */
+    double m2;            /**< Suma de cuadrados de las diferencias respecto del promedio. */
+    float min;            /**< Mínimo de los datos válidos. */
+    float max;            /**< Máximo de los datos válidos. */
+} PdaAccumulator;
+
+/* === Public variable declarations ============================================================ */
+
+/* === Public function declarations ============================================================ */
+
+/**
+ * @brief Inicializa un acumulador sin datos.
+ *
+ * @param acc Acumulador a inicializar.
+ */
+void pdaAccInit(PdaAccumulator * acc);
+
+/**
+ * @brief Agrega un dato al acumulador.
+ *
+ * @param acc Acumulador.
+ * @param value Dato de MP.
+ * @return Verdadero si el dato es válido y fue acumulado; falso si fue descartado.
+ */
+bool pdaAccPush(PdaAccumulator * acc, float value);
+
+/**
+ * @brief Agrega un bloque de datos al acumulador.
+ *
+ * El bloque se reduce con el núcleo vectorizado activo y luego se combina con el estado
+ * acumulado, por lo que es más eficiente que llamar a pdaAccPush por cada dato.
+ *
+ * @param acc Acumulador.
+ * @param data Array de datos flotantes.
+ * @param n_data Número de elementos en el array.
+ */
+void pdaAccPushBatch(PdaAccumulator * acc, const float * data, size_t n_data);
+
+/**
+ * @brief Combina en acc los datos acumulados en other.
+ *
+ * @param acc Acumulador destino.
+ * @param other Acumulador a incorporar.
+ */
+void pdaAccMerge(PdaAccumulator * acc, const PdaAccumulator * other);
+
+/**
+ * @brief Obtiene las estadísticas acumuladas.
+ *
+ * Los valores de error coinciden con los de computeParticulateStats aplicada a todos los datos
+ * recibidos.
+ *
+ * @param acc Acumulador.
+ * @param stats Estructura donde se almacenan los resultados.
+ * @return Verdadero si hay al menos un dato válido; falso en caso contrario.
+ */
+bool pdaAccQuery(const PdaAccumulator * acc, PdaStats * stats);
+
+/* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PDAACCUMULATOR_H */
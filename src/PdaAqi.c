@@ -0,0 +1,349 @@
+/*
+ * Nombre del archivo: PdaAqi.c
+ * Versión: 0.1
+ * Descripción:
+ *  Promedio móvil de 24 horas, NowCast e índice de calidad del aire (AQI) incrementales para
+ *  MP2.5 y MP10.
+ *
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo bajo los términos de la
+ * Licencia Pública General GNU publicada por la Free Software Foundation, ya sea la versión 3 de la
+ * Licencia, o (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil, pero SIN NINGUNA GARANTÍA; sin
+ * siquiera la garantía implícita de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU junto con este programa.
+ * Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ */
+
+/**
+ * @file PdaAqi.c
+ * @brief Implementación de los indicadores regulatorios de una estación.
+ *
+ * El NowCast es sum(w^i c_i) / sum(w^i) con i = 0 para la hora más reciente, sobre las horas
+ * válidas. Como w cambia cada hora con el mínimo y el máximo de la ventana, la suma ponderada no
+ * puede arrastrarse entre horas; se evalúa con el esquema de Horner desde la hora más antigua, en
+ * el mismo recorrido que obtiene el mínimo y el máximo.
+ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "PdaAqi.h"
+#include <math.h> // Para floor
+
+/* === Macros definitions ====================================================================== */
+
+/**
+ * @brief Horas recientes evaluadas por la regla de completitud del NowCast, y mínimo de válidas.
+ */
+#define NOWCAST_RECENT_HOURS 3
+#define NOWCAST_RECENT_VALID 2
+
+/**
+ * @brief Cota inferior del factor de peso del NowCast para material particulado.
+ */
+#define NOWCAST_MIN_WEIGHT 0.5
+
+/**
+ * @brief Margen para truncar concentraciones almacenadas en float (0.7f vale 0.69999999).
+ */
+#define TRUNCATION_EPSILON 1e-4
+
+/**
+ * @brief Límites superiores de cada categoría del AQI.
+ */
+#define AQI_GOOD_MAX           50
+#define AQI_MODERATE_MAX       100
+#define AQI_SENSITIVE_MAX      150
+#define AQI_UNHEALTHY_MAX      200
+#define AQI_VERY_UNHEALTHY_MAX 300
+#define AQI_MAX                500
+
+/* === Private data type declarations ========================================================== */
+
+/**
+ * @brief Fila de una tabla de cortes: concentraciones [low, high] se mapean en [aqiLow, aqiHigh].
+ */
+typedef struct {
+    double low;
+    double high;
+    int aqiLow;
+    int aqiHigh;
+} AqiBreakpoint;
+
+/**
+ * @brief Tabla de cortes de un contaminante.
+ */
+typedef struct {
+    const AqiBreakpoint * rows;
+    size_t count;
+    double resolution; /**< Inversa del paso de truncamiento: 10 para 0,1 ug/m3. */
+} AqiTable;
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/**
+ * @brief Cortes de MP2.5 (promedio de 24 horas, ug/m3), revisión EPA 2024.
+ */
+static const AqiBreakpoint pm25Rows[] = {
+    {0.0, 9.0, 0, 50},       {9.1, 35.4, 51, 100},     {35.5, 55.4, 101, 150},
+    {55.5, 125.4, 151, 200}, {125.5, 225.4, 201, 300}, {225.5, 325.4, 301, 500},
+};
+
+/**
+ * @brief Cortes de MP10 (promedio de 24 horas, ug/m3), revisión EPA 2024.
+ */
+static const AqiBreakpoint pm10Rows[] = {
+    {0.0, 54.0, 0, 50},       {55.0, 154.0, 51, 100},   {155.0, 254.0, 101, 150},
+    {255.0, 354.0, 151, 200}, {355.0, 424.0, 201, 300}, {425.0, 604.0, 301, 500},
+};
+
+/**
+ * @brief Tablas indexadas por PdaPollutant.
+ */
+static const AqiTable tables[PDA_POLLUTANT_COUNT] = {
+    {pm25Rows, sizeof(pm25Rows) / sizeof(pm25Rows[0]), 10.0},
+    {pm10Rows, sizeof(pm10Rows) / sizeof(pm10Rows[0]), 1.0},
+};
+
+/**
+ * @brief Nombres legibles de las categorías, indexados por PdaAqiCategory.
+ */
+static const char * const categoryNames[PDA_AQI_CATEGORY_COUNT] = {
+    "good", "moderate", "unhealthy for sensitive groups", "unhealthy", "very unhealthy",
+    "hazardous"};
+
+/* === Private function implementation ========================================================= */
+
+/**
+ * @brief Recalcula la suma de las horas válidas para descartar el error de redondeo acumulado.
+ */
+static void rebuildSum(PdaAqiStation * station) {
+    double sum = 0.0;
+    for (size_t i = 0; i < PDA_AQI_HOURS; i++) {
+        if (station->validMask & (UINT32_C(1) << i))
+            sum += station->hours[i];
+    }
+    station->sum = sum;
+    station->sinceRebuild = 0;
+}
+
+/**
+ * @brief Posición en el buffer de la hora situada age horas antes de la más reciente.
+ */
+static size_t slotForAge(const PdaAqiStation * station, size_t age) {
+    return (station->next + 2 * PDA_AQI_HOURS - 1 - age) % PDA_AQI_HOURS;
+}
+
+/**
+ * @brief Indica si la hora situada age horas antes de la más reciente es válida.
+ */
+static bool hourIsValid(const PdaAqiStation * station, size_t age) {
+    return (station->validMask >> slotForAge(station, age)) & 1u;
+}
+
+/**
+ * @brief Promedio de las horas válidas de las últimas 24, o el código de error que corresponde.
+ */
+static float average24h(const PdaAqiStation * station) {
+    if (station->validCount == 0)
+        return MSN_VOID_ARRAY_VALUE;
+    if (station->validCount < PDA_AQI_MIN_HOURS)
+        return MSN_NOT_DATA;
+    return (float)(station->sum / (double)station->validCount);
+}
+
+/**
+ * @brief NowCast de las últimas 12 horas, o el código de error que corresponde.
+ */
+static float nowCast(const PdaAqiStation * station) {
+    size_t hours = (station->count < PDA_NOWCAST_HOURS) ? station->count : PDA_NOWCAST_HOURS;
+    size_t recent = (hours < NOWCAST_RECENT_HOURS) ? hours : NOWCAST_RECENT_HOURS;
+    size_t recentValid = 0;
+    for (size_t age = 0; age < recent; age++)
+        recentValid += hourIsValid(station, age);
+
+    float min = MP_MAX_VALUE, max = 0.0f;
+    size_t valid = 0;
+    for (size_t age = 0; age < hours; age++) {
+        if (!hourIsValid(station, age))
+            continue;
+        float value = station->hours[slotForAge(station, age)];
+        if (value < min)
+            min = value;
+        if (value > max)
+            max = value;
+        valid++;
+    }
+    if (valid == 0)
+        return MSN_VOID_ARRAY_VALUE;
+    if (recentValid < NOWCAST_RECENT_VALID)
+        return MSN_NOT_DATA;
+
+    double weight = (double)min / (double)max;
+    if (weight < NOWCAST_MIN_WEIGHT)
+        weight = NOWCAST_MIN_WEIGHT;
+    double numerator = 0.0, denominator = 0.0;
+    for (size_t age = hours; age-- > 0;) {
+        bool isValid = hourIsValid(station, age);
+        numerator = numerator * weight + (isValid ? station->hours[slotForAge(station, age)] : 0.0);
+        denominator = denominator * weight + (isValid ? 1.0 : 0.0);
+    }
+    return (float)(numerator / denominator);
+}
+
+/**
+ * @brief AQI de un promedio, propagando los códigos de error.
+ */
+static int aqiOrError(PdaPollutant pollutant, float average) {
+    if (average == MSN_VOID_ARRAY_VALUE || average == MSN_NOT_DATA)
+        return (int)average;
+    return pdaAqi(pollutant, average);
+}
+
+/* === Public function implementation ========================================================== */
+
+/**
+ * @brief Inicializa el estado de una estación.
+ *
+ * @param station Estación a inicializar.
+ * @param pollutant Contaminante medido.
+ */
+void pdaAqiInit(PdaAqiStation * station, PdaPollutant pollutant) {
+    station->pollutant = pollutant;
+    station->validMask = 0;
+    station->next = 0;
+    station->count = 0;
+    station->validCount = 0;
+    station->sum = 0.0;
+    station->sinceRebuild = 0;
+}
+
+/**
+ * @brief Incorpora el promedio de una hora.
+ *
+ * @param station Estación.
+ * @param hourlyAverage Promedio horario.
+ * @return Verdadero si la hora es válida.
+ */
+bool pdaAqiPushHour(PdaAqiStation * station, float hourlyAverage) {
+    size_t slot = station->next;
+    uint32_t bit = UINT32_C(1) << slot;
+    if (station->count == PDA_AQI_HOURS) {
+        if (station->validMask & bit) {
+            station->sum -= station->hours[slot];
+            station->validCount--;
+        }
+    } else {
+        station->count++;
+    }
+
+    bool valid = maskIsDataTrue(hourlyAverage);
+    station->hours[slot] = hourlyAverage;
+    if (valid) {
+        station->validMask |= bit;
+        station->sum += hourlyAverage;
+        station->validCount++;
+    } else {
+        station->validMask &= ~bit;
+    }
+    station->next = (slot + 1) % PDA_AQI_HOURS;
+    if (++station->sinceRebuild >= PDA_AQI_HOURS)
+        rebuildSum(station);
+    return valid;
+}
+
+/**
+ * @brief Calcula los indicadores de la estación.
+ *
+ * @param station Estación.
+ * @param report Estructura donde se almacenan los indicadores.
+ * @return Verdadero si el promedio de 24 horas o el NowCast pudo calcularse.
+ */
+bool pdaAqiQuery(const PdaAqiStation * station, PdaAqiReport * report) {
+    if (station == NULL || report == NULL)
+        return false;
+    report->average24h = average24h(station);
+    report->nowCast = nowCast(station);
+    report->aqi24h = aqiOrError(station->pollutant, report->average24h);
+    report->aqiNowCast = aqiOrError(station->pollutant, report->nowCast);
+    report->category24h = pdaAqiCategory(report->aqi24h);
+    report->categoryNow = pdaAqiCategory(report->aqiNowCast);
+    report->validHours = station->validCount;
+    return report->aqi24h >= 0 || report->aqiNowCast >= 0;
+}
+
+/**
+ * @brief Convierte una concentración en AQI.
+ *
+ * @param pollutant Contaminante.
+ * @param concentration Concentración en ug/m3.
+ * @return El AQI entre 0 y 500, o MSN_VOID_ARRAY_VALUE.
+ */
+int pdaAqi(PdaPollutant pollutant, float concentration) {
+    if ((unsigned)pollutant >= PDA_POLLUTANT_COUNT || !(concentration >= 0.0f))
+        return MSN_VOID_ARRAY_VALUE;
+
+    const AqiTable * table = &tables[pollutant];
+    double truncated =
+        floor((double)concentration * table->resolution + TRUNCATION_EPSILON) / table->resolution;
+    const AqiBreakpoint * row = &table->rows[0];
+    for (size_t i = 1; i < table->count && table->rows[i].low <= truncated; i++)
+        row = &table->rows[i];
+    if (truncated > row->high)
+        return AQI_MAX;
+
+    double aqi = (double)(row->aqiHigh - row->aqiLow) / (row->high - row->low) *
+                     (truncated - row->low) +
+                 row->aqiLow;
+    return (int)floor(aqi + 0.5);
+}
+
+/**
+ * @brief Categoría de un valor de AQI.
+ *
+ * @param aqi Valor de AQI.
+ * @return La categoría, o PDA_AQI_NOT_AVAILABLE si aqi es negativo.
+ */
+PdaAqiCategory pdaAqiCategory(int aqi) {
+    if (aqi < 0)
+        return PDA_AQI_NOT_AVAILABLE;
+    if (aqi <= AQI_GOOD_MAX)
+        return PDA_AQI_GOOD;
+    if (aqi <= AQI_MODERATE_MAX)
+        return PDA_AQI_MODERATE;
+    if (aqi <= AQI_SENSITIVE_MAX)
+        return PDA_AQI_SENSITIVE;
+    if (aqi <= AQI_UNHEALTHY_MAX)
+        return PDA_AQI_UNHEALTHY;
+    if (aqi <= AQI_VERY_UNHEALTHY_MAX)
+        return PDA_AQI_VERY_UNHEALTHY;
+    return PDA_AQI_HAZARDOUS;
+}
+
+/**
+ * @brief Nombre legible de una categoría.
+ *
+ * @param category Categoría.
+ * @return Nombre de la categoría o "n/a".
+ */
+const char * pdaAqiCategoryName(PdaAqiCategory category) {
+    if ((unsigned)category >= PDA_AQI_CATEGORY_COUNT)
+        return "n/a";
+    return categoryNames[category];
+}
+
+/* === End of documentation ==================================================================== */
@@ -0,0 +1,203 @@
+/*
+ * Nombre del archivo: PdaAqi.h
+ * Versión: 0.1
+ * Descripción:
+ *  Promedio móvil de 24 horas, NowCast e índice de calidad del aire (AQI) incrementales para
+ *  MP2.5 y MP10.
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "ParticulateDataAnalyzer.h"
+
+#ifndef PDAAQI_H
+#define PDAAQI_H
+
+/**
+ * @file PdaAqi.h
+ * @brief Indicadores regulatorios de una estación a partir de promedios horarios.
+ *
+ * - pdaAqiInit: Inicializa el estado de una estación para un contaminante.
+ * - pdaAqiPushHour: Incorpora el promedio de una hora (las horas faltantes se informan con un
+ *   valor inválido, por ejemplo MSN_VOID_ARRAY_VALUE).
+ * - pdaAqiQuery: Promedio de 24 horas, NowCast y sus AQI y categorías.
+ * - pdaAqi / pdaAqiCategory / pdaAqiCategoryName: Conversión de una concentración a AQI.
+ *
+ * Las horas se guardan en un buffer circular de 24 posiciones. La suma de las horas válidas se
+ * actualiza al agregar y al descartar cada hora (y se recalcula cada 24 horas para que no
+ * acumule error), por lo que el promedio de 24 horas cuesta O(1) por hora. El NowCast se evalúa
+ * con un único recorrido de Horner de las 12 horas guardadas, un costo fijo que no depende de la
+ * historia. Una hora es válida si cumple maskIsDataTrue.
+ *
+ * Reglas (EPA, Technical Assistance Document for the Reporting of Daily Air Quality, 2024):
+ * - Promedio de 24 horas: requiere al menos PDA_AQI_MIN_HOURS (75 %) horas válidas.
+ * - NowCast: requiere al menos 2 de las 3 horas más recientes. El factor de peso es
+ *   mínimo / máximo de las 12 horas, acotado inferiormente por 0,5.
+ * - AQI: interpolación lineal en la tabla de cortes del contaminante, con la concentración
+ *   truncada a 0,1 ug/m3 (MP2.5) o a 1 ug/m3 (MP10). Por encima de la tabla se informa 500.
+ */
+
+/* === Headers files inclusions ================================================================ */
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+/**
+ * @brief Horas del promedio móvil regulatorio.
+ */
+#define PDA_AQI_HOURS 24
+
+/**
+ * @brief Horas consideradas por el NowCast.
+ */
+#define PDA_NOWCAST_HOURS 12
+
+/**
+ * @brief Horas válidas necesarias para el promedio de 24 horas (75 %).
+ */
+#define PDA_AQI_MIN_HOURS 18
+
+/* === Public data type declarations =========================================================== */
+
+/**
+ * @brief Contaminantes con tabla de cortes.
+ */
+typedef enum {
+    PDA_POLLUTANT_PM25 = 0, /**< Material particulado de hasta 2,5 um. */
+    PDA_POLLUTANT_PM10,     /**< Material particulado de hasta 10 um. */
+    PDA_POLLUTANT_COUNT     /**< Cantidad de contaminantes definidos. */
+} PdaPollutant;
+
+/**
+ * @brief Categorías del AQI.
+ */
+typedef enum {
+    PDA_AQI_GOOD = 0,           /**< 0 a 50. */
+    PDA_AQI_MODERATE,           /**< 51 a 100. */
+    PDA_AQI_SENSITIVE,          /**< 101 a 150: dañina para grupos sensibles. */
+    PDA_AQI_UNHEALTHY,          /**< 151 a 200. */
+    PDA_AQI_VERY_UNHEALTHY,     /**< 201 a 300. */
+    PDA_AQI_HAZARDOUS,          /**< 301 a 500. */
+    PDA_AQI_CATEGORY_COUNT,     /**< Cantidad de categorías definidas. */
+    PDA_AQI_NOT_AVAILABLE = -1  /**< El indicador no pudo calcularse. */
+} PdaAqiCategory;
+
+/**
+ * @brief Estado de una estación. No reserva memoria dinámica.
+ */
+typedef struct {
+    PdaPollutant pollutant;       /**< Contaminante, para elegir la tabla de cortes. */
+    float hours[PDA_AQI_HOURS];   /**< Promedios horarios, en un buffer circular. */
+    uint32_t validMask;           /**< Bit i encendido si hours[i] es válida. */
+    size_t next;                  /**< Posición donde se escribirá la próxima hora. */
+    size_t count;                 /**< Horas presentes en el buffer. */
+    size_t validCount;            /**< Horas válidas presentes en el buffer. */
+    double sum;                   /**< Suma de las horas válidas presentes. */
+    size_t sinceRebuild;          /**< Horas agregadas desde el último recálculo de sum. */
+} PdaAqiStation;
+
+/**
+ * @brief Indicadores de una estación.
+ *
+ * Los promedios que no pueden calcularse valen MSN_VOID_ARRAY_VALUE si no hay horas válidas y
+ * MSN_NOT_DATA si no se alcanza el mínimo de horas; su AQI vale el mismo código y su categoría
+ * PDA_AQI_NOT_AVAILABLE.
+ */
+typedef struct {
+    float average24h;            /**< Promedio de las horas válidas de las últimas 24. */
+    float nowCast;               /**< NowCast de las últimas 12 horas. */
+    int aqi24h;                  /**< AQI del promedio de 24 horas. */
+    int aqiNowCast;              /**< AQI del NowCast. */
+    PdaAqiCategory category24h;  /**< Categoría del AQI de 24 horas. */
+    PdaAqiCategory categoryNow;  /**< Categoría del AQI del NowCast. */
+    size_t validHours;           /**< Horas válidas de las últimas 24. */
+} PdaAqiReport;
+
+/* === Public variable declarations ============================================================ */
+
+/* === Public function declarations ============================================================ */
+
+/**
+ * @brief Inicializa el estado de una estación.
+ *
+ * @param station Estación a inicializar.
+ * @param pollutant Contaminante medido.
+ */
+void pdaAqiInit(PdaAqiStation * station, PdaPollutant pollutant);
+
+/**
+ * @brief Incorpora el promedio de una hora, descartando la hora de 24 horas atrás.
+ *
+ * @param station Estación.
+ * @param hourlyAverage Promedio horario; un valor inválido registra una hora faltante.
+ * @return Verdadero si la hora es válida según maskIsDataTrue.
+ */
+bool pdaAqiPushHour(PdaAqiStation * station, float hourlyAverage);
+
+/**
+ * @brief Calcula los indicadores de la estación.
+ *
+ * @param station Estación.
+ * @param report Estructura donde se almacenan los indicadores.
+ * @return Verdadero si el promedio de 24 horas o el NowCast pudo calcularse.
+ */
+bool pdaAqiQuery(const PdaAqiStation * station, PdaAqiReport * report);
+
+/**
+ * @brief Convierte una concentración en AQI con la tabla de cortes del contaminante.
+ *
+ * @param pollutant Contaminante.
+ * @param concentration Concentración en ug/m3.
+ * @return El AQI entre 0 y 500, o MSN_VOID_ARRAY_VALUE si la concentración es negativa, NaN o el
+ *         contaminante no existe.
+ */
+int pdaAqi(PdaPollutant pollutant, float concentration);
+
+/**
+ * @brief Categoría de un valor de AQI.
+ *
+ * @param aqi Valor de AQI.
+ * @return La categoría, o PDA_AQI_NOT_AVAILABLE si aqi es negativo.
+ */
+PdaAqiCategory pdaAqiCategory(int aqi);
+
+/**
+ * @brief Nombre legible de una categoría.
+ *
+ * @param category Categoría.
+ * @return Nombre de la categoría o "n/a".
+ */
+const char * pdaAqiCategoryName(PdaAqiCategory category);
+
+/* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PDAAQI_H */
@@ -0,0 +1,210 @@
+/*
+ * Nombre del archivo: PdaArchive.c
+ * Versión: 0.1
+ * Descripción:
+ *  Lectura de archivos binarios de datos de MP (float32 little-endian) mapeados en memoria, sin
+ *  copiarlos a un buffer intermedio.
+ *
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo bajo los términos de la
+ * Licencia Pública General GNU publicada por la Free Software Foundation, ya sea la versión 3 de la
+ * Licencia, o (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil, pero SIN NINGUNA GARANTÍA; sin
+ * siquiera la garantía implícita de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU junto con este programa.
+ * Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ */
+
+/**
+ * @file PdaArchive.c
+ * @brief Implementación de la lectura de archivos mapeados en memoria.
+ *
+ * El descriptor se cierra apenas se crea el mapeo, que sigue siendo válido hasta munmap. Como el
+ * mapeo es privado y de solo lectura, MADV_DONTNEED solo descarta páginas limpias que el núcleo
+ * vuelve a leer del archivo si se acceden otra vez.
+ */
+
+/* === Headers files inclusions =============================================================== */
+
+#define _DEFAULT_SOURCE // Para madvise y O_CLOEXEC también con -std=c99
+
+#include "PdaArchive.h"
+#include "PdaAccumulator.h"
+#include "PdaByteOrder.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define PDA_HAVE_MMAP 1
+#include <fcntl.h>    // Para open
+#include <sys/mman.h> // Para mmap, madvise y munmap
+#include <sys/stat.h> // Para fstat
+#include <unistd.h>   // Para close
+#endif
+
+/* === Macros definitions ====================================================================== */
+
+/**
+ * @brief Datos de cada bloque.
+ */
+#define CHUNK_VALUES (PDA_ARCHIVE_CHUNK_BYTES / sizeof(float))
+
+/**
+ * @brief Los datos del archivo pueden usarse sin convertir si la plataforma es little-endian.
+ */
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define PDA_NATIVE_LITTLE_ENDIAN 0
+#else
+#define PDA_NATIVE_LITTLE_ENDIAN 1
+#endif
+
+/**
+ * @brief Datos convertidos por vez en plataformas big-endian.
+ */
+#define CONVERT_VALUES 1024
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/* === Private function implementation ========================================================= */
+
+/**
+ * @brief Acumula un bloque en el PdaAccumulator recibido como contexto.
+ */
+static void accumulateChunk(const float * data, size_t n_data, void * context) {
+    pdaAccPushBatch(context, data, n_data);
+}
+
+/**
+ * @brief Entrega un bloque en el orden de bytes de la plataforma.
+ */
+static void deliverChunk(const uint8_t * bytes, size_t n_data, PdaArchiveChunkFn chunk,
+                         void * context) {
+#if PDA_NATIVE_LITTLE_ENDIAN
+    chunk((const float *)(const void *)bytes, n_data, context);
+#else
+    float converted[CONVERT_VALUES];
+    for (size_t done = 0; done < n_data; done += CONVERT_VALUES) {
+        size_t count = (n_data - done < CONVERT_VALUES) ? n_data - done : CONVERT_VALUES;
+        for (size_t i = 0; i < count; i++)
+            converted[i] = pdaReadFloat(bytes + (done + i) * sizeof(float));
+        chunk(converted, count, context);
+    }
+#endif
+}
+
+/* === Public function implementation ========================================================== */
+
+/**
+ * @brief Mapea un archivo de datos en memoria.
+ *
+ * @param archive Estructura a completar.
+ * @param path Ruta del archivo.
+ * @return Verdadero si el archivo se abrió y mapeó.
+ */
+bool pdaArchiveOpen(PdaArchive * archive, const char * path) {
+    if (archive == NULL || path == NULL)
+        return false;
+    archive->base = NULL;
+    archive->mappedBytes = 0;
+    archive->count = 0;
+    archive->trailingBytes = 0;
+#ifdef PDA_HAVE_MMAP
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return false;
+    struct stat info;
+    // en un sistema de 32 bits un archivo de más de 4 GiB no cabe en el espacio de direcciones
+    if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) ||
+        (uintmax_t)info.st_size > SIZE_MAX) {
+        close(fd);
+        return false;
+    }
+    size_t bytes = (size_t)info.st_size;
+    if (bytes > 0) {
+        void * base = mmap(NULL, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (base == MAP_FAILED) {
+            close(fd);
+            return false;
+        }
+        madvise(base, bytes, MADV_SEQUENTIAL);
+        archive->base = base;
+        archive->mappedBytes = bytes;
+    }
+    close(fd);
+    archive->count = bytes / sizeof(float);
+    archive->trailingBytes = bytes % sizeof(float);
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Libera el mapeo de un archivo.
+ *
+ * @param archive Archivo abierto con pdaArchiveOpen.
+ */
+void pdaArchiveClose(PdaArchive * archive) {
+    if (archive == NULL)
+        return;
+#ifdef PDA_HAVE_MMAP
+    if (archive->base != NULL)
+        munmap((void *)archive->base, archive->mappedBytes);
+#endif
+    archive->base = NULL;
+    archive->mappedBytes = 0;
+    archive->count = 0;
+}
+
+/**
+ * @brief Recorre el archivo en bloques alineados a página.
+ *
+ * @param archive Archivo abierto.
+ * @param chunk Función que recibe cada bloque.
+ * @param context Puntero que se entrega a chunk.
+ * @return Verdadero si se recorrió el archivo.
+ */
+bool pdaArchiveForEachChunk(const PdaArchive * archive, PdaArchiveChunkFn chunk, void * context) {
+    if (archive == NULL || chunk == NULL)
+        return false;
+    for (size_t done = 0; done < archive->count; done += CHUNK_VALUES) {
+        size_t remaining = archive->count - done;
+        size_t count = (remaining < CHUNK_VALUES) ? remaining : CHUNK_VALUES;
+        const uint8_t * bytes = archive->base + done * sizeof(float);
+        deliverChunk(bytes, count, chunk, context);
+#ifdef PDA_HAVE_MMAP
+        madvise((void *)bytes, count * sizeof(float), MADV_DONTNEED);
+#endif
+    }
+    return true;
+}
+
+/**
+ * @brief Calcula las estadísticas de todos los datos del archivo.
+ *
+ * @param archive Archivo abierto.
+ * @param stats Estructura donde se almacenan los resultados.
+ * @return Verdadero si hay al menos un dato válido.
+ */
+bool pdaArchiveStats(const PdaArchive * archive, PdaStats * stats) {
+    PdaAccumulator acc;
+    pdaAccInit(&acc);
+    pdaArchiveForEachChunk(archive, accumulateChunk, &acc);
+    return pdaAccQuery(&acc, stats);
+}
+
+/* === End of documentation ==================================================================== */
@@ -0,0 +1,139 @@
+/*
+ * Nombre del archivo: PdaArchive.h
+ * Versión: 0.1
+ * Descripción:
+ *  Lectura de archivos binarios de datos de MP (float32 little-endian) mapeados en memoria, sin
+ *  copiarlos a un buffer intermedio.
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "ParticulateDataAnalyzer.h"
+
+#ifndef PDAARCHIVE_H
+#define PDAARCHIVE_H
+
+/**
+ * @file PdaArchive.h
+ * @brief Archivos de historia de sensores leídos con mmap y procesados por bloques.
+ *
+ * - pdaArchiveOpen / pdaArchiveClose: Mapean y liberan un archivo de datos float32
+ *   little-endian, sin encabezado.
+ * - pdaArchiveForEachChunk: Entrega el archivo en bloques de PDA_ARCHIVE_CHUNK_BYTES alineados a
+ *   página, apuntando directamente al mapeo.
+ * - pdaArchiveStats: Estadísticas de todo el archivo, acumulando cada bloque con
+ *   pdaAccPushBatch (núcleos vectorizados).
+ *
+ * El archivo se mapea en solo lectura con madvise(MADV_SEQUENTIAL), de modo que el núcleo lee
+ * por adelantado. Al terminar cada bloque sus páginas se liberan con madvise(MADV_DONTNEED): la
+ * memoria residente queda acotada por unos pocos bloques aunque se procesen a la vez varios
+ * archivos de decenas de GB. En plataformas big-endian cada bloque se convierte en un buffer
+ * local antes de reducirlo. Fuera de sistemas POSIX pdaArchiveOpen siempre falla.
+ *
+ * Los bytes finales que no completan un float (archivo truncado) se ignoran y se informan en
+ * trailingBytes.
+ */
+
+/* === Headers files inclusions ================================================================ */
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+/**
+ * @brief Tamaño de cada bloque entregado por pdaArchiveForEachChunk (múltiplo de la página).
+ */
+#define PDA_ARCHIVE_CHUNK_BYTES (4u * 1024u * 1024u)
+
+/* === Public data type declarations =========================================================== */
+
+/**
+ * @brief Archivo de datos mapeado en memoria.
+ */
+typedef struct {
+    const uint8_t * base; /**< Inicio del mapeo, o NULL si el archivo está vacío. */
+    size_t mappedBytes;   /**< Tamaño del mapeo, en bytes. */
+    size_t count;         /**< Cantidad de datos float32 del archivo. */
+    size_t trailingBytes; /**< Bytes finales ignorados por no completar un dato. */
+} PdaArchive;
+
+/**
+ * @brief Función que recibe cada bloque del archivo.
+ *
+ * @param data Datos del bloque; solo son válidos durante la llamada.
+ * @param n_data Número de datos del bloque.
+ * @param context Puntero entregado a pdaArchiveForEachChunk.
+ */
+typedef void (*PdaArchiveChunkFn)(const float * data, size_t n_data, void * context);
+
+/* === Public variable declarations ============================================================ */
+
+/* === Public function declarations ============================================================ */
+
+/**
+ * @brief Mapea un archivo de datos en memoria.
+ *
+ * @param archive Estructura a completar.
+ * @param path Ruta del archivo.
+ * @return Verdadero si el archivo se abrió y mapeó; falso en caso contrario, también si su tamaño
+ *         no cabe en size_t (archivos de más de 4 GiB en sistemas de 32 bits).
+ */
+bool pdaArchiveOpen(PdaArchive * archive, const char * path);
+
+/**
+ * @brief Libera el mapeo de un archivo.
+ *
+ * @param archive Archivo abierto con pdaArchiveOpen.
+ */
+void pdaArchiveClose(PdaArchive * archive);
+
+/**
+ * @brief Recorre el archivo en bloques, liberando las páginas de cada bloque al terminarlo.
+ *
+ * @param archive Archivo abierto.
+ * @param chunk Función que recibe cada bloque.
+ * @param context Puntero que se entrega a chunk.
+ * @return Verdadero si se recorrió el archivo; falso si algún argumento es NULL.
+ */
+bool pdaArchiveForEachChunk(const PdaArchive * archive, PdaArchiveChunkFn chunk, void * context);
+
+/**
+ * @brief Calcula las estadísticas de todos los datos del archivo.
+ *
+ * @param archive Archivo abierto.
+ * @param stats Estructura donde se almacenan los resultados.
+ * @return Verdadero si hay al menos un dato válido; falso en caso contrario.
+ */
+bool pdaArchiveStats(const PdaArchive * archive, PdaStats * stats);
+
+/* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PDAARCHIVE_H */
@@ -0,0 +1,415 @@
+/*
+ * Nombre del archivo: PdaBlockStore.c
+ * Versión: 0.1
+ * Descripción:
+ *  Formato en disco de series de MP por bloques de tamaño fijo, con un resumen precalculado por
+ *  bloque para responder consultas por rango sin leer los datos.
+ *
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo bajo los términos de la
+ * Licencia Pública General GNU publicada por la Free Software Foundation, ya sea la versión 3 de la
+ * Licencia, o (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil, pero SIN NINGUNA GARANTÍA; sin
+ * siquiera la garantía implícita de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU junto con este programa.
+ * Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ */
+
+/**
+ * @file PdaBlockStore.c
+ * @brief Implementación de los archivos por bloques.
+ *
+ * Se usa stdio para que el formato funcione en cualquier plataforma; los desplazamientos se
+ * limitan a LONG_MAX, que en plataformas de 64 bits no es una restricción práctica. Una consulta
+ * posiciona el archivo a lo sumo tres veces (dos extremos y el índice), por lo que no conviene
+ * mapear el archivo con lectura secuencial anticipada como en PdaArchive.
+ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "PdaBlockStore.h"
+#include "PdaAccumulator.h"
+#include "PdaByteOrder.h"
+#include <limits.h> // Para LONG_MAX
+
+/* === Macros definitions ====================================================================== */
+
+/**
+ * @brief Identificador del archivo: "PDAB" leído como uint32 little-endian.
+ */
+#define BLOCK_MAGIC 0x42414450u
+
+/**
+ * @brief Identificador del pie: "PDAI" leído como uint32 little-endian.
+ */
+#define FOOTER_MAGIC 0x49414450u
+
+/**
+ * @brief Desplazamientos de cada campo dentro del encabezado del archivo.
+ */
+#define OFFSET_MAGIC        0
+#define OFFSET_VERSION      4
+#define OFFSET_RESERVED     6
+#define OFFSET_BLOCK_VALUES 8
+#define OFFSET_RESERVED2    12
+
+/**
+ * @brief Desplazamientos de cada campo dentro del pie del archivo.
+ */
+#define OFFSET_FOOTER_COUNT    0
+#define OFFSET_FOOTER_MAGIC    8
+#define OFFSET_FOOTER_RESERVED 12
+
+/**
+ * @brief Datos que se convierten por vez al leer o escribir.
+ */
+#define DECODE_VALUES 1024
+
+/**
+ * @brief Resúmenes que se leen o copian por vez.
+ */
+#define INDEX_CHUNK 64
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/* === Private function implementation ========================================================= */
+
+/**
+ * @brief Desplazamiento del dato i dentro del archivo.
+ */
+static uint64_t valueOffset(size_t i) {
+    return PDA_BLOCK_FILE_HEADER + (uint64_t)i * sizeof(float);
+}
+
+/**
+ * @brief Desplazamiento del resumen del bloque b dentro del archivo.
+ */
+static uint64_t summaryOffset(const PdaBlockFile * file, size_t b) {
+    return valueOffset(file->count) + (uint64_t)b * PDA_PARTIAL_BLOB_SIZE;
+}
+
+/**
+ * @brief Cantidad de datos del bloque b.
+ */
+static size_t blockLength(const PdaBlockFile * file, size_t b) {
+    size_t start = b * file->blockValues;
+    size_t remaining = file->count - start;
+    return (remaining < file->blockValues) ? remaining : file->blockValues;
+}
+
+/**
+ * @brief Posiciona el archivo en un desplazamiento absoluto.
+ */
+static bool seekTo(FILE * stream, uint64_t offset) {
+    return offset <= (uint64_t)LONG_MAX && fseek(stream, (long)offset, SEEK_SET) == 0;
+}
+
+/**
+ * @brief Agrega el resumen del bloque en curso al índice temporal, si tiene datos, y comienza
+ *        uno nuevo.
+ */
+static void flushBlock(PdaBlockWriter * writer) {
+    if (writer->pending == 0)
+        return;
+    uint8_t summary[PDA_PARTIAL_BLOB_SIZE];
+    pdaPartialSerialize(&writer->summary, summary);
+    if (fwrite(summary, sizeof(summary), 1, writer->index) != 1)
+        writer->failed = true;
+    writer->pending = 0;
+    pdaAccInit(&writer->summary);
+}
+
+/**
+ * @brief Copia el índice temporal al final del archivo y escribe el pie.
+ */
+static void writeIndex(PdaBlockWriter * writer) {
+    uint8_t chunk[INDEX_CHUNK * PDA_PARTIAL_BLOB_SIZE];
+    size_t read;
+    rewind(writer->index);
+    while ((read = fread(chunk, 1, sizeof(chunk), writer->index)) > 0) {
+        if (fwrite(chunk, 1, read, writer->file) != read)
+            writer->failed = true;
+    }
+    if (ferror(writer->index))
+        writer->failed = true;
+
+    uint8_t footer[PDA_BLOCK_FILE_FOOTER];
+    pdaWriteLe(footer + OFFSET_FOOTER_COUNT, writer->count, sizeof(uint64_t));
+    pdaWriteLe(footer + OFFSET_FOOTER_MAGIC, FOOTER_MAGIC, sizeof(uint32_t));
+    pdaWriteLe(footer + OFFSET_FOOTER_RESERVED, 0, sizeof(uint32_t));
+    if (fwrite(footer, sizeof(footer), 1, writer->file) != 1)
+        writer->failed = true;
+}
+
+/**
+ * @brief Combina los resúmenes de los bloques [from, to) leyendo el índice en un solo tramo, y
+ *        verifica que cada uno describa la cantidad de datos de su bloque.
+ */
+static bool mergeSummaries(PdaBlockFile * file, size_t from, size_t to, PdaAccumulator * acc) {
+    if (!seekTo(file->file, summaryOffset(file, from)))
+        return false;
+    file->indexReads++;
+    uint8_t blobs[INDEX_CHUNK * PDA_PARTIAL_BLOB_SIZE];
+    for (size_t done = from; done < to; done += INDEX_CHUNK) {
+        size_t count = (to - done < INDEX_CHUNK) ? to - done : INDEX_CHUNK;
+        if (fread(blobs, PDA_PARTIAL_BLOB_SIZE, count, file->file) != count)
+            return false;
+        for (size_t i = 0; i < count; i++) {
+            PdaPartial summary;
+            if (!pdaPartialDeserialize(blobs + i * PDA_PARTIAL_BLOB_SIZE, &summary) ||
+                summary.validCount + summary.rejectedCount != blockLength(file, done + i))
+                return false;
+            pdaAccMerge(acc, &summary);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Acumula los datos [from, to) leyéndolos del archivo en un solo tramo.
+ */
+static bool decodeValues(PdaBlockFile * file, size_t from, size_t to, PdaAccumulator * acc) {
+    if (from >= to)
+        return true;
+    if (!seekTo(file->file, valueOffset(from)))
+        return false;
+    file->blocksDecoded += (to - 1) / file->blockValues - from / file->blockValues + 1;
+    uint8_t bytes[DECODE_VALUES * sizeof(float)];
+    float values[DECODE_VALUES];
+    for (size_t done = from; done < to; done += DECODE_VALUES) {
+        size_t count = (to - done < DECODE_VALUES) ? to - done : DECODE_VALUES;
+        if (fread(bytes, sizeof(float), count, file->file) != count)
+            return false;
+        for (size_t i = 0; i < count; i++)
+            values[i] = pdaReadFloat(bytes + i * sizeof(float));
+        pdaAccPushBatch(acc, values, count);
+    }
+    return true;
+}
+
+/* === Public function implementation ========================================================== */
+
+/**
+ * @brief Crea un archivo por bloques y escribe su encabezado.
+ *
+ * @param writer Escritor a inicializar.
+ * @param path Ruta del archivo.
+ * @param blockValues Datos por bloque.
+ * @return Verdadero si el archivo y el archivo temporal del índice se crearon.
+ */
+bool pdaBlockWriterOpen(PdaBlockWriter * writer, const char * path, size_t blockValues) {
+    if (writer == NULL || path == NULL || blockValues == 0 || blockValues > PDA_BLOCK_MAX_VALUES)
+        return false;
+    writer->index = tmpfile();
+    if (writer->index == NULL)
+        return false;
+    writer->file = fopen(path, "wb");
+    if (writer->file == NULL) {
+        fclose(writer->index);
+        writer->index = NULL;
+        return false;
+    }
+    writer->blockValues = blockValues;
+    writer->pending = 0;
+    writer->count = 0;
+    writer->failed = false;
+    pdaAccInit(&writer->summary);
+
+    uint8_t header[PDA_BLOCK_FILE_HEADER];
+    pdaWriteLe(header + OFFSET_MAGIC, BLOCK_MAGIC, sizeof(uint32_t));
+    pdaWriteLe(header + OFFSET_VERSION, PDA_BLOCK_VERSION, sizeof(uint16_t));
+    pdaWriteLe(header + OFFSET_RESERVED, 0, sizeof(uint16_t));
+    pdaWriteLe(header + OFFSET_BLOCK_VALUES, blockValues, sizeof(uint32_t));
+    pdaWriteLe(header + OFFSET_RESERVED2, 0, sizeof(uint32_t));
+    if (fwrite(header, sizeof(header), 1, writer->file) != 1)
+        writer->failed = true;
+    return true;
+}
+
+/**
+ * @brief Agrega datos a la serie, escribiéndolos de inmediato y guardando el resumen de cada
+ *        bloque al completarse.
+ *
+ * @param writer Escritor.
+ * @param data Array de datos flotantes.
+ * @param n_data Número de elementos en el array.
+ * @return Verdadero si no falló ninguna escritura hasta el momento.
+ */
+bool pdaBlockWriterPush(PdaBlockWriter * writer, const float * data, size_t n_data) {
+    if (writer == NULL || writer->file == NULL || (data == NULL && n_data > 0))
+        return false;
+    uint8_t bytes[DECODE_VALUES * sizeof(float)];
+    while (n_data > 0) {
+        size_t room = writer->blockValues - writer->pending;
+        size_t count = (n_data < room) ? n_data : room;
+        if (count > DECODE_VALUES)
+            count = DECODE_VALUES;
+        pdaAccPushBatch(&writer->summary, data, count);
+        for (size_t i = 0; i < count; i++)
+            pdaWriteFloat(bytes + i * sizeof(float), data[i]);
+        if (fwrite(bytes, sizeof(float), count, writer->file) != count)
+            writer->failed = true;
+        writer->pending += count;
+        writer->count += count;
+        if (writer->pending == writer->blockValues)
+            flushBlock(writer);
+        data += count;
+        n_data -= count;
+    }
+    return !writer->failed;
+}
+
+/**
+ * @brief Escribe el resumen del último bloque, el índice y el pie, y cierra el archivo.
+ *
+ * @param writer Escritor.
+ * @return Verdadero si todo el archivo se escribió correctamente.
+ */
+bool pdaBlockWriterClose(PdaBlockWriter * writer) {
+    if (writer == NULL || writer->file == NULL)
+        return false;
+    flushBlock(writer);
+    writeIndex(writer);
+    fclose(writer->index);
+    if (fclose(writer->file) != 0)
+        writer->failed = true;
+    writer->index = NULL;
+    writer->file = NULL;
+    return !writer->failed;
+}
+
+/**
+ * @brief Abre un archivo por bloques.
+ *
+ * Rechaza archivos con identificador, versión o campos reservados incorrectos, y archivos cuyo
+ * tamaño no corresponde a la cantidad de datos indicada en el pie más su índice.
+ *
+ * @param file Estructura a completar.
+ * @param path Ruta del archivo.
+ * @return Verdadero si el archivo es válido.
+ */
+bool pdaBlockOpen(PdaBlockFile * file, const char * path) {
+    if (file == NULL || path == NULL)
+        return false;
+    file->blockCount = 0;
+    file->count = 0;
+    file->blocksDecoded = 0;
+    file->indexReads = 0;
+    file->file = fopen(path, "rb");
+    if (file->file == NULL)
+        return false;
+
+    uint8_t header[PDA_BLOCK_FILE_HEADER] = {0};
+    uint8_t footer[PDA_BLOCK_FILE_FOOTER] = {0};
+    long size = -1;
+    if (fread(header, sizeof(header), 1, file->file) == 1 &&
+        pdaReadLe(header + OFFSET_MAGIC, sizeof(uint32_t)) == BLOCK_MAGIC &&
+        pdaReadLe(header + OFFSET_VERSION, sizeof(uint16_t)) == PDA_BLOCK_VERSION &&
+        pdaReadLe(header + OFFSET_RESERVED, sizeof(uint16_t)) == 0 &&
+        pdaReadLe(header + OFFSET_RESERVED2, sizeof(uint32_t)) == 0 &&
+        fseek(file->file, -PDA_BLOCK_FILE_FOOTER, SEEK_END) == 0 &&
+        fread(footer, sizeof(footer), 1, file->file) == 1 &&
+        pdaReadLe(footer + OFFSET_FOOTER_MAGIC, sizeof(uint32_t)) == FOOTER_MAGIC &&
+        pdaReadLe(footer + OFFSET_FOOTER_RESERVED, sizeof(uint32_t)) == 0)
+        size = ftell(file->file);
+    file->blockValues = (size_t)pdaReadLe(header + OFFSET_BLOCK_VALUES, sizeof(uint32_t));
+    uint64_t count = pdaReadLe(footer + OFFSET_FOOTER_COUNT, sizeof(uint64_t));
+    if (size < PDA_BLOCK_FILE_HEADER + PDA_BLOCK_FILE_FOOTER || file->blockValues == 0 ||
+        file->blockValues > PDA_BLOCK_MAX_VALUES || count > (uint64_t)size / sizeof(float)) {
+        pdaBlockClose(file);
+        return false;
+    }
+
+    uint64_t blockCount = (count + file->blockValues - 1) / file->blockValues;
+    uint64_t expected = PDA_BLOCK_FILE_HEADER + count * sizeof(float) +
+                        blockCount * PDA_PARTIAL_BLOB_SIZE + PDA_BLOCK_FILE_FOOTER;
+    if ((uint64_t)size != expected) {
+        pdaBlockClose(file);
+        return false;
+    }
+    file->blockCount = (size_t)blockCount;
+    file->count = (size_t)count;
+    return true;
+}
+
+/**
+ * @brief Cierra un archivo por bloques.
+ *
+ * @param file Archivo abierto con pdaBlockOpen.
+ */
+void pdaBlockClose(PdaBlockFile * file) {
+    if (file == NULL)
+        return;
+    if (file->file != NULL)
+        fclose(file->file);
+    file->file = NULL;
+    file->blockCount = 0;
+    file->count = 0;
+}
+
+/**
+ * @brief Calcula las estadísticas de un rango de datos.
+ *
+ * Los bloques cubiertos por completo se combinan desde sus resúmenes, leídos en un solo tramo
+ * del índice; los datos de los extremos que no completan un bloque se leen del archivo.
+ *
+ * @param file Archivo abierto.
+ * @param first Índice del primer dato.
+ * @param n_data Cantidad de datos del rango.
+ * @param stats Estructura donde se almacenan los resultados.
+ * @return Verdadero si el rango se leyó y contiene al menos un dato válido.
+ */
+bool pdaBlockRangeStats(PdaBlockFile * file, size_t first, size_t n_data, PdaStats * stats) {
+    PdaAccumulator acc;
+    pdaAccInit(&acc);
+    bool ok = file != NULL && file->file != NULL && first <= file->count &&
+              n_data <= file->count - first;
+    if (ok && n_data > 0) {
+        size_t end = first + n_data;
+        // bloques [fullFirst, fullEnd) contenidos en el rango; el último bloque puede ser corto
+        size_t fullFirst = (first + file->blockValues - 1) / file->blockValues;
+        size_t fullEnd = (end == file->count) ? file->blockCount : end / file->blockValues;
+        if (fullFirst >= fullEnd) {
+            ok = decodeValues(file, first, end, &acc);
+        } else {
+            size_t headEnd = fullFirst * file->blockValues;
+            size_t tailStart = fullEnd * file->blockValues;
+            ok = decodeValues(file, first, headEnd, &acc) &&
+                 mergeSummaries(file, fullFirst, fullEnd, &acc) &&
+                 decodeValues(file, (tailStart < end) ? tailStart : end, end, &acc);
+        }
+    }
+    if (!ok)
+        pdaAccInit(&acc);
+    bool valid = pdaAccQuery(&acc, stats);
+    return ok && valid;
+}
+
+/**
+ * @brief Calcula las estadísticas de todo el archivo.
+ *
+ * @param file Archivo abierto.
+ * @param stats Estructura donde se almacenan los resultados.
+ * @return Verdadero si el archivo se leyó y contiene al menos un dato válido.
+ */
+bool pdaBlockStats(PdaBlockFile * file, PdaStats * stats) {
+    return pdaBlockRangeStats(file, 0, (file != NULL) ? file->count : 0, stats);
+}
+
+/* === End of documentation ==================================================================== */
@@ -0,0 +1,219 @@
+/*
+ * Nombre del archivo: PdaBlockStore.h
+ * Versión: 0.1
+ * Descripción:
+ *  Formato en disco de series de MP por bloques de tamaño fijo, con un resumen precalculado por
+ *  bloque para responder consultas por rango sin leer los datos.
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include "ParticulateDataAnalyzer.h"
+#include "PdaPartial.h"
+
+#ifndef PDABLOCKSTORE_H
+#define PDABLOCKSTORE_H
+
+/**
+ * @file PdaBlockStore.h
+ * @brief Archivos de series por bloques con un resumen por bloque (zone map).
+ *
+ * - pdaBlockWriterOpen / pdaBlockWriterPush / pdaBlockWriterClose: Escriben una serie en flujo,
+ *   con memoria acotada (un resumen y un archivo temporal para el índice).
+ * - pdaBlockOpen / pdaBlockClose: Abren un archivo y validan su encabezado y su tamaño.
+ * - pdaBlockRangeStats: Estadísticas de un rango de datos.
+ * - pdaBlockStats: Estadísticas de todo el archivo.
+ *
+ * Formato: un encabezado de archivo, los datos de todos los bloques en float32 little-endian y
+ * contiguos, el índice con el resumen de cada bloque y un pie. Todos los bloques tienen
+ * blockValues datos salvo el último, que puede tener menos. Cada resumen es un parcial
+ * serializado (PDA_PARTIAL_BLOB_SIZE bytes: cantidad de válidos y descartados, promedio, M2,
+ * mínimo y máximo); los resúmenes se guardan juntos, en el orden de los bloques.
+ *
+ * | Desplazamiento   | Tamaño           | Contenido                                      |
+ * |------------------|------------------|------------------------------------------------|
+ * | 0                | 4                | Identificador "PDAB"                           |
+ * | 4                | 2                | Versión del formato (PDA_BLOCK_VERSION)        |
+ * | 6                | 2                | Reservado, en cero                             |
+ * | 8                | 4                | blockValues (uint32, little-endian)            |
+ * | 12               | 4                | Reservado, en cero                             |
+ * | 16               | 4 * count        | Datos float32 de todos los bloques             |
+ * | 16 + 4 * count   | 48 * blockCount  | Índice: un resumen por bloque                  |
+ * | final - 16       | 8                | count (uint64, little-endian)                  |
+ * | final - 8        | 4                | Identificador del pie "PDAI"                   |
+ * | final - 4        | 4                | Reservado, en cero                             |
+ *
+ * Los bloques que el rango cubre por completo se resuelven con su resumen combinado con
+ * pdaAccMerge, leyendo sus resúmenes del índice con un único posicionamiento y una lectura
+ * secuencial; solo se leen los datos de los extremos del rango que no completan un bloque. Una
+ * consulta lee a lo sumo dos tramos de datos de menos de un bloque cada uno más 48 bytes de
+ * índice por bloque cubierto (menos del 0,1% de los datos con PDA_BLOCK_DEFAULT_VALUES). El
+ * resumen usa promedio y M2 en lugar de suma y suma de cuadrados para no perder precisión en
+ * bloques con promedios altos y varianza baja.
+ *
+ * El escritor guarda los datos a medida que llegan y los resúmenes en un archivo temporal
+ * (tmpfile), que copia al final del archivo al cerrarlo; no retiene los datos del bloque en curso.
+ */
+
+/* === Headers files inclusions ================================================================ */
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+/**
+ * @brief Versión del formato de los archivos por bloques.
+ */
+#define PDA_BLOCK_VERSION 2
+
+/**
+ * @brief Tamaño en bytes del encabezado del archivo.
+ */
+#define PDA_BLOCK_FILE_HEADER 16
+
+/**
+ * @brief Tamaño en bytes del pie del archivo.
+ */
+#define PDA_BLOCK_FILE_FOOTER 16
+
+/**
+ * @brief Datos por bloque recomendados: 64 KiB de datos por cada resumen de 48 bytes.
+ */
+#define PDA_BLOCK_DEFAULT_VALUES 16384
+
+/**
+ * @brief Datos por bloque máximos que acepta el escritor.
+ */
+#define PDA_BLOCK_MAX_VALUES 65536
+
+/* === Public data type declarations =========================================================== */
+
+/**
+ * @brief Escritor de archivos por bloques.
+ */
+typedef struct {
+    FILE * file;        /**< Archivo de salida. */
+    FILE * index;       /**< Archivo temporal con los resúmenes de los bloques completos. */
+    size_t blockValues; /**< Datos por bloque. */
+    size_t pending;     /**< Datos del bloque en curso. */
+    uint64_t count;     /**< Datos escritos. */
+    PdaPartial summary; /**< Resumen del bloque en curso. */
+    bool failed;        /**< Falló alguna escritura. */
+} PdaBlockWriter;
+
+/**
+ * @brief Archivo por bloques abierto para consultas.
+ */
+typedef struct {
+    FILE * file;          /**< Archivo de entrada. */
+    size_t blockValues;   /**< Datos por bloque. */
+    size_t blockCount;    /**< Cantidad de bloques. */
+    size_t count;         /**< Cantidad total de datos. */
+    size_t blocksDecoded; /**< Bloques cuyos datos se leyeron, para medir las consultas. */
+    size_t indexReads;    /**< Tramos del índice leídos, para medir las consultas. */
+} PdaBlockFile;
+
+/* === Public variable declarations ============================================================ */
+
+/* === Public function declarations ============================================================ */
+
+/**
+ * @brief Crea un archivo por bloques.
+ *
+ * @param writer Escritor a inicializar.
+ * @param path Ruta del archivo; si existe se reemplaza.
+ * @param blockValues Datos por bloque, entre 1 y PDA_BLOCK_MAX_VALUES.
+ * @return Verdadero si el archivo y el archivo temporal del índice se crearon.
+ */
+bool pdaBlockWriterOpen(PdaBlockWriter * writer, const char * path, size_t blockValues);
+
+/**
+ * @brief Agrega datos a la serie.
+ *
+ * @param writer Escritor.
+ * @param data Array de datos flotantes.
+ * @param n_data Número de elementos en el array.
+ * @return Verdadero si no falló ninguna escritura hasta el momento.
+ */
+bool pdaBlockWriterPush(PdaBlockWriter * writer, const float * data, size_t n_data);
+
+/**
+ * @brief Escribe el resumen del último bloque, el índice y el pie, y cierra el archivo.
+ *
+ * @param writer Escritor.
+ * @return Verdadero si todo el archivo se escribió correctamente.
+ */
+bool pdaBlockWriterClose(PdaBlockWriter * writer);
+
+/**
+ * @brief Abre un archivo por bloques.
+ *
+ * @param file Estructura a completar.
+ * @param path Ruta del archivo.
+ * @return Verdadero si el archivo existe y su encabezado, su pie y su tamaño son coherentes.
+ */
+bool pdaBlockOpen(PdaBlockFile * file, const char * path);
+
+/**
+ * @brief Cierra un archivo por bloques.
+ *
+ * @param file Archivo abierto con pdaBlockOpen.
+ */
+void pdaBlockClose(PdaBlockFile * file);
+
+/**
+ * @brief Calcula las estadísticas de los datos [first, first + n_data) del archivo.
+ *
+ * Los valores de error coinciden con los de computeParticulateStats aplicada al rango. Si el
+ * rango excede el archivo, o un resumen está dañado o no coincide con su bloque, el resultado es
+ * el de un rango vacío.
+ *
+ * @param file Archivo abierto.
+ * @param first Índice del primer dato.
+ * @param n_data Cantidad de datos del rango.
+ * @param stats Estructura donde se almacenan los resultados.
+ * @return Verdadero si el rango se leyó y contiene al menos un dato válido.
+ */
+bool pdaBlockRangeStats(PdaBlockFile * file, size_t first, size_t n_data, PdaStats * stats);
+
+/**
+ * @brief Calcula las estadísticas de todo el archivo, leyendo solo los resúmenes.
+ *
+ * @param file Archivo abierto.
+ * @param stats Estructura donde se almacenan los resultados.
+ * @return Verdadero si el archivo se leyó y contiene al menos un dato válido.
+ */
+bool pdaBlockStats(PdaBlockFile * file, PdaStats * stats);
+
+/* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PDABLOCKSTORE_H */
@@ -0,0 +1,124 @@
+/*
+ * Nombre del archivo: PdaByteOrder.h
+ * Versión: 0.1
+ * Descripción:
+ *  Lectura y escritura de enteros y flotantes en little-endian para los formatos binarios de la
+ *  biblioteca.
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h> // Para memcpy
+
+#ifndef PDABYTEORDER_H
+#define PDABYTEORDER_H
+
+/**
+ * @file PdaByteOrder.h
+ * @brief Funciones en línea para serializar valores en little-endian, independientemente del
+ * orden de bytes de la plataforma. Los flotantes se almacenan con su representación IEEE-754.
+ */
+
+/* === Headers files inclusions ================================================================ */
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+/**
+ * @brief Bits por byte.
+ */
+#define PDA_BITS_PER_BYTE 8
+
+/* === Public data type declarations =========================================================== */
+
+/* === Public variable declarations ============================================================ */
+
+/* === Public function declarations ============================================================ */
+
+/**
+ * @brief Escribe un entero sin signo de size bytes en little-endian.
+ */
+static inline void pdaWriteLe(uint8_t * buffer, uint64_t value, size_t size) {
+    for (size_t i = 0; i < size; i++)
+        buffer[i] = (uint8_t)(value >> (PDA_BITS_PER_BYTE * i));
+}
+
+/**
+ * @brief Lee un entero sin signo de size bytes en little-endian.
+ */
+static inline uint64_t pdaReadLe(const uint8_t * buffer, size_t size) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < size; i++)
+        value |= (uint64_t)buffer[i] << (PDA_BITS_PER_BYTE * i);
+    return value;
+}
+
+/**
+ * @brief Escribe un double en little-endian.
+ */
+static inline void pdaWriteDouble(uint8_t * buffer, double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    pdaWriteLe(buffer, bits, sizeof(bits));
+}
+
+/**
+ * @brief Lee un double en little-endian.
+ */
+static inline double pdaReadDouble(const uint8_t * buffer) {
+    uint64_t bits = pdaReadLe(buffer, sizeof(bits));
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/**
+ * @brief Escribe un float en little-endian.
+ */
+static inline void pdaWriteFloat(uint8_t * buffer, float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    pdaWriteLe(buffer, bits, sizeof(bits));
+}
+
+/**
+ * @brief Lee un float en little-endian.
+ */
+static inline float pdaReadFloat(const uint8_t * buffer) {
+    uint32_t bits = (uint32_t)pdaReadLe(buffer, sizeof(bits));
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PDABYTEORDER_H */
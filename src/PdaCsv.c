@@ -0,0 +1,391 @@
+/*
+ * Nombre del archivo: PdaCsv.c
+ * Versión: 0.1
+ * Descripción:
+ *  Lectura en flujo de registros CSV de sensores (marca de tiempo, MP2.5, MP10, temperatura,
+ *  humedad) sin reservar memoria, acumulando las columnas elegidas.
+ *
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo bajo los términos de la
+ * Licencia Pública General GNU publicada por la Free Software Foundation, ya sea la versión 3 de la
+ * Licencia, o (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil, pero SIN NINGUNA GARANTÍA; sin
+ * siquiera la garantía implícita de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU junto con este programa.
+ * Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ */
+
+/**
+ * @file PdaCsv.c
+ * @brief Implementación del lector de CSV.
+ *
+ * Las líneas completas de cada bloque se procesan sobre el mismo bloque, sin copiarlas; solo la
+ * línea partida al final se copia a carry. Los campos se separan con memchr y solo se convierten
+ * los de las columnas elegidas. Los valores de una fila se guardan primero en un array local y
+ * se pasan al lote solo si la fila completa es válida.
+ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "PdaCsv.h"
+#include <float.h>  // Para FLT_EVAL_METHOD
+#include <locale.h> // Para localeconv
+#include <stdlib.h> // Para strtof
+#include <string.h> // Para memchr y memcpy
+
+/* === Macros definitions ====================================================================== */
+
+/**
+ * @brief Mayor mantisa representable exactamente en float (2^24).
+ */
+#define FAST_MAX_MANTISSA (UINT64_C(1) << 24)
+
+/**
+ * @brief Mayor potencia de diez representable exactamente en float.
+ */
+#define FAST_MAX_EXPONENT 10
+
+/**
+ * @brief El camino rápido solo es exacto si las operaciones float no usan precisión extendida.
+ */
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+#define FAST_PATH_ENABLED 1
+#else
+#define FAST_PATH_ENABLED 0
+#endif
+
+/**
+ * @brief Cifras significativas que caben en la mantisa de 64 bits sin desbordar.
+ */
+#define MAX_MANTISSA_DIGITS 19
+
+/**
+ * @brief Cota del exponente leído, suficiente para desbordar cualquier float.
+ */
+#define EXPONENT_LIMIT 100000
+
+/**
+ * @brief Bytes máximos del separador decimal de la configuración regional (uno multibyte en UTF-8).
+ */
+#define MAX_DECIMAL_POINT 4
+
+/**
+ * @brief Marca de campo no elegido en slotOf.
+ */
+#define NO_SLOT (-1)
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/**
+ * @brief Potencias de diez exactas en float.
+ */
+static const float powersOfTen[FAST_MAX_EXPONENT + 1] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f,
+                                                         1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+
+/* === Private function implementation ========================================================= */
+
+/**
+ * @brief Indica si un carácter es un dígito decimal.
+ */
+static bool isDigit(char c) {
+    return (unsigned char)(c - '0') < 10u;
+}
+
+/**
+ * @brief Convierte con strtof un número ya validado, copiándolo para terminarlo en cero.
+ *
+ * strtof usa el separador decimal de LC_NUMERIC; el punto del campo se reemplaza por ese
+ * separador para que la conversión no dependa de la configuración regional.
+ */
+static float parseSlow(const char * begin, const char * end) {
+    char text[PDA_CSV_MAX_LINE + MAX_DECIMAL_POINT + 1];
+    const char * point = localeconv()->decimal_point;
+    size_t pointLength = strlen(point);
+    if (pointLength == 0 || pointLength > MAX_DECIMAL_POINT) {
+        point = ".";
+        pointLength = 1;
+    }
+    size_t length = 0;
+    for (const char * c = begin; c < end && length < PDA_CSV_MAX_LINE; c++) {
+        if (*c == '.') {
+            memcpy(text + length, point, pointLength);
+            length += pointLength;
+        } else {
+            text[length++] = *c;
+        }
+    }
+    text[length] = '\0';
+    return strtof(text, NULL);
+}
+
+/**
+ * @brief Acumula los lotes pendientes.
+ */
+static void flushBatch(PdaCsvParser * parser) {
+    for (size_t slot = 0; slot < parser->columnCount; slot++)
+        pdaAccPushBatch(&parser->acc[slot], parser->batch[slot], parser->batchCount);
+    parser->rows += parser->batchCount;
+    parser->batchCount = 0;
+}
+
+/**
+ * @brief Descarta una línea más larga que PDA_CSV_MAX_LINE: si quedan líneas de encabezado por
+ *        saltear la cuenta como una de ellas y, si no, como fila mal formada.
+ */
+static void skipLongLine(PdaCsvParser * parser) {
+    if (parser->headerLines > 0)
+        parser->headerLines--;
+    else
+        parser->malformedRows++;
+}
+
+/**
+ * @brief Procesa una línea completa, sin el salto de línea.
+ */
+static void parseLine(PdaCsvParser * parser, const char * line, const char * end) {
+    if (end > line && end[-1] == '\r')
+        end--;
+    if (end == line)
+        return; // línea vacía
+    if (parser->headerLines > 0) {
+        parser->headerLines--;
+        return;
+    }
+
+    float row[PDA_CSV_MAX_COLUMNS];
+    const char * field = line;
+    for (size_t index = 0; index <= parser->lastField; index++) {
+        const char * fieldEnd = memchr(field, parser->delimiter, (size_t)(end - field));
+        if (fieldEnd == NULL)
+            fieldEnd = end;
+        int slot = parser->slotOf[index];
+        if (slot != NO_SLOT && !pdaCsvParseFloat(field, fieldEnd, &row[slot])) {
+            parser->malformedRows++;
+            return;
+        }
+        if (fieldEnd == end && index < parser->lastField) {
+            parser->malformedRows++; // faltan columnas
+            return;
+        }
+        field = fieldEnd + 1;
+    }
+
+    for (size_t slot = 0; slot < parser->columnCount; slot++)
+        parser->batch[slot][parser->batchCount] = row[slot];
+    if (++parser->batchCount == PDA_CSV_BATCH)
+        flushBatch(parser);
+}
+
+/* === Public function implementation ========================================================== */
+
+/**
+ * @brief Configura un lector.
+ *
+ * @param parser Lector a configurar.
+ * @param columns Índices de las columnas a leer.
+ * @param columnCount Cantidad de columnas.
+ * @param delimiter Separador de campos.
+ * @param headerLines Líneas iniciales que se saltean.
+ * @return Verdadero si la configuración es válida.
+ */
+bool pdaCsvInit(PdaCsvParser * parser, const size_t columns[], size_t columnCount, char delimiter,
+                size_t headerLines) {
+    if (parser == NULL || columns == NULL || columnCount == 0 ||
+        columnCount > PDA_CSV_MAX_COLUMNS || delimiter == '\n' || delimiter == '\r')
+        return false;
+    for (size_t i = 0; i < PDA_CSV_MAX_FIELDS; i++)
+        parser->slotOf[i] = NO_SLOT;
+    parser->lastField = 0;
+    for (size_t slot = 0; slot < columnCount; slot++) {
+        size_t index = columns[slot];
+        if (index >= PDA_CSV_MAX_FIELDS || parser->slotOf[index] != NO_SLOT)
+            return false;
+        parser->slotOf[index] = (int8_t)slot;
+        if (index > parser->lastField)
+            parser->lastField = index;
+        pdaAccInit(&parser->acc[slot]);
+    }
+    parser->delimiter = delimiter;
+    parser->columnCount = columnCount;
+    parser->headerLines = headerLines;
+    parser->rows = 0;
+    parser->malformedRows = 0;
+    parser->batchCount = 0;
+    parser->carryLength = 0;
+    parser->carryOverflow = false;
+    return true;
+}
+
+/**
+ * @brief Procesa un bloque de bytes.
+ *
+ * @param parser Lector.
+ * @param data Bytes del bloque.
+ * @param length Cantidad de bytes.
+ */
+void pdaCsvFeed(PdaCsvParser * parser, const char * data, size_t length) {
+    if (parser == NULL || data == NULL)
+        return;
+    const char * end = data + length;
+
+    // completa la línea partida del bloque anterior
+    if (parser->carryLength > 0 || parser->carryOverflow) {
+        const char * newline = memchr(data, '\n', length);
+        const char * stop = (newline != NULL) ? newline : end;
+        size_t piece = (size_t)(stop - data);
+        if (parser->carryLength + piece > PDA_CSV_MAX_LINE)
+            parser->carryOverflow = true;
+        else {
+            memcpy(parser->carry + parser->carryLength, data, piece);
+            parser->carryLength += piece;
+        }
+        if (newline == NULL)
+            return;
+        if (parser->carryOverflow)
+            skipLongLine(parser);
+        else
+            parseLine(parser, parser->carry, parser->carry + parser->carryLength);
+        parser->carryLength = 0;
+        parser->carryOverflow = false;
+        data = newline + 1;
+    }
+
+    for (;;) {
+        const char * newline = memchr(data, '\n', (size_t)(end - data));
+        if (newline == NULL)
+            break;
+        if (newline - data > PDA_CSV_MAX_LINE)
+            skipLongLine(parser);
+        else
+            parseLine(parser, data, newline);
+        data = newline + 1;
+    }
+
+    size_t rest = (size_t)(end - data);
+    if (rest > PDA_CSV_MAX_LINE)
+        parser->carryOverflow = true;
+    else {
+        memcpy(parser->carry, data, rest);
+        parser->carryLength = rest;
+    }
+}
+
+/**
+ * @brief Procesa la línea final pendiente y acumula los lotes.
+ *
+ * @param parser Lector.
+ */
+void pdaCsvFinish(PdaCsvParser * parser) {
+    if (parser == NULL)
+        return;
+    if (parser->carryOverflow)
+        skipLongLine(parser);
+    else if (parser->carryLength > 0)
+        parseLine(parser, parser->carry, parser->carry + parser->carryLength);
+    parser->carryLength = 0;
+    parser->carryOverflow = false;
+    flushBatch(parser);
+}
+
+/**
+ * @brief Estadísticas de una columna elegida.
+ *
+ * @param parser Lector.
+ * @param slot Posición de la columna en el array entregado a pdaCsvInit.
+ * @param stats Estructura donde se almacenan los resultados.
+ * @return Verdadero si hay al menos un dato válido.
+ */
+bool pdaCsvQuery(const PdaCsvParser * parser, size_t slot, PdaStats * stats) {
+    if (parser == NULL || slot >= parser->columnCount)
+        return false;
+    return pdaAccQuery(&parser->acc[slot], stats);
+}
+
+/**
+ * @brief Convierte un campo en float.
+ *
+ * @param begin Primer carácter del campo.
+ * @param end Carácter siguiente al último del campo.
+ * @param value Resultado.
+ * @return Verdadero si todo el campo es un número.
+ */
+bool pdaCsvParseFloat(const char * begin, const char * end, float * value) {
+    while (begin < end && *begin == ' ')
+        begin++;
+    while (end > begin && end[-1] == ' ')
+        end--;
+    const char * p = begin;
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+'))
+        negative = (*p++ == '-');
+
+    uint64_t mantissa = 0;
+    int digits = 0, exponent = 0;
+    bool anyDigit = false;
+    for (; p < end && isDigit(*p); p++, anyDigit = true) {
+        if (mantissa != 0 || *p != '0') {
+            if (digits++ < MAX_MANTISSA_DIGITS)
+                mantissa = mantissa * 10u + (uint64_t)(*p - '0');
+            else
+                exponent++; // cifra descartada: el camino rápido ya no aplica
+        }
+    }
+    if (p < end && *p == '.') {
+        for (p++; p < end && isDigit(*p); p++, anyDigit = true) {
+            if (mantissa != 0 || *p != '0') {
+                if (digits++ < MAX_MANTISSA_DIGITS) {
+                    mantissa = mantissa * 10u + (uint64_t)(*p - '0');
+                    exponent--;
+                }
+            } else {
+                exponent--;
+            }
+        }
+    }
+    if (!anyDigit)
+        return false;
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        p++;
+        bool negativeExponent = false;
+        if (p < end && (*p == '-' || *p == '+'))
+            negativeExponent = (*p++ == '-');
+        if (p == end || !isDigit(*p))
+            return false;
+        int explicitExponent = 0;
+        for (; p < end && isDigit(*p); p++) {
+            if (explicitExponent < EXPONENT_LIMIT)
+                explicitExponent = explicitExponent * 10 + (*p - '0');
+        }
+        exponent += negativeExponent ? -explicitExponent : explicitExponent;
+    }
+    if (p != end)
+        return false;
+
+    if (FAST_PATH_ENABLED && digits <= MAX_MANTISSA_DIGITS && mantissa <= FAST_MAX_MANTISSA &&
+        exponent >= -FAST_MAX_EXPONENT && exponent <= FAST_MAX_EXPONENT) {
+        float result = (float)mantissa;
+        result = (exponent < 0) ? result / powersOfTen[-exponent] : result * powersOfTen[exponent];
+        *value = negative ? -result : result;
+        return true;
+    }
+    *value = parseSlow(begin, end);
+    return true;
+}
+
+/* === End of documentation ==================================================================== */
@@ -0,0 +1,176 @@
+/*
+ * Nombre del archivo: PdaCsv.h
+ * Versión: 0.1
+ * Descripción:
+ *  Lectura en flujo de registros CSV de sensores (marca de tiempo, MP2.5, MP10, temperatura,
+ *  humedad) sin reservar memoria, acumulando las columnas elegidas.
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "ParticulateDataAnalyzer.h"
+#include "PdaAccumulator.h"
+
+#ifndef PDACSV_H
+#define PDACSV_H
+
+/**
+ * @file PdaCsv.h
+ * @brief Lector de CSV por bloques, sin memoria dinámica, conectado a los acumuladores.
+ *
+ * - pdaCsvInit: Elige las columnas a leer (índices desde 0), el separador y las líneas de
+ *   encabezado a saltear.
+ * - pdaCsvFeed: Recibe un bloque de bytes de cualquier tamaño; las líneas partidas entre bloques
+ *   se completan con el bloque siguiente.
+ * - pdaCsvFinish: Procesa la última línea si no termina en salto de línea y vacía los lotes.
+ * - pdaCsvQuery: Estadísticas de una de las columnas elegidas.
+ * - pdaCsvParseFloat: Conversión de un campo a float.
+ *
+ * Los valores de cada columna se juntan en lotes de PDA_CSV_BATCH y se acumulan con
+ * pdaAccPushBatch, de modo que las estadísticas usan los núcleos vectorizados. Una fila es
+ * malformada si le falta alguna columna elegida, si alguna no es un número o si supera
+ * PDA_CSV_MAX_LINE bytes; sus valores se descartan completos y se cuenta en malformedRows. Las
+ * líneas vacías se ignoran y se aceptan finales de línea LF y CRLF.
+ *
+ * Conversión: los números con hasta 7 cifras significativas y exponente decimal entre -10 y 10
+ * (el caso de los registros de sensores) se convierten con el camino rápido de Clinger: la
+ * mantisa y la potencia de diez son exactas en float y una sola operación da el resultado
+ * correctamente redondeado. El resto se convierte con strtof, reemplazando el punto por el
+ * separador decimal de LC_NUMERIC, por lo que el resultado siempre es idéntico al de strtof en la
+ * configuración regional "C", cualquiera sea la vigente. No debe llamarse a setlocale mientras
+ * otro hilo convierte campos.
+ */
+
+/* === Headers files inclusions ================================================================ */
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+/**
+ * @brief Cantidad máxima de columnas elegidas.
+ */
+#define PDA_CSV_MAX_COLUMNS 8
+
+/**
+ * @brief Índice máximo (excluido) de una columna elegida.
+ */
+#define PDA_CSV_MAX_FIELDS 32
+
+/**
+ * @brief Largo máximo de una línea, en bytes, sin contar el salto de línea.
+ */
+#define PDA_CSV_MAX_LINE 256
+
+/**
+ * @brief Filas que se juntan antes de acumularlas.
+ */
+#define PDA_CSV_BATCH 1024
+
+/* === Public data type declarations =========================================================== */
+
+/**
+ * @brief Estado del lector. No reserva memoria dinámica.
+ */
+typedef struct {
+    char delimiter;                                 /**< Separador de campos. */
+    size_t columnCount;                             /**< Columnas elegidas. */
+    int8_t slotOf[PDA_CSV_MAX_FIELDS];              /**< Columna elegida de cada campo, o -1. */
+    size_t lastField;                               /**< Mayor índice de campo elegido. */
+    size_t headerLines;                             /**< Líneas de encabezado por saltear. */
+    size_t rows;                                    /**< Filas acumuladas. */
+    size_t malformedRows;                           /**< Filas descartadas. */
+    PdaAccumulator acc[PDA_CSV_MAX_COLUMNS];        /**< Estadísticas de cada columna. */
+    float batch[PDA_CSV_MAX_COLUMNS][PDA_CSV_BATCH]; /**< Valores pendientes de acumular. */
+    size_t batchCount;                              /**< Filas pendientes de acumular. */
+    char carry[PDA_CSV_MAX_LINE];                   /**< Línea partida al final de un bloque. */
+    size_t carryLength;                             /**< Bytes guardados en carry. */
+    bool carryOverflow;                             /**< La línea partida superó el máximo. */
+} PdaCsvParser;
+
+/* === Public variable declarations ============================================================ */
+
+/* === Public function declarations ============================================================ */
+
+/**
+ * @brief Configura un lector.
+ *
+ * @param parser Lector a configurar.
+ * @param columns Índices de las columnas a leer, distintos y menores que PDA_CSV_MAX_FIELDS.
+ * @param columnCount Cantidad de columnas, entre 1 y PDA_CSV_MAX_COLUMNS.
+ * @param delimiter Separador de campos, por ejemplo ','.
+ * @param headerLines Líneas iniciales que se saltean.
+ * @return Verdadero si la configuración es válida.
+ */
+bool pdaCsvInit(PdaCsvParser * parser, const size_t columns[], size_t columnCount, char delimiter,
+                size_t headerLines);
+
+/**
+ * @brief Procesa un bloque de bytes.
+ *
+ * @param parser Lector.
+ * @param data Bytes del bloque.
+ * @param length Cantidad de bytes.
+ */
+void pdaCsvFeed(PdaCsvParser * parser, const char * data, size_t length);
+
+/**
+ * @brief Procesa la línea final pendiente y acumula los lotes.
+ *
+ * @param parser Lector.
+ */
+void pdaCsvFinish(PdaCsvParser * parser);
+
+/**
+ * @brief Estadísticas de una columna elegida.
+ *
+ * Solo incluye las filas ya acumuladas; después de pdaCsvFinish incluye todas.
+ *
+ * @param parser Lector.
+ * @param slot Posición de la columna en el array entregado a pdaCsvInit.
+ * @param stats Estructura donde se almacenan los resultados.
+ * @return Verdadero si hay al menos un dato válido; falso en caso contrario.
+ */
+bool pdaCsvQuery(const PdaCsvParser * parser, size_t slot, PdaStats * stats);
+
+/**
+ * @brief Convierte un campo en float, admitiendo espacios antes y después del número.
+ *
+ * @param begin Primer carácter del campo.
+ * @param end Carácter siguiente al último del campo.
+ * @param value Resultado.
+ * @return Verdadero si todo el campo es un número.
+ */
+bool pdaCsvParseFloat(const char * begin, const char * end, float * value);
+
+/* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PDACSV_H */
@@ -0,0 +1,258 @@
+/*
+ * Nombre del archivo: PdaFixed.c
+ * Versión: 0.1
+ * Descripción:
+ *  Variante en punto fijo de la API de estadísticas de MP, sin operaciones de punto flotante,
+ *  para microcontroladores sin FPU.
+ *
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo bajo los términos de la
+ * Licencia Pública General GNU publicada por la Free Software Foundation, ya sea la versión 3 de la
+ * Licencia, o (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil, pero SIN NINGUNA GARANTÍA; sin
+ * siquiera la garantía implícita de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU junto con este programa.
+ * Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ */
+
+/**
+ * @file PdaFixed.c
+ * @brief Implementación de las estadísticas en punto fijo.
+ *
+ * Solo pdaFixFromFloat y pdaFixToFloat usan float; el resto del módulo es aritmética entera y,
+ * si el firmware no llama a las conversiones, el enlazador no incorpora la emulación de punto
+ * flotante.
+ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "PdaFixed.h"
+
+/* === Macros definitions ====================================================================== */
+
+/**
+ * @brief Valor inicial del mínimo, mayor que cualquier dato válido.
+ */
+#define INI_MIN_RAW UINT16_MAX
+
+/**
+ * @brief Valor inicial del máximo, menor que cualquier dato válido.
+ */
+#define INI_MAX_RAW 0
+
+/**
+ * @brief Bit más alto del resultado de pdaIsqrt32, elevado al cuadrado.
+ */
+#define ISQRT32_TOP_BIT (1u << 30)
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/* === Private function implementation ========================================================= */
+
+/**
+ * @brief Desviación estándar muestral redondeada al entero más cercano.
+ *
+ * Con m datos válidos, S = suma y Q = suma de cuadrados, la varianza es A / B con
+ * A = m * Q - S^2 y B = m * (m - 1). Si q = A / B y r = pdaIsqrt32(q), la raíz exacta es al menos
+ * r + 1/2 si y solo si A / B >= r^2 + r + 1/4: basta comparar q con r^2 + r y, si son iguales,
+ * el resto de la división con B / 4.
+ *
+ * @param validCount Cantidad de datos válidos, al menos 2.
+ * @param sum Suma de los datos válidos.
+ * @param sumOfSquares Suma de los cuadrados de los datos válidos.
+ * @return Desviación estándar en Q24.7.
+ */
+static PdaFix roundedStdDev(uint32_t validCount, uint64_t sum, uint64_t sumOfSquares) {
+    uint64_t a = validCount * sumOfSquares - sum * sum;
+    uint64_t b = (uint64_t)validCount * (validCount - 1);
+    uint32_t q = (uint32_t)(a / b);
+    uint64_t rem = a % b;
+    uint32_t r = pdaIsqrt32(q);
+    uint32_t half = r * r + r;
+    if (q > half || (q == half && 4 * rem >= b))
+        r++;
+    return (PdaFix)r;
+}
+
+/* === Public function implementation ========================================================== */
+
+/**
+ * @brief Calcula todas las estadísticas en una sola pasada, sin punto flotante.
+ *
+ * Los valores de error siguen las reglas de pdaStatsFromMoments.
+ *
+ * @param data Array de datos en UQ9.7.
+ * @param n_data Número de elementos en el array.
+ * @param stats Estructura donde se almacenan los resultados.
+ * @return Verdadero si hay al menos un dato válido; falso en caso contrario.
+ */
+bool computeParticulateStatsFix(const PdaFixSample * data, uint16_t n_data, PdaFixStats * stats) {
+    if (stats == NULL)
+        return false;
+    if (data == NULL)
+        n_data = 0;
+
+    uint32_t validCount = 0;
+    uint64_t sum = 0;
+    uint64_t sumOfSquares = 0;
+    uint32_t min = INI_MIN_RAW;
+    uint32_t max = INI_MAX_RAW;
+    for (uint32_t i = 0; i < n_data; i++) {
+        uint32_t value = data[i];
+        if (pdaFixIsValid((PdaFixSample)value)) {
+            sum += value;
+            sumOfSquares += value * value; // menor que 2^32: una multiplicación de 32 bits
+            if (value < min)
+                min = value;
+            if (value > max)
+                max = value;
+            validCount++;
+        }
+    }
+
+    stats->validCount = (uint16_t)validCount;
+    stats->rejectedCount = (uint16_t)(n_data - validCount);
+    if (n_data == 0)
+        stats->stdDev = PDA_FIX_VOID_ARRAY_VALUE;
+    else if (n_data <= 1)
+        stats->stdDev = PDA_FIX_DS_NOTDEFINI;
+    else
+        stats->stdDev = PDA_FIX_NOT_DATA;
+
+    if (validCount == 0) {
+        stats->mean = PDA_FIX_VOID_ARRAY_VALUE;
+        stats->min = PDA_FIX_VOID_ARRAY_VALUE;
+        stats->max = PDA_FIX_VOID_ARRAY_VALUE;
+        return false;
+    }
+
+    stats->mean = (PdaFix)((2 * sum + validCount) / (2 * (uint64_t)validCount));
+    stats->min = (PdaFix)min;
+    stats->max = (PdaFix)max;
+    if (n_data > 1 && validCount > 1)
+        stats->stdDev = roundedStdDev(validCount, sum, sumOfSquares);
+    return true;
+}
+
+/**
+ * @brief Calcula el promedio de los datos válidos.
+ *
+ * @param data Array de datos en UQ9.7.
+ * @param n_data Número de elementos en el array.
+ * @return El promedio en Q24.7 o PDA_FIX_VOID_ARRAY_VALUE.
+ */
+PdaFix calculateAverageFix(const PdaFixSample * data, uint16_t n_data) {
+    PdaFixStats stats;
+    computeParticulateStatsFix(data, n_data, &stats);
+    return stats.mean;
+}
+
+/**
+ * @brief Encuentra el valor máximo de los datos válidos.
+ *
+ * @param data Array de datos en UQ9.7.
+ * @param n_data Número de elementos en el array.
+ * @return El máximo en Q24.7 o PDA_FIX_VOID_ARRAY_VALUE.
+ */
+PdaFix findMaxValueFix(const PdaFixSample * data, uint16_t n_data) {
+    PdaFixStats stats;
+    computeParticulateStatsFix(data, n_data, &stats);
+    return stats.max;
+}
+
+/**
+ * @brief Encuentra el valor mínimo de los datos válidos.
+ *
+ * @param data Array de datos en UQ9.7.
+ * @param n_data Número de elementos en el array.
+ * @return El mínimo en Q24.7 o PDA_FIX_VOID_ARRAY_VALUE.
+ */
+PdaFix findMinValueFix(const PdaFixSample * data, uint16_t n_data) {
+    PdaFixStats stats;
+    computeParticulateStatsFix(data, n_data, &stats);
+    return stats.min;
+}
+
+/**
+ * @brief Calcula la desviación estándar muestral de los datos válidos.
+ *
+ * @param data Array de datos en UQ9.7.
+ * @param n_data Número de elementos en el array.
+ * @return La desviación estándar en Q24.7 o un valor de error.
+ */
+PdaFix calculateStandardDeviationFix(const PdaFixSample * data, uint16_t n_data) {
+    PdaFixStats stats;
+    computeParticulateStatsFix(data, n_data, &stats);
+    return stats.stdDev;
+}
+
+/**
+ * @brief Raíz cuadrada entera por el método dígito a dígito.
+ *
+ * Determina un bit del resultado por iteración, de mayor a menor, con 16 iteraciones de
+ * desplazamientos, sumas y una comparación; no usa multiplicaciones ni divisiones.
+ *
+ * @param x Radicando.
+ * @return El mayor r tal que r * r <= x.
+ */
+uint16_t pdaIsqrt32(uint32_t x) {
+    uint32_t result = 0;
+    uint32_t bit = ISQRT32_TOP_BIT;
+    while (bit > x)
+        bit >>= 2;
+    while (bit != 0) {
+        if (x >= result + bit) {
+            x -= result + bit;
+            result = (result >> 1) + bit;
+        } else {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint16_t)result;
+}
+
+/**
+ * @brief Convierte un dato de MP a UQ9.7, redondeando al más cercano.
+ *
+ * @param value Dato de MP.
+ * @return Dato en UQ9.7; 0 (inválido) si value no cumple maskIsDataTrue.
+ */
+PdaFixSample pdaFixFromFloat(float value) {
+    if (!maskIsDataTrue(value))
+        return 0;
+    uint32_t raw = (uint32_t)(value * PDA_FIX_ONE + 0.5f);
+    if (raw < PDA_FIX_MIN_RAW)
+        return PDA_FIX_MIN_RAW;
+    if (raw > PDA_FIX_MAX_RAW)
+        return PDA_FIX_MAX_RAW;
+    return (PdaFixSample)raw;
+}
+
+/**
+ * @brief Convierte un resultado en Q24.7 a float.
+ *
+ * @param value Resultado en Q24.7.
+ * @return value / PDA_FIX_ONE.
+ */
+float pdaFixToFloat(PdaFix value) {
+    return (float)value / PDA_FIX_ONE;
+}
+
+/* === End of documentation ==================================================================== */
@@ -0,0 +1,227 @@
+/*
+ * Nombre del archivo: PdaFixed.h
+ * Versión: 0.1
+ * Descripción:
+ *  Variante en punto fijo de la API de estadísticas de MP, sin operaciones de punto flotante,
+ *  para microcontroladores sin FPU.
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "ParticulateDataAnalyzer.h"
+
+#ifndef PDAFIXED_H
+#define PDAFIXED_H
+
+/**
+ * @file PdaFixed.h
+ * @brief Estadísticas de MP en punto fijo, con aritmética entera únicamente.
+ *
+ * Equivalentes en punto fijo de la API de ParticulateDataAnalyzer.h:
+ * - pdaFixIsValid: maskIsDataTrue como comparación entera.
+ * - calculateAverageFix, findMaxValueFix, findMinValueFix, calculateStandardDeviationFix.
+ * - computeParticulateStatsFix: Todas las estadísticas en una sola pasada.
+ * - pdaIsqrt32: Raíz cuadrada entera, reemplazo de sqrt_binary_search.
+ * - pdaFixFromFloat / pdaFixToFloat: Conversiones para el lado del host y las pruebas.
+ *
+ * Formato: cada dato es un PdaFixSample en UQ9.7 (uint16_t, 1/128 µg/m³ por unidad). El rango
+ * válido (MP_MIN_VALUE, MP_MAX_VALUE) corresponde exactamente a [PDA_FIX_MIN_RAW,
+ * PDA_FIX_MAX_RAW], porque todo dato UQ9.7 es representable en float sin error. Los resultados
+ * son PdaFix en Q24.7 (int32_t), de modo que también pueden representar los valores de error
+ * de la API (PDA_FIX_VOID_ARRAY_VALUE, PDA_FIX_DS_NOTDEFINI, PDA_FIX_NOT_DATA), que
+ * pdaFixToFloat convierte en los mismos MSN_* que retorna la API en float.
+ *
+ * Cálculo: el bucle acumula la suma y la suma de cuadrados en 64 bits; cada cuadrado es menor
+ * que 2^32, por lo que se obtiene con una sola instrucción MULS de 32 bits. Con a lo sumo 65535
+ * datos (de ahí n_data de tipo uint16_t), n * Q - S^2 es exacto en 64 bits. La varianza
+ * muestral de datos UQ9.7 es menor que 2^31, por lo que su raíz se obtiene con pdaIsqrt32. El
+ * promedio y la desviación estándar se redondean al Q24.7 más cercano al valor exacto, es decir,
+ * son exactos al último bit.
+ *
+ * Ciclos estimados en Cortex-M0 con multiplicador de un ciclo, contando las instrucciones del
+ * bucle (no medidos en hardware):
+ *
+ * | Operación                                         | Ciclos aproximados |
+ * |---------------------------------------------------|--------------------|
+ * | Bucle de computeParticulateStatsFix, dato válido  | 25                 |
+ * | Bucle de computeParticulateStatsFix, dato inválido| 10                 |
+ * | pdaIsqrt32                                        | 150                |
+ * | Cierre: dos divisiones de 64 bits por software    | 1500               |
+ *
+ * Con el multiplicador iterativo de 32 ciclos el bucle sube a unos 56 ciclos por dato válido.
+ * La API en float con emulación por software necesita del orden de 300 ciclos por dato.
+ */
+
+/* === Headers files inclusions ================================================================ */
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+/**
+ * @brief Bits fraccionarios de PdaFixSample y de PdaFix.
+ */
+#define PDA_FIX_FRAC_BITS 7
+
+/**
+ * @brief Valor de 1 µg/m³ en punto fijo.
+ */
+#define PDA_FIX_ONE (1 << PDA_FIX_FRAC_BITS)
+
+/**
+ * @brief Menor dato válido: 13/128 = 0.1016 µg/m³, el primero mayor que MP_MIN_VALUE.
+ */
+#define PDA_FIX_MIN_RAW 13
+
+/**
+ * @brief Mayor dato válido: 63999/128 = 499.992 µg/m³, el último menor que MP_MAX_VALUE.
+ */
+#define PDA_FIX_MAX_RAW 63999
+
+/**
+ * @brief Valores de error de la API expresados en Q24.7.
+ */
+#define PDA_FIX_VOID_ARRAY_VALUE ((PdaFix)MSN_VOID_ARRAY_VALUE * PDA_FIX_ONE)
+#define PDA_FIX_DS_NOTDEFINI     ((PdaFix)MSN_DS_NOTDEFINI * PDA_FIX_ONE)
+#define PDA_FIX_NOT_DATA         ((PdaFix)MSN_NOT_DATA * PDA_FIX_ONE)
+
+/* === Public data type declarations =========================================================== */
+
+/**
+ * @brief Dato de MP en UQ9.7.
+ */
+typedef uint16_t PdaFixSample;
+
+/**
+ * @brief Resultado en Q24.7: un dato de MP o un valor de error.
+ */
+typedef int32_t PdaFix;
+
+/**
+ * @brief Resumen estadístico en punto fijo, con los mismos campos y valores de error que PdaStats.
+ */
+typedef struct {
+    PdaFix mean;            /**< Promedio de los datos válidos. */
+    PdaFix min;             /**< Valor mínimo de los datos válidos. */
+    PdaFix max;             /**< Valor máximo de los datos válidos. */
+    PdaFix stdDev;          /**< Desviación estándar muestral de los datos válidos. */
+    uint16_t validCount;    /**< Cantidad de datos que cumplen pdaFixIsValid. */
+    uint16_t rejectedCount; /**< Cantidad de datos descartados por estar fuera de rango. */
+} PdaFixStats;
+
+/* === Public variable declarations ============================================================ */
+
+/* === Public function declarations ============================================================ */
+
+/**
+ * @brief Verifica si un dato está dentro del rango válido, con una única comparación sin signo.
+ *
+ * @param sample Dato en UQ9.7.
+ * @return Verdadero si sample está en [PDA_FIX_MIN_RAW, PDA_FIX_MAX_RAW].
+ */
+static inline bool pdaFixIsValid(PdaFixSample sample) {
+    return (uint16_t)(sample - PDA_FIX_MIN_RAW) <= PDA_FIX_MAX_RAW - PDA_FIX_MIN_RAW;
+}
+
+/**
+ * @brief Calcula todas las estadísticas en una sola pasada, sin punto flotante.
+ *
+ * @param data Array de datos en UQ9.7.
+ * @param n_data Número de elementos en el array.
+ * @param stats Estructura donde se almacenan los resultados.
+ * @return Verdadero si hay al menos un dato válido; falso en caso contrario.
+ */
+bool computeParticulateStatsFix(const PdaFixSample * data, uint16_t n_data, PdaFixStats * stats);
+
+/**
+ * @brief Calcula el promedio de los datos válidos.
+ *
+ * @param data Array de datos en UQ9.7.
+ * @param n_data Número de elementos en el array.
+ * @return El promedio en Q24.7 o PDA_FIX_VOID_ARRAY_VALUE.
+ */
+PdaFix calculateAverageFix(const PdaFixSample * data, uint16_t n_data);
+
+/**
+ * @brief Encuentra el valor máximo de los datos válidos.
+ *
+ * @param data Array de datos en UQ9.7.
+ * @param n_data Número de elementos en el array.
+ * @return El máximo en Q24.7 o PDA_FIX_VOID_ARRAY_VALUE.
+ */
+PdaFix findMaxValueFix(const PdaFixSample * data, uint16_t n_data);
+
+/**
+ * @brief Encuentra el valor mínimo de los datos válidos.
+ *
+ * @param data Array de datos en UQ9.7.
+ * @param n_data Número de elementos en el array.
+ * @return El mínimo en Q24.7 o PDA_FIX_VOID_ARRAY_VALUE.
+ */
+PdaFix findMinValueFix(const PdaFixSample * data, uint16_t n_data);
+
+/**
+ * @brief Calcula la desviación estándar muestral de los datos válidos.
+ *
+ * @param data Array de datos en UQ9.7.
+ * @param n_data Número de elementos en el array.
+ * @return La desviación estándar en Q24.7, PDA_FIX_VOID_ARRAY_VALUE, PDA_FIX_DS_NOTDEFINI o
+ *         PDA_FIX_NOT_DATA, con las mismas reglas que calculateStandardDeviation.
+ */
+PdaFix calculateStandardDeviationFix(const PdaFixSample * data, uint16_t n_data);
+
+/**
+ * @brief Raíz cuadrada entera por el método dígito a dígito (solo desplazamientos y sumas).
+ *
+ * @param x Radicando.
+ * @return El mayor r tal que r * r <= x.
+ */
+uint16_t pdaIsqrt32(uint32_t x);
+
+/**
+ * @brief Convierte un dato de MP a UQ9.7, redondeando al más cercano.
+ *
+ * @param value Dato de MP.
+ * @return Dato en UQ9.7; 0 (inválido) si value no cumple maskIsDataTrue.
+ */
+PdaFixSample pdaFixFromFloat(float value);
+
+/**
+ * @brief Convierte un resultado en Q24.7 a float.
+ *
+ * @param value Resultado en Q24.7.
+ * @return value / PDA_FIX_ONE.
+ */
+float pdaFixToFloat(PdaFix value);
+
+/* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PDAFIXED_H */
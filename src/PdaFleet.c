@@ -0,0 +1,428 @@
+/*
+ * Nombre del archivo: PdaFleet.c
+ * Versión: 0.1
+ * Descripción:
+ *  Estadísticas por sensor de una flota de sensores de MP, con el estado de todos los sensores
+ *  en una única región de memoria.
+ *
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo bajo los términos de la
+ * Licencia Pública General GNU publicada por la Free Software Foundation, ya sea la versión 3 de la
+ * Licencia, o (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil, pero SIN NINGUNA GARANTÍA; sin
+ * siquiera la garantía implícita de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU junto con este programa.
+ * Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ */
+
+/**
+ * @file PdaFleet.c
+ * @brief Implementación de la flota de sensores.
+ *
+ * La región comienza con la estructura PdaFleet y sigue con la tabla de lugares. El lugar inicial
+ * de cada sensor se obtiene con hash multiplicativo (Fibonacci): los bits altos de
+ * sensorId * 2^32 / phi, que distribuyen bien incluso identificadores consecutivos. Como los
+ * sensores nunca se eliminan de la tabla, el sondeo lineal no necesita marcas de borrado.
+ *
+ * Cada acumulador desplaza sus datos respecto de su primer dato válido, igual que
+ * pdaAccPushBatch, para que la suma de cuadrados en doble precisión no pierda dígitos cuando la
+ * dispersión es pequeña frente al promedio.
+ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "PdaFleet.h"
+#include <stdlib.h>
+
+/* === Macros definitions ====================================================================== */
+
+/**
+ * @brief valor inicial de contadores
+ */
+#define INI_COUNT 0
+
+/**
+ * @brief valor inicial de sumas
+ */
+#define INI_SUM 0.0
+
+/**
+ * @brief Parte entera de 2^32 / phi, multiplicador del hash.
+ */
+#define FIBONACCI_HASH 0x9E3779B9u
+
+/**
+ * @brief Bits del resultado del hash.
+ */
+#define HASH_BITS 32
+
+/**
+ * @brief Alineación de la tabla dentro de la región.
+ */
+#define ARENA_ALIGN 8
+
+/**
+ * @brief Cantidad de pares que se anticipa la carga del lugar de un sensor.
+ */
+#define PREFETCH_DISTANCE 16
+
+/**
+ * @brief Mayor cantidad de sensores, para que la tabla tenga a lo sumo 2^31 lugares.
+ */
+#define MAX_SENSORS (1u << 30)
+
+#if defined(__GNUC__)
+#define PREFETCH_WRITE(address) __builtin_prefetch((address), 1)
+#else
+#define PREFETCH_WRITE(address) ((void)(address))
+#endif
+
+/* === Private data type declarations ========================================================== */
+
+/**
+ * @brief Acumulador de un sensor, de 40 bytes.
+ */
+typedef struct {
+    uint32_t sensorId;      /**< Identificador, o PDA_FLEET_NO_SENSOR si el lugar está vacío. */
+    uint32_t validCount;    /**< Datos válidos del período. */
+    uint32_t rejectedCount; /**< Datos descartados del período. */
+    float shift;            /**< Primer dato válido del período, referencia de las sumas. */
+    float min;              /**< Mínimo de los datos válidos. */
+    float max;              /**< Máximo de los datos válidos. */
+    double sum;             /**< Suma de los datos válidos menos shift. */
+    double sumOfSquares;    /**< Suma de los cuadrados de los datos válidos menos shift. */
+} SensorSlot;
+
+/**
+ * @brief Flota de sensores, ubicada al comienzo de su región.
+ */
+struct PdaFleet {
+    SensorSlot * slots; /**< Tabla de lugares. */
+    size_t mask;        /**< Cantidad de lugares - 1 (potencia de dos - 1). */
+    size_t maxSensors;  /**< Sensores admitidos. */
+    size_t sensorCount; /**< Sensores registrados. */
+    unsigned hashShift; /**< Desplazamiento que deja en el hash los bits del índice. */
+    bool ownsArena;     /**< Indica si la región se obtuvo en pdaFleetCreate. */
+};
+
+#ifdef USE_STATIC_MEM
+/**
+ * @brief Bloque de pdaFleetPool: una región para PDA_FLEET_STATIC_SENSORS sensores.
+ */
+typedef struct {
+    PdaFleet fleet;                                 /**< Estado de la flota. */
+    SensorSlot slots[2 * PDA_FLEET_STATIC_SENSORS]; /**< Tabla de lugares. */
+} FleetBlock;
+#endif
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+#ifdef USE_STATIC_MEM
+/**
+ * @brief Bloques de pdaFleetPool.
+ */
+static FleetBlock fleetBlocks[PDA_FLEET_MAX_INSTANCES];
+
+PdaPool pdaFleetPool = PDA_POOL_INITIALIZER("PdaFleet", fleetBlocks);
+#endif
+
+/* === Private variable definitions ============================================================ */
+
+/* === Private function implementation ========================================================= */
+
+/**
+ * @brief Cantidad de lugares de la tabla: la menor potencia de dos que duplica maxSensors.
+ *
+ * @param maxSensors Cantidad máxima de sensores, entre 1 y MAX_SENSORS.
+ * @return Cantidad de lugares.
+ */
+static size_t slotCount(size_t maxSensors) {
+    size_t count = 2;
+    while (count < 2 * maxSensors)
+        count *= 2;
+    return count;
+}
+
+/**
+ * @brief Bytes que ocupa la estructura PdaFleet al comienzo de la región, con la tabla alineada.
+ */
+static size_t headerSize(void) {
+    return (sizeof(PdaFleet) + ARENA_ALIGN - 1) / ARENA_ALIGN * ARENA_ALIGN;
+}
+
+/**
+ * @brief Lugar inicial de un sensor en la tabla.
+ */
+static inline size_t hashIndex(const PdaFleet * fleet, uint32_t sensorId) {
+    return (uint32_t)(sensorId * FIBONACCI_HASH) >> fleet->hashShift;
+}
+
+/**
+ * @brief Deja un acumulador sin datos, conservando su identificador.
+ */
+static void resetSlot(SensorSlot * slot) {
+    slot->validCount = INI_COUNT;
+    slot->rejectedCount = INI_COUNT;
+    slot->shift = 0.0f;
+    slot->min = 0.0f;
+    slot->max = 0.0f;
+    slot->sum = INI_SUM;
+    slot->sumOfSquares = INI_SUM;
+}
+
+/**
+ * @brief Busca el lugar de un sensor y lo registra si es nuevo.
+ *
+ * @return El lugar del sensor o NULL si la tabla ya tiene maxSensors sensores.
+ */
+static SensorSlot * findOrInsert(PdaFleet * fleet, uint32_t sensorId) {
+    size_t i = hashIndex(fleet, sensorId);
+    for (;;) {
+        SensorSlot * slot = &fleet->slots[i];
+        if (slot->sensorId == sensorId)
+            return slot;
+        if (slot->sensorId == PDA_FLEET_NO_SENSOR) {
+            if (fleet->sensorCount == fleet->maxSensors)
+                return NULL;
+            fleet->sensorCount++;
+            slot->sensorId = sensorId;
+            return slot;
+        }
+        i = (i + 1) & fleet->mask;
+    }
+}
+
+/**
+ * @brief Incorpora un dato al acumulador de un sensor.
+ */
+static inline void pushSlot(SensorSlot * slot, float value) {
+    if (!(value > MP_MIN_VALUE && value < MP_MAX_VALUE)) { // misma condición que maskIsDataTrue
+        slot->rejectedCount++;
+        return;
+    }
+    if (slot->validCount == 0) {
+        slot->shift = value;
+        slot->min = value;
+        slot->max = value;
+    }
+    double delta = (double)value - slot->shift;
+    slot->sum += delta;
+    slot->sumOfSquares += delta * delta;
+    if (value < slot->min)
+        slot->min = value;
+    if (value > slot->max)
+        slot->max = value;
+    slot->validCount++;
+}
+
+/**
+ * @brief Calcula las estadísticas de un acumulador.
+ */
+static bool slotStats(const SensorSlot * slot, PdaStats * stats) {
+    double n = slot->validCount > 0 ? (double)slot->validCount : 1.0;
+    double m2 = slot->sumOfSquares - slot->sum * slot->sum / n;
+    if (m2 < 0.0)
+        m2 = 0.0; // descarta residuos negativos de redondeo
+    return pdaStatsFromMoments((size_t)slot->validCount + slot->rejectedCount, slot->validCount,
+                               slot->shift + slot->sum / n, m2, slot->min, slot->max, stats);
+}
+
+/* === Public function implementation ========================================================== */
+
+/**
+ * @brief Calcula la memoria necesaria para una flota.
+ *
+ * @param maxSensors Cantidad máxima de sensores.
+ * @return Bytes necesarios, o 0 si maxSensors es 0 o demasiado grande.
+ */
+size_t pdaFleetArenaSize(size_t maxSensors) {
+    if (maxSensors == 0 || maxSensors > MAX_SENSORS)
+        return 0;
+    size_t slots = slotCount(maxSensors);
+    if (slots > (SIZE_MAX - headerSize()) / sizeof(SensorSlot))
+        return 0;
+    return headerSize() + slots * sizeof(SensorSlot);
+}
+
+/**
+ * @brief Crea una flota vacía con una única reserva de memoria.
+ *
+ * @param maxSensors Cantidad máxima de sensores.
+ * @return La flota creada o NULL si maxSensors no es válido o no hay memoria disponible.
+ */
+PdaFleet * pdaFleetCreate(size_t maxSensors) {
+    size_t size = pdaFleetArenaSize(maxSensors);
+    if (size == 0)
+        return NULL;
+#ifdef USE_STATIC_MEM
+    if (size > sizeof(FleetBlock)) {
+        pdaPoolReject(&pdaFleetPool);
+        return NULL;
+    }
+    FleetBlock * arena = pdaPoolAcquire(&pdaFleetPool);
+    size = sizeof(FleetBlock);
+#else
+    void * arena = malloc(size);
+#endif
+    if (arena == NULL)
+        return NULL;
+    PdaFleet * fleet = pdaFleetCreateIn(arena, size, maxSensors);
+    fleet->ownsArena = true;
+    return fleet;
+}
+
+/**
+ * @brief Crea una flota vacía en una región de memoria del llamador.
+ *
+ * @param arena Región de al menos pdaFleetArenaSize(maxSensors) bytes, alineada a 8 bytes.
+ * @param arenaSize Tamaño de la región en bytes.
+ * @param maxSensors Cantidad máxima de sensores.
+ * @return La flota, ubicada al comienzo de arena, o NULL si la región no alcanza.
+ */
+PdaFleet * pdaFleetCreateIn(void * arena, size_t arenaSize, size_t maxSensors) {
+    size_t size = pdaFleetArenaSize(maxSensors);
+    if (arena == NULL || size == 0 || arenaSize < size ||
+        (uintptr_t)arena % ARENA_ALIGN != 0)
+        return NULL;
+
+    PdaFleet * fleet = arena;
+    size_t slots = slotCount(maxSensors);
+    fleet->slots = (SensorSlot *)((char *)arena + headerSize());
+    fleet->mask = slots - 1;
+    fleet->maxSensors = maxSensors;
+    fleet->sensorCount = INI_COUNT;
+    fleet->hashShift = HASH_BITS;
+    for (size_t s = slots; s > 1; s /= 2)
+        fleet->hashShift--;
+    fleet->ownsArena = false;
+    for (size_t i = 0; i < slots; i++) {
+        fleet->slots[i].sensorId = PDA_FLEET_NO_SENSOR;
+        resetSlot(&fleet->slots[i]);
+    }
+    return fleet;
+}
+
+/**
+ * @brief Libera una flota.
+ *
+ * @param fleet Flota a liberar; se ignora si es NULL.
+ */
+void pdaFleetDestroy(PdaFleet * fleet) {
+    if (fleet == NULL || !fleet->ownsArena)
+        return;
+#ifdef USE_STATIC_MEM
+    pdaPoolRelease(&pdaFleetPool, fleet); // la flota está al comienzo de su FleetBlock
+#else
+    free(fleet);
+#endif
+}
+
+/**
+ * @brief Agrega un lote de datos, registrando los sensores nuevos.
+ *
+ * @param fleet Flota.
+ * @param samples Pares (sensor, dato), en cualquier orden.
+ * @param n_samples Cantidad de pares.
+ * @return Cantidad de pares incorporados.
+ */
+size_t pdaFleetIngest(PdaFleet * fleet, const PdaSensorSample * samples, size_t n_samples) {
+    if (fleet == NULL || samples == NULL)
+        return 0;
+
+    size_t accepted = INI_COUNT;
+    uint32_t lastId = PDA_FLEET_NO_SENSOR;
+    SensorSlot * slot = NULL;
+    for (size_t i = 0; i < n_samples; i++) {
+        if (i + PREFETCH_DISTANCE < n_samples) {
+            uint32_t aheadId = samples[i + PREFETCH_DISTANCE].sensorId;
+            PREFETCH_WRITE(&fleet->slots[hashIndex(fleet, aheadId)]);
+        }
+        uint32_t sensorId = samples[i].sensorId;
+        if (sensorId != lastId || slot == NULL) {
+            if (sensorId == PDA_FLEET_NO_SENSOR)
+                continue;
+            slot = findOrInsert(fleet, sensorId);
+            lastId = sensorId;
+            if (slot == NULL)
+                continue;
+        }
+        pushSlot(slot, samples[i].value);
+        accepted++;
+    }
+    return accepted;
+}
+
+/**
+ * @brief Obtiene las estadísticas de un sensor en el período actual.
+ *
+ * @param fleet Flota.
+ * @param sensorId Identificador del sensor.
+ * @param stats Estructura donde se almacenan los resultados.
+ * @return Verdadero si el sensor está registrado y tiene al menos un dato válido.
+ */
+bool pdaFleetQuery(const PdaFleet * fleet, uint32_t sensorId, PdaStats * stats) {
+    if (fleet == NULL || stats == NULL)
+        return false;
+    if (sensorId != PDA_FLEET_NO_SENSOR) {
+        for (size_t i = hashIndex(fleet, sensorId);
+             fleet->slots[i].sensorId != PDA_FLEET_NO_SENSOR; i = (i + 1) & fleet->mask) {
+            if (fleet->slots[i].sensorId == sensorId)
+                return slotStats(&fleet->slots[i], stats);
+        }
+    }
+    pdaStatsFromMoments(0, 0, 0.0, 0.0, 0.0f, 0.0f, stats);
+    return false;
+}
+
+/**
+ * @brief Entrega las estadísticas de todos los sensores registrados en un único recorrido.
+ *
+ * @param fleet Flota.
+ * @param emit Receptor de las estadísticas de cada sensor; puede ser NULL.
+ * @param context Puntero que se entrega a emit.
+ * @param reset Si es verdadero, los acumuladores se reinician después de entregarlos.
+ * @return Cantidad de sensores recorridos.
+ */
+size_t pdaFleetSnapshot(PdaFleet * fleet, PdaSensorFn emit, void * context, bool reset) {
+    if (fleet == NULL)
+        return 0;
+    size_t visited = INI_COUNT;
+    for (size_t i = 0; i <= fleet->mask; i++) {
+        SensorSlot * slot = &fleet->slots[i];
+        if (slot->sensorId == PDA_FLEET_NO_SENSOR)
+            continue;
+        if (emit != NULL) {
+            PdaStats stats;
+            slotStats(slot, &stats);
+            emit(slot->sensorId, &stats, context);
+        }
+        if (reset)
+            resetSlot(slot);
+        visited++;
+    }
+    return visited;
+}
+
+/**
+ * @brief Retorna la cantidad de sensores registrados.
+ *
+ * @param fleet Flota.
+ * @return Sensores que recibieron al menos un dato.
+ */
+size_t pdaFleetSensorCount(const PdaFleet * fleet) {
+    return fleet == NULL ? 0 : fleet->sensorCount;
+}
+
+/* === End of documentation ==================================================================== */
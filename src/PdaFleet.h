@@ -0,0 +1,214 @@
+/*
+ * Nombre del archivo: PdaFleet.h
+ * Versión: 0.1
+ * Descripción:
+ *  Estadísticas por sensor de una flota de sensores de MP, con el estado de todos los sensores
+ *  en una única región de memoria.
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "ParticulateDataAnalyzer.h"
+#include "PdaPool.h"
+
+#ifndef PDAFLEET_H
+#define PDAFLEET_H
+
+/**
+ * @file PdaFleet.h
+ * @brief Acumuladores por sensor para flotas de miles de sensores.
+ *
+ * - pdaFleetArenaSize: Memoria necesaria para una flota de N sensores.
+ * - pdaFleetCreate / pdaFleetCreateIn: Crea una flota con memoria propia o en una región dada.
+ * - pdaFleetDestroy: Libera la flota.
+ * - pdaFleetIngest: Agrega un lote de pares (sensor, dato), ordenados o no.
+ * - pdaFleetQuery: Estadísticas de un sensor.
+ * - pdaFleetSnapshot: Entrega las estadísticas de todos los sensores y opcionalmente las reinicia.
+ * - pdaFleetSensorCount: Cantidad de sensores registrados.
+ *
+ * Cada sensor ocupa un acumulador de 40 bytes (identificador, contadores, mínimo, máximo y la
+ * suma y la suma de cuadrados desplazadas respecto de su primer dato válido) dentro de una tabla
+ * hash de direccionamiento abierto con sondeo lineal. La tabla tiene al menos el doble de lugares
+ * que sensores, de modo que la mayoría de las búsquedas termina en el primer lugar. Un sensor se
+ * registra al recibir su primer dato; los datos de sensores nuevos que no entran en la tabla se
+ * descartan. El identificador PDA_FLEET_NO_SENSOR está reservado.
+ *
+ * Toda la tabla vive en una sola región de pdaFleetArenaSize bytes: pdaFleetCreate la obtiene con
+ * una única reserva y pdaFleetCreateIn la ubica en memoria del llamador (por ejemplo, un arreglo
+ * estático), sin memoria dinámica. Con USE_STATIC_MEM, pdaFleetCreate toma la región de
+ * pdaFleetPool, con PDA_FLEET_MAX_INSTANCES regiones de hasta PDA_FLEET_STATIC_SENSORS sensores.
+ *
+ * pdaFleetIngest reutiliza el último lugar encontrado mientras se repite el sensor, por lo que un
+ * lote ordenado por sensor hace una búsqueda por tramo; con lotes desordenados anticipa la carga
+ * del lugar de los pares siguientes para solapar los accesos a memoria.
+ *
+ * pdaFleetSnapshot recorre la tabla una vez, entrega a un receptor las estadísticas de cada
+ * sensor con los mismos valores de error que computeParticulateStats y, si se pide, reinicia sus
+ * acumuladores en el mismo recorrido; los sensores quedan registrados para el período siguiente.
+ */
+
+/* === Headers files inclusions ================================================================ */
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+/**
+ * @brief Identificador reservado para los lugares vacíos de la tabla.
+ */
+#define PDA_FLEET_NO_SENSOR UINT32_MAX
+
+#ifndef PDA_FLEET_MAX_INSTANCES
+/**
+ * @brief Cantidad de flotas de pdaFleetCreate disponibles con USE_STATIC_MEM.
+ */
+#define PDA_FLEET_MAX_INSTANCES 1
+#endif
+
+#ifndef PDA_FLEET_STATIC_SENSORS
+/**
+ * @brief Sensores de cada flota de pdaFleetCreate con USE_STATIC_MEM (potencia de dos).
+ */
+#define PDA_FLEET_STATIC_SENSORS 64
+#endif
+
+/* === Public data type declarations =========================================================== */
+
+/**
+ * @brief Flota de sensores. Su contenido es privado del módulo.
+ */
+typedef struct PdaFleet PdaFleet;
+
+/**
+ * @brief Dato de un sensor.
+ */
+typedef struct {
+    uint32_t sensorId; /**< Identificador del sensor. */
+    float value;       /**< Dato de MP. */
+} PdaSensorSample;
+
+/**
+ * @brief Receptor de las estadísticas de cada sensor.
+ *
+ * @param sensorId Identificador del sensor.
+ * @param stats Estadísticas del sensor en el período.
+ * @param context Puntero entregado a pdaFleetSnapshot.
+ */
+typedef void (*PdaSensorFn)(uint32_t sensorId, const PdaStats * stats, void * context);
+
+/* === Public variable declarations ============================================================ */
+
+#ifdef USE_STATIC_MEM
+/**
+ * @brief Conjunto de regiones del modo sin memoria dinámica, para consultar su uso.
+ */
+extern PdaPool pdaFleetPool;
+#endif
+
+/* === Public function declarations ============================================================ */
+
+/**
+ * @brief Calcula la memoria necesaria para una flota.
+ *
+ * @param maxSensors Cantidad máxima de sensores.
+ * @return Bytes necesarios, o 0 si maxSensors es 0 o demasiado grande.
+ */
+size_t pdaFleetArenaSize(size_t maxSensors);
+
+/**
+ * @brief Crea una flota vacía con una única reserva de memoria.
+ *
+ * @param maxSensors Cantidad máxima de sensores.
+ * @return La flota creada o NULL si maxSensors no es válido o no hay memoria disponible.
+ */
+PdaFleet * pdaFleetCreate(size_t maxSensors);
+
+/**
+ * @brief Crea una flota vacía en una región de memoria del llamador.
+ *
+ * @param arena Región de al menos pdaFleetArenaSize(maxSensors) bytes, alineada a 8 bytes. Debe
+ *              permanecer válida mientras se use la flota.
+ * @param arenaSize Tamaño de la región en bytes.
+ * @param maxSensors Cantidad máxima de sensores.
+ * @return La flota, ubicada al comienzo de arena, o NULL si la región no alcanza.
+ */
+PdaFleet * pdaFleetCreateIn(void * arena, size_t arenaSize, size_t maxSensors);
+
+/**
+ * @brief Libera una flota; la memoria de pdaFleetCreateIn queda a cargo del llamador.
+ *
+ * @param fleet Flota a liberar; se ignora si es NULL.
+ */
+void pdaFleetDestroy(PdaFleet * fleet);
+
+/**
+ * @brief Agrega un lote de datos, registrando los sensores nuevos.
+ *
+ * @param fleet Flota.
+ * @param samples Pares (sensor, dato), en cualquier orden.
+ * @param n_samples Cantidad de pares.
+ * @return Cantidad de pares incorporados; el resto pertenece a sensores que no entran en la tabla
+ *         o a PDA_FLEET_NO_SENSOR.
+ */
+size_t pdaFleetIngest(PdaFleet * fleet, const PdaSensorSample * samples, size_t n_samples);
+
+/**
+ * @brief Obtiene las estadísticas de un sensor en el período actual.
+ *
+ * @param fleet Flota.
+ * @param sensorId Identificador del sensor.
+ * @param stats Estructura donde se almacenan los resultados.
+ * @return Verdadero si el sensor está registrado y tiene al menos un dato válido.
+ */
+bool pdaFleetQuery(const PdaFleet * fleet, uint32_t sensorId, PdaStats * stats);
+
+/**
+ * @brief Entrega las estadísticas de todos los sensores registrados en un único recorrido.
+ *
+ * @param fleet Flota.
+ * @param emit Receptor de las estadísticas de cada sensor; puede ser NULL si solo se reinicia.
+ * @param context Puntero que se entrega a emit.
+ * @param reset Si es verdadero, los acumuladores se reinician después de entregarlos.
+ * @return Cantidad de sensores recorridos.
+ */
+size_t pdaFleetSnapshot(PdaFleet * fleet, PdaSensorFn emit, void * context, bool reset);
+
+/**
+ * @brief Retorna la cantidad de sensores registrados.
+ *
+ * @param fleet Flota.
+ * @return Sensores que recibieron al menos un dato.
+ */
+size_t pdaFleetSensorCount(const PdaFleet * fleet);
+
+/* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PDAFLEET_H */
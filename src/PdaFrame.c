@@ -0,0 +1,194 @@
+/*
+ * Nombre del archivo: PdaFrame.c
+ * Versión: 0.1
+ * Descripción:
+ *  Estadísticas de tramas de sensor con varios canales intercalados (MP1.0, MP2.5, MP10 y
+ *  conteos de partículas) sin separar los canales en arrays.
+ *
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo bajo los términos de la
+ * Licencia Pública General GNU publicada por la Free Software Foundation, ya sea la versión 3 de la
+ * Licencia, o (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil, pero SIN NINGUNA GARANTÍA; sin
+ * siquiera la garantía implícita de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU junto con este programa.
+ * Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ */
+
+/**
+ * @file PdaFrame.c
+ * @brief Implementación de las estadísticas por canal de tramas intercaladas.
+ *
+ * Cada trama se lee una sola vez y todos sus canales se acumulan antes de pasar a la siguiente,
+ * de modo que el buffer se recorre en orden de memoria. Como en computeParticulateStats, las
+ * sumas de cada canal se acumulan en doble precisión y desplazadas respecto de su primer dato
+ * válido, que se toma al encontrarlo durante la misma pasada.
+ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "PdaFrame.h"
+#include <string.h> // Para memcpy
+
+/* === Macros definitions ====================================================================== */
+
+/* === Private data type declarations ========================================================== */
+
+/**
+ * @brief Sumas de un canal durante la pasada.
+ */
+typedef struct {
+    size_t validCount;
+    double shift;
+    double sum;
+    double sumOfSquares;
+    float min;
+    float max;
+} ChannelSums;
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/* === Private function implementation ========================================================= */
+
+/**
+ * @brief Tamaño en bytes del campo de un canal, o 0 si el tipo no existe.
+ */
+static size_t fieldSize(PdaChannelType type) {
+    switch (type) {
+    case PDA_CHANNEL_F32:
+        return sizeof(float);
+    case PDA_CHANNEL_U16:
+        return sizeof(uint16_t);
+    case PDA_CHANNEL_U32:
+        return sizeof(uint32_t);
+    default:
+        return 0;
+    }
+}
+
+/**
+ * @brief Lee el campo de un canal, sin requerir alineación.
+ */
+static float readField(const uint8_t * field, PdaChannelType type) {
+    float f32;
+    uint16_t u16;
+    uint32_t u32;
+    switch (type) {
+    case PDA_CHANNEL_U16:
+        memcpy(&u16, field, sizeof(u16));
+        return (float)u16;
+    case PDA_CHANNEL_U32:
+        memcpy(&u32, field, sizeof(u32));
+        return (float)u32;
+    default:
+        memcpy(&f32, field, sizeof(f32));
+        return f32;
+    }
+}
+
+/**
+ * @brief Incorpora un dato válido a las sumas de su canal.
+ */
+static void addValue(ChannelSums * sums, float value) {
+    if (sums->validCount == 0) {
+        sums->shift = value;
+        sums->min = value;
+        sums->max = value;
+    }
+    double delta = (double)value - sums->shift;
+    sums->validCount++;
+    sums->sum += delta;
+    sums->sumOfSquares += delta * delta;
+    if (value < sums->min)
+        sums->min = value;
+    if (value > sums->max)
+        sums->max = value;
+}
+
+/**
+ * @brief Completa las estadísticas de un canal a partir de sus sumas.
+ */
+static void finishChannel(const ChannelSums * sums, size_t n_frames, PdaStats * stats) {
+    if (sums->validCount == 0) {
+        pdaStatsFromMoments(n_frames, 0, 0.0, 0.0, 0.0f, 0.0f, stats);
+        return;
+    }
+    double n = (double)sums->validCount;
+    double mean = sums->shift + sums->sum / n;
+    double m2 = sums->sumOfSquares - sums->sum * sums->sum / n;
+    pdaStatsFromMoments(n_frames, sums->validCount, mean, m2, sums->min, sums->max, stats);
+}
+
+/* === Public function implementation ========================================================== */
+
+/**
+ * @brief Variante de computeParticulateStats para un canal float con separación stride.
+ *
+ * @param data Primer dato del canal.
+ * @param n_data Número de datos del canal.
+ * @param stride Distancia en bytes entre datos consecutivos.
+ * @param minValue Límite inferior del rango válido, excluido.
+ * @param maxValue Límite superior del rango válido, excluido.
+ * @param stats Estructura donde se almacenan los resultados.
+ * @return Verdadero si hay al menos un dato válido; falso en caso contrario.
+ */
+bool computeParticulateStatsStrided(const float * data, size_t n_data, size_t stride,
+                                    double minValue, double maxValue, PdaStats * stats) {
+    const PdaChannel channel = {0, PDA_CHANNEL_F32, minValue, maxValue};
+    return computeFrameStats(data, n_data, stride, &channel, 1, stats) && stats->validCount > 0;
+}
+
+/**
+ * @brief Calcula las estadísticas de varios canales intercalados en una sola pasada.
+ *
+ * @param frames Primera trama.
+ * @param n_frames Número de tramas.
+ * @param frameSize Tamaño de cada trama en bytes.
+ * @param channels Descripción de los canales.
+ * @param n_channels Número de canales.
+ * @param stats Array de n_channels estructuras, una por canal.
+ * @return Verdadero si los argumentos son válidos y se completó stats.
+ */
+bool computeFrameStats(const void * frames, size_t n_frames, size_t frameSize,
+                       const PdaChannel channels[], size_t n_channels, PdaStats stats[]) {
+    if (channels == NULL || stats == NULL || n_channels == 0 ||
+        n_channels > PDA_FRAME_MAX_CHANNELS)
+        return false;
+    for (size_t c = 0; c < n_channels; c++) {
+        size_t size = fieldSize(channels[c].type);
+        if (size == 0 || channels[c].offset > frameSize || frameSize - channels[c].offset < size)
+            return false;
+    }
+    if (frames == NULL)
+        n_frames = 0; // Manejo de array vacío, como computeParticulateStats
+
+    ChannelSums sums[PDA_FRAME_MAX_CHANNELS] = {0};
+    const uint8_t * frame = frames;
+    for (size_t i = 0; i < n_frames; i++, frame += frameSize) {
+        for (size_t c = 0; c < n_channels; c++) {
+            float value = readField(frame + channels[c].offset, channels[c].type);
+            if (value > channels[c].minValue && value < channels[c].maxValue)
+                addValue(&sums[c], value);
+        }
+    }
+
+    for (size_t c = 0; c < n_channels; c++)
+        finishChannel(&sums[c], n_frames, &stats[c]);
+    return true;
+}
+
+/* === End of documentation ==================================================================== */
@@ -0,0 +1,149 @@
+/*
+ * Nombre del archivo: PdaFrame.h
+ * Versión: 0.1
+ * Descripción:
+ *  Estadísticas de tramas de sensor con varios canales intercalados (MP1.0, MP2.5, MP10 y
+ *  conteos de partículas) sin separar los canales en arrays.
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "ParticulateDataAnalyzer.h"
+
+#ifndef PDAFRAME_H
+#define PDAFRAME_H
+
+/**
+ * @file PdaFrame.h
+ * @brief Estadísticas por canal de un array de tramas (array de estructuras), sin copias.
+ *
+ * - computeParticulateStatsStrided: computeParticulateStats sobre un canal float que se repite
+ *   cada stride bytes, con su propio rango de validez.
+ * - computeFrameStats: Estadísticas de todos los canales descritos por un array de PdaChannel en
+ *   una sola pasada por las tramas.
+ *
+ * Cada canal indica el desplazamiento de su campo dentro de la trama, su tipo (float o conteo
+ * entero sin signo) y su rango de validez (min, max), ambos excluidos, que reemplaza a
+ * MP_MIN_VALUE y MP_MAX_VALUE. Con PDA_CHANNEL_MP el criterio es exactamente el de
+ * maskIsDataTrue y los resultados de un canal float coinciden con los de computeParticulateStats
+ * sobre el canal separado. Los campos se leen con memcpy, por lo que la trama puede estar
+ * empaquetada y sin alinear.
+ *
+ * Ejemplo:
+ * @code
+ * const PdaChannel channels[] = {
+ *     PDA_CHANNEL_MP(SensorFrame, pm25),
+ *     PDA_CHANNEL(SensorFrame, count03, PDA_CHANNEL_U16, 0.0, 65535.0),
+ * };
+ * computeFrameStats(frames, n, sizeof(SensorFrame), channels, 2, stats);
+ * @endcode
+ */
+
+/* === Headers files inclusions ================================================================ */
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+/**
+ * @brief Cantidad máxima de canales por llamada a computeFrameStats.
+ */
+#define PDA_FRAME_MAX_CHANNELS 16
+
+/**
+ * @brief Describe el campo field de la estructura type con tipo y rango de validez propios.
+ */
+#define PDA_CHANNEL(type, field, kind, minValue, maxValue)                                         \
+    { offsetof(type, field), (kind), (minValue), (maxValue) }
+
+/**
+ * @brief Describe un campo float de MP con el rango de validez de maskIsDataTrue.
+ */
+#define PDA_CHANNEL_MP(type, field)                                                                \
+    PDA_CHANNEL(type, field, PDA_CHANNEL_F32, MP_MIN_VALUE, MP_MAX_VALUE)
+
+/* === Public data type declarations =========================================================== */
+
+/**
+ * @brief Tipo del campo de un canal.
+ */
+typedef enum {
+    PDA_CHANNEL_F32 = 0, /**< float, concentración de MP. */
+    PDA_CHANNEL_U16,     /**< uint16_t, conteo de partículas. */
+    PDA_CHANNEL_U32      /**< uint32_t, conteo de partículas. */
+} PdaChannelType;
+
+/**
+ * @brief Canal de una trama.
+ */
+typedef struct {
+    size_t offset;       /**< Desplazamiento del campo dentro de la trama, en bytes. */
+    PdaChannelType type; /**< Tipo del campo. */
+    double minValue;     /**< Límite inferior del rango válido, excluido. */
+    double maxValue;     /**< Límite superior del rango válido, excluido. */
+} PdaChannel;
+
+/* === Public variable declarations ============================================================ */
+
+/* === Public function declarations ============================================================ */
+
+/**
+ * @brief Variante de computeParticulateStats para un canal float con separación stride.
+ *
+ * @param data Primer dato del canal.
+ * @param n_data Número de datos del canal.
+ * @param stride Distancia en bytes entre datos consecutivos; sizeof(float) para un array.
+ * @param minValue Límite inferior del rango válido, excluido (MP_MIN_VALUE para MP).
+ * @param maxValue Límite superior del rango válido, excluido (MP_MAX_VALUE para MP).
+ * @param stats Estructura donde se almacenan los resultados.
+ * @return Verdadero si hay al menos un dato válido; falso en caso contrario.
+ */
+bool computeParticulateStatsStrided(const float * data, size_t n_data, size_t stride,
+                                    double minValue, double maxValue, PdaStats * stats);
+
+/**
+ * @brief Calcula las estadísticas de varios canales intercalados en una sola pasada.
+ *
+ * @param frames Primera trama.
+ * @param n_frames Número de tramas.
+ * @param frameSize Tamaño de cada trama en bytes (sizeof de la estructura).
+ * @param channels Descripción de los canales.
+ * @param n_channels Número de canales, entre 1 y PDA_FRAME_MAX_CHANNELS.
+ * @param stats Array de n_channels estructuras, una por canal.
+ * @return Verdadero si los argumentos son válidos y se completó stats; la presencia de datos
+ *         válidos en cada canal se informa en su validCount.
+ */
+bool computeFrameStats(const void * frames, size_t n_frames, size_t frameSize,
+                       const PdaChannel channels[], size_t n_channels, PdaStats stats[]);
+
+/* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PDAFRAME_H */
@@ -0,0 +1,321 @@
+/*
+ * Nombre del archivo: PdaInstrument.c
+ * Versión: 0.1
+ * Descripción:
+ *  Contadores opcionales de llamadas, datos recorridos, datos descartados y tiempo de las
+ *  funciones de estadísticas, por hilo y sin bloqueos.
+ *
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo bajo los términos de la
+ * Licencia Pública General GNU publicada por la Free Software Foundation, ya sea la versión 3 de la
+ * Licencia, o (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil, pero SIN NINGUNA GARANTÍA; sin
+ * siquiera la garantía implícita de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU junto con este programa.
+ * Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ */
+
+/**
+ * @file PdaInstrument.c
+ * @brief Implementación de los contadores por hilo.
+ *
+ * Cada hilo toma en su primera llamada un conjunto de contadores del arreglo threadSlots con un
+ * incremento atómico de slotCount. Como es su único escritor, lo actualiza con una lectura y una
+ * escritura relajadas, que en x86 y AArch64 son accesos comunes a memoria; la atomicidad solo
+ * garantiza que pdaInstrSnapshot no lea valores a medio escribir. El último conjunto lo comparten
+ * los hilos excedentes y se actualiza con sumas atómicas.
+ *
+ * El tiempo se acumula en las unidades del reloj (ciclos del TSC en x86). pdaInstrSnapshot
+ * calcula la frecuencia del reloj comparándolo con clock_gettime desde la primera llamada
+ * registrada y convierte el total a nanosegundos.
+ *
+ * Sin PDA_INSTRUMENT el archivo no define nada: PdaInstrument.h provee versiones en línea vacías.
+ */
+
+/* === Headers files inclusions =============================================================== */
+
+#define _POSIX_C_SOURCE 200809L // Para clock_gettime con -std=c11
+
+#include "PdaInstrument.h"
+
+#ifdef PDA_INSTRUMENT
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define PDA_INSTR_RDTSC 1
+#include <x86intrin.h> // Para __rdtsc
+#endif
+
+/* === Macros definitions ====================================================================== */
+
+/**
+ * @brief Nanosegundos por segundo.
+ */
+#define NS_PER_SECOND 1000000000ull
+
+/**
+ * @brief Índice de cada contador dentro de un conjunto.
+ */
+#define COUNTER_CALLS         0
+#define COUNTER_SCANNED       1
+#define COUNTER_REJECTED_LOW  2
+#define COUNTER_REJECTED_HIGH 3
+#define COUNTER_TICKS         4
+#define COUNTER_FIELDS        5
+
+/**
+ * @brief Índice del conjunto compartido por los hilos excedentes.
+ */
+#define SHARED_SLOT PDA_INSTR_MAX_THREADS
+
+/* === Private data type declarations ========================================================== */
+
+/**
+ * @brief Contadores de un hilo. Se alinean a 64 bytes para que dos hilos no compartan una línea
+ *        de caché.
+ */
+typedef struct {
+    _Alignas(64) _Atomic uint64_t counters[PDA_INSTR_FUNCTION_COUNT][COUNTER_FIELDS];
+} ThreadSlot;
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/**
+ * @brief Contadores de cada hilo, más el conjunto compartido.
+ */
+static ThreadSlot threadSlots[PDA_INSTR_MAX_THREADS + 1];
+
+/**
+ * @brief Cantidad de conjuntos asignados, incluidos los pedidos por hilos excedentes.
+ */
+static _Atomic uint32_t slotCount;
+
+/**
+ * @brief Conjunto del hilo actual, o NULL antes de su primera llamada.
+ */
+static _Thread_local ThreadSlot * threadSlot;
+
+/**
+ * @brief Reloj de la instrumentación y reloj monotónico al registrar la primera llamada.
+ */
+static _Atomic uint64_t originTicks;
+static _Atomic uint64_t originNs;
+
+/**
+ * @brief Nombres de las funciones, indexados por PdaInstrFunction.
+ */
+static const char * const functionNames[PDA_INSTR_FUNCTION_COUNT] = {
+    "calculateAverage", "findMaxValue", "findMinValue", "calculateStandardDeviation",
+    "computeParticulateStats"};
+
+/* === Private function implementation ========================================================= */
+
+/**
+ * @brief Lee el reloj monotónico en nanosegundos.
+ */
+static uint64_t monotonicNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * NS_PER_SECOND + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Lee el reloj de la instrumentación.
+ */
+static uint64_t readTicks(void) {
+#ifdef PDA_INSTR_RDTSC
+    return __rdtsc();
+#else
+    return monotonicNs();
+#endif
+}
+
+/**
+ * @brief Asigna un conjunto de contadores al hilo actual.
+ */
+static ThreadSlot * claimSlot(void) {
+    uint32_t index = atomic_fetch_add_explicit(&slotCount, 1, memory_order_relaxed);
+    if (index == 0) {
+        atomic_store_explicit(&originNs, monotonicNs(), memory_order_relaxed);
+        atomic_store_explicit(&originTicks, readTicks(), memory_order_release);
+    }
+    return &threadSlots[index < SHARED_SLOT ? index : SHARED_SLOT];
+}
+
+/**
+ * @brief Suma un valor a un contador; solo el conjunto compartido necesita una suma atómica.
+ */
+static void addCounter(ThreadSlot * slot, _Atomic uint64_t * counter, uint64_t value) {
+    if (slot == &threadSlots[SHARED_SLOT]) {
+        atomic_fetch_add_explicit(counter, value, memory_order_relaxed);
+        return;
+    }
+    uint64_t current = atomic_load_explicit(counter, memory_order_relaxed);
+    atomic_store_explicit(counter, current + value, memory_order_relaxed);
+}
+
+/**
+ * @brief Convierte unidades del reloj de la instrumentación a nanosegundos.
+ */
+static uint64_t ticksToNs(uint64_t ticks) {
+#ifdef PDA_INSTR_RDTSC
+    uint64_t origin = atomic_load_explicit(&originTicks, memory_order_acquire);
+    double elapsedTicks = (double)(readTicks() - origin);
+    double elapsedNs = (double)(monotonicNs() - atomic_load_explicit(&originNs,
+                                                                     memory_order_relaxed));
+    if (origin == 0 || elapsedTicks <= 0.0)
+        return 0;
+    return (uint64_t)((double)ticks * (elapsedNs / elapsedTicks));
+#else
+    return ticks;
+#endif
+}
+
+/* === Public function implementation ========================================================== */
+
+/**
+ * @brief Indica si la instrumentación está compilada (macro PDA_INSTRUMENT).
+ *
+ * @return Verdadero si las funciones de la API registran sus llamadas.
+ */
+bool pdaInstrEnabled(void) {
+    return true;
+}
+
+/**
+ * @brief Suma los contadores de todos los hilos.
+ *
+ * @param snapshot Estructura donde se almacena la instantánea.
+ */
+void pdaInstrSnapshot(PdaInstrSnapshot * snapshot) {
+    if (snapshot == NULL)
+        return;
+    memset(snapshot, 0, sizeof(*snapshot));
+    uint32_t slots = atomic_load_explicit(&slotCount, memory_order_relaxed);
+    snapshot->threads = slots;
+    if (slots > SHARED_SLOT + 1)
+        slots = SHARED_SLOT + 1;
+
+    uint64_t ticks[PDA_INSTR_FUNCTION_COUNT] = {0};
+    for (uint32_t s = 0; s < slots; s++) {
+        for (int f = 0; f < PDA_INSTR_FUNCTION_COUNT; f++) {
+            _Atomic uint64_t * c = threadSlots[s].counters[f];
+            PdaInstrCounters * out = &snapshot->functions[f];
+            out->calls += atomic_load_explicit(&c[COUNTER_CALLS], memory_order_relaxed);
+            out->scanned += atomic_load_explicit(&c[COUNTER_SCANNED], memory_order_relaxed);
+            out->rejectedLow +=
+                atomic_load_explicit(&c[COUNTER_REJECTED_LOW], memory_order_relaxed);
+            out->rejectedHigh +=
+                atomic_load_explicit(&c[COUNTER_REJECTED_HIGH], memory_order_relaxed);
+            ticks[f] += atomic_load_explicit(&c[COUNTER_TICKS], memory_order_relaxed);
+        }
+    }
+    for (int f = 0; f < PDA_INSTR_FUNCTION_COUNT; f++)
+        snapshot->functions[f].nanoseconds = ticksToNs(ticks[f]);
+}
+
+/**
+ * @brief Exporta una instantánea como un objeto JSON, con la semántica de snprintf.
+ *
+ * @param snapshot Instantánea a exportar.
+ * @param buffer Buffer donde se escribe el texto, terminado en cero si size es mayor que cero.
+ * @param size Tamaño del buffer en bytes.
+ * @return Largo del texto completo sin el terminador; si es mayor o igual que size, el texto se
+ *         truncó.
+ */
+size_t pdaInstrExportJson(const PdaInstrSnapshot * snapshot, char * buffer, size_t size) {
+    if (snapshot == NULL)
+        return 0;
+    if (buffer == NULL)
+        size = 0;
+    size_t length = 0;
+    int written = snprintf(buffer, size, "{\"enabled\": %s, \"threads\": %u, \"functions\": {",
+                           pdaInstrEnabled() ? "true" : "false", (unsigned)snapshot->threads);
+    for (int f = 0; f < PDA_INSTR_FUNCTION_COUNT && written >= 0; f++) {
+        length += (size_t)written;
+        const PdaInstrCounters * c = &snapshot->functions[f];
+        char * tail = (length < size) ? buffer + length : NULL;
+        size_t room = (length < size) ? size - length : 0;
+        written = snprintf(tail, room,
+                           "%s\"%s\": {\"calls\": %llu, \"scanned\": %llu, \"rejectedLow\": %llu, "
+                           "\"rejectedHigh\": %llu, \"nanoseconds\": %llu}",
+                           f ? ", " : "", functionNames[f], (unsigned long long)c->calls,
+                           (unsigned long long)c->scanned, (unsigned long long)c->rejectedLow,
+                           (unsigned long long)c->rejectedHigh,
+                           (unsigned long long)c->nanoseconds);
+    }
+    if (written < 0)
+        return 0;
+    length += (size_t)written;
+    written = snprintf((length < size) ? buffer + length : NULL,
+                       (length < size) ? size - length : 0, "}}");
+    return length + (size_t)(written < 0 ? 0 : written);
+}
+
+/**
+ * @brief Retorna el nombre de una función instrumentada.
+ *
+ * @param function Función a consultar.
+ * @return Nombre de la función o "unknown" si el identificador no es válido.
+ */
+const char * pdaInstrFunctionName(PdaInstrFunction function) {
+    if ((unsigned)function >= PDA_INSTR_FUNCTION_COUNT)
+        return "unknown";
+    return functionNames[function];
+}
+
+/**
+ * @brief Lee el reloj de la instrumentación al comenzar una llamada.
+ *
+ * @return Marca de tiempo a pasar a pdaInstrRecord.
+ */
+uint64_t pdaInstrStart(void) {
+    return readTicks();
+}
+
+/**
+ * @brief Registra una llamada en los contadores del hilo actual.
+ *
+ * @param function Función instrumentada.
+ * @param start Marca de tiempo retornada por pdaInstrStart.
+ * @param scanned Datos recorridos.
+ * @param rejectedLow Datos descartados por debajo del mínimo o NaN.
+ * @param rejectedHigh Datos descartados por encima del máximo.
+ */
+void pdaInstrRecord(PdaInstrFunction function, uint64_t start, size_t scanned,
+                    size_t rejectedLow, size_t rejectedHigh) {
+    uint64_t elapsed = readTicks() - start;
+    if ((unsigned)function >= PDA_INSTR_FUNCTION_COUNT)
+        return;
+    ThreadSlot * slot = threadSlot;
+    if (slot == NULL)
+        slot = threadSlot = claimSlot();
+    _Atomic uint64_t * c = slot->counters[function];
+    addCounter(slot, &c[COUNTER_CALLS], 1);
+    addCounter(slot, &c[COUNTER_SCANNED], scanned);
+    addCounter(slot, &c[COUNTER_REJECTED_LOW], rejectedLow);
+    addCounter(slot, &c[COUNTER_REJECTED_HIGH], rejectedHigh);
+    addCounter(slot, &c[COUNTER_TICKS], elapsed);
+}
+
+#endif /* PDA_INSTRUMENT */
+
+/* === End of documentation ==================================================================== */
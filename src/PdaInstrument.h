@@ -0,0 +1,226 @@
+/*
+ * Nombre del archivo: PdaInstrument.h
+ * Versión: 0.1
+ * Descripción:
+ *  Contadores opcionales de llamadas, datos recorridos, datos descartados y tiempo de las
+ *  funciones de estadísticas, por hilo y sin bloqueos.
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifndef PDAINSTRUMENT_H
+#define PDAINSTRUMENT_H
+
+/**
+ * @file PdaInstrument.h
+ * @brief Instrumentación de las funciones de ParticulateDataAnalyzer.h.
+ *
+ * - pdaInstrEnabled: Indica si la instrumentación está compilada.
+ * - pdaInstrSnapshot: Suma los contadores de todos los hilos.
+ * - pdaInstrExportJson: Exporta una instantánea como JSON.
+ * - pdaInstrFunctionName: Nombre de cada función instrumentada.
+ * - pdaInstrStart / pdaInstrRecord: Registro de una llamada, para los módulos instrumentados.
+ *
+ * La instrumentación se compila solo con la macro PDA_INSTRUMENT definida en todo el proyecto
+ * (por ejemplo, -DPDA_INSTRUMENT). Sin ella PdaInstrument.c queda vacío (sin contadores, memoria
+ * por hilo ni operaciones atómicas de 64 bits), las funciones de la API no llaman a este módulo,
+ * la reducción no cuenta los descartes y las funciones de este archivo son versiones en línea
+ * vacías: pdaInstrSnapshot retorna todos los contadores en cero, pdaInstrExportJson escribe un
+ * texto vacío y pdaInstrFunctionName retorna "unknown".
+ *
+ * Para cada función se cuentan las llamadas, los datos recorridos, los datos descartados por
+ * maskIsDataTrue separados en bajos (menores o iguales que MP_MIN_VALUE, o NaN) y altos (mayores
+ * o iguales que MP_MAX_VALUE) y el tiempo acumulado. Las variantes 64 comparten el contador de
+ * la función clásica correspondiente. La separación de los descartes se obtiene de la misma
+ * comparación con la que los núcleos validan cada dato, sin recorrer el array otra vez.
+ *
+ * Cada hilo escribe solo en sus propios contadores (hasta PDA_INSTR_MAX_THREADS hilos), con
+ * lecturas y escrituras atómicas relajadas y sin instrucciones de bloqueo; los hilos que exceden
+ * ese límite comparten un último conjunto de contadores con sumas atómicas. Los contadores de un
+ * hilo que termina se conservan. pdaInstrSnapshot puede llamarse desde cualquier hilo en
+ * cualquier momento; para medir un intervalo se restan dos instantáneas.
+ *
+ * El tiempo se mide con rdtsc en x86 y se convierte a nanosegundos al tomar la instantánea; en
+ * otras arquitecturas se usa clock_gettime.
+ *
+ * Costo: dos lecturas del reloj y cinco contadores por llamada (de 15 ns en hardware a unos
+ * 100 ns en una máquina virtual, donde rdtsc es más lento), más una comparación por vector en los
+ * núcleos. Con datos que no están en caché el costo por dato queda oculto por el acceso a memoria
+ * y el total es menor que el 2% desde unos 50000 datos por llamada; con datos en L1/L2 la
+ * comparación adicional cuesta entre 4% y 10% según el núcleo (medido con make bench).
+ */
+
+/* === Headers files inclusions ================================================================ */
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+/**
+ * @brief Cantidad de hilos con contadores propios.
+ */
+#define PDA_INSTR_MAX_THREADS 64
+
+/* === Public data type declarations =========================================================== */
+
+/**
+ * @brief Funciones instrumentadas.
+ */
+typedef enum {
+    PDA_INSTR_CALCULATE_AVERAGE = 0,        /**< calculateAverage y calculateAverage64. */
+    PDA_INSTR_FIND_MAX_VALUE,               /**< findMaxValue y findMaxValue64. */
+    PDA_INSTR_FIND_MIN_VALUE,               /**< findMinValue y findMinValue64. */
+    PDA_INSTR_CALCULATE_STANDARD_DEVIATION, /**< calculateStandardDeviation y su variante 64. */
+    PDA_INSTR_COMPUTE_PARTICULATE_STATS,    /**< computeParticulateStats. */
+    PDA_INSTR_FUNCTION_COUNT                /**< Cantidad de funciones instrumentadas. */
+} PdaInstrFunction;
+
+/**
+ * @brief Contadores acumulados de una función.
+ */
+typedef struct {
+    uint64_t calls;        /**< Cantidad de llamadas. */
+    uint64_t scanned;      /**< Datos recorridos. */
+    uint64_t rejectedLow;  /**< Datos descartados por ser menores o iguales que el mínimo o NaN. */
+    uint64_t rejectedHigh; /**< Datos descartados por ser mayores o iguales que el máximo. */
+    uint64_t nanoseconds;  /**< Tiempo acumulado dentro de la función. */
+} PdaInstrCounters;
+
+/**
+ * @brief Suma de los contadores de todos los hilos.
+ */
+typedef struct {
+    PdaInstrCounters functions[PDA_INSTR_FUNCTION_COUNT]; /**< Contadores por función. */
+    uint32_t threads; /**< Cantidad de hilos que registraron al menos una llamada. */
+} PdaInstrSnapshot;
+
+/* === Public variable declarations ============================================================ */
+
+/* === Public function declarations ============================================================ */
+
+#ifdef PDA_INSTRUMENT
+
+/**
+ * @brief Indica si la instrumentación está compilada (macro PDA_INSTRUMENT).
+ *
+ * @return Verdadero si las funciones de la API registran sus llamadas.
+ */
+bool pdaInstrEnabled(void);
+
+/**
+ * @brief Suma los contadores de todos los hilos.
+ *
+ * @param snapshot Estructura donde se almacena la instantánea.
+ */
+void pdaInstrSnapshot(PdaInstrSnapshot * snapshot);
+
+/**
+ * @brief Exporta una instantánea como un objeto JSON, con la semántica de snprintf.
+ *
+ * @param snapshot Instantánea a exportar.
+ * @param buffer Buffer donde se escribe el texto, terminado en cero si size es mayor que cero.
+ * @param size Tamaño del buffer en bytes.
+ * @return Largo del texto completo sin el terminador; si es mayor o igual que size, el texto se
+ *         truncó.
+ */
+size_t pdaInstrExportJson(const PdaInstrSnapshot * snapshot, char * buffer, size_t size);
+
+/**
+ * @brief Retorna el nombre de una función instrumentada.
+ *
+ * @param function Función a consultar.
+ * @return Nombre de la función o "unknown" si el identificador no es válido.
+ */
+const char * pdaInstrFunctionName(PdaInstrFunction function);
+
+/**
+ * @brief Lee el reloj de la instrumentación al comenzar una llamada.
+ *
+ * @return Marca de tiempo a pasar a pdaInstrRecord.
+ */
+uint64_t pdaInstrStart(void);
+
+/**
+ * @brief Registra una llamada en los contadores del hilo actual.
+ *
+ * @param function Función instrumentada.
+ * @param start Marca de tiempo retornada por pdaInstrStart.
+ * @param scanned Datos recorridos.
+ * @param rejectedLow Datos descartados por debajo del mínimo o NaN.
+ * @param rejectedHigh Datos descartados por encima del máximo.
+ */
+void pdaInstrRecord(PdaInstrFunction function, uint64_t start, size_t scanned,
+                    size_t rejectedLow, size_t rejectedHigh);
+
+#else
+
+static inline bool pdaInstrEnabled(void) {
+    return false;
+}
+
+static inline void pdaInstrSnapshot(PdaInstrSnapshot * snapshot) {
+    PdaInstrSnapshot empty = {0};
+    if (snapshot != NULL)
+        *snapshot = empty;
+}
+
+static inline size_t pdaInstrExportJson(const PdaInstrSnapshot * snapshot, char * buffer,
+                                        size_t size) {
+    (void)snapshot;
+    if (buffer != NULL && size > 0)
+        buffer[0] = '\0';
+    return 0;
+}
+
+static inline const char * pdaInstrFunctionName(PdaInstrFunction function) {
+    (void)function;
+    return "unknown";
+}
+
+static inline uint64_t pdaInstrStart(void) {
+    return 0;
+}
+
+static inline void pdaInstrRecord(PdaInstrFunction function, uint64_t start, size_t scanned,
+                                  size_t rejectedLow, size_t rejectedHigh) {
+    (void)function;
+    (void)start;
+    (void)scanned;
+    (void)rejectedLow;
+    (void)rejectedHigh;
+}
+
+#endif /* PDA_INSTRUMENT */
+
+/* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PDAINSTRUMENT_H */
@@ -0,0 +1,911 @@
+/*
+ * Nombre del archivo: PdaKernels.c
+ * Versión: 0.1
+ * Descripción:
+ *  Núcleos de reducción vectorizados (SSE2, AVX2, AVX-512 y NEON) con selección en tiempo de
+ *  ejecución para el análisis de datos de material particulado.
+ *
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo bajo los términos de la
+ * Licencia Pública General GNU publicada por la Free Software Foundation, ya sea la versión 3 de la
+ * Licencia, o (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil, pero SIN NINGUNA GARANTÍA; sin
+ * siquiera la garantía implícita de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU junto con este programa.
+ * Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ */
+
+/**
+ * @file PdaKernels.c
+ * @brief Implementación de los núcleos de reducción enmascarada y su selección por CPU.
+ *
+ * Los núcleos vectoriales convierten cada dato a doble precisión y evalúan el rango válido con
+ * comparaciones ordenadas en doble precisión, exactamente igual que maskIsDataTrue (que promueve
+ * el dato a double al compararlo con MP_MIN_VALUE). Así los valores NaN, infinitos y los bordes
+ * del rango se clasifican igual que en el núcleo escalar.
+ *
+ * Los núcleos x86 se compilan con atributos target de GCC/Clang, por lo que no requieren
+ * opciones -m adicionales; la selección se realiza con __builtin_cpu_supports (CPUID).
+ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "PdaKernels.h"
+#include "ParticulateDataAnalyzer.h"
+#include "PdaQuantized.h"
+#include <math.h> // Para INFINITY
+#include <stdatomic.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define PDA_HAVE_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define PDA_HAVE_NEON_KERNEL 1
+#include <arm_neon.h>
+#endif
+
+/* === Macros definitions ====================================================================== */
+
+/**
+ * @brief valor inicial de contador de datos
+ */
+#define INI_VALID_COUNT 0
+
+/**
+ * @brief valor inicial para sumas
+ */
+#define INI_SUM 0.0
+
+/**
+ * @brief Cantidad de datos procesados por iteración en cada núcleo vectorial.
+ */
+#define SSE2_STEP   4
+#define AVX2_STEP   8
+#define AVX512_STEP 16
+#define NEON_STEP   4
+
+/**
+ * @brief Cantidad de códigos procesados por iteración en cada núcleo entero.
+ */
+#define SSE2_Q16_STEP 8
+#define AVX2_Q16_STEP 16
+#define NEON_Q16_STEP 8
+
+/**
+ * @brief Iteraciones que los núcleos enteros acumulan en 32 bits antes de pasar a 64 bits.
+ *
+ * Cada carril de 32 bits suma a lo sumo dos cuadrados por iteración (2 * 4999^2 < 5e7), de modo
+ * que 32 iteraciones quedan por debajo de 2^31.
+ */
+#define Q16_CHUNK_STEPS 32
+
+/* === Private data type declarations ========================================================== */
+
+/**
+ * @brief Firma común de todos los núcleos de reducción.
+ */
+typedef void (*PdaReduceFn)(const float * data, size_t n_data, double shift, PdaReduction * out);
+
+/**
+ * @brief Firma común de todos los núcleos de reducción de datos cuantizados.
+ */
+typedef void (*PdaReduceQ16Fn)(const uint16_t * codes, size_t n_data, PdaReductionQ16 * out);
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+static void reduceScalar(const float * data, size_t n_data, double shift, PdaReduction * out);
+static void reduceQ16Scalar(const uint16_t * codes, size_t n_data, PdaReductionQ16 * out);
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/**
+ * @brief Identificador del núcleo activo, o PDA_KERNEL_COUNT hasta la primera selección. Es
+ *        atómico porque los hilos de PdaParallel lo leen mientras otro puede estar eligiéndolo.
+ */
+static _Atomic int activeKernel = PDA_KERNEL_COUNT;
+
+/**
+ * @brief Nombres legibles de los núcleos, indexados por PdaKernelId.
+ */
+static const char * const kernelNames[PDA_KERNEL_COUNT] = {"scalar", "sse2", "avx2", "avx512",
+                                                           "neon"};
+
+/* === Private function implementation ========================================================= */
+
+/**
+ * @brief Núcleo escalar de referencia.
+ *
+ * @param data Array de datos flotantes.
+ * @param n_data Número de elementos en el array.
+ * @param shift Valor de referencia restado a cada dato.
+ * @param out Estructura donde se almacena el resultado.
+ */
+static void reduceScalar(const float * data, size_t n_data, double shift, PdaReduction * out) {
+    size_t validCount = INI_VALID_COUNT;
+    double sum = INI_SUM;
+    double sumOfSquares = INI_SUM;
+    float min = INFINITY;
+    float max = -INFINITY;
+#ifdef PDA_INSTRUMENT
+    size_t aboveMinCount = INI_VALID_COUNT;
+#endif
+
+    for (size_t i = 0; i < n_data; i++) {
+        float value = data[i];
+#ifdef PDA_INSTRUMENT
+        aboveMinCount += value > MP_MIN_VALUE;
+#endif
+        if (maskIsDataTrue(value)) {
+            double delta = (double)value - shift;
+            sum += delta;
+            sumOfSquares += delta * delta;
+            if (value < min)
+                min = value;
+            if (value > max)
+                max = value;
+            validCount++;
+        }
+    }
+
+    out->validCount = validCount;
+    out->sum = sum;
+    out->sumOfSquares = sumOfSquares;
+    out->min = min;
+    out->max = max;
+#ifdef PDA_INSTRUMENT
+    out->aboveMinCount = aboveMinCount;
+#endif
+}
+
+/**
+ * @brief Agrega al resultado de un núcleo vectorial los datos finales que no completan un bloque.
+ *
+ * @param data Inicio de los datos restantes.
+ * @param n_data Número de datos restantes.
+ * @param shift Valor de referencia restado a cada dato.
+ * @param out Resultado parcial a completar.
+ */
+static void reduceTail(const float * data, size_t n_data, double shift, PdaReduction * out) {
+    PdaReduction tail;
+    reduceScalar(data, n_data, shift, &tail);
+    out->validCount += tail.validCount;
+#ifdef PDA_INSTRUMENT
+    out->aboveMinCount += tail.aboveMinCount;
+#endif
+    out->sum += tail.sum;
+    out->sumOfSquares += tail.sumOfSquares;
+    if (tail.min < out->min)
+        out->min = tail.min;
+    if (tail.max > out->max)
+        out->max = tail.max;
+}
+
+/**
+ * @brief Núcleo escalar de referencia para datos cuantizados.
+ *
+ * @param codes Array de datos cuantizados.
+ * @param n_data Número de elementos en el array.
+ * @param out Estructura donde se almacena el resultado.
+ */
+static void reduceQ16Scalar(const uint16_t * codes, size_t n_data, PdaReductionQ16 * out) {
+    size_t validCount = INI_VALID_COUNT;
+    uint64_t sum = 0;
+    uint64_t sumOfSquares = 0;
+    uint16_t min = UINT16_MAX;
+    uint16_t max = 0;
+
+    for (size_t i = 0; i < n_data; i++) {
+        uint16_t code = codes[i];
+        if (pdaQ16IsValid(code)) {
+            sum += code;
+            sumOfSquares += (uint64_t)code * code;
+            if (code < min)
+                min = code;
+            if (code > max)
+                max = code;
+            validCount++;
+        }
+    }
+
+    out->validCount = validCount;
+    out->sum = sum;
+    out->sumOfSquares = sumOfSquares;
+    out->min = min;
+    out->max = max;
+}
+
+/**
+ * @brief Agrega al resultado de un núcleo entero los códigos finales que no completan un bloque.
+ *
+ * @param codes Inicio de los códigos restantes.
+ * @param n_data Número de códigos restantes.
+ * @param out Resultado parcial a completar.
+ */
+static void reduceQ16Tail(const uint16_t * codes, size_t n_data, PdaReductionQ16 * out) {
+    PdaReductionQ16 tail;
+    reduceQ16Scalar(codes, n_data, &tail);
+    out->validCount += tail.validCount;
+    out->sum += tail.sum;
+    out->sumOfSquares += tail.sumOfSquares;
+    if (tail.min < out->min)
+        out->min = tail.min;
+    if (tail.max > out->max)
+        out->max = tail.max;
+}
+
+#ifdef PDA_HAVE_X86_KERNELS
+
+/**
+ * @brief Núcleo SSE2: procesa 4 datos por iteración en dos vectores de 2 doubles.
+ */
+__attribute__((target("sse2"))) static void reduceSse2(const float * data, size_t n_data,
+                                                       double shift, PdaReduction * out) {
+    const __m128d lo = _mm_set1_pd(MP_MIN_VALUE);
+    const __m128d hi = _mm_set1_pd(MP_MAX_VALUE);
+    const __m128d ref = _mm_set1_pd(shift);
+    const __m128d posInf = _mm_set1_pd(INFINITY);
+    const __m128d negInf = _mm_set1_pd(-INFINITY);
+    __m128d sumA = _mm_setzero_pd(), sumB = _mm_setzero_pd();
+    __m128d sqA = _mm_setzero_pd(), sqB = _mm_setzero_pd();
+    __m128d minV = posInf, maxV = negInf;
+    __m128i count = _mm_setzero_si128();
+#ifdef PDA_INSTRUMENT
+    __m128i aboveMin = _mm_setzero_si128();
+#endif
+    size_t i = 0;
+
+    for (; i + SSE2_STEP <= n_data; i += SSE2_STEP) {
+        __m128 v = _mm_loadu_ps(data + i);
+        __m128d a = _mm_cvtps_pd(v);
+        __m128d b = _mm_cvtps_pd(_mm_movehl_ps(v, v));
+        __m128d ma = _mm_and_pd(_mm_cmpgt_pd(a, lo), _mm_cmplt_pd(a, hi));
+        __m128d mb = _mm_and_pd(_mm_cmpgt_pd(b, lo), _mm_cmplt_pd(b, hi));
+        __m128d da = _mm_and_pd(_mm_sub_pd(a, ref), ma);
+        __m128d db = _mm_and_pd(_mm_sub_pd(b, ref), mb);
+        sumA = _mm_add_pd(sumA, da);
+        sumB = _mm_add_pd(sumB, db);
+        sqA = _mm_add_pd(sqA, _mm_mul_pd(da, da));
+        sqB = _mm_add_pd(sqB, _mm_mul_pd(db, db));
+        minV = _mm_min_pd(minV, _mm_or_pd(_mm_and_pd(ma, a), _mm_andnot_pd(ma, posInf)));
+        minV = _mm_min_pd(minV, _mm_or_pd(_mm_and_pd(mb, b), _mm_andnot_pd(mb, posInf)));
+        maxV = _mm_max_pd(maxV, _mm_or_pd(_mm_and_pd(ma, a), _mm_andnot_pd(ma, negInf)));
+        maxV = _mm_max_pd(maxV, _mm_or_pd(_mm_and_pd(mb, b), _mm_andnot_pd(mb, negInf)));
+        // cada carril válido vale -1 en la máscara, por lo que restarla incrementa el contador
+        count = _mm_sub_epi64(count, _mm_castpd_si128(ma));
+        count = _mm_sub_epi64(count, _mm_castpd_si128(mb));
+#ifdef PDA_INSTRUMENT
+        aboveMin = _mm_sub_epi64(aboveMin, _mm_castpd_si128(_mm_cmpgt_pd(a, lo)));
+        aboveMin = _mm_sub_epi64(aboveMin, _mm_castpd_si128(_mm_cmpgt_pd(b, lo)));
+#endif
+    }
+
+    double sums[2], squares[2], mins[2], maxs[2];
+    uint64_t counts[2];
+    _mm_storeu_pd(sums, _mm_add_pd(sumA, sumB));
+    _mm_storeu_pd(squares, _mm_add_pd(sqA, sqB));
+    _mm_storeu_pd(mins, minV);
+    _mm_storeu_pd(maxs, maxV);
+    _mm_storeu_si128((__m128i *)counts, count);
+
+    out->validCount = (size_t)(counts[0] + counts[1]);
+#ifdef PDA_INSTRUMENT
+    _mm_storeu_si128((__m128i *)counts, aboveMin);
+    out->aboveMinCount = (size_t)(counts[0] + counts[1]);
+#endif
+    out->sum = sums[0] + sums[1];
+    out->sumOfSquares = squares[0] + squares[1];
+    out->min = (float)(mins[0] < mins[1] ? mins[0] : mins[1]);
+    out->max = (float)(maxs[0] > maxs[1] ? maxs[0] : maxs[1]);
+    reduceTail(data + i, n_data - i, shift, out);
+}
+
+/**
+ * @brief Núcleo AVX2: procesa 8 datos por iteración en dos vectores de 4 doubles.
+ */
+__attribute__((target("avx2"))) static void reduceAvx2(const float * data, size_t n_data,
+                                                       double shift, PdaReduction * out) {
+    const __m256d lo = _mm256_set1_pd(MP_MIN_VALUE);
+    const __m256d hi = _mm256_set1_pd(MP_MAX_VALUE);
+    const __m256d ref = _mm256_set1_pd(shift);
+    const __m256d posInf = _mm256_set1_pd(INFINITY);
+    const __m256d negInf = _mm256_set1_pd(-INFINITY);
+    __m256d sumA = _mm256_setzero_pd(), sumB = _mm256_setzero_pd();
+    __m256d sqA = _mm256_setzero_pd(), sqB = _mm256_setzero_pd();
+    __m256d minV = posInf, maxV = negInf;
+    __m256i count = _mm256_setzero_si256();
+#ifdef PDA_INSTRUMENT
+    __m256i aboveMin = _mm256_setzero_si256();
+#endif
+    size_t i = 0;
+
+    for (; i + AVX2_STEP <= n_data; i += AVX2_STEP) {
+        __m256 v = _mm256_loadu_ps(data + i);
+        __m256d a = _mm256_cvtps_pd(_mm256_castps256_ps128(v));
+        __m256d b = _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1));
+        __m256d ma = _mm256_and_pd(_mm256_cmp_pd(a, lo, _CMP_GT_OQ),
+                                   _mm256_cmp_pd(a, hi, _CMP_LT_OQ));
+        __m256d mb = _mm256_and_pd(_mm256_cmp_pd(b, lo, _CMP_GT_OQ),
+                                   _mm256_cmp_pd(b, hi, _CMP_LT_OQ));
+        __m256d da = _mm256_and_pd(_mm256_sub_pd(a, ref), ma);
+        __m256d db = _mm256_and_pd(_mm256_sub_pd(b, ref), mb);
+        sumA = _mm256_add_pd(sumA, da);
+        sumB = _mm256_add_pd(sumB, db);
+        sqA = _mm256_add_pd(sqA, _mm256_mul_pd(da, da));
+        sqB = _mm256_add_pd(sqB, _mm256_mul_pd(db, db));
+        minV = _mm256_min_pd(minV, _mm256_blendv_pd(posInf, a, ma));
+        minV = _mm256_min_pd(minV, _mm256_blendv_pd(posInf, b, mb));
+        maxV = _mm256_max_pd(maxV, _mm256_blendv_pd(negInf, a, ma));
+        maxV = _mm256_max_pd(maxV, _mm256_blendv_pd(negInf, b, mb));
+        count = _mm256_sub_epi64(count, _mm256_castpd_si256(ma));
+        count = _mm256_sub_epi64(count, _mm256_castpd_si256(mb));
+#ifdef PDA_INSTRUMENT
+        aboveMin = _mm256_sub_epi64(aboveMin,
+                                    _mm256_castpd_si256(_mm256_cmp_pd(a, lo, _CMP_GT_OQ)));
+        aboveMin = _mm256_sub_epi64(aboveMin,
+                                    _mm256_castpd_si256(_mm256_cmp_pd(b, lo, _CMP_GT_OQ)));
+#endif
+    }
+
+    double sums[4], squares[4], mins[4], maxs[4];
+    uint64_t counts[4];
+    _mm256_storeu_pd(sums, _mm256_add_pd(sumA, sumB));
+    _mm256_storeu_pd(squares, _mm256_add_pd(sqA, sqB));
+    _mm256_storeu_pd(mins, minV);
+    _mm256_storeu_pd(maxs, maxV);
+    _mm256_storeu_si256((__m256i *)counts, count);
+
+    out->validCount = (size_t)(counts[0] + counts[1] + counts[2] + counts[3]);
+#ifdef PDA_INSTRUMENT
+    _mm256_storeu_si256((__m256i *)counts, aboveMin);
+    out->aboveMinCount = (size_t)(counts[0] + counts[1] + counts[2] + counts[3]);
+#endif
+    out->sum = (sums[0] + sums[1]) + (sums[2] + sums[3]);
+    out->sumOfSquares = (squares[0] + squares[1]) + (squares[2] + squares[3]);
+    double min = mins[0], max = maxs[0];
+    for (int lane = 1; lane < 4; lane++) {
+        if (mins[lane] < min)
+            min = mins[lane];
+        if (maxs[lane] > max)
+            max = maxs[lane];
+    }
+    out->min = (float)min;
+    out->max = (float)max;
+    reduceTail(data + i, n_data - i, shift, out);
+}
+
+/**
+ * @brief Núcleo AVX-512: procesa 16 datos por iteración con registros de máscara.
+ */
+__attribute__((target("avx512f"))) static void reduceAvx512(const float * data, size_t n_data,
+                                                            double shift, PdaReduction * out) {
+    const __m512d lo = _mm512_set1_pd(MP_MIN_VALUE);
+    const __m512d hi = _mm512_set1_pd(MP_MAX_VALUE);
+    const __m512d ref = _mm512_set1_pd(shift);
+    __m512d sumA = _mm512_setzero_pd(), sumB = _mm512_setzero_pd();
+    __m512d sqA = _mm512_setzero_pd(), sqB = _mm512_setzero_pd();
+    __m512d minV = _mm512_set1_pd(INFINITY), maxV = _mm512_set1_pd(-INFINITY);
+    size_t validCount = INI_VALID_COUNT;
+#ifdef PDA_INSTRUMENT
+    const __m512i one = _mm512_set1_epi64(1);
+    __m512i aboveMin = _mm512_setzero_si512();
+#endif
+    size_t i = 0;
+
+    for (; i + AVX512_STEP <= n_data; i += AVX512_STEP) {
+        __m512 v = _mm512_loadu_ps(data + i);
+        __m512d a = _mm512_cvtps_pd(_mm512_castps512_ps256(v));
+        __m512d b = _mm512_cvtps_pd(
+            _mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(v), 1)));
+        __mmask8 ma = _mm512_cmp_pd_mask(a, lo, _CMP_GT_OQ) & _mm512_cmp_pd_mask(a, hi, _CMP_LT_OQ);
+        __mmask8 mb = _mm512_cmp_pd_mask(b, lo, _CMP_GT_OQ) & _mm512_cmp_pd_mask(b, hi, _CMP_LT_OQ);
+        __m512d da = _mm512_maskz_sub_pd(ma, a, ref);
+        __m512d db = _mm512_maskz_sub_pd(mb, b, ref);
+        sumA = _mm512_add_pd(sumA, da);
+        sumB = _mm512_add_pd(sumB, db);
+        sqA = _mm512_add_pd(sqA, _mm512_mul_pd(da, da));
+        sqB = _mm512_add_pd(sqB, _mm512_mul_pd(db, db));
+        minV = _mm512_mask_min_pd(minV, ma, minV, a);
+        minV = _mm512_mask_min_pd(minV, mb, minV, b);
+        maxV = _mm512_mask_max_pd(maxV, ma, maxV, a);
+        maxV = _mm512_mask_max_pd(maxV, mb, maxV, b);
+        validCount += (size_t)__builtin_popcount((unsigned)ma | ((unsigned)mb << 8));
+#ifdef PDA_INSTRUMENT
+        aboveMin = _mm512_mask_add_epi64(aboveMin, _mm512_cmp_pd_mask(a, lo, _CMP_GT_OQ), aboveMin,
+                                         one);
+        aboveMin = _mm512_mask_add_epi64(aboveMin, _mm512_cmp_pd_mask(b, lo, _CMP_GT_OQ), aboveMin,
+                                         one);
+#endif
+    }
+
+    out->validCount = validCount;
+#ifdef PDA_INSTRUMENT
+    out->aboveMinCount = (size_t)_mm512_reduce_add_epi64(aboveMin);
+#endif
+    out->sum = _mm512_reduce_add_pd(_mm512_add_pd(sumA, sumB));
+    out->sumOfSquares = _mm512_reduce_add_pd(_mm512_add_pd(sqA, sqB));
+    out->min = (float)_mm512_reduce_min_pd(minV);
+    out->max = (float)_mm512_reduce_max_pd(maxV);
+    reduceTail(data + i, n_data - i, shift, out);
+}
+
+/**
+ * @brief Núcleo entero SSE2: procesa 8 códigos por iteración.
+ *
+ * Los códigos válidos caben en int16_t, por lo que el rango se evalúa con comparaciones con
+ * signo (los códigos mayores que INT16_MAX quedan negativos y fuera del rango) y el mínimo y el
+ * máximo con _mm_min_epi16 y _mm_max_epi16. Las sumas se acumulan con _mm_madd_epi16 en 32 bits
+ * y se pasan a 64 bits cada Q16_CHUNK_STEPS iteraciones.
+ */
+__attribute__((target("sse2"))) static void reduceQ16Sse2(const uint16_t * codes, size_t n_data,
+                                                          PdaReductionQ16 * out) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ones = _mm_set1_epi16(1);
+    const __m128i limit = _mm_set1_epi16(PDA_Q16_MAX + 1);
+    const __m128i top = _mm_set1_epi16(INT16_MAX);
+    __m128i sum64 = zero, sq64 = zero, count64 = zero;
+    __m128i minV = top, maxV = zero;
+    size_t i = 0;
+
+    while (i + SSE2_Q16_STEP <= n_data) {
+        size_t steps = (n_data - i) / SSE2_Q16_STEP;
+        size_t end = i + ((steps < Q16_CHUNK_STEPS) ? steps : Q16_CHUNK_STEPS) * SSE2_Q16_STEP;
+        __m128i sum32 = zero, sq32 = zero, count16 = zero;
+        for (; i < end; i += SSE2_Q16_STEP) {
+            __m128i v = _mm_loadu_si128((const __m128i *)(const void *)(codes + i));
+            __m128i m = _mm_and_si128(_mm_cmpgt_epi16(v, zero), _mm_cmplt_epi16(v, limit));
+            __m128i x = _mm_and_si128(v, m);
+            sum32 = _mm_add_epi32(sum32, _mm_madd_epi16(x, ones));
+            sq32 = _mm_add_epi32(sq32, _mm_madd_epi16(x, x));
+            count16 = _mm_sub_epi16(count16, m);
+            minV = _mm_min_epi16(minV, _mm_or_si128(x, _mm_andnot_si128(m, top)));
+            maxV = _mm_max_epi16(maxV, x);
+        }
+        __m128i count32 = _mm_madd_epi16(count16, ones);
+        sum64 = _mm_add_epi64(sum64, _mm_add_epi64(_mm_unpacklo_epi32(sum32, zero),
+                                                   _mm_unpackhi_epi32(sum32, zero)));
+        sq64 = _mm_add_epi64(sq64, _mm_add_epi64(_mm_unpacklo_epi32(sq32, zero),
+                                                 _mm_unpackhi_epi32(sq32, zero)));
+        count64 = _mm_add_epi64(count64, _mm_add_epi64(_mm_unpacklo_epi32(count32, zero),
+                                                       _mm_unpackhi_epi32(count32, zero)));
+    }
+
+    uint64_t sums[2], squares[2], counts[2];
+    int16_t mins[SSE2_Q16_STEP], maxs[SSE2_Q16_STEP];
+    _mm_storeu_si128((__m128i *)(void *)sums, sum64);
+    _mm_storeu_si128((__m128i *)(void *)squares, sq64);
+    _mm_storeu_si128((__m128i *)(void *)counts, count64);
+    _mm_storeu_si128((__m128i *)(void *)mins, minV);
+    _mm_storeu_si128((__m128i *)(void *)maxs, maxV);
+
+    out->validCount = (size_t)(counts[0] + counts[1]);
+    out->sum = sums[0] + sums[1];
+    out->sumOfSquares = squares[0] + squares[1];
+    out->min = UINT16_MAX;
+    out->max = 0;
+    for (int lane = 0; lane < SSE2_Q16_STEP; lane++) {
+        if (mins[lane] != INT16_MAX && (uint16_t)mins[lane] < out->min)
+            out->min = (uint16_t)mins[lane];
+        if ((uint16_t)maxs[lane] > out->max)
+            out->max = (uint16_t)maxs[lane];
+    }
+    reduceQ16Tail(codes + i, n_data - i, out);
+}
+
+/**
+ * @brief Núcleo entero AVX2: procesa 16 códigos por iteración, igual que reduceQ16Sse2.
+ */
+__attribute__((target("avx2"))) static void reduceQ16Avx2(const uint16_t * codes, size_t n_data,
+                                                          PdaReductionQ16 * out) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ones = _mm256_set1_epi16(1);
+    const __m256i limit = _mm256_set1_epi16(PDA_Q16_MAX + 1);
+    const __m256i top = _mm256_set1_epi16(INT16_MAX);
+    __m256i sum64 = zero, sq64 = zero, count64 = zero;
+    __m256i minV = top, maxV = zero;
+    size_t i = 0;
+
+    while (i + AVX2_Q16_STEP <= n_data) {
+        size_t steps = (n_data - i) / AVX2_Q16_STEP;
+        size_t end = i + ((steps < Q16_CHUNK_STEPS) ? steps : Q16_CHUNK_STEPS) * AVX2_Q16_STEP;
+        __m256i sum32 = zero, sq32 = zero, count16 = zero;
+        for (; i < end; i += AVX2_Q16_STEP) {
+            __m256i v = _mm256_loadu_si256((const __m256i *)(const void *)(codes + i));
+            __m256i m =
+                _mm256_and_si256(_mm256_cmpgt_epi16(v, zero), _mm256_cmpgt_epi16(limit, v));
+            __m256i x = _mm256_and_si256(v, m);
+            sum32 = _mm256_add_epi32(sum32, _mm256_madd_epi16(x, ones));
+            sq32 = _mm256_add_epi32(sq32, _mm256_madd_epi16(x, x));
+            count16 = _mm256_sub_epi16(count16, m);
+            minV = _mm256_min_epi16(minV, _mm256_blendv_epi8(top, x, m));
+            maxV = _mm256_max_epi16(maxV, x);
+        }
+        __m256i count32 = _mm256_madd_epi16(count16, ones);
+        sum64 = _mm256_add_epi64(sum64, _mm256_add_epi64(_mm256_unpacklo_epi32(sum32, zero),
+                                                         _mm256_unpackhi_epi32(sum32, zero)));
+        sq64 = _mm256_add_epi64(sq64, _mm256_add_epi64(_mm256_unpacklo_epi32(sq32, zero),
+                                                       _mm256_unpackhi_epi32(sq32, zero)));
+        count64 = _mm256_add_epi64(count64,
+                                   _mm256_add_epi64(_mm256_unpacklo_epi32(count32, zero),
+                                                    _mm256_unpackhi_epi32(count32, zero)));
+    }
+
+    uint64_t sums[4], squares[4], counts[4];
+    int16_t mins[AVX2_Q16_STEP], maxs[AVX2_Q16_STEP];
+    _mm256_storeu_si256((__m256i *)(void *)sums, sum64);
+    _mm256_storeu_si256((__m256i *)(void *)squares, sq64);
+    _mm256_storeu_si256((__m256i *)(void *)counts, count64);
+    _mm256_storeu_si256((__m256i *)(void *)mins, minV);
+    _mm256_storeu_si256((__m256i *)(void *)maxs, maxV);
+
+    out->validCount = (size_t)((counts[0] + counts[1]) + (counts[2] + counts[3]));
+    out->sum = (sums[0] + sums[1]) + (sums[2] + sums[3]);
+    out->sumOfSquares = (squares[0] + squares[1]) + (squares[2] + squares[3]);
+    out->min = UINT16_MAX;
+    out->max = 0;
+    for (int lane = 0; lane < AVX2_Q16_STEP; lane++) {
+        if (mins[lane] != INT16_MAX && (uint16_t)mins[lane] < out->min)
+            out->min = (uint16_t)mins[lane];
+        if ((uint16_t)maxs[lane] > out->max)
+            out->max = (uint16_t)maxs[lane];
+    }
+    reduceQ16Tail(codes + i, n_data - i, out);
+}
+
+#endif /* PDA_HAVE_X86_KERNELS */
+
+#ifdef PDA_HAVE_NEON_KERNEL
+
+/**
+ * @brief Núcleo NEON (AArch64): procesa 4 datos por iteración en dos vectores de 2 doubles.
+ */
+static void reduceNeon(const float * data, size_t n_data, double shift, PdaReduction * out) {
+    const float64x2_t lo = vdupq_n_f64(MP_MIN_VALUE);
+    const float64x2_t hi = vdupq_n_f64(MP_MAX_VALUE);
+    const float64x2_t ref = vdupq_n_f64(shift);
+    const float64x2_t posInf = vdupq_n_f64(INFINITY);
+    const float64x2_t negInf = vdupq_n_f64(-INFINITY);
+    float64x2_t sumA = vdupq_n_f64(INI_SUM), sumB = vdupq_n_f64(INI_SUM);
+    float64x2_t sqA = vdupq_n_f64(INI_SUM), sqB = vdupq_n_f64(INI_SUM);
+    float64x2_t minV = posInf, maxV = negInf;
+    uint64x2_t count = vdupq_n_u64(INI_VALID_COUNT);
+#ifdef PDA_INSTRUMENT
+    uint64x2_t aboveMin = vdupq_n_u64(INI_VALID_COUNT);
+#endif
+    size_t i = 0;
+
+    for (; i + NEON_STEP <= n_data; i += NEON_STEP) {
+        float32x4_t v = vld1q_f32(data + i);
+        float64x2_t a = vcvt_f64_f32(vget_low_f32(v));
+        float64x2_t b = vcvt_high_f64_f32(v);
+        uint64x2_t ma = vandq_u64(vcgtq_f64(a, lo), vcltq_f64(a, hi));
+        uint64x2_t mb = vandq_u64(vcgtq_f64(b, lo), vcltq_f64(b, hi));
+        float64x2_t da =
+            vreinterpretq_f64_u64(vandq_u64(vreinterpretq_u64_f64(vsubq_f64(a, ref)), ma));
+        float64x2_t db =
+            vreinterpretq_f64_u64(vandq_u64(vreinterpretq_u64_f64(vsubq_f64(b, ref)), mb));
+        sumA = vaddq_f64(sumA, da);
+        sumB = vaddq_f64(sumB, db);
+        sqA = vaddq_f64(sqA, vmulq_f64(da, da));
+        sqB = vaddq_f64(sqB, vmulq_f64(db, db));
+        minV = vminq_f64(minV, vbslq_f64(ma, a, posInf));
+        minV = vminq_f64(minV, vbslq_f64(mb, b, posInf));
+        maxV = vmaxq_f64(maxV, vbslq_f64(ma, a, negInf));
+        maxV = vmaxq_f64(maxV, vbslq_f64(mb, b, negInf));
+        count = vsubq_u64(count, ma);
+        count = vsubq_u64(count, mb);
+#ifdef PDA_INSTRUMENT
+        aboveMin = vsubq_u64(aboveMin, vcgtq_f64(a, lo));
+        aboveMin = vsubq_u64(aboveMin, vcgtq_f64(b, lo));
+#endif
+    }
+
+    out->validCount = (size_t)vaddvq_u64(count);
+#ifdef PDA_INSTRUMENT
+    out->aboveMinCount = (size_t)vaddvq_u64(aboveMin);
+#endif
+    out->sum = vaddvq_f64(vaddq_f64(sumA, sumB));
+    out->sumOfSquares = vaddvq_f64(vaddq_f64(sqA, sqB));
+    out->min = (float)vminvq_f64(minV);
+    out->max = (float)vmaxvq_f64(maxV);
+    reduceTail(data + i, n_data - i, shift, out);
+}
+
+/**
+ * @brief Núcleo entero NEON (AArch64): procesa 8 códigos por iteración.
+ *
+ * Las sumas se acumulan por pares en 32 bits con vpadalq_u16 y vmlal_u16 y se pasan a 64 bits
+ * cada Q16_CHUNK_STEPS iteraciones.
+ */
+static void reduceQ16Neon(const uint16_t * codes, size_t n_data, PdaReductionQ16 * out) {
+    const uint16x8_t low = vdupq_n_u16(PDA_Q16_MIN);
+    const uint16x8_t high = vdupq_n_u16(PDA_Q16_MAX);
+    uint64x2_t sum64 = vdupq_n_u64(0), sq64 = vdupq_n_u64(0), count64 = vdupq_n_u64(0);
+    uint16x8_t minV = vdupq_n_u16(UINT16_MAX), maxV = vdupq_n_u16(0);
+    size_t i = 0;
+
+    while (i + NEON_Q16_STEP <= n_data) {
+        size_t steps = (n_data - i) / NEON_Q16_STEP;
+        size_t end = i + ((steps < Q16_CHUNK_STEPS) ? steps : Q16_CHUNK_STEPS) * NEON_Q16_STEP;
+        uint32x4_t sum32 = vdupq_n_u32(0), sq32 = vdupq_n_u32(0), count32 = vdupq_n_u32(0);
+        for (; i < end; i += NEON_Q16_STEP) {
+            uint16x8_t v = vld1q_u16(codes + i);
+            uint16x8_t m = vandq_u16(vcgeq_u16(v, low), vcleq_u16(v, high));
+            uint16x8_t x = vandq_u16(v, m);
+            sum32 = vpadalq_u16(sum32, x);
+            sq32 = vmlal_u16(sq32, vget_low_u16(x), vget_low_u16(x));
+            sq32 = vmlal_high_u16(sq32, x, x);
+            count32 = vpadalq_u16(count32, vshrq_n_u16(m, 15));
+            minV = vminq_u16(minV, vorrq_u16(x, vmvnq_u16(m)));
+            maxV = vmaxq_u16(maxV, x);
+        }
+        sum64 = vpadalq_u32(sum64, sum32);
+        sq64 = vpadalq_u32(sq64, sq32);
+        count64 = vpadalq_u32(count64, count32);
+    }
+
+    out->validCount = (size_t)vaddvq_u64(count64);
+    out->sum = vaddvq_u64(sum64);
+    out->sumOfSquares = vaddvq_u64(sq64);
+    out->min = vminvq_u16(minV);
+    out->max = vmaxvq_u16(maxV);
+    reduceQ16Tail(codes + i, n_data - i, out);
+}
+
+#endif /* PDA_HAVE_NEON_KERNEL */
+
+/**
+ * @brief Retorna la función que implementa un núcleo, o NULL si no fue compilado.
+ *
+ * @param kernel Núcleo a consultar.
+ * @return Puntero a la función del núcleo.
+ */
+static PdaReduceFn kernelFunction(PdaKernelId kernel) {
+    switch (kernel) {
+    case PDA_KERNEL_SCALAR:
+        return reduceScalar;
+#ifdef PDA_HAVE_X86_KERNELS
+    case PDA_KERNEL_SSE2:
+        return reduceSse2;
+    case PDA_KERNEL_AVX2:
+        return reduceAvx2;
+    case PDA_KERNEL_AVX512:
+        return reduceAvx512;
+#endif
+#ifdef PDA_HAVE_NEON_KERNEL
+    case PDA_KERNEL_NEON:
+        return reduceNeon;
+#endif
+    default:
+        return NULL;
+    }
+}
+
+/**
+ * @brief Retorna la función que implementa el núcleo entero de un núcleo, o NULL si no fue
+ * compilado. PDA_KERNEL_AVX512 usa el núcleo AVX2.
+ *
+ * @param kernel Núcleo a consultar.
+ * @return Puntero a la función del núcleo entero.
+ */
+static PdaReduceQ16Fn kernelQ16Function(PdaKernelId kernel) {
+    switch (kernel) {
+    case PDA_KERNEL_SCALAR:
+        return reduceQ16Scalar;
+#ifdef PDA_HAVE_X86_KERNELS
+    case PDA_KERNEL_SSE2:
+        return reduceQ16Sse2;
+    case PDA_KERNEL_AVX2:
+    case PDA_KERNEL_AVX512:
+        return reduceQ16Avx2;
+#endif
+#ifdef PDA_HAVE_NEON_KERNEL
+    case PDA_KERNEL_NEON:
+        return reduceQ16Neon;
+#endif
+    default:
+        return NULL;
+    }
+}
+
+/**
+ * @brief Elige el núcleo más rápido soportado por la CPU.
+ *
+ * @return Identificador del núcleo elegido.
+ */
+static PdaKernelId bestKernel(void) {
+    static const PdaKernelId preference[] = {PDA_KERNEL_AVX512, PDA_KERNEL_AVX2, PDA_KERNEL_NEON,
+                                             PDA_KERNEL_SSE2};
+    for (size_t i = 0; i < sizeof(preference) / sizeof(preference[0]); i++) {
+        if (pdaKernelSupported(preference[i]))
+            return preference[i];
+    }
+    return PDA_KERNEL_SCALAR;
+}
+
+/**
+ * @brief Reduce por bloques de PDA_REDUCE_BLOCK datos y combina los bloques por pares.
+ *
+ * Cada bloque se reduce con el núcleo recibido y las mitades se combinan recursivamente, de
+ * modo que el error de redondeo crece con log2(n_data / PDA_REDUCE_BLOCK) y no con n_data. La
+ * mitad izquierda se redondea a un múltiplo del bloque para que el reparto no dependa del
+ * núcleo y todos los núcleos sumen los mismos bloques.
+ *
+ * @param reduce Núcleo que reduce cada bloque.
+ * @param data Array de datos flotantes.
+ * @param n_data Número de elementos en el array.
+ * @param shift Valor de referencia restado a cada dato.
+ * @param out Estructura donde se almacena el resultado.
+ */
+static void reducePairwise(PdaReduceFn reduce, const float * data, size_t n_data, double shift,
+                           PdaReduction * out) {
+    if (n_data <= PDA_REDUCE_BLOCK) {
+        reduce(data, n_data, shift, out);
+        return;
+    }
+    size_t half = (n_data / 2 + PDA_REDUCE_BLOCK - 1) / PDA_REDUCE_BLOCK * PDA_REDUCE_BLOCK;
+    PdaReduction right;
+    reducePairwise(reduce, data, half, shift, out);
+    reducePairwise(reduce, data + half, n_data - half, shift, &right);
+    out->validCount += right.validCount;
+#ifdef PDA_INSTRUMENT
+    out->aboveMinCount += right.aboveMinCount;
+#endif
+    out->sum += right.sum;
+    out->sumOfSquares += right.sumOfSquares;
+    if (right.min < out->min)
+        out->min = right.min;
+    if (right.max > out->max)
+        out->max = right.max;
+}
+
+/**
+ * @brief Retorna el núcleo activo, seleccionando el más rápido en la primera llamada.
+ *
+ * @return Identificador del núcleo activo.
+ */
+static PdaKernelId loadActiveKernel(void) {
+    int kernel = atomic_load_explicit(&activeKernel, memory_order_acquire);
+    if (kernel == PDA_KERNEL_COUNT) {
+        kernel = (int)bestKernel();
+        atomic_store_explicit(&activeKernel, kernel, memory_order_release);
+    }
+    return (PdaKernelId)kernel;
+}
+
+/* === Public function implementation ========================================================== */
+
+/**
+ * @brief Reduce un array con el núcleo activo, seleccionándolo en la primera llamada.
+ *
+ * @param data Array de datos flotantes.
+ * @param n_data Número de elementos en el array.
+ * @param shift Valor de referencia restado a cada dato.
+ * @param out Estructura donde se almacena el resultado.
+ */
+void pdaReduce(const float * data, size_t n_data, double shift, PdaReduction * out) {
+    reducePairwise(kernelFunction(loadActiveKernel()), data, n_data, shift, out);
+}
+
+/**
+ * @brief Reduce un array con un núcleo específico, si la CPU lo soporta.
+ *
+ * @param kernel Núcleo a utilizar.
+ * @param data Array de datos flotantes.
+ * @param n_data Número de elementos en el array.
+ * @param shift Valor de referencia restado a cada dato.
+ * @param out Estructura donde se almacena el resultado.
+ * @return Verdadero si el núcleo se ejecutó; falso si no está soportado.
+ */
+bool pdaReduceWith(PdaKernelId kernel, const float * data, size_t n_data, double shift,
+                   PdaReduction * out) {
+    if (!pdaKernelSupported(kernel))
+        return false;
+    reducePairwise(kernelFunction(kernel), data, n_data, shift, out);
+    return true;
+}
+
+/**
+ * @brief Reduce un array de datos cuantizados con el núcleo entero correspondiente al activo.
+ *
+ * Con AVX-512 activo, el núcleo entero AVX2 se ejecuta solo si la CPU también soporta AVX2.
+ *
+ * @param codes Array de datos cuantizados.
+ * @param n_data Número de elementos en el array.
+ * @param out Estructura donde se almacena el resultado.
+ */
+void pdaReduceQ16(const uint16_t * codes, size_t n_data, PdaReductionQ16 * out) {
+    PdaKernelId kernel = pdaActiveKernel();
+    if (kernel == PDA_KERNEL_AVX512 && !pdaKernelSupported(PDA_KERNEL_AVX2))
+        kernel = PDA_KERNEL_SSE2;
+    kernelQ16Function(kernel)(codes, n_data, out);
+}
+
+/**
+ * @brief Reduce un array de datos cuantizados con un núcleo específico, si la CPU lo soporta.
+ *
+ * @param kernel Núcleo a utilizar.
+ * @param codes Array de datos cuantizados.
+ * @param n_data Número de elementos en el array.
+ * @param out Estructura donde se almacena el resultado.
+ * @return Verdadero si el núcleo se ejecutó; falso si no está soportado.
+ */
+bool pdaReduceQ16With(PdaKernelId kernel, const uint16_t * codes, size_t n_data,
+                      PdaReductionQ16 * out) {
+    if (!pdaKernelSupported(kernel))
+        return false;
+    if (kernel == PDA_KERNEL_AVX512 && !pdaKernelSupported(PDA_KERNEL_AVX2))
+        kernel = PDA_KERNEL_SSE2;
+    kernelQ16Function(kernel)(codes, n_data, out);
+    return true;
+}
+
+/**
+ * @brief Indica si un núcleo fue compilado y la CPU soporta sus instrucciones.
+ *
+ * @param kernel Núcleo a consultar.
+ * @return Verdadero si el núcleo puede ejecutarse.
+ */
+bool pdaKernelSupported(PdaKernelId kernel) {
+    if (kernelFunction(kernel) == NULL)
+        return false;
+#ifdef PDA_HAVE_X86_KERNELS
+    __builtin_cpu_init();
+    if (kernel == PDA_KERNEL_SSE2)
+        return __builtin_cpu_supports("sse2");
+    if (kernel == PDA_KERNEL_AVX2)
+        return __builtin_cpu_supports("avx2");
+    if (kernel == PDA_KERNEL_AVX512)
+        return __builtin_cpu_supports("avx512f");
+#endif
+    return true;
+}
+
+/**
+ * @brief Retorna el núcleo activo, seleccionándolo si todavía no se hizo.
+ *
+ * @return Identificador del núcleo activo.
+ */
+PdaKernelId pdaActiveKernel(void) {
+    return loadActiveKernel();
+}
+
+/**
+ * @brief Fuerza el núcleo utilizado por pdaReduce.
+ *
+ * @param kernel Núcleo a utilizar.
+ * @return Verdadero si el núcleo está soportado y quedó activo.
+ */
+bool pdaSelectKernel(PdaKernelId kernel) {
+    if (!pdaKernelSupported(kernel))
+        return false;
+    atomic_store_explicit(&activeKernel, (int)kernel, memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Retorna el nombre legible de un núcleo.
+ *
+ * @param kernel Núcleo a consultar.
+ * @return Nombre del núcleo o "unknown" si el identificador no es válido.
+ */
+const char * pdaKernelName(PdaKernelId kernel) {
+    if ((unsigned)kernel >= PDA_KERNEL_COUNT)
+        return "unknown";
+    return kernelNames[kernel];
+}
+
+/* === End of documentation ==================================================================== */
@@ -0,0 +1,223 @@
+/*
+ * Nombre del archivo: PdaKernels.h
+ * Versión: 0.1
+ * Descripción:
+ *  Núcleos de reducción vectorizados (SSE2, AVX2, AVX-512 y NEON) con selección en tiempo de
+ *  ejecución para el análisis de datos de material particulado.
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifndef PDAKERNELS_H
+#define PDAKERNELS_H
+
+/**
+ * @file PdaKernels.h
+ * @brief Núcleos de reducción enmascarada usados por las funciones estadísticas.
+ *
+ * Cada núcleo aplica la prueba de rango MP_MIN_VALUE/MP_MAX_VALUE como una máscara de
+ * comparación y acumula, sin saltos condicionales, la cantidad de datos válidos, la suma y la
+ * suma de cuadrados (desplazadas respecto de un valor de referencia), el mínimo y el máximo.
+ *
+ * El núcleo escalar es la implementación de referencia. Los núcleos vectoriales se seleccionan
+ * una sola vez, según las capacidades de la CPU, en la primera llamada a pdaReduce.
+ *
+ * Tolerancia: validCount, min y max son idénticos en todos los núcleos. sum y sumOfSquares solo
+ * difieren por el orden de las sumas en doble precisión; su error relativo respecto del núcleo
+ * escalar es menor que PDA_KERNEL_TOLERANCE.
+ *
+ * Conjuntos grandes: pdaReduce y pdaReduceWith reducen bloques de PDA_REDUCE_BLOCK datos con el
+ * núcleo vectorial y combinan los bloques por pares, por lo que el error no crece con la
+ * cantidad de datos. Para n datos, el error absoluto de sum respecto de la suma exacta (por
+ * ejemplo, acumulada en long double) está acotado por
+ *
+ *     (PDA_REDUCE_BLOCK + ceil(log2(n / PDA_REDUCE_BLOCK)) + 8) * 2^-53 * suma(|dato - shift|)
+ *
+ * y el de sumOfSquares por la misma expresión con suma((dato - shift)^2). Con el bloque de 4096
+ * datos esto es un error relativo menor que 5e-13 para cualquier tamaño representable en size_t.
+ *
+ * Datos cuantizados: pdaReduceQ16 y pdaReduceQ16With reducen arrays de PdaQ16 (ver
+ * PdaQuantized.h) con núcleos enteros que validan cada código con una comparación de rango
+ * entera. Sus sumas son enteras y exactas, por lo que el resultado es idéntico en todos los
+ * núcleos. AVX-512F no tiene operaciones sobre enteros de 16 bits, por lo que PDA_KERNEL_AVX512
+ * usa el núcleo entero AVX2.
+ *
+ * Instrumentación: compilado con PDA_INSTRUMENT, PdaReduction incluye aboveMinCount, que cada
+ * núcleo obtiene de la comparación con MP_MIN_VALUE que ya realiza para validar los datos. Con
+ * él, PdaInstrument.h separa los datos descartados por debajo del mínimo de los que superan el
+ * máximo sin recorrer el array otra vez.
+ */
+
+/* === Headers files inclusions ================================================================ */
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+/**
+ * @brief Error relativo máximo de sum y sumOfSquares de un núcleo vectorial frente al escalar.
+ */
+#define PDA_KERNEL_TOLERANCE 1e-9
+
+/**
+ * @brief Cantidad de datos que cada núcleo acumula en secuencia antes de combinar por pares.
+ */
+#define PDA_REDUCE_BLOCK 4096
+
+/* === Public data type declarations =========================================================== */
+
+/**
+ * @brief Identificador de cada núcleo de reducción disponible.
+ */
+typedef enum {
+    PDA_KERNEL_SCALAR = 0, /**< Implementación de referencia, disponible siempre. */
+    PDA_KERNEL_SSE2,       /**< x86 con SSE2, 4 datos por iteración. */
+    PDA_KERNEL_AVX2,       /**< x86 con AVX2, 8 datos por iteración. */
+    PDA_KERNEL_AVX512,     /**< x86 con AVX-512F, 16 datos por iteración. */
+    PDA_KERNEL_NEON,       /**< AArch64 con NEON, 4 datos por iteración. */
+    PDA_KERNEL_COUNT       /**< Cantidad de identificadores definidos. */
+} PdaKernelId;
+
+/**
+ * @brief Resultado parcial de una reducción enmascarada.
+ *
+ * Las sumas se expresan respecto del valor de referencia (shift) recibido por el núcleo, de
+ * modo que la varianza puede obtenerse sin cancelación catastrófica. min y max solo tienen
+ * sentido si validCount es mayor que cero.
+ */
+typedef struct {
+    size_t validCount;   /**< Cantidad de datos que cumplen maskIsDataTrue. */
+    double sum;          /**< Suma de (dato - shift) para los datos válidos. */
+    double sumOfSquares; /**< Suma de (dato - shift)^2 para los datos válidos. */
+    float min;           /**< Mínimo de los datos válidos. */
+    float max;           /**< Máximo de los datos válidos. */
+#ifdef PDA_INSTRUMENT
+    size_t aboveMinCount; /**< Cantidad de datos mayores que MP_MIN_VALUE, válidos o no. */
+#endif
+} PdaReduction;
+
+/**
+ * @brief Resultado de una reducción de datos cuantizados, expresado en códigos.
+ *
+ * Las sumas son exactas mientras la cantidad de datos sea menor que 7e11. min y max solo tienen
+ * sentido si validCount es mayor que cero.
+ */
+typedef struct {
+    size_t validCount;     /**< Cantidad de códigos válidos. */
+    uint64_t sum;          /**< Suma de los códigos válidos. */
+    uint64_t sumOfSquares; /**< Suma de los cuadrados de los códigos válidos. */
+    uint16_t min;          /**< Mínimo de los códigos válidos. */
+    uint16_t max;          /**< Máximo de los códigos válidos. */
+} PdaReductionQ16;
+
+/* === Public variable declarations ============================================================ */
+
+/* === Public function declarations ============================================================ */
+
+/**
+ * @brief Reduce un array con el mejor núcleo disponible en la CPU.
+ *
+ * @param data Array de datos flotantes.
+ * @param n_data Número de elementos en el array.
+ * @param shift Valor de referencia restado a cada dato antes de acumular sumas.
+ * @param out Estructura donde se almacena el resultado.
+ */
+void pdaReduce(const float * data, size_t n_data, double shift, PdaReduction * out);
+
+/**
+ * @brief Reduce un array con un núcleo específico.
+ *
+ * @param kernel Núcleo a utilizar.
+ * @param data Array de datos flotantes.
+ * @param n_data Número de elementos en el array.
+ * @param shift Valor de referencia restado a cada dato antes de acumular sumas.
+ * @param out Estructura donde se almacena el resultado.
+ * @return Verdadero si el núcleo está soportado y se ejecutó; falso en caso contrario.
+ */
+bool pdaReduceWith(PdaKernelId kernel, const float * data, size_t n_data, double shift,
+                   PdaReduction * out);
+
+/**
+ * @brief Reduce un array de datos cuantizados con el núcleo entero correspondiente al activo.
+ *
+ * @param codes Array de datos cuantizados (PdaQ16).
+ * @param n_data Número de elementos en el array.
+ * @param out Estructura donde se almacena el resultado.
+ */
+void pdaReduceQ16(const uint16_t * codes, size_t n_data, PdaReductionQ16 * out);
+
+/**
+ * @brief Reduce un array de datos cuantizados con un núcleo específico.
+ *
+ * @param kernel Núcleo a utilizar.
+ * @param codes Array de datos cuantizados (PdaQ16).
+ * @param n_data Número de elementos en el array.
+ * @param out Estructura donde se almacena el resultado.
+ * @return Verdadero si el núcleo está soportado y se ejecutó; falso en caso contrario.
+ */
+bool pdaReduceQ16With(PdaKernelId kernel, const uint16_t * codes, size_t n_data,
+                      PdaReductionQ16 * out);
+
+/**
+ * @brief Indica si un núcleo puede ejecutarse en la CPU actual.
+ *
+ * @param kernel Núcleo a consultar.
+ * @return Verdadero si el núcleo fue compilado y la CPU lo soporta.
+ */
+bool pdaKernelSupported(PdaKernelId kernel);
+
+/**
+ * @brief Retorna el núcleo utilizado por pdaReduce.
+ *
+ * @return Identificador del núcleo activo.
+ */
+PdaKernelId pdaActiveKernel(void);
+
+/**
+ * @brief Fuerza el núcleo utilizado por pdaReduce.
+ *
+ * @param kernel Núcleo a utilizar.
+ * @return Verdadero si el núcleo está soportado y quedó activo.
+ */
+bool pdaSelectKernel(PdaKernelId kernel);
+
+/**
+ * @brief Retorna el nombre legible de un núcleo.
+ *
+ * @param kernel Núcleo a consultar.
+ * @return Nombre del núcleo o "unknown" si el identificador no es válido.
+ */
+const char * pdaKernelName(PdaKernelId kernel);
+
+/* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PDAKERNELS_H */
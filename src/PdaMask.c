@@ -0,0 +1,435 @@
+/*
+ * Nombre del archivo: PdaMask.c
+ * Versión: 0.1
+ * Descripción:
+ *  Máscara empaquetada de datos válidos, calculada una sola vez y reutilizada por las funciones
+ *  estadísticas.
+ *
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo bajo los términos de la
+ * Licencia Pública General GNU publicada por la Free Software Foundation, ya sea la versión 3 de la
+ * Licencia, o (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil, pero SIN NINGUNA GARANTÍA; sin
+ * siquiera la garantía implícita de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU junto con este programa.
+ * Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ */
+
+/**
+ * @file PdaMask.c
+ * @brief Implementación de la máscara de validez y de las estadísticas enmascaradas.
+ *
+ * Los núcleos vectoriales comparan en simple precisión contra los límites [lo, hi], donde lo es
+ * el menor float mayor que MP_MIN_VALUE y hi el mayor float menor que MP_MAX_VALUE. Para un dato
+ * float, lo <= dato <= hi equivale exactamente a maskIsDataTrue, y las comparaciones ordenadas
+ * descartan NaN. Así cada comparación evalúa 4, 8 o 16 datos y movemask (o el registro de
+ * máscara de AVX-512) entrega los bits directamente.
+ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "PdaMask.h"
+#include <math.h> // Para nextafterf e INFINITY
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define PDA_HAVE_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define PDA_HAVE_NEON_KERNEL 1
+#include <arm_neon.h>
+#endif
+
+/* === Macros definitions ====================================================================== */
+
+/**
+ * @brief Palabra con todos los datos marcados.
+ */
+#define FULL_WORD UINT64_MAX
+
+/**
+ * @brief Cantidad de datos comparados por instrucción en cada núcleo vectorial.
+ */
+#define SSE2_STEP   4
+#define AVX2_STEP   8
+#define AVX512_STEP 16
+#define NEON_STEP   4
+
+/* === Private data type declarations ========================================================== */
+
+/**
+ * @brief Firma de las funciones que calculan una palabra completa de la máscara.
+ */
+typedef uint64_t (*PdaMaskWordFn)(const float * data, float lo, float hi);
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/* === Private function implementation ========================================================= */
+
+/**
+ * @brief Menor float mayor que MP_MIN_VALUE.
+ */
+static float lowerLimit(void) {
+    float limit = (float)MP_MIN_VALUE;
+    return ((double)limit > MP_MIN_VALUE) ? limit : nextafterf(limit, INFINITY);
+}
+
+/**
+ * @brief Mayor float menor que MP_MAX_VALUE.
+ */
+static float upperLimit(void) {
+    float limit = (float)MP_MAX_VALUE;
+    return ((double)limit < MP_MAX_VALUE) ? limit : nextafterf(limit, -INFINITY);
+}
+
+/**
+ * @brief Máscara de count datos (count <= 64) con maskIsDataTrue.
+ */
+static uint64_t partialWord(const float * data, size_t count) {
+    uint64_t bits = 0;
+    for (size_t i = 0; i < count; i++)
+        bits |= (uint64_t)maskIsDataTrue(data[i]) << i;
+    return bits;
+}
+
+/**
+ * @brief Núcleo escalar de referencia para una palabra completa.
+ */
+static uint64_t wordScalar(const float * data, float lo, float hi) {
+    (void)lo;
+    (void)hi;
+    return partialWord(data, PDA_MASK_WORD_BITS);
+}
+
+#ifdef PDA_HAVE_X86_KERNELS
+
+/**
+ * @brief Núcleo SSE2: 4 datos por comparación.
+ */
+__attribute__((target("sse2"))) static uint64_t wordSse2(const float * data, float lo, float hi) {
+    const __m128 vlo = _mm_set1_ps(lo);
+    const __m128 vhi = _mm_set1_ps(hi);
+    uint64_t bits = 0;
+    for (unsigned j = 0; j < PDA_MASK_WORD_BITS; j += SSE2_STEP) {
+        __m128 v = _mm_loadu_ps(data + j);
+        __m128 m = _mm_and_ps(_mm_cmpge_ps(v, vlo), _mm_cmple_ps(v, vhi));
+        bits |= (uint64_t)(unsigned)_mm_movemask_ps(m) << j;
+    }
+    return bits;
+}
+
+/**
+ * @brief Núcleo AVX2: 8 datos por comparación.
+ */
+__attribute__((target("avx2"))) static uint64_t wordAvx2(const float * data, float lo, float hi) {
+    const __m256 vlo = _mm256_set1_ps(lo);
+    const __m256 vhi = _mm256_set1_ps(hi);
+    uint64_t bits = 0;
+    for (unsigned j = 0; j < PDA_MASK_WORD_BITS; j += AVX2_STEP) {
+        __m256 v = _mm256_loadu_ps(data + j);
+        __m256 m = _mm256_and_ps(_mm256_cmp_ps(v, vlo, _CMP_GE_OQ),
+                                 _mm256_cmp_ps(v, vhi, _CMP_LE_OQ));
+        bits |= (uint64_t)(unsigned)_mm256_movemask_ps(m) << j;
+    }
+    return bits;
+}
+
+/**
+ * @brief Núcleo AVX-512: 16 datos por comparación, directamente en un registro de máscara.
+ */
+__attribute__((target("avx512f"))) static uint64_t wordAvx512(const float * data, float lo,
+                                                              float hi) {
+    const __m512 vlo = _mm512_set1_ps(lo);
+    const __m512 vhi = _mm512_set1_ps(hi);
+    uint64_t bits = 0;
+    for (unsigned j = 0; j < PDA_MASK_WORD_BITS; j += AVX512_STEP) {
+        __m512 v = _mm512_loadu_ps(data + j);
+        __mmask16 m = _mm512_cmp_ps_mask(v, vlo, _CMP_GE_OQ);
+        m &= _mm512_cmp_ps_mask(v, vhi, _CMP_LE_OQ);
+        bits |= (uint64_t)m << j;
+    }
+    return bits;
+}
+
+#endif /* PDA_HAVE_X86_KERNELS */
+
+#ifdef PDA_HAVE_NEON_KERNEL
+
+/**
+ * @brief Núcleo NEON: 4 datos por comparación; los bits se obtienen pesando cada carril.
+ */
+static uint64_t wordNeon(const float * data, float lo, float hi) {
+    static const uint32_t laneBits[NEON_STEP] = {1u, 2u, 4u, 8u};
+    const float32x4_t vlo = vdupq_n_f32(lo);
+    const float32x4_t vhi = vdupq_n_f32(hi);
+    const uint32x4_t weights = vld1q_u32(laneBits);
+    uint64_t bits = 0;
+    for (unsigned j = 0; j < PDA_MASK_WORD_BITS; j += NEON_STEP) {
+        float32x4_t v = vld1q_f32(data + j);
+        uint32x4_t m = vandq_u32(vcgeq_f32(v, vlo), vcleq_f32(v, vhi));
+        bits |= (uint64_t)vaddvq_u32(vandq_u32(m, weights)) << j;
+    }
+    return bits;
+}
+
+#endif /* PDA_HAVE_NEON_KERNEL */
+
+/**
+ * @brief Retorna la función que implementa un núcleo, o NULL si no fue compilado.
+ */
+static PdaMaskWordFn wordFunction(PdaKernelId kernel) {
+    switch (kernel) {
+    case PDA_KERNEL_SCALAR:
+        return wordScalar;
+#ifdef PDA_HAVE_X86_KERNELS
+    case PDA_KERNEL_SSE2:
+        return wordSse2;
+    case PDA_KERNEL_AVX2:
+        return wordAvx2;
+    case PDA_KERNEL_AVX512:
+        return wordAvx512;
+#endif
+#ifdef PDA_HAVE_NEON_KERNEL
+    case PDA_KERNEL_NEON:
+        return wordNeon;
+#endif
+    default:
+        return NULL;
+    }
+}
+
+/**
+ * @brief Palabra w de la máscara, con los bits posteriores a n_data apagados.
+ */
+static uint64_t maskWord(const uint64_t * mask, size_t w, size_t n_data) {
+    size_t remaining = n_data - w * PDA_MASK_WORD_BITS;
+    if (remaining >= PDA_MASK_WORD_BITS)
+        return mask[w];
+    return mask[w] & ((UINT64_C(1) << remaining) - 1);
+}
+
+/**
+ * @brief Agrega un resultado parcial a un total.
+ */
+static void addReduction(PdaReduction * total, const PdaReduction * part) {
+    total->validCount += part->validCount;
+    total->sum += part->sum;
+    total->sumOfSquares += part->sumOfSquares;
+    if (part->min < total->min)
+        total->min = part->min;
+    if (part->max > total->max)
+        total->max = part->max;
+}
+
+/**
+ * @brief Busca el primer dato marcado y válido.
+ *
+ * @return Su posición, o n_data si no existe.
+ */
+static size_t firstMarked(const float * data, const uint64_t * mask, size_t n_data) {
+    for (size_t w = 0; w < PDA_MASK_WORDS(n_data); w++) {
+        for (uint64_t bits = maskWord(mask, w, n_data); bits != 0; bits &= bits - 1) {
+            size_t i = w * PDA_MASK_WORD_BITS + (size_t)__builtin_ctzll(bits);
+            if (maskIsDataTrue(data[i]))
+                return i;
+        }
+    }
+    return n_data;
+}
+
+/* === Public function implementation ========================================================== */
+
+/**
+ * @brief Calcula la máscara de datos válidos con el núcleo activo.
+ *
+ * @param data Array de datos flotantes.
+ * @param n_data Número de elementos en el array.
+ * @param mask Array de al menos PDA_MASK_WORDS(n_data) palabras.
+ * @return Cantidad de datos válidos.
+ */
+size_t pdaMaskBuild(const float * data, size_t n_data, uint64_t * mask) {
+    size_t validCount = 0;
+    pdaMaskBuildWith(pdaActiveKernel(), data, n_data, mask, &validCount);
+    return validCount;
+}
+
+/**
+ * @brief Calcula la máscara de datos válidos con un núcleo específico.
+ *
+ * @param kernel Núcleo a utilizar.
+ * @param data Array de datos flotantes.
+ * @param n_data Número de elementos en el array.
+ * @param mask Array de al menos PDA_MASK_WORDS(n_data) palabras.
+ * @param validCount Cantidad de datos válidos; puede ser NULL.
+ * @return Verdadero si el núcleo está soportado y se ejecutó.
+ */
+bool pdaMaskBuildWith(PdaKernelId kernel, const float * data, size_t n_data, uint64_t * mask,
+                      size_t * validCount) {
+    if (!pdaKernelSupported(kernel))
+        return false;
+
+    PdaMaskWordFn word = wordFunction(kernel);
+    float lo = lowerLimit(), hi = upperLimit();
+    size_t count = 0;
+    size_t full = (data != NULL && mask != NULL) ? n_data / PDA_MASK_WORD_BITS : 0;
+    for (size_t w = 0; w < full; w++) {
+        mask[w] = word(data + w * PDA_MASK_WORD_BITS, lo, hi);
+        count += (size_t)__builtin_popcountll(mask[w]);
+    }
+    size_t tail = n_data % PDA_MASK_WORD_BITS;
+    if (data != NULL && mask != NULL && tail > 0) {
+        mask[full] = partialWord(data + full * PDA_MASK_WORD_BITS, tail);
+        count += (size_t)__builtin_popcountll(mask[full]);
+    }
+    if (validCount != NULL)
+        *validCount = count;
+    return true;
+}
+
+/**
+ * @brief Cantidad de bits encendidos en los primeros n_data bits de la máscara.
+ *
+ * @param mask Máscara de datos.
+ * @param n_data Número de datos representados.
+ * @return Cantidad de bits encendidos.
+ */
+size_t pdaMaskCount(const uint64_t * mask, size_t n_data) {
+    size_t count = 0;
+    for (size_t w = 0; mask != NULL && w < PDA_MASK_WORDS(n_data); w++)
+        count += (size_t)__builtin_popcountll(maskWord(mask, w, n_data));
+    return count;
+}
+
+/**
+ * @brief Variante de computeParticulateStats que solo considera los datos marcados.
+ *
+ * Las palabras nulas se saltan sin leer los datos; los tramos de palabras completas se reducen
+ * con pdaReduce en una sola llamada y las palabras mixtas se recorren bit a bit.
+ *
+ * @param data Array de datos flotantes.
+ * @param mask Máscara de PDA_MASK_WORDS(n_data) palabras.
+ * @param n_data Número de elementos en el array.
+ * @param stats Estructura donde se almacenan los resultados.
+ * @return Verdadero si hay al menos un dato marcado y válido.
+ */
+bool computeParticulateStatsMasked(const float * data, const uint64_t * mask, size_t n_data,
+                                   PdaStats * stats) {
+    if (stats == NULL)
+        return false;
+    if (n_data == 0 || data == NULL || mask == NULL)
+        return pdaStatsFromMoments(0, 0, 0.0, 0.0, 0.0f, 0.0f, stats);
+
+    size_t first = firstMarked(data, mask, n_data);
+    if (first == n_data)
+        return pdaStatsFromMoments(n_data, 0, 0.0, 0.0, 0.0f, 0.0f, stats);
+
+    double shift = data[first];
+    PdaReduction total = {.validCount = 0, .sum = 0.0, .sumOfSquares = 0.0, .min = INFINITY,
+                          .max = -INFINITY};
+    size_t words = PDA_MASK_WORDS(n_data);
+    for (size_t w = first / PDA_MASK_WORD_BITS; w < words;) {
+        uint64_t bits = maskWord(mask, w, n_data);
+        if (bits == FULL_WORD) {
+            size_t start = w;
+            while (w < words && maskWord(mask, w, n_data) == FULL_WORD)
+                w++;
+            PdaReduction part;
+            pdaReduce(data + start * PDA_MASK_WORD_BITS, (w - start) * PDA_MASK_WORD_BITS,
+                      shift, &part);
+            addReduction(&total, &part);
+            continue;
+        }
+        for (; bits != 0; bits &= bits - 1) {
+            float value = data[w * PDA_MASK_WORD_BITS + (size_t)__builtin_ctzll(bits)];
+            if (!maskIsDataTrue(value))
+                continue;
+            double delta = (double)value - shift;
+            total.sum += delta;
+            total.sumOfSquares += delta * delta;
+            if (value < total.min)
+                total.min = value;
+            if (value > total.max)
+                total.max = value;
+            total.validCount++;
+        }
+        w++;
+    }
+
+    double n = (double)total.validCount;
+    double mean = shift + total.sum / n;
+    double m2 = total.sumOfSquares - total.sum * total.sum / n;
+    return pdaStatsFromMoments(n_data, total.validCount, mean, m2, total.min, total.max, stats);
+}
+
+/**
+ * @brief Variante de calculateAverage que solo considera los datos marcados.
+ *
+ * @param data Array de datos flotantes.
+ * @param mask Máscara de PDA_MASK_WORDS(n_data) palabras.
+ * @param n_data Número de elementos en el array.
+ * @return El promedio o MSN_VOID_ARRAY_VALUE.
+ */
+float calculateAverageMasked(const float * data, const uint64_t * mask, size_t n_data) {
+    PdaStats stats;
+    computeParticulateStatsMasked(data, mask, n_data, &stats);
+    return stats.mean;
+}
+
+/**
+ * @brief Variante de findMaxValue que solo considera los datos marcados.
+ *
+ * @param data Array de datos flotantes.
+ * @param mask Máscara de PDA_MASK_WORDS(n_data) palabras.
+ * @param n_data Número de elementos en el array.
+ * @return El valor máximo o MSN_VOID_ARRAY_VALUE.
+ */
+float findMaxValueMasked(const float * data, const uint64_t * mask, size_t n_data) {
+    PdaStats stats;
+    computeParticulateStatsMasked(data, mask, n_data, &stats);
+    return stats.max;
+}
+
+/**
+ * @brief Variante de findMinValue que solo considera los datos marcados.
+ *
+ * @param data Array de datos flotantes.
+ * @param mask Máscara de PDA_MASK_WORDS(n_data) palabras.
+ * @param n_data Número de elementos en el array.
+ * @return El valor mínimo o MSN_VOID_ARRAY_VALUE.
+ */
+float findMinValueMasked(const float * data, const uint64_t * mask, size_t n_data) {
+    PdaStats stats;
+    computeParticulateStatsMasked(data, mask, n_data, &stats);
+    return stats.min;
+}
+
+/**
+ * @brief Variante de calculateStandardDeviation que solo considera los datos marcados.
+ *
+ * @param data Array de datos flotantes.
+ * @param mask Máscara de PDA_MASK_WORDS(n_data) palabras.
+ * @param n_data Número de elementos en el array.
+ * @return La desviación estándar, MSN_VOID_ARRAY_VALUE, MSN_DS_NOTDEFINI o MSN_NOT_DATA.
+ */
+float calculateStandardDeviationMasked(const float * data, const uint64_t * mask, size_t n_data) {
+    PdaStats stats;
+    computeParticulateStatsMasked(data, mask, n_data, &stats);
+    return stats.stdDev;
+}
+
+/* === End of documentation ==================================================================== */
@@ -0,0 +1,173 @@
+/*
+ * Nombre del archivo: PdaMask.h
+ * Versión: 0.1
+ * Descripción:
+ *  Máscara empaquetada de datos válidos, calculada una sola vez y reutilizada por las funciones
+ *  estadísticas.
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "ParticulateDataAnalyzer.h"
+#include "PdaKernels.h"
+
+#ifndef PDAMASK_H
+#define PDAMASK_H
+
+/**
+ * @file PdaMask.h
+ * @brief Máscara de validez empaquetada en palabras de 64 bits.
+ *
+ * - pdaMaskBuild: Evalúa maskIsDataTrue una sola vez por dato, con el núcleo vectorial activo, y
+ *   retorna la cantidad de datos válidos (popcount de la máscara).
+ * - computeParticulateStatsMasked y las variantes Masked de las cuatro funciones clásicas:
+ *   calculan las estadísticas de los datos marcados en la máscara.
+ *
+ * El bit i % 64 de la palabra i / 64 corresponde al dato i. Los bits posteriores a n_data en la
+ * última palabra valen cero.
+ *
+ * Las funciones Masked saltan sin leer los datos las palabras nulas (por ejemplo, períodos de
+ * calentamiento o cortes del sensor) y reducen con pdaReduce los tramos de palabras completas.
+ * Un dato participa si su bit está encendido y además cumple maskIsDataTrue, de modo que la
+ * máscara puede restringirse con otros criterios (por ejemplo, marcas de calidad) apagando bits.
+ * Con la máscara de pdaMaskBuild los resultados son los de computeParticulateStats.
+ */
+
+/* === Headers files inclusions ================================================================ */
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+/**
+ * @brief Cantidad de datos representados por cada palabra de la máscara.
+ */
+#define PDA_MASK_WORD_BITS 64
+
+/**
+ * @brief Cantidad de palabras necesarias para una máscara de n datos.
+ */
+#define PDA_MASK_WORDS(n) (((n) + PDA_MASK_WORD_BITS - 1) / PDA_MASK_WORD_BITS)
+
+/* === Public data type declarations =========================================================== */
+
+/* === Public variable declarations ============================================================ */
+
+/* === Public function declarations ============================================================ */
+
+/**
+ * @brief Calcula la máscara de datos válidos con el núcleo activo.
+ *
+ * @param data Array de datos flotantes.
+ * @param n_data Número de elementos en el array.
+ * @param mask Array de al menos PDA_MASK_WORDS(n_data) palabras donde se escribe la máscara.
+ * @return Cantidad de datos válidos.
+ */
+size_t pdaMaskBuild(const float * data, size_t n_data, uint64_t * mask);
+
+/**
+ * @brief Calcula la máscara de datos válidos con un núcleo específico.
+ *
+ * @param kernel Núcleo a utilizar.
+ * @param data Array de datos flotantes.
+ * @param n_data Número de elementos en el array.
+ * @param mask Array de al menos PDA_MASK_WORDS(n_data) palabras donde se escribe la máscara.
+ * @param validCount Cantidad de datos válidos; puede ser NULL.
+ * @return Verdadero si el núcleo está soportado y se ejecutó; falso en caso contrario.
+ */
+bool pdaMaskBuildWith(PdaKernelId kernel, const float * data, size_t n_data, uint64_t * mask,
+                      size_t * validCount);
+
+/**
+ * @brief Cantidad de bits encendidos en los primeros n_data bits de la máscara.
+ *
+ * @param mask Máscara de datos.
+ * @param n_data Número de datos representados.
+ * @return Cantidad de bits encendidos.
+ */
+size_t pdaMaskCount(const uint64_t * mask, size_t n_data);
+
+/**
+ * @brief Variante de computeParticulateStats que solo considera los datos marcados en la máscara.
+ *
+ * @param data Array de datos flotantes.
+ * @param mask Máscara de PDA_MASK_WORDS(n_data) palabras.
+ * @param n_data Número de elementos en el array.
+ * @param stats Estructura donde se almacenan los resultados.
+ * @return Verdadero si hay al menos un dato marcado y válido.
+ */
+bool computeParticulateStatsMasked(const float * data, const uint64_t * mask, size_t n_data,
+                                   PdaStats * stats);
+
+/**
+ * @brief Variante de calculateAverage que solo considera los datos marcados en la máscara.
+ *
+ * @param data Array de datos flotantes.
+ * @param mask Máscara de PDA_MASK_WORDS(n_data) palabras.
+ * @param n_data Número de elementos en el array.
+ * @return El promedio o MSN_VOID_ARRAY_VALUE si no hay datos marcados y válidos.
+ */
+float calculateAverageMasked(const float * data, const uint64_t * mask, size_t n_data);
+
+/**
+ * @brief Variante de findMaxValue que solo considera los datos marcados en la máscara.
+ *
+ * @param data Array de datos flotantes.
+ * @param mask Máscara de PDA_MASK_WORDS(n_data) palabras.
+ * @param n_data Número de elementos en el array.
+ * @return El valor máximo o MSN_VOID_ARRAY_VALUE si no hay datos marcados y válidos.
+ */
+float findMaxValueMasked(const float * data, const uint64_t * mask, size_t n_data);
+
+/**
+ * @brief Variante de findMinValue que solo considera los datos marcados en la máscara.
+ *
+ * @param data Array de datos flotantes.
+ * @param mask Máscara de PDA_MASK_WORDS(n_data) palabras.
+ * @param n_data Número de elementos en el array.
+ * @return El valor mínimo o MSN_VOID_ARRAY_VALUE si no hay datos marcados y válidos.
+ */
+float findMinValueMasked(const float * data, const uint64_t * mask, size_t n_data);
+
+/**
+ * @brief Variante de calculateStandardDeviation que solo considera los datos marcados.
+ *
+ * @param data Array de datos flotantes.
+ * @param mask Máscara de PDA_MASK_WORDS(n_data) palabras.
+ * @param n_data Número de elementos en el array.
+ * @return La desviación estándar, MSN_VOID_ARRAY_VALUE, MSN_DS_NOTDEFINI o MSN_NOT_DATA, con
+ *         las mismas reglas que calculateStandardDeviation.
+ */
+float calculateStandardDeviationMasked(const float * data, const uint64_t * mask, size_t n_data);
+
+/* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PDAMASK_H */
@@ -0,0 +1,296 @@
+/*
+ * Nombre del archivo: PdaParallel.c
+ * Versión: 0.1
+ * Descripción:
+ *  Reducción multihilo de arrays muy grandes de datos de material particulado.
+ *
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo bajo los términos de la
+ * Licencia Pública General GNU publicada por la Free Software Foundation, ya sea la versión 3 de la
+ * Licencia, o (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil, pero SIN NINGUNA GARANTÍA; sin
+ * siquiera la garantía implícita de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU junto con este programa.
+ * Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ */
+
+/**
+ * @file PdaParallel.c
+ * @brief Implementación de la reducción multihilo con pthreads.
+ *
+ * El hilo que llama también trabaja: reduce el primer tramo mientras los demás hilos reducen el
+ * resto. Si no se puede crear un hilo, su tramo se reduce en el hilo que llama, de modo que el
+ * resultado no depende de la disponibilidad de hilos.
+ *
+ * El árbol del modo determinista se recorre como un contador binario: cada bloque se combina con
+ * el subárbol de su mismo nivel a la izquierda y, al final, los subárboles restantes se combinan
+ * de derecha a izquierda. Es el mismo orden que la reducción por pares nivel a nivel. Un tramo
+ * de span bloques alineado a span (potencia de dos) es un subárbol completo, y los bloques que
+ * siguen al último tramo completo forman los subárboles más chicos, que se combinan primero al
+ * final; por eso cada hilo puede reducir su tramo por separado sin guardar los parciales de cada
+ * bloque.
+ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "PdaParallel.h"
+#include "PdaKernels.h"
+#include <pthread.h>
+#include <unistd.h> // Para sysconf
+
+/* === Macros definitions ====================================================================== */
+
+/**
+ * @brief Cantidad máxima de niveles del árbol de combinación (uno por bit de size_t).
+ */
+#define TREE_MAX_LEVELS 64
+
+/**
+ * @brief Cantidad de hilos cuando no se puede consultar la cantidad de procesadores.
+ */
+#define DEFAULT_THREAD_COUNT 1
+
+/* === Private data type declarations ========================================================== */
+
+/**
+ * @brief Árbol de combinación de orden fijo que se construye agregando hojas de izquierda a
+ *        derecha: dos subárboles del mismo nivel se combinan apenas se completan.
+ */
+typedef struct {
+    PdaPartial nodes[TREE_MAX_LEVELS]; /**< Subárboles completos pendientes. */
+    unsigned levels[TREE_MAX_LEVELS];  /**< Nivel de cada subárbol pendiente. */
+    size_t top;                        /**< Cantidad de subárboles pendientes. */
+} MergeTree;
+
+/**
+ * @brief Trabajo asignado a un hilo.
+ */
+typedef struct {
+    const float * data; /**< Array completo. */
+    size_t n_data;      /**< Número de elementos del array completo. */
+    size_t begin;       /**< Primer dato (modo normal) o bloque (modo determinista). */
+    size_t end;         /**< Fin, excluido, del tramo asignado. */
+    bool deterministic; /**< Modo de reducción. */
+    PdaPartial result;  /**< Parcial del tramo. */
+} Worker;
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/* === Private function implementation ========================================================= */
+
+/**
+ * @brief Inicializa un árbol vacío.
+ */
+static void treeInit(MergeTree * tree) {
+    tree->top = 0;
+}
+
+/**
+ * @brief Agrega una hoja a la derecha del árbol.
+ */
+static void treePush(MergeTree * tree, const PdaPartial * leaf) {
+    PdaPartial node = *leaf;
+    unsigned level = 0;
+    while (tree->top > 0 && tree->levels[tree->top - 1] == level) {
+        node = pdaMerge(&tree->nodes[tree->top - 1], &node);
+        tree->top--;
+        level++;
+    }
+    tree->nodes[tree->top] = node;
+    tree->levels[tree->top] = level;
+    tree->top++;
+}
+
+/**
+ * @brief Combina los subárboles pendientes de derecha a izquierda.
+ *
+ * @param tree Árbol a completar.
+ * @param tail Resultado de las hojas que siguen a las del árbol, o NULL si no hay más hojas.
+ * @param result Parcial donde se almacena el resultado.
+ */
+static void treeFinish(MergeTree * tree, const PdaPartial * tail, PdaPartial * result) {
+    pdaAccInit(result);
+    if (tail != NULL)
+        *result = *tail;
+    else if (tree->top > 0)
+        *result = tree->nodes[--tree->top];
+    while (tree->top > 0) {
+        tree->top--;
+        *result = pdaMerge(&tree->nodes[tree->top], result);
+    }
+}
+
+/**
+ * @brief Combina los bloques [first, end) del array en el árbol de orden fijo.
+ *
+ * Si first es múltiplo de una potencia de dos mayor o igual que end - first, el resultado es el
+ * mismo subárbol que se obtiene al combinar todos los bloques del array.
+ */
+static void reduceChunkRange(const float * data, size_t n_data, size_t first, size_t end,
+                             PdaPartial * result) {
+    MergeTree tree;
+    treeInit(&tree);
+    for (size_t chunk = first; chunk < end; chunk++) {
+        size_t begin = chunk * PDA_PARALLEL_CHUNK_SIZE;
+        size_t length = n_data - begin;
+        if (length > PDA_PARALLEL_CHUNK_SIZE)
+            length = PDA_PARALLEL_CHUNK_SIZE;
+        PdaPartial leaf;
+        pdaPartialReduce(data + begin, length, &leaf);
+        treePush(&tree, &leaf);
+    }
+    treeFinish(&tree, NULL, result);
+}
+
+/**
+ * @brief Función de cada hilo: reduce el tramo asignado.
+ */
+static void * workerRun(void * arg) {
+    Worker * worker = arg;
+    if (worker->deterministic)
+        reduceChunkRange(worker->data, worker->n_data, worker->begin, worker->end,
+                         &worker->result);
+    else
+        pdaPartialReduce(worker->data + worker->begin, worker->end - worker->begin,
+                         &worker->result);
+    return NULL;
+}
+
+/**
+ * @brief Determina la cantidad de hilos a usar.
+ *
+ * Nunca se usan más hilos que bloques de PDA_PARALLEL_CHUNK_SIZE datos, para que los arrays
+ * pequeños no paguen el costo de crear hilos.
+ */
+static size_t threadCountFor(const PdaParallelConfig * config, size_t chunkCount) {
+    size_t threads = (config != NULL) ? config->threadCount : 0;
+    if (threads == 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = (online > 0) ? (size_t)online : DEFAULT_THREAD_COUNT;
+    }
+    if (threads > PDA_PARALLEL_MAX_THREADS)
+        threads = PDA_PARALLEL_MAX_THREADS;
+    if (threads > chunkCount)
+        threads = chunkCount;
+    return (threads > 0) ? threads : DEFAULT_THREAD_COUNT;
+}
+
+/**
+ * @brief Inicio del tramo t al repartir units unidades entre parts tramos de tamaño parejo.
+ */
+static size_t sliceBegin(size_t units, size_t parts, size_t t) {
+    size_t remainder = units % parts;
+    return t * (units / parts) + (t < remainder ? t : remainder);
+}
+
+/* === Public function implementation ========================================================== */
+
+/**
+ * @brief Reduce un array a un parcial usando varios hilos.
+ *
+ * @param data Array de datos flotantes.
+ * @param n_data Número de elementos en el array.
+ * @param config Configuración; NULL equivale a modo normal con un hilo por procesador.
+ * @param partial Parcial donde se almacena el resultado.
+ * @return Verdadero si el array contiene al menos un dato válido.
+ */
+bool pdaParallelReduce(const float * data, size_t n_data, const PdaParallelConfig * config,
+                       PdaPartial * partial) {
+    if (partial == NULL)
+        return false;
+    pdaAccInit(partial);
+    if (data == NULL || n_data == 0)
+        return false;
+
+    bool deterministic = (config != NULL) && config->deterministic;
+    size_t chunkCount = (n_data + PDA_PARALLEL_CHUNK_SIZE - 1) / PDA_PARALLEL_CHUNK_SIZE;
+    size_t threadCount = threadCountFor(config, chunkCount);
+
+    // en modo determinista cada hilo recibe un subárbol de span bloques alineado a span, con span
+    // la menor potencia de dos que alcanza; el último hilo recibe los bloques restantes
+    size_t span = 1;
+    size_t fullTasks = chunkCount;
+    bool hasTail = false;
+    if (deterministic) {
+        while ((chunkCount + span - 1) / span > threadCount)
+            span *= 2;
+        fullTasks = chunkCount / span;
+        hasTail = (chunkCount % span != 0);
+        threadCount = fullTasks + hasTail;
+    }
+
+    // el núcleo se selecciona antes de crear los hilos
+    pdaActiveKernel();
+
+    Worker workers[PDA_PARALLEL_MAX_THREADS];
+    pthread_t threads[PDA_PARALLEL_MAX_THREADS];
+    bool started[PDA_PARALLEL_MAX_THREADS];
+    for (size_t t = 0; t < threadCount; t++) {
+        workers[t].data = data;
+        workers[t].n_data = n_data;
+        workers[t].deterministic = deterministic;
+        if (deterministic) {
+            workers[t].begin = t * span;
+            workers[t].end = (t < fullTasks) ? (t + 1) * span : chunkCount;
+        } else {
+            workers[t].begin = sliceBegin(n_data, threadCount, t);
+            workers[t].end = sliceBegin(n_data, threadCount, t + 1);
+        }
+    }
+
+    for (size_t t = 1; t < threadCount; t++)
+        started[t] = (pthread_create(&threads[t], NULL, workerRun, &workers[t]) == 0);
+    workerRun(&workers[0]);
+    for (size_t t = 1; t < threadCount; t++) {
+        if (started[t])
+            pthread_join(threads[t], NULL);
+        else
+            workerRun(&workers[t]);
+    }
+
+    if (deterministic) {
+        // los subárboles completos se combinan como hojas del mismo árbol; los bloques restantes
+        // son los subárboles más chicos, que el árbol combina al final
+        MergeTree tree;
+        treeInit(&tree);
+        for (size_t t = 0; t < fullTasks; t++)
+            treePush(&tree, &workers[t].result);
+        treeFinish(&tree, hasTail ? &workers[fullTasks].result : NULL, partial);
+    } else {
+        for (size_t t = 0; t < threadCount; t++)
+            *partial = pdaMerge(partial, &workers[t].result);
+    }
+    return partial->validCount > 0;
+}
+
+/**
+ * @brief Variante multihilo de computeParticulateStats.
+ *
+ * @param data Array de datos flotantes.
+ * @param n_data Número de elementos en el array.
+ * @param config Configuración; NULL equivale a modo normal con un hilo por procesador.
+ * @param stats Estructura donde se almacenan los resultados.
+ * @return Verdadero si el array contiene al menos un dato válido.
+ */
+bool computeParticulateStatsParallel(const float * data, size_t n_data,
+                                     const PdaParallelConfig * config, PdaStats * stats) {
+    PdaPartial partial;
+    pdaParallelReduce(data, n_data, config, &partial);
+    return pdaPartialQuery(&partial, stats);
+}
+
+/* === End of documentation ==================================================================== */
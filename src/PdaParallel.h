@@ -0,0 +1,124 @@
+/*
+ * Nombre del archivo: PdaParallel.h
+ * Versión: 0.1
+ * Descripción:
+ *  Reducción multihilo de arrays muy grandes de datos de material particulado.
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "ParticulateDataAnalyzer.h"
+#include "PdaPartial.h"
+
+#ifndef PDAPARALLEL_H
+#define PDAPARALLEL_H
+
+/**
+ * @file PdaParallel.h
+ * @brief Variante multihilo (pthreads) de las funciones estadísticas.
+ *
+ * El array se divide entre varios hilos, cada uno lo reduce a un PdaPartial y los parciales se
+ * combinan con pdaMerge. Hay dos modos:
+ * - Normal: cada hilo reduce un tramo contiguo y los parciales se combinan en orden de hilo. Es
+ *   el modo más rápido; el resultado puede variar en el último bit según la cantidad de hilos.
+ * - Determinista: el array se divide en bloques de PDA_PARALLEL_CHUNK_SIZE datos,
+ *   independientemente de la cantidad de hilos, y los parciales de los bloques se combinan en un
+ *   árbol binario de orden fijo. El resultado es idéntico bit a bit para cualquier cantidad de
+ *   hilos.
+ *
+ * En modo determinista cada hilo reduce un subárbol completo del árbol fijo: un tramo de bloques
+ * alineado a una potencia de dos, con la menor potencia que alcanza para la cantidad de hilos, y
+ * el último hilo reduce los bloques restantes. Luego se combinan los subárboles en el mismo orden
+ * fijo. Ningún modo usa memoria dinámica ni limita el tamaño del array; a cambio, un hilo puede
+ * recibir hasta el doble de bloques que en un reparto parejo.
+ */
+
+/* === Headers files inclusions ================================================================ */
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+/**
+ * @brief Cantidad de datos de cada bloque del modo determinista.
+ */
+#ifndef PDA_PARALLEL_CHUNK_SIZE
+#define PDA_PARALLEL_CHUNK_SIZE 65536
+#endif
+
+/**
+ * @brief Cantidad máxima de hilos de trabajo.
+ */
+#ifndef PDA_PARALLEL_MAX_THREADS
+#define PDA_PARALLEL_MAX_THREADS 256
+#endif
+
+/* === Public data type declarations =========================================================== */
+
+/**
+ * @brief Configuración de la reducción multihilo.
+ */
+typedef struct {
+    unsigned threadCount; /**< Hilos de trabajo; 0 usa la cantidad de procesadores en línea. */
+    bool deterministic;   /**< Resultado idéntico con cualquier cantidad de hilos. */
+} PdaParallelConfig;
+
+/* === Public variable declarations ============================================================ */
+
+/* === Public function declarations ============================================================ */
+
+/**
+ * @brief Reduce un array a un parcial usando varios hilos.
+ *
+ * @param data Array de datos flotantes.
+ * @param n_data Número de elementos en el array.
+ * @param config Configuración; NULL equivale a modo normal con un hilo por procesador.
+ * @param partial Parcial donde se almacena el resultado.
+ * @return Verdadero si el array contiene al menos un dato válido.
+ */
+bool pdaParallelReduce(const float * data, size_t n_data, const PdaParallelConfig * config,
+                       PdaPartial * partial);
+
+/**
+ * @brief Variante multihilo de computeParticulateStats.
+ *
+ * @param data Array de datos flotantes.
+ * @param n_data Número de elementos en el array.
+ * @param config Configuración; NULL equivale a modo normal con un hilo por procesador.
+ * @param stats Estructura donde se almacenan los resultados.
+ * @return Verdadero si el array contiene al menos un dato válido.
+ */
+bool computeParticulateStatsParallel(const float * data, size_t n_data,
+                                     const PdaParallelConfig * config, PdaStats * stats);
+
+/* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PDAPARALLEL_H */
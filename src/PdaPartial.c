@@ -0,0 +1,165 @@
+/*
+ * Nombre del archivo: PdaPartial.c
+ * Versión: 0.1
+ * Descripción:
+ *  Agregados parciales combinables para reducir en paralelo o de forma distribuida conjuntos de
+ *  datos de material particulado.
+ *
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo bajo los términos de la
+ * Licencia Pública General GNU publicada por la Free Software Foundation, ya sea la versión 3 de la
+ * Licencia, o (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil, pero SIN NINGUNA GARANTÍA; sin
+ * siquiera la garantía implícita de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU junto con este programa.
+ * Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ */
+
+/**
+ * @file PdaPartial.c
+ * @brief Implementación de los agregados parciales y su formato binario.
+ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "PdaPartial.h"
+#include "PdaByteOrder.h"
+
+/* === Macros definitions ====================================================================== */
+
+/**
+ * @brief Identificador del bloque binario: "PDAP" leído como uint32 little-endian.
+ */
+#define PARTIAL_MAGIC 0x50414450u
+
+/**
+ * @brief Desplazamientos de cada campo dentro del bloque binario.
+ */
+#define OFFSET_MAGIC    0
+#define OFFSET_VERSION  4
+#define OFFSET_RESERVED 6
+#define OFFSET_VALID    8
+#define OFFSET_REJECTED 16
+#define OFFSET_MEAN     24
+#define OFFSET_M2       32
+#define OFFSET_MIN      40
+#define OFFSET_MAX      44
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/* === Private function implementation ========================================================= */
+
+/* === Public function implementation ========================================================== */
+
+/**
+ * @brief Reduce un fragmento de datos a un parcial.
+ *
+ * @param data Array de datos flotantes.
+ * @param n_data Número de elementos en el array.
+ * @param partial Parcial donde se almacena el resultado.
+ * @return Verdadero si el fragmento contiene al menos un dato válido.
+ */
+bool pdaPartialReduce(const float * data, size_t n_data, PdaPartial * partial) {
+    if (partial == NULL)
+        return false;
+    pdaAccInit(partial);
+    pdaAccPushBatch(partial, data, n_data);
+    return partial->validCount > 0;
+}
+
+/**
+ * @brief Combina dos parciales con la fórmula de Chan et al.
+ *
+ * @param a Primer parcial.
+ * @param b Segundo parcial.
+ * @return Parcial equivalente a reducir los datos de ambos fragmentos juntos.
+ */
+PdaPartial pdaMerge(const PdaPartial * a, const PdaPartial * b) {
+    PdaPartial result;
+    pdaAccInit(&result);
+    pdaAccMerge(&result, a);
+    pdaAccMerge(&result, b);
+    return result;
+}
+
+/**
+ * @brief Obtiene las estadísticas representadas por un parcial.
+ *
+ * @param partial Parcial.
+ * @param stats Estructura donde se almacenan los resultados.
+ * @return Verdadero si el parcial contiene al menos un dato válido.
+ */
+bool pdaPartialQuery(const PdaPartial * partial, PdaStats * stats) {
+    return pdaAccQuery(partial, stats);
+}
+
+/**
+ * @brief Serializa un parcial en un bloque binario de tamaño fijo.
+ *
+ * @param partial Parcial a serializar.
+ * @param blob Buffer de PDA_PARTIAL_BLOB_SIZE bytes.
+ */
+void pdaPartialSerialize(const PdaPartial * partial, uint8_t blob[PDA_PARTIAL_BLOB_SIZE]) {
+    if (partial == NULL || blob == NULL)
+        return;
+    pdaWriteLe(blob + OFFSET_MAGIC, PARTIAL_MAGIC, sizeof(uint32_t));
+    pdaWriteLe(blob + OFFSET_VERSION, PDA_PARTIAL_VERSION, sizeof(uint16_t));
+    pdaWriteLe(blob + OFFSET_RESERVED, 0, sizeof(uint16_t));
+    pdaWriteLe(blob + OFFSET_VALID, partial->validCount, sizeof(uint64_t));
+    pdaWriteLe(blob + OFFSET_REJECTED, partial->rejectedCount, sizeof(uint64_t));
+    pdaWriteDouble(blob + OFFSET_MEAN, partial->mean);
+    pdaWriteDouble(blob + OFFSET_M2, partial->m2);
+    pdaWriteFloat(blob + OFFSET_MIN, partial->min);
+    pdaWriteFloat(blob + OFFSET_MAX, partial->max);
+}
+
+/**
+ * @brief Reconstruye un parcial desde un bloque binario.
+ *
+ * Rechaza bloques con identificador, versión o campo reservado incorrectos, con M2 negativo o
+ * no numérico, o con contadores que no caben en size_t.
+ *
+ * @param blob Buffer de PDA_PARTIAL_BLOB_SIZE bytes generado por pdaPartialSerialize.
+ * @param partial Parcial donde se almacena el resultado.
+ * @return Verdadero si el bloque es válido.
+ */
+bool pdaPartialDeserialize(const uint8_t blob[PDA_PARTIAL_BLOB_SIZE], PdaPartial * partial) {
+    if (blob == NULL || partial == NULL)
+        return false;
+    if (pdaReadLe(blob + OFFSET_MAGIC, sizeof(uint32_t)) != PARTIAL_MAGIC ||
+        pdaReadLe(blob + OFFSET_VERSION, sizeof(uint16_t)) != PDA_PARTIAL_VERSION ||
+        pdaReadLe(blob + OFFSET_RESERVED, sizeof(uint16_t)) != 0)
+        return false;
+
+    uint64_t validCount = pdaReadLe(blob + OFFSET_VALID, sizeof(uint64_t));
+    uint64_t rejectedCount = pdaReadLe(blob + OFFSET_REJECTED, sizeof(uint64_t));
+    double m2 = pdaReadDouble(blob + OFFSET_M2);
+    if (validCount > SIZE_MAX || rejectedCount > SIZE_MAX || !(m2 >= 0.0))
+        return false;
+
+    partial->validCount = (size_t)validCount;
+    partial->rejectedCount = (size_t)rejectedCount;
+    partial->mean = pdaReadDouble(blob + OFFSET_MEAN);
+    partial->m2 = m2;
+    partial->min = pdaReadFloat(blob + OFFSET_MIN);
+    partial->max = pdaReadFloat(blob + OFFSET_MAX);
+    return true;
+}
+
+/* === End of documentation ==================================================================== */
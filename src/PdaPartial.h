@@ -0,0 +1,146 @@
+/*
+ * Nombre del archivo: PdaPartial.h
+ * Versión: 0.1
+ * Descripción:
+ *  Agregados parciales combinables para reducir en paralelo o de forma distribuida conjuntos de
+ *  datos de material particulado.
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "ParticulateDataAnalyzer.h"
+#include "PdaAccumulator.h"
+
+#ifndef PDAPARTIAL_H
+#define PDAPARTIAL_H
+
+/**
+ * @file PdaPartial.h
+ * @brief Estado parcial (cantidad, promedio, M2, mínimo, máximo y descartados) combinable.
+ *
+ * Cada fragmento de un conjunto de datos (hilo, archivo, día o gateway) se reduce por separado
+ * con pdaPartialReduce y los resultados se combinan con pdaMerge usando la fórmula de varianza
+ * en paralelo de Chan et al. El resultado es el mismo que reducir los datos concatenados.
+ *
+ * Para enviar parciales entre procesos, pdaPartialSerialize los convierte en un bloque binario de
+ * tamaño fijo PDA_PARTIAL_BLOB_SIZE, independiente del orden de bytes de la plataforma:
+ *
+ * | Desplazamiento | Tamaño | Contenido                                  |
+ * |----------------|--------|--------------------------------------------|
+ * | 0              | 4      | Identificador "PDAP"                       |
+ * | 4              | 2      | Versión del formato (PDA_PARTIAL_VERSION)  |
+ * | 6              | 2      | Reservado, en cero                         |
+ * | 8              | 8      | validCount (uint64, little-endian)         |
+ * | 16             | 8      | rejectedCount (uint64, little-endian)      |
+ * | 24             | 8      | mean (IEEE-754 double, little-endian)      |
+ * | 32             | 8      | m2 (IEEE-754 double, little-endian)        |
+ * | 40             | 4      | min (IEEE-754 float, little-endian)        |
+ * | 44             | 4      | max (IEEE-754 float, little-endian)        |
+ */
+
+/* === Headers files inclusions ================================================================ */
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+/**
+ * @brief Tamaño en bytes de un parcial serializado.
+ */
+#define PDA_PARTIAL_BLOB_SIZE 48
+
+/**
+ * @brief Versión del formato binario de los parciales.
+ */
+#define PDA_PARTIAL_VERSION 1
+
+/* === Public data type declarations =========================================================== */
+
+/**
+ * @brief Agregado parcial combinable. Comparte representación con PdaAccumulator, por lo que
+ * puede alimentarse también con pdaAccPush y pdaAccPushBatch.
+ */
+typedef PdaAccumulator PdaPartial;
+
+/* === Public variable declarations ============================================================ */
+
+/* === Public function declarations ============================================================ */
+
+/**
+ * @brief Reduce un fragmento de datos a un parcial.
+ *
+ * @param data Array de datos flotantes.
+ * @param n_data Número de elementos en el array.
+ * @param partial Parcial donde se almacena el resultado.
+ * @return Verdadero si el fragmento contiene al menos un dato válido.
+ */
+bool pdaPartialReduce(const float * data, size_t n_data, PdaPartial * partial);
+
+/**
+ * @brief Combina dos parciales.
+ *
+ * La operación es conmutativa y asociativa salvo por el redondeo en doble precisión.
+ *
+ * @param a Primer parcial.
+ * @param b Segundo parcial.
+ * @return Parcial equivalente a reducir los datos de ambos fragmentos juntos.
+ */
+PdaPartial pdaMerge(const PdaPartial * a, const PdaPartial * b);
+
+/**
+ * @brief Obtiene las estadísticas representadas por un parcial.
+ *
+ * @param partial Parcial.
+ * @param stats Estructura donde se almacenan los resultados.
+ * @return Verdadero si el parcial contiene al menos un dato válido.
+ */
+bool pdaPartialQuery(const PdaPartial * partial, PdaStats * stats);
+
+/**
+ * @brief Serializa un parcial en un bloque binario de tamaño fijo.
+ *
+ * @param partial Parcial a serializar.
+ * @param blob Buffer de PDA_PARTIAL_BLOB_SIZE bytes.
+ */
+void pdaPartialSerialize(const PdaPartial * partial, uint8_t blob[PDA_PARTIAL_BLOB_SIZE]);
+
+/**
+ * @brief Reconstruye un parcial desde un bloque binario.
+ *
+ * @param blob Buffer de PDA_PARTIAL_BLOB_SIZE bytes generado por pdaPartialSerialize.
+ * @param partial Parcial donde se almacena el resultado.
+ * @return Verdadero si el bloque tiene identificador y versión correctos y contenido coherente.
+ */
+bool pdaPartialDeserialize(const uint8_t blob[PDA_PARTIAL_BLOB_SIZE], PdaPartial * partial);
+
+/* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PDAPARTIAL_H */
@@ -0,0 +1,311 @@
+/*
+ * Nombre del archivo: PdaPercentile.c
+ * Versión: 0.1
+ * Descripción:
+ *  Mediana y percentiles de datos de material particulado por selección, sin ordenar el array
+ *  completo.
+ *
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo bajo los términos de la
+ * Licencia Pública General GNU publicada por la Free Software Foundation, ya sea la versión 3 de la
+ * Licencia, o (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil, pero SIN NINGUNA GARANTÍA; sin
+ * siquiera la garantía implícita de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU junto con este programa.
+ * Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ */
+
+/**
+ * @file PdaPercentile.c
+ * @brief Implementación de la selección múltiple (introselect) de estadísticos de orden.
+ *
+ * Los datos válidos se compactan al inicio del buffer de trabajo. Luego se calculan las
+ * posiciones (rangos) necesarias para todos los percentiles y se ordenan. Cada partición de tres
+ * vías (menores, iguales y mayores que el pivote) reparte los rangos pendientes entre los dos
+ * lados, de modo que la recursión solo continúa por los tramos que contienen algún rango. Con k
+ * percentiles el costo promedio es O(n log k) en lugar de O(k n).
+ *
+ * Como en introselect, si la recursión supera 2 log2(n) niveles el tramo se ordena con heapsort,
+ * lo que acota el peor caso en O(n log n).
+ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "PdaPercentile.h"
+
+/* === Macros definitions ====================================================================== */
+
+/**
+ * @brief Tamaño de tramo a partir del cual se ordena por inserción en lugar de particionar.
+ */
+#define INSERTION_SORT_THRESHOLD 16
+
+/**
+ * @brief Rango válido de los percentiles.
+ */
+#define PERCENTILE_MIN 0.0f
+#define PERCENTILE_MAX 100.0f
+
+/**
+ * @brief Cantidad máxima de rangos: dos estadísticos de orden por percentil.
+ */
+#define MAX_RANKS (2 * PDA_MAX_PERCENTILES)
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/* === Private function implementation ========================================================= */
+
+/**
+ * @brief Ordena un tramo corto por inserción.
+ */
+static void insertionSort(float * a, size_t n) {
+    for (size_t i = 1; i < n; i++) {
+        float value = a[i];
+        size_t j = i;
+        while (j > 0 && a[j - 1] > value) {
+            a[j] = a[j - 1];
+            j--;
+        }
+        a[j] = value;
+    }
+}
+
+/**
+ * @brief Hunde el elemento root en el montículo de máximos a[0..n).
+ */
+static void siftDown(float * a, size_t root, size_t n) {
+    float value = a[root];
+    size_t child;
+    while ((child = 2 * root + 1) < n) {
+        if (child + 1 < n && a[child + 1] > a[child])
+            child++;
+        if (a[child] <= value)
+            break;
+        a[root] = a[child];
+        root = child;
+    }
+    a[root] = value;
+}
+
+/**
+ * @brief Ordena un tramo con heapsort; se usa cuando la recursión es demasiado profunda.
+ */
+static void heapSort(float * a, size_t n) {
+    for (size_t i = n / 2; i-- > 0;)
+        siftDown(a, i, n);
+    for (size_t end = n; end-- > 1;) {
+        float top = a[0];
+        a[0] = a[end];
+        a[end] = top;
+        siftDown(a, 0, end);
+    }
+}
+
+/**
+ * @brief Mediana de tres valores, usada como pivote.
+ */
+static float medianOfThree(float a, float b, float c) {
+    if (a < b)
+        return (b < c) ? b : ((a < c) ? c : a);
+    return (a < c) ? a : ((b < c) ? c : b);
+}
+
+/**
+ * @brief Primer índice de ranks[first..last) cuyo rango es mayor o igual a position.
+ */
+static size_t firstRankFrom(const size_t * ranks, size_t first, size_t last, size_t position) {
+    while (first < last && ranks[first] < position)
+        first++;
+    return first;
+}
+
+/**
+ * @brief Ubica en su posición ordenada cada rango de ranks[rFirst..rLast) dentro de a[left..right).
+ *
+ * @param a Buffer de trabajo.
+ * @param left Inicio del tramo.
+ * @param right Fin, excluido, del tramo.
+ * @param ranks Rangos ordenados de forma creciente.
+ * @param rFirst Primer rango pendiente del tramo.
+ * @param rLast Fin, excluido, de los rangos pendientes del tramo.
+ * @param depth Niveles de partición restantes antes de recurrir a heapsort.
+ */
+static void multiSelect(float * a, size_t left, size_t right, const size_t * ranks, size_t rFirst,
+                        size_t rLast, unsigned depth) {
+    while (rFirst < rLast) {
+        size_t n = right - left;
+        if (n <= INSERTION_SORT_THRESHOLD) {
+            insertionSort(a + left, n);
+            return;
+        }
+        if (depth == 0) {
+            heapSort(a + left, n);
+            return;
+        }
+        depth--;
+
+        float pivot = medianOfThree(a[left], a[left + n / 2], a[right - 1]);
+        size_t lt = left, i = left, gt = right;
+        while (i < gt) {
+            float value = a[i];
+            if (value < pivot) {
+                a[i++] = a[lt];
+                a[lt++] = value;
+            } else if (value > pivot) {
+                a[i] = a[--gt];
+                a[gt] = value;
+            } else {
+                i++;
+            }
+        }
+
+        // los rangos en [lt, gt) ya están resueltos: todos valen pivot
+        size_t rMiddle = firstRankFrom(ranks, rFirst, rLast, lt);
+        size_t rRight = firstRankFrom(ranks, rMiddle, rLast, gt);
+        multiSelect(a, left, lt, ranks, rFirst, rMiddle, depth);
+        left = gt;
+        rFirst = rRight;
+    }
+}
+
+/**
+ * @brief Cantidad de niveles permitidos antes de recurrir a heapsort: 2 log2(n).
+ */
+static unsigned depthLimit(size_t n) {
+    unsigned depth = 0;
+    while (n > 1) {
+        n >>= 1;
+        depth += 2;
+    }
+    return depth;
+}
+
+/**
+ * @brief Indica si un percentil está en el rango [0, 100]; rechaza también NaN.
+ */
+static bool percentileInRange(float percentile) {
+    return percentile >= PERCENTILE_MIN && percentile <= PERCENTILE_MAX;
+}
+
+/**
+ * @brief Posición fraccionaria (m - 1) * p / 100 del percentil entre m datos ordenados.
+ */
+static double percentilePosition(float percentile, size_t m) {
+    return (double)(m - 1) * percentile / PERCENTILE_MAX;
+}
+
+/* === Public function implementation ========================================================== */
+
+/**
+ * @brief Calcula un percentil de los datos válidos.
+ *
+ * @param data Un array de datos flotantes; si scratch es NULL se permuta en el lugar.
+ * @param n_data El número de elementos en el array.
+ * @param percentile Percentil en [0, 100].
+ * @param scratch Buffer de al menos n_data elementos, o NULL para trabajar en el lugar.
+ * @return El percentil, MSN_VOID_ARRAY_VALUE o MSN_PERCENTILE_OUT_OF_RANGE.
+ */
+float pdaPercentile(float data[], size_t n_data, float percentile, float scratch[]) {
+    float result;
+    pdaPercentiles(data, n_data, &percentile, 1, &result, scratch);
+    return result;
+}
+
+/**
+ * @brief Calcula varios percentiles de los datos válidos en una sola partición recursiva.
+ *
+ * @param data Un array de datos flotantes; si scratch es NULL se permuta en el lugar.
+ * @param n_data El número de elementos en el array.
+ * @param percentiles Percentiles solicitados, cada uno en [0, 100].
+ * @param count Cantidad de percentiles, como máximo PDA_MAX_PERCENTILES.
+ * @param results Array de count elementos donde se almacenan los resultados.
+ * @param scratch Buffer de al menos n_data elementos, o NULL para trabajar en el lugar.
+ * @return Verdadero si había datos válidos y todos los percentiles estaban en rango.
+ */
+bool pdaPercentiles(float data[], size_t n_data, const float percentiles[], size_t count,
+                    float results[], float scratch[]) {
+    if (percentiles == NULL || results == NULL || count > PDA_MAX_PERCENTILES)
+        return false;
+
+    // lleva los datos válidos al inicio del buffer de trabajo; en el lugar se intercambian, para
+    // que el array resultante sea una permutación del original
+    float * work = (scratch != NULL) ? scratch : data;
+    size_t m = 0;
+    for (size_t i = 0; data != NULL && i < n_data; i++) {
+        float value = data[i];
+        if (maskIsDataTrue(value)) {
+            if (work == data)
+                data[i] = data[m];
+            work[m++] = value;
+        }
+    }
+
+    // rangos necesarios de todos los percentiles, ordenados y sin repetir
+    size_t ranks[MAX_RANKS];
+    size_t rankCount = 0;
+    bool ok = (m > 0);
+    for (size_t k = 0; k < count; k++) {
+        if (!percentileInRange(percentiles[k])) {
+            ok = false;
+            continue;
+        }
+        if (m == 0)
+            continue;
+        double position = percentilePosition(percentiles[k], m);
+        size_t lower = (size_t)position;
+        ranks[rankCount++] = lower;
+        if (lower + 1 < m && position > (double)lower)
+            ranks[rankCount++] = lower + 1;
+    }
+    for (size_t i = 1; i < rankCount; i++) {
+        size_t rank = ranks[i], j = i;
+        while (j > 0 && ranks[j - 1] > rank) {
+            ranks[j] = ranks[j - 1];
+            j--;
+        }
+        ranks[j] = rank;
+    }
+    size_t unique = 0;
+    for (size_t i = 0; i < rankCount; i++) {
+        if (unique == 0 || ranks[unique - 1] != ranks[i])
+            ranks[unique++] = ranks[i];
+    }
+
+    if (m > 0 && unique > 0)
+        multiSelect(work, 0, m, ranks, 0, unique, depthLimit(m));
+
+    for (size_t k = 0; k < count; k++) {
+        if (!percentileInRange(percentiles[k])) {
+            results[k] = MSN_PERCENTILE_OUT_OF_RANGE;
+        } else if (m == 0) {
+            results[k] = MSN_VOID_ARRAY_VALUE;
+        } else {
+            double position = percentilePosition(percentiles[k], m);
+            size_t lower = (size_t)position;
+            double fraction = position - (double)lower;
+            double value = work[lower];
+            if (lower + 1 < m && fraction > 0.0)
+                value += fraction * ((double)work[lower + 1] - value);
+            results[k] = (float)value;
+        }
+    }
+    return ok;
+}
+
+/* === End of documentation ==================================================================== */
@@ -0,0 +1,113 @@
+/*
+ * Nombre del archivo: PdaPercentile.h
+ * Versión: 0.1
+ * Descripción:
+ *  Mediana y percentiles de datos de material particulado por selección, sin ordenar el array
+ *  completo.
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "ParticulateDataAnalyzer.h"
+
+#ifndef PDAPERCENTILE_H
+#define PDAPERCENTILE_H
+
+/**
+ * @file PdaPercentile.h
+ * @brief Percentiles (mediana, P95, P98) en tiempo promedio O(n) mediante introselect.
+ *
+ * - pdaPercentile: Calcula un percentil.
+ * - pdaPercentiles: Calcula varios percentiles en una sola partición recursiva.
+ *
+ * Solo se consideran los datos que cumplen maskIsDataTrue. El percentil p se obtiene por
+ * interpolación lineal entre los estadísticos de orden vecinos a la posición (m - 1) * p / 100,
+ * con m la cantidad de datos válidos (el mismo criterio que el método por defecto de numpy).
+ *
+ * Si se entrega un buffer scratch de al menos n_data elementos, los datos válidos se copian allí y
+ * el array original no se modifica. Si scratch es NULL, el array se reordena en el lugar: conserva
+ * los mismos valores, incluidos los inválidos, en otro orden.
+ */
+
+/* === Headers files inclusions ================================================================ */
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+/**
+ * @brief Valor retornado cuando el percentil solicitado está fuera del rango [0, 100].
+ */
+#define MSN_PERCENTILE_OUT_OF_RANGE -555
+
+/**
+ * @brief Cantidad máxima de percentiles calculables en una llamada a pdaPercentiles.
+ */
+#define PDA_MAX_PERCENTILES 32
+
+/* === Public data type declarations =========================================================== */
+
+/* === Public variable declarations ============================================================ */
+
+/* === Public function declarations ============================================================ */
+
+/**
+ * @brief Calcula un percentil de los datos válidos.
+ *
+ * @param data Un array de datos flotantes; si scratch es NULL se permuta en el lugar.
+ * @param n_data El número de elementos en el array.
+ * @param percentile Percentil en [0, 100]; 50 es la mediana.
+ * @param scratch Buffer de al menos n_data elementos, o NULL para trabajar en el lugar.
+ * @return El percentil, MSN_VOID_ARRAY_VALUE si no hay datos válidos o
+ *         MSN_PERCENTILE_OUT_OF_RANGE si el percentil no está en [0, 100].
+ */
+float pdaPercentile(float data[], size_t n_data, float percentile, float scratch[]);
+
+/**
+ * @brief Calcula varios percentiles de los datos válidos en una sola partición recursiva.
+ *
+ * Los percentiles pueden estar en cualquier orden. Cada resultado sigue las mismas reglas que
+ * pdaPercentile.
+ *
+ * @param data Un array de datos flotantes; si scratch es NULL se permuta en el lugar.
+ * @param n_data El número de elementos en el array.
+ * @param percentiles Percentiles solicitados, cada uno en [0, 100].
+ * @param count Cantidad de percentiles, como máximo PDA_MAX_PERCENTILES.
+ * @param results Array de count elementos donde se almacenan los resultados.
+ * @param scratch Buffer de al menos n_data elementos, o NULL para trabajar en el lugar.
+ * @return Verdadero si había datos válidos y todos los percentiles estaban en rango.
+ */
+bool pdaPercentiles(float data[], size_t n_data, const float percentiles[], size_t count,
+                    float results[], float scratch[]);
+
+/* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PDAPERCENTILE_H */
@@ -0,0 +1,216 @@
+/*
+ * Nombre del archivo: PdaPool.c
+ * Versión: 0.1
+ * Descripción:
+ *  Conjuntos de bloques de memoria de tamaño fijo y capacidad definida al compilar, para crear
+ *  los objetos de la biblioteca sin memoria dinámica (macro USE_STATIC_MEM).
+ *
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo bajo los términos de la
+ * Licencia Pública General GNU publicada por la Free Software Foundation, ya sea la versión 3 de la
+ * Licencia, o (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil, pero SIN NINGUNA GARANTÍA; sin
+ * siquiera la garantía implícita de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU junto con este programa.
+ * Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ */
+
+/**
+ * @file PdaPool.c
+ * @brief Implementación de los conjuntos de bloques.
+ *
+ * Un único cerrojo protege todos los conjuntos: las secciones protegidas son de unas pocas
+ * instrucciones y solo se ejecutan al crear o liberar objetos, por lo que no hay contención que
+ * justifique un cerrojo por conjunto.
+ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "PdaPool.h"
+#include <string.h>
+
+#ifndef PDA_POOL_LOCK
+#include <stdatomic.h>
+#endif
+
+/* === Macros definitions ====================================================================== */
+
+#ifndef PDA_POOL_LOCK
+/**
+ * @brief Toma el cerrojo de los conjuntos.
+ */
+#define PDA_POOL_LOCK()                                                                            \
+    do {                                                                                           \
+    } while (atomic_flag_test_and_set_explicit(&poolLock, memory_order_acquire))
+
+/**
+ * @brief Libera el cerrojo de los conjuntos.
+ */
+#define PDA_POOL_UNLOCK() atomic_flag_clear_explicit(&poolLock, memory_order_release)
+
+/**
+ * @brief Indica que el cerrojo es el atomic_flag de este módulo.
+ */
+#define PDA_POOL_DEFAULT_LOCK 1
+#endif
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+#ifdef PDA_POOL_DEFAULT_LOCK
+/**
+ * @brief Cerrojo de todos los conjuntos.
+ */
+static atomic_flag poolLock = ATOMIC_FLAG_INIT;
+#endif
+
+/**
+ * @brief Función que recibe los pedidos rechazados.
+ */
+static PdaPoolExhaustedFn exhaustedHandler;
+
+/**
+ * @brief Contexto de exhaustedHandler.
+ */
+static void * exhaustedContext;
+
+/* === Private function implementation ========================================================= */
+
+/**
+ * @brief Cuenta un pedido rechazado y lo informa, con el cerrojo tomado; lo libera al salir.
+ */
+static void rejectLocked(PdaPool * pool) {
+    pool->failures++;
+    PdaPoolExhaustedFn handler = exhaustedHandler;
+    void * context = exhaustedContext;
+    PDA_POOL_UNLOCK();
+    if (handler != NULL)
+        handler(pool, context);
+}
+
+/* === Public function implementation ========================================================== */
+
+/**
+ * @brief Entrega un bloque del conjunto.
+ *
+ * @param pool Conjunto.
+ * @return Un bloque o NULL si no quedan bloques libres.
+ */
+void * pdaPoolAcquire(PdaPool * pool) {
+    if (pool == NULL)
+        return NULL;
+    PDA_POOL_LOCK();
+    void * block = pool->freeList;
+    if (block != NULL) {
+        memcpy(&pool->freeList, block, sizeof(void *));
+    } else if (pool->fresh < pool->capacity) {
+        block = pool->storage + pool->fresh * pool->blockSize;
+        pool->fresh++;
+    } else {
+        rejectLocked(pool);
+        return NULL;
+    }
+    pool->used++;
+    if (pool->used > pool->highWater)
+        pool->highWater = pool->used;
+    PDA_POOL_UNLOCK();
+    return block;
+}
+
+/**
+ * @brief Devuelve un bloque al conjunto.
+ *
+ * @param pool Conjunto del que se obtuvo el bloque.
+ * @param block Bloque a devolver; se ignora si es NULL.
+ */
+void pdaPoolRelease(PdaPool * pool, void * block) {
+    if (pool == NULL || block == NULL)
+        return;
+    PDA_POOL_LOCK();
+    memcpy(block, &pool->freeList, sizeof(void *));
+    pool->freeList = block;
+    pool->used--;
+    PDA_POOL_UNLOCK();
+}
+
+/**
+ * @brief Cuenta como rechazado un pedido que no entra en un bloque y lo informa.
+ *
+ * @param pool Conjunto.
+ */
+void pdaPoolReject(PdaPool * pool) {
+    if (pool == NULL)
+        return;
+    PDA_POOL_LOCK();
+    rejectLocked(pool);
+}
+
+/**
+ * @brief Obtiene el uso de un conjunto.
+ *
+ * @param pool Conjunto.
+ * @param usage Estructura donde se almacena el uso.
+ */
+void pdaPoolUsage(const PdaPool * pool, PdaPoolUsage * usage) {
+    if (pool == NULL || usage == NULL)
+        return;
+    PDA_POOL_LOCK();
+    usage->capacity = pool->capacity;
+    usage->used = pool->used;
+    usage->highWater = pool->highWater;
+    usage->failures = pool->failures;
+    PDA_POOL_UNLOCK();
+}
+
+/**
+ * @brief Registra la función que recibe los pedidos rechazados de todos los conjuntos.
+ *
+ * @param handler Función a llamar; NULL para no informar.
+ * @param context Puntero que se entrega a handler.
+ */
+void pdaPoolSetExhaustedHandler(PdaPoolExhaustedFn handler, void * context) {
+    PDA_POOL_LOCK();
+    exhaustedHandler = handler;
+    exhaustedContext = context;
+    PDA_POOL_UNLOCK();
+}
+
+/**
+ * @brief Retorna el nombre de un conjunto.
+ *
+ * @param pool Conjunto.
+ * @return Nombre indicado en PDA_POOL_INITIALIZER.
+ */
+const char * pdaPoolName(const PdaPool * pool) {
+    return pool == NULL ? NULL : pool->name;
+}
+
+/**
+ * @brief Indica si la biblioteca se compiló sin memoria dinámica.
+ *
+ * @return Verdadero si se definió USE_STATIC_MEM.
+ */
+bool pdaPoolStaticMem(void) {
+#ifdef USE_STATIC_MEM
+    return true;
+#else
+    return false;
+#endif
+}
+
+/* === End of documentation ==================================================================== */
@@ -0,0 +1,189 @@
+/*
+ * Nombre del archivo: PdaPool.h
+ * Versión: 0.1
+ * Descripción:
+ *  Conjuntos de bloques de memoria de tamaño fijo y capacidad definida al compilar, para crear
+ *  los objetos de la biblioteca sin memoria dinámica (macro USE_STATIC_MEM).
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifndef PDAPOOL_H
+#define PDAPOOL_H
+
+/**
+ * @file PdaPool.h
+ * @brief Conjuntos de bloques estáticos con entrega y devolución O(1).
+ *
+ * - pdaPoolAcquire / pdaPoolRelease: Entrega y devuelve un bloque.
+ * - pdaPoolUsage: Bloques en uso, máximo histórico y pedidos rechazados.
+ * - pdaPoolSetExhaustedHandler: Función a llamar cuando un pedido no puede atenderse.
+ * - pdaPoolStaticMem: Indica si la biblioteca se compiló con USE_STATIC_MEM.
+ *
+ * Modo sin memoria dinámica: con la macro USE_STATIC_MEM (la que define el makefile) ningún módulo
+ * llama a malloc. Los objetos que la biblioteca crea (PdaRollingWindow, PdaRangeIndex, PdaRing y
+ * PdaFleet) se toman de un PdaPool propio de cada módulo, con la cantidad de objetos y su tamaño
+ * máximo fijados por macros que pueden redefinirse al compilar. Los valores por defecto reservan
+ * pocos kilobytes por módulo (un objeto chico en la mayoría), de modo que cada aplicación los
+ * amplía según lo que use, por ejemplo -DPDA_WINDOW_MAX_INSTANCES=4; cada módulo publica su
+ * PdaPool para consultar su uso. Las estructuras que reserva el llamador (PdaAccumulator,
+ * PdaSketch, PdaAqiStation, PdaResampler) y PdaParallel no usan memoria dinámica en ningún modo.
+ * Cuando un conjunto se agota, la función de creación retorna NULL, el pedido se cuenta en
+ * PdaPoolUsage::failures y se llama a la función registrada con pdaPoolSetExhaustedHandler.
+ *
+ * Los bloques nunca entregados se toman en orden del arreglo y los devueltos se enlazan en una
+ * lista dentro de los propios bloques, por lo que el conjunto no necesita inicialización ni
+ * memoria adicional y entregar o devolver un bloque cuesta lo mismo con cualquier ocupación.
+ *
+ * Las operaciones se protegen con PDA_POOL_LOCK / PDA_POOL_UNLOCK, por defecto un spinlock con
+ * atomic_flag de C11. En un microcontrolador sin instrucciones atómicas pueden redefinirse al
+ * compilar, por ejemplo para deshabilitar interrupciones. Los objetos no deben crearse ni
+ * liberarse desde una interrupción.
+ */
+
+/* === Headers files inclusions ================================================================ */
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+/**
+ * @brief Inicializador de un PdaPool sobre un arreglo estático de bloques.
+ *
+ * @param poolName Nombre del conjunto, para los reportes.
+ * @param blocks Arreglo de bloques; cada elemento es un bloque.
+ */
+#define PDA_POOL_INITIALIZER(poolName, blocks)                                                     \
+    {                                                                                              \
+        .name = (poolName), .storage = (unsigned char *)(blocks),                                  \
+        .blockSize = sizeof((blocks)[0]), .capacity = sizeof(blocks) / sizeof((blocks)[0]),        \
+    }
+
+/* === Public data type declarations =========================================================== */
+
+/**
+ * @brief Conjunto de bloques de tamaño fijo. Se inicializa con PDA_POOL_INITIALIZER y sus campos
+ *        son privados del módulo.
+ */
+typedef struct {
+    const char * name;       /**< Nombre del conjunto. */
+    unsigned char * storage; /**< Arreglo de bloques. */
+    size_t blockSize;        /**< Tamaño de cada bloque en bytes, al menos sizeof(void *). */
+    size_t capacity;         /**< Cantidad de bloques. */
+    void * freeList;         /**< Bloques devueltos, enlazados a través de su primer puntero. */
+    size_t fresh;            /**< Bloques del arreglo entregados al menos una vez. */
+    size_t used;             /**< Bloques entregados y no devueltos. */
+    size_t highWater;        /**< Mayor valor alcanzado por used. */
+    size_t failures;         /**< Pedidos rechazados por falta de bloques. */
+} PdaPool;
+
+/**
+ * @brief Uso de un conjunto.
+ */
+typedef struct {
+    size_t capacity;  /**< Cantidad de bloques. */
+    size_t used;      /**< Bloques en uso. */
+    size_t highWater; /**< Mayor cantidad de bloques en uso simultáneo. */
+    size_t failures;  /**< Pedidos rechazados por falta de bloques o por tamaño. */
+} PdaPoolUsage;
+
+/**
+ * @brief Función que recibe los pedidos rechazados.
+ *
+ * @param pool Conjunto que rechazó el pedido.
+ * @param context Puntero entregado a pdaPoolSetExhaustedHandler.
+ */
+typedef void (*PdaPoolExhaustedFn)(const PdaPool * pool, void * context);
+
+/* === Public variable declarations ============================================================ */
+
+/* === Public function declarations ============================================================ */
+
+/**
+ * @brief Entrega un bloque del conjunto.
+ *
+ * @param pool Conjunto.
+ * @return Un bloque de pool->blockSize bytes, alineado como el tipo de los bloques, o NULL si
+ *         no quedan bloques libres (el pedido se cuenta y se informa).
+ */
+void * pdaPoolAcquire(PdaPool * pool);
+
+/**
+ * @brief Devuelve un bloque al conjunto.
+ *
+ * @param pool Conjunto del que se obtuvo el bloque.
+ * @param block Bloque a devolver; se ignora si es NULL.
+ */
+void pdaPoolRelease(PdaPool * pool, void * block);
+
+/**
+ * @brief Cuenta como rechazado un pedido que el módulo no puede atender con el tamaño de los
+ *        bloques (por ejemplo, una ventana mayor que la máxima) y lo informa.
+ *
+ * @param pool Conjunto.
+ */
+void pdaPoolReject(PdaPool * pool);
+
+/**
+ * @brief Obtiene el uso de un conjunto.
+ *
+ * @param pool Conjunto.
+ * @param usage Estructura donde se almacena el uso.
+ */
+void pdaPoolUsage(const PdaPool * pool, PdaPoolUsage * usage);
+
+/**
+ * @brief Registra la función que recibe los pedidos rechazados de todos los conjuntos.
+ *
+ * @param handler Función a llamar, fuera de la sección protegida; NULL para no informar.
+ * @param context Puntero que se entrega a handler.
+ */
+void pdaPoolSetExhaustedHandler(PdaPoolExhaustedFn handler, void * context);
+
+/**
+ * @brief Retorna el nombre de un conjunto.
+ *
+ * @param pool Conjunto.
+ * @return Nombre indicado en PDA_POOL_INITIALIZER.
+ */
+const char * pdaPoolName(const PdaPool * pool);
+
+/**
+ * @brief Indica si la biblioteca se compiló sin memoria dinámica (macro USE_STATIC_MEM).
+ *
+ * @return Verdadero si los objetos se toman de conjuntos estáticos.
+ */
+bool pdaPoolStaticMem(void);
+
+/* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PDAPOOL_H */
@@ -0,0 +1,172 @@
+/*
+ * Nombre del archivo: PdaQuantized.c
+ * Versión: 0.1
+ * Descripción:
+ *  Datos de MP cuantizados a décimas en 16 bits y estadísticas calculadas directamente sobre
+ *  ellos, sin convertirlos a float.
+ *
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo bajo los términos de la
+ * Licencia Pública General GNU publicada por la Free Software Foundation, ya sea la versión 3 de la
+ * Licencia, o (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil, pero SIN NINGUNA GARANTÍA; sin
+ * siquiera la garantía implícita de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU junto con este programa.
+ * Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ */
+
+/**
+ * @file PdaQuantized.c
+ * @brief Implementación de la cuantización a 16 bits y de sus estadísticas.
+ *
+ * Cada bloque de PDA_REDUCE_BLOCK códigos se reduce con pdaReduceQ16 y se convierte en un
+ * PdaAccumulator con aritmética entera: con n códigos válidos de suma S y suma de cuadrados Q,
+ * n * Q - S^2 es exacto en 64 bits y menor que 2^53, por lo que M2 = (n * Q - S^2) / n del
+ * bloque no sufre cancelación. Los bloques se combinan con pdaAccMerge.
+ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "PdaQuantized.h"
+#include "PdaKernels.h"
+
+/* === Macros definitions ====================================================================== */
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/* === Private function implementation ========================================================= */
+
+/**
+ * @brief Convierte la reducción de un bloque de códigos en un acumulador.
+ *
+ * @param reduction Resultado de pdaReduceQ16 para el bloque.
+ * @param n_data Cantidad de códigos del bloque, a lo sumo PDA_REDUCE_BLOCK.
+ * @param block Acumulador donde se almacena el resultado.
+ */
+static void blockAccumulator(const PdaReductionQ16 * reduction, size_t n_data,
+                             PdaAccumulator * block) {
+    pdaAccInit(block);
+    block->rejectedCount = n_data - reduction->validCount;
+    if (reduction->validCount == 0)
+        return;
+    uint64_t n = reduction->validCount;
+    double scale = PDA_Q16_SCALE;
+    block->validCount = reduction->validCount;
+    block->mean = (double)reduction->sum / (double)n / scale;
+    block->m2 = (double)(n * reduction->sumOfSquares - reduction->sum * reduction->sum) /
+                (double)n / (scale * scale);
+    block->min = pdaQ16Decode(reduction->min);
+    block->max = pdaQ16Decode(reduction->max);
+}
+
+/* === Public function implementation ========================================================== */
+
+/**
+ * @brief Cuantiza un dato de MP redondeando a la décima más cercana.
+ *
+ * @param value Dato de MP.
+ * @return Código del dato, o PDA_Q16_NO_DATA si no es válido.
+ */
+PdaQ16 pdaQ16Encode(float value) {
+    if (!maskIsDataTrue(value))
+        return PDA_Q16_NO_DATA;
+    long code = (long)((double)value * PDA_Q16_SCALE + 0.5);
+    if (code < PDA_Q16_MIN)
+        return PDA_Q16_MIN;
+    if (code > PDA_Q16_MAX)
+        return PDA_Q16_MAX;
+    return (PdaQ16)code;
+}
+
+/**
+ * @brief Recupera el valor de un dato cuantizado.
+ *
+ * @param code Dato cuantizado.
+ * @return Valor en µg/m³, o MSN_NOT_DATA si el código no es válido.
+ */
+float pdaQ16Decode(PdaQ16 code) {
+    if (!pdaQ16IsValid(code))
+        return MSN_NOT_DATA;
+    return (float)((double)code / PDA_Q16_SCALE);
+}
+
+/**
+ * @brief Cuantiza un array de datos de MP.
+ *
+ * @param data Array de datos flotantes.
+ * @param n_data Número de elementos en el array.
+ * @param codes Array de n_data códigos donde se almacena el resultado.
+ */
+void pdaQ16EncodeArray(const float * data, size_t n_data, PdaQ16 * codes) {
+    if (data == NULL || codes == NULL)
+        return;
+    for (size_t i = 0; i < n_data; i++)
+        codes[i] = pdaQ16Encode(data[i]);
+}
+
+/**
+ * @brief Recupera los valores de un array de datos cuantizados.
+ *
+ * @param codes Array de datos cuantizados.
+ * @param n_data Número de elementos en el array.
+ * @param data Array de n_data flotantes donde se almacena el resultado.
+ */
+void pdaQ16DecodeArray(const PdaQ16 * codes, size_t n_data, float * data) {
+    if (codes == NULL || data == NULL)
+        return;
+    for (size_t i = 0; i < n_data; i++)
+        data[i] = pdaQ16Decode(codes[i]);
+}
+
+/**
+ * @brief Agrega un bloque de datos cuantizados a un acumulador, de a PDA_REDUCE_BLOCK códigos.
+ *
+ * @param acc Acumulador.
+ * @param codes Array de datos cuantizados.
+ * @param n_data Número de elementos en el array.
+ */
+void pdaAccPushQ16(PdaAccumulator * acc, const PdaQ16 * codes, size_t n_data) {
+    if (acc == NULL || codes == NULL)
+        return;
+    for (size_t done = 0; done < n_data; done += PDA_REDUCE_BLOCK) {
+        size_t count = (n_data - done < PDA_REDUCE_BLOCK) ? n_data - done : PDA_REDUCE_BLOCK;
+        PdaReductionQ16 reduction;
+        PdaAccumulator block;
+        pdaReduceQ16(codes + done, count, &reduction);
+        blockAccumulator(&reduction, count, &block);
+        pdaAccMerge(acc, &block);
+    }
+}
+
+/**
+ * @brief Calcula las estadísticas de un array de datos cuantizados.
+ *
+ * @param codes Array de datos cuantizados.
+ * @param n_data Número de elementos en el array.
+ * @param stats Estructura donde se almacenan los resultados.
+ * @return Verdadero si hay al menos un dato válido; falso en caso contrario.
+ */
+bool computeParticulateStatsQ16(const PdaQ16 * codes, size_t n_data, PdaStats * stats) {
+    PdaAccumulator acc;
+    pdaAccInit(&acc);
+    pdaAccPushQ16(&acc, codes, n_data);
+    return pdaAccQuery(&acc, stats);
+}
+
+/* === End of documentation ==================================================================== */
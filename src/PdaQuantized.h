@@ -0,0 +1,170 @@
+/*
+ * Nombre del archivo: PdaQuantized.h
+ * Versión: 0.1
+ * Descripción:
+ *  Datos de MP cuantizados a décimas en 16 bits y estadísticas calculadas directamente sobre
+ *  ellos, sin convertirlos a float.
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "ParticulateDataAnalyzer.h"
+#include "PdaAccumulator.h"
+
+#ifndef PDAQUANTIZED_H
+#define PDAQUANTIZED_H
+
+/**
+ * @file PdaQuantized.h
+ * @brief Datos de MP en décimas de µg/m³ almacenados en un uint16_t (PdaQ16).
+ *
+ * - pdaQ16Encode / pdaQ16Decode: Conversión de un dato desde y hacia float.
+ * - pdaQ16EncodeArray / pdaQ16DecodeArray: Conversión de arrays.
+ * - pdaQ16IsValid: Validación como comparación entera.
+ * - pdaAccPushQ16: Agrega datos cuantizados a un acumulador.
+ * - computeParticulateStatsQ16: Estadísticas de un array cuantizado.
+ *
+ * Un dato válido (mayor que MP_MIN_VALUE y menor que MP_MAX_VALUE) se redondea a la décima más
+ * cercana y se limita a [PDA_Q16_MIN, PDA_Q16_MAX]; un dato inválido se codifica como
+ * PDA_Q16_NO_DATA. Así un dato es válido antes de codificarlo si y solo si lo es su código, y
+ * también después de decodificarlo, de modo que las cantidades de válidos y descartados no
+ * cambian. El error de cuantización es a lo sumo media décima (una décima junto a MP_MAX_VALUE).
+ *
+ * Las estadísticas usan pdaReduceQ16, que suma los códigos en enteros de 64 bits con los núcleos
+ * vectoriales enteros: la suma, la suma de cuadrados, el mínimo y el máximo de los códigos son
+ * exactos e iguales en todos los núcleos, y cada dato ocupa la mitad de memoria que un float.
+ */
+
+/* === Headers files inclusions ================================================================ */
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+/**
+ * @brief Códigos por unidad de concentración: un código es una décima de µg/m³.
+ */
+#define PDA_Q16_SCALE 10
+
+/**
+ * @brief Código de un dato inválido o ausente. Un buffer en cero no tiene datos.
+ */
+#define PDA_Q16_NO_DATA 0
+
+/**
+ * @brief Menor código válido (0.1 µg/m³, que como float supera MP_MIN_VALUE).
+ */
+#define PDA_Q16_MIN 1
+
+/**
+ * @brief Mayor código válido (499.9 µg/m³, la mayor décima menor que MP_MAX_VALUE).
+ */
+#define PDA_Q16_MAX 4999
+
+/* === Public data type declarations =========================================================== */
+
+/**
+ * @brief Dato de MP cuantizado a décimas de µg/m³.
+ */
+typedef uint16_t PdaQ16;
+
+/* === Public variable declarations ============================================================ */
+
+/* === Public function declarations ============================================================ */
+
+/**
+ * @brief Indica si un código corresponde a un dato válido, con una única comparación sin signo.
+ *
+ * @param code Dato cuantizado.
+ * @return Verdadero si code está en [PDA_Q16_MIN, PDA_Q16_MAX].
+ */
+static inline bool pdaQ16IsValid(PdaQ16 code) {
+    return (uint16_t)(code - PDA_Q16_MIN) <= PDA_Q16_MAX - PDA_Q16_MIN;
+}
+
+/**
+ * @brief Cuantiza un dato de MP.
+ *
+ * @param value Dato de MP.
+ * @return Código del dato, o PDA_Q16_NO_DATA si no es válido.
+ */
+PdaQ16 pdaQ16Encode(float value);
+
+/**
+ * @brief Recupera el valor de un dato cuantizado.
+ *
+ * @param code Dato cuantizado.
+ * @return Valor en µg/m³, o MSN_NOT_DATA si el código no es válido.
+ */
+float pdaQ16Decode(PdaQ16 code);
+
+/**
+ * @brief Cuantiza un array de datos de MP.
+ *
+ * @param data Array de datos flotantes.
+ * @param n_data Número de elementos en el array.
+ * @param codes Array de n_data códigos donde se almacena el resultado.
+ */
+void pdaQ16EncodeArray(const float * data, size_t n_data, PdaQ16 * codes);
+
+/**
+ * @brief Recupera los valores de un array de datos cuantizados.
+ *
+ * @param codes Array de datos cuantizados.
+ * @param n_data Número de elementos en el array.
+ * @param data Array de n_data flotantes donde se almacena el resultado.
+ */
+void pdaQ16DecodeArray(const PdaQ16 * codes, size_t n_data, float * data);
+
+/**
+ * @brief Agrega un bloque de datos cuantizados a un acumulador.
+ *
+ * @param acc Acumulador.
+ * @param codes Array de datos cuantizados.
+ * @param n_data Número de elementos en el array.
+ */
+void pdaAccPushQ16(PdaAccumulator * acc, const PdaQ16 * codes, size_t n_data);
+
+/**
+ * @brief Calcula las estadísticas de un array de datos cuantizados.
+ *
+ * Los valores de error coinciden con los de computeParticulateStats.
+ *
+ * @param codes Array de datos cuantizados.
+ * @param n_data Número de elementos en el array.
+ * @param stats Estructura donde se almacenan los resultados.
+ * @return Verdadero si hay al menos un dato válido; falso en caso contrario.
+ */
+bool computeParticulateStatsQ16(const PdaQ16 * codes, size_t n_data, PdaStats * stats);
+
+/* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PDAQUANTIZED_H */
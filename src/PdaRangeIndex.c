@@ -0,0 +1,362 @@
+/*
+ * Nombre del archivo: PdaRangeIndex.c
+ * Versión: 0.1
+ * Descripción:
+ *  Índice de consultas por rango (sumas prefijas y tabla dispersa) sobre arrays históricos de
+ *  material particulado.
+ *
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo bajo los términos de la
+ * Licencia Pública General GNU publicada por la Free Software Foundation, ya sea la versión 3 de la
+ * Licencia, o (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil, pero SIN NINGUNA GARANTÍA; sin
+ * siquiera la garantía implícita de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU junto con este programa.
+ * Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ */
+
+/**
+ * @file PdaRangeIndex.c
+ * @brief Implementación del índice de consultas por rango.
+ *
+ * La fila l de la tabla dispersa guarda el mínimo (y el máximo) de los bloques [k, k + 2^l). Un
+ * tramo de m bloques completos se cubre con las filas de nivel floor(log2 m) que comienzan en su
+ * primer bloque y terminan en su último; como mínimo y máximo son idempotentes, el solapamiento
+ * no altera el resultado.
+ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "PdaRangeIndex.h"
+#include "PdaKernels.h"
+#include <math.h>   // Para INFINITY
+#include <stdlib.h> // Para malloc y free
+
+/* === Macros definitions ====================================================================== */
+
+/**
+ * @brief Cantidad de bits del argumento de __builtin_clzll, usada para calcular log2.
+ */
+#define CLZ_BITS (sizeof(unsigned long long) * 8)
+
+/* === Private data type declarations ========================================================== */
+
+/**
+ * @brief Contenido del índice.
+ */
+struct PdaRangeIndex {
+    const float * data;     /**< Array indexado. */
+    size_t size;            /**< Cantidad de datos del array. */
+    size_t blockSize;       /**< Datos por bloque. */
+    size_t blockCount;      /**< Bloques completos. */
+    size_t levels;          /**< Filas de la tabla dispersa. */
+    double shift;           /**< Referencia de las sumas prefijas: la media global. */
+    size_t * prefixCount;   /**< Datos válidos antes de cada borde de bloque. */
+    double * prefixSum;     /**< Suma de (dato - shift) antes de cada borde de bloque. */
+    double * prefixSquares; /**< Suma de (dato - shift)^2 antes de cada borde de bloque. */
+    float * minTable;       /**< Tabla dispersa de mínimos, levels filas de blockCount. */
+    float * maxTable;       /**< Tabla dispersa de máximos, levels filas de blockCount. */
+};
+
+#ifdef USE_STATIC_MEM
+/**
+ * @brief Bloque de pdaRangeIndexPool: el índice y sus tablas.
+ */
+typedef struct {
+    PdaRangeIndex index;                                     /**< Estado del índice. */
+    size_t prefixCount[PDA_RANGE_INDEX_STATIC_BLOCKS + 1];   /**< Datos válidos prefijos. */
+    double prefixSum[PDA_RANGE_INDEX_STATIC_BLOCKS + 1];     /**< Sumas prefijas. */
+    double prefixSquares[PDA_RANGE_INDEX_STATIC_BLOCKS + 1]; /**< Sumas prefijas de cuadrados. */
+    float minTable[PDA_RANGE_INDEX_STATIC_LEVELS * PDA_RANGE_INDEX_STATIC_BLOCKS]; /**< Mínimos. */
+    float maxTable[PDA_RANGE_INDEX_STATIC_LEVELS * PDA_RANGE_INDEX_STATIC_BLOCKS]; /**< Máximos. */
+} IndexBlock;
+
+_Static_assert(((size_t)1 << PDA_RANGE_INDEX_STATIC_LEVELS) > PDA_RANGE_INDEX_STATIC_BLOCKS,
+               "PDA_RANGE_INDEX_STATIC_LEVELS no alcanza para PDA_RANGE_INDEX_STATIC_BLOCKS");
+#endif
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+#ifdef USE_STATIC_MEM
+/**
+ * @brief Bloques de pdaRangeIndexPool.
+ */
+static IndexBlock indexBlocks[PDA_RANGE_INDEX_MAX_INSTANCES];
+
+PdaPool pdaRangeIndexPool = PDA_POOL_INITIALIZER("PdaRangeIndex", indexBlocks);
+#endif
+
+/* === Private variable definitions ============================================================ */
+
+/* === Private function implementation ========================================================= */
+
+/**
+ * @brief floor(log2(n)) para n > 0.
+ */
+static size_t floorLog2(size_t n) {
+    return CLZ_BITS - 1 - (size_t)__builtin_clzll((unsigned long long)n);
+}
+
+/**
+ * @brief Cantidad de filas de la tabla dispersa para blockCount bloques.
+ */
+static size_t tableLevels(size_t blockCount) {
+    return (blockCount > 0) ? floorLog2(blockCount) + 1 : 0;
+}
+
+/**
+ * @brief Reemplaza un tamaño de bloque 0 por el valor por defecto.
+ */
+static size_t effectiveBlock(size_t blockSize) {
+    return (blockSize > 0) ? blockSize : PDA_RANGE_DEFAULT_BLOCK;
+}
+
+/**
+ * @brief Agrega la reducción directa de data[begin, end) a un total.
+ */
+static void addDirect(const PdaRangeIndex * index, size_t begin, size_t end,
+                      PdaReduction * total) {
+    if (begin >= end)
+        return;
+    PdaReduction part;
+    pdaReduce(index->data + begin, end - begin, index->shift, &part);
+    total->validCount += part.validCount;
+    total->sum += part.sum;
+    total->sumOfSquares += part.sumOfSquares;
+    if (part.min < total->min)
+        total->min = part.min;
+    if (part.max > total->max)
+        total->max = part.max;
+}
+
+/**
+ * @brief Agrega los bloques completos [first, last) a un total.
+ */
+static void addBlocks(const PdaRangeIndex * index, size_t first, size_t last,
+                      PdaReduction * total) {
+    if (first >= last)
+        return;
+    total->validCount += index->prefixCount[last] - index->prefixCount[first];
+    total->sum += index->prefixSum[last] - index->prefixSum[first];
+    total->sumOfSquares += index->prefixSquares[last] - index->prefixSquares[first];
+
+    size_t level = floorLog2(last - first);
+    const float * mins = index->minTable + level * index->blockCount;
+    const float * maxs = index->maxTable + level * index->blockCount;
+    size_t other = last - ((size_t)1 << level);
+    float min = (mins[other] < mins[first]) ? mins[other] : mins[first];
+    float max = (maxs[other] > maxs[first]) ? maxs[other] : maxs[first];
+    if (min < total->min)
+        total->min = min;
+    if (max > total->max)
+        total->max = max;
+}
+
+/* === Public function implementation ========================================================== */
+
+/**
+ * @brief Construye un índice sobre un array.
+ *
+ * @param data Array de datos flotantes.
+ * @param n_data Número de elementos en el array.
+ * @param blockSize Datos por bloque; 0 equivale a PDA_RANGE_DEFAULT_BLOCK.
+ * @return El índice creado o NULL.
+ */
+PdaRangeIndex * pdaRangeIndexCreate(const float * data, size_t n_data, size_t blockSize) {
+    if (data == NULL)
+        return NULL;
+    size_t effective = effectiveBlock(blockSize);
+    size_t blockCount = n_data / effective;
+#ifdef USE_STATIC_MEM
+    if (blockCount > PDA_RANGE_INDEX_STATIC_BLOCKS) {
+        pdaPoolReject(&pdaRangeIndexPool);
+        return NULL;
+    }
+    IndexBlock * block = pdaPoolAcquire(&pdaRangeIndexPool);
+    if (block == NULL)
+        return NULL;
+    PdaRangeIndex * index = &block->index;
+    index->prefixCount = block->prefixCount;
+    index->prefixSum = block->prefixSum;
+    index->prefixSquares = block->prefixSquares;
+    index->minTable = block->minTable;
+    index->maxTable = block->maxTable;
+#else
+    size_t cells = tableLevels(blockCount) * blockCount;
+    PdaRangeIndex * index = malloc(sizeof(*index));
+    if (index == NULL)
+        return NULL;
+    index->prefixCount = malloc((blockCount + 1) * sizeof(size_t));
+    index->prefixSum = malloc((blockCount + 1) * sizeof(double));
+    index->prefixSquares = malloc((blockCount + 1) * sizeof(double));
+    index->minTable = malloc((cells > 0 ? cells : 1) * sizeof(float));
+    index->maxTable = malloc((cells > 0 ? cells : 1) * sizeof(float));
+    if (index->prefixCount == NULL || index->prefixSum == NULL || index->prefixSquares == NULL ||
+        index->minTable == NULL || index->maxTable == NULL) {
+        pdaRangeIndexDestroy(index);
+        return NULL;
+    }
+#endif
+
+    index->data = data;
+    index->size = n_data;
+    index->blockSize = effective;
+    index->blockCount = blockCount;
+    index->levels = tableLevels(blockCount);
+
+    PdaStats global;
+    index->shift = computeParticulateStats(data, n_data, &global) ? global.mean : 0.0;
+
+    index->prefixCount[0] = 0;
+    index->prefixSum[0] = 0.0;
+    index->prefixSquares[0] = 0.0;
+    for (size_t k = 0; k < index->blockCount; k++) {
+        PdaReduction block;
+        pdaReduce(data + k * index->blockSize, index->blockSize, index->shift, &block);
+        index->prefixCount[k + 1] = index->prefixCount[k] + block.validCount;
+        index->prefixSum[k + 1] = index->prefixSum[k] + block.sum;
+        index->prefixSquares[k + 1] = index->prefixSquares[k] + block.sumOfSquares;
+        index->minTable[k] = block.min;
+        index->maxTable[k] = block.max;
+    }
+
+    for (size_t level = 1; level < index->levels; level++) {
+        size_t half = (size_t)1 << (level - 1);
+        const float * prevMin = index->minTable + (level - 1) * index->blockCount;
+        const float * prevMax = index->maxTable + (level - 1) * index->blockCount;
+        float * mins = index->minTable + level * index->blockCount;
+        float * maxs = index->maxTable + level * index->blockCount;
+        for (size_t k = 0; k + 2 * half <= index->blockCount; k++) {
+            mins[k] = (prevMin[k + half] < prevMin[k]) ? prevMin[k + half] : prevMin[k];
+            maxs[k] = (prevMax[k + half] > prevMax[k]) ? prevMax[k + half] : prevMax[k];
+        }
+    }
+    return index;
+}
+
+/**
+ * @brief Libera un índice creado con pdaRangeIndexCreate.
+ *
+ * @param index Índice a liberar; se ignora si es NULL.
+ */
+void pdaRangeIndexDestroy(PdaRangeIndex * index) {
+    if (index == NULL)
+        return;
+#ifdef USE_STATIC_MEM
+    pdaPoolRelease(&pdaRangeIndexPool, index); // index es el primer campo de su IndexBlock
+#else
+    free(index->prefixCount);
+    free(index->prefixSum);
+    free(index->prefixSquares);
+    free(index->minTable);
+    free(index->maxTable);
+    free(index);
+#endif
+}
+
+/**
+ * @brief Memoria, en bytes, que ocuparía un índice.
+ *
+ * @param n_data Número de elementos del array.
+ * @param blockSize Datos por bloque; 0 equivale a PDA_RANGE_DEFAULT_BLOCK.
+ * @return Bytes reservados por pdaRangeIndexCreate.
+ */
+size_t pdaRangeIndexMemory(size_t n_data, size_t blockSize) {
+    size_t blockCount = n_data / effectiveBlock(blockSize);
+    size_t cells = tableLevels(blockCount) * blockCount;
+    return sizeof(PdaRangeIndex) +
+           (blockCount + 1) * (sizeof(size_t) + 2 * sizeof(double)) +
+           2 * (cells > 0 ? cells : 1) * sizeof(float);
+}
+
+/**
+ * @brief Calcula las estadísticas del sub-rango [begin, end).
+ *
+ * @param index Índice.
+ * @param begin Primer dato del sub-rango.
+ * @param end Dato siguiente al último del sub-rango.
+ * @param stats Estructura donde se almacenan los resultados.
+ * @return Verdadero si el sub-rango es válido y contiene al menos un dato válido.
+ */
+bool pdaRangeStats(const PdaRangeIndex * index, size_t begin, size_t end, PdaStats * stats) {
+    if (stats == NULL)
+        return false;
+    if (index == NULL || begin > end || end > index->size)
+        return pdaStatsFromMoments(0, 0, 0.0, 0.0, 0.0f, 0.0f, stats);
+
+    PdaReduction total = {.validCount = 0, .sum = 0.0, .sumOfSquares = 0.0, .min = INFINITY,
+                          .max = -INFINITY};
+    size_t firstBlock = (begin + index->blockSize - 1) / index->blockSize;
+    size_t lastBlock = end / index->blockSize;
+    if (firstBlock >= lastBlock) {
+        addDirect(index, begin, end, &total);
+    } else {
+        addDirect(index, begin, firstBlock * index->blockSize, &total);
+        addBlocks(index, firstBlock, lastBlock, &total);
+        addDirect(index, lastBlock * index->blockSize, end, &total);
+    }
+    if (total.validCount == 0)
+        return pdaStatsFromMoments(end - begin, 0, 0.0, 0.0, 0.0f, 0.0f, stats);
+
+    double n = (double)total.validCount;
+    double mean = index->shift + total.sum / n;
+    double m2 = total.sumOfSquares - total.sum * total.sum / n;
+    return pdaStatsFromMoments(end - begin, total.validCount, mean, m2, total.min, total.max,
+                               stats);
+}
+
+/**
+ * @brief Promedio de los datos válidos del sub-rango [begin, end).
+ *
+ * @param index Índice.
+ * @param begin Primer dato del sub-rango.
+ * @param end Dato siguiente al último del sub-rango.
+ * @return El promedio o MSN_VOID_ARRAY_VALUE.
+ */
+float pdaRangeAverage(const PdaRangeIndex * index, size_t begin, size_t end) {
+    PdaStats stats;
+    pdaRangeStats(index, begin, end, &stats);
+    return stats.mean;
+}
+
+/**
+ * @brief Mínimo de los datos válidos del sub-rango [begin, end).
+ *
+ * @param index Índice.
+ * @param begin Primer dato del sub-rango.
+ * @param end Dato siguiente al último del sub-rango.
+ * @return El mínimo o MSN_VOID_ARRAY_VALUE.
+ */
+float pdaRangeMin(const PdaRangeIndex * index, size_t begin, size_t end) {
+    PdaStats stats;
+    pdaRangeStats(index, begin, end, &stats);
+    return stats.min;
+}
+
+/**
+ * @brief Máximo de los datos válidos del sub-rango [begin, end).
+ *
+ * @param index Índice.
+ * @param begin Primer dato del sub-rango.
+ * @param end Dato siguiente al último del sub-rango.
+ * @return El máximo o MSN_VOID_ARRAY_VALUE.
+ */
+float pdaRangeMax(const PdaRangeIndex * index, size_t begin, size_t end) {
+    PdaStats stats;
+    pdaRangeStats(index, begin, end, &stats);
+    return stats.max;
+}
+
+/* === End of documentation ==================================================================== */
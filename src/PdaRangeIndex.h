@@ -0,0 +1,195 @@
+/*
+ * Nombre del archivo: PdaRangeIndex.h
+ * Versión: 0.1
+ * Descripción:
+ *  Índice de consultas por rango (sumas prefijas y tabla dispersa) sobre arrays históricos de
+ *  material particulado.
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "ParticulateDataAnalyzer.h"
+#include "PdaPool.h"
+
+#ifndef PDARANGEINDEX_H
+#define PDARANGEINDEX_H
+
+/**
+ * @file PdaRangeIndex.h
+ * @brief Estadísticas de sub-rangos [begin, end) de un array en tiempo constante.
+ *
+ * - pdaRangeIndexCreate: Construye el índice en O(n) sobre un array que no cambia.
+ * - pdaRangeStats: Promedio, desviación estándar, mínimo y máximo de un sub-rango.
+ * - pdaRangeAverage / pdaRangeMin / pdaRangeMax: Consultas individuales.
+ * - pdaRangeIndexMemory: Memoria que ocupará un índice, para elegir el tamaño de bloque.
+ * - pdaRangeIndexDestroy: Libera el índice.
+ *
+ * El array se divide en bloques de blockSize datos. Para cada borde de bloque se guardan la
+ * cantidad de datos válidos y las sumas prefijas de (dato - referencia) y de su cuadrado, en
+ * doble precisión, con la media global como referencia. El mínimo y el máximo de los bloques
+ * completos se obtienen de una tabla dispersa (sparse table) con dos consultas solapadas.
+ * Los extremos de un sub-rango que no completan un bloque se reducen directamente sobre el array
+ * con pdaReduce, por lo que cada consulta cuesta O(1) más a lo sumo 2 * blockSize datos.
+ *
+ * Memoria: unos (24 + 8 log2(n / blockSize)) / blockSize bytes por dato. Con blockSize = 1 las
+ * consultas son O(1) estrictas; con blockSize = 64 el índice ocupa menos de 2 bytes por dato para
+ * un día de datos a 1 Hz y cada consulta lee como mucho 128 datos con el núcleo vectorial.
+ *
+ * El índice guarda un puntero al array: este debe seguir vigente y sin cambios mientras se use.
+ * Solo se consideran los datos que cumplen maskIsDataTrue.
+ *
+ * Con USE_STATIC_MEM los índices se toman de pdaRangeIndexPool, con PDA_RANGE_INDEX_MAX_INSTANCES
+ * índices de hasta PDA_RANGE_INDEX_STATIC_BLOCKS bloques; con los valores por defecto, un índice
+ * de 4096 datos (algo más de una hora a 1 Hz) con PDA_RANGE_DEFAULT_BLOCK.
+ */
+
+/* === Headers files inclusions ================================================================ */
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+/**
+ * @brief Tamaño de bloque sugerido: un compromiso entre memoria y datos leídos por consulta.
+ */
+#define PDA_RANGE_DEFAULT_BLOCK 64
+
+#ifndef PDA_RANGE_INDEX_MAX_INSTANCES
+/**
+ * @brief Cantidad de índices disponibles con USE_STATIC_MEM.
+ */
+#define PDA_RANGE_INDEX_MAX_INSTANCES 1
+#endif
+
+#ifndef PDA_RANGE_INDEX_STATIC_BLOCKS
+/**
+ * @brief Cantidad máxima de bloques de cada índice con USE_STATIC_MEM.
+ */
+#define PDA_RANGE_INDEX_STATIC_BLOCKS 64
+#endif
+
+#ifndef PDA_RANGE_INDEX_STATIC_LEVELS
+/**
+ * @brief Filas de la tabla dispersa con USE_STATIC_MEM: floor(log2(PDA_RANGE_INDEX_STATIC_BLOCKS))
+ *        + 1.
+ */
+#define PDA_RANGE_INDEX_STATIC_LEVELS 7
+#endif
+
+/* === Public data type declarations =========================================================== */
+
+/**
+ * @brief Índice de consultas por rango. Su contenido es privado del módulo.
+ */
+typedef struct PdaRangeIndex PdaRangeIndex;
+
+/* === Public variable declarations ============================================================ */
+
+#ifdef USE_STATIC_MEM
+/**
+ * @brief Conjunto de índices del modo sin memoria dinámica, para consultar su uso.
+ */
+extern PdaPool pdaRangeIndexPool;
+#endif
+
+/* === Public function declarations ============================================================ */
+
+/**
+ * @brief Construye un índice sobre un array.
+ *
+ * @param data Array de datos flotantes; debe seguir vigente mientras se use el índice.
+ * @param n_data Número de elementos en el array.
+ * @param blockSize Datos por bloque; 0 equivale a PDA_RANGE_DEFAULT_BLOCK.
+ * @return El índice creado o NULL si data es NULL o no hay memoria disponible.
+ */
+PdaRangeIndex * pdaRangeIndexCreate(const float * data, size_t n_data, size_t blockSize);
+
+/**
+ * @brief Libera un índice creado con pdaRangeIndexCreate.
+ *
+ * @param index Índice a liberar; se ignora si es NULL.
+ */
+void pdaRangeIndexDestroy(PdaRangeIndex * index);
+
+/**
+ * @brief Memoria, en bytes, que ocuparía un índice, sin contar el array de datos.
+ *
+ * @param n_data Número de elementos del array.
+ * @param blockSize Datos por bloque; 0 equivale a PDA_RANGE_DEFAULT_BLOCK.
+ * @return Bytes reservados por pdaRangeIndexCreate.
+ */
+size_t pdaRangeIndexMemory(size_t n_data, size_t blockSize);
+
+/**
+ * @brief Calcula las estadísticas del sub-rango [begin, end).
+ *
+ * @param index Índice.
+ * @param begin Primer dato del sub-rango.
+ * @param end Dato siguiente al último del sub-rango.
+ * @param stats Estructura donde se almacenan los resultados, con las mismas reglas que
+ *        computeParticulateStats.
+ * @return Verdadero si el sub-rango es válido y contiene al menos un dato válido.
+ */
+bool pdaRangeStats(const PdaRangeIndex * index, size_t begin, size_t end, PdaStats * stats);
+
+/**
+ * @brief Promedio de los datos válidos del sub-rango [begin, end).
+ *
+ * @param index Índice.
+ * @param begin Primer dato del sub-rango.
+ * @param end Dato siguiente al último del sub-rango.
+ * @return El promedio o MSN_VOID_ARRAY_VALUE si el sub-rango no contiene datos válidos.
+ */
+float pdaRangeAverage(const PdaRangeIndex * index, size_t begin, size_t end);
+
+/**
+ * @brief Mínimo de los datos válidos del sub-rango [begin, end).
+ *
+ * @param index Índice.
+ * @param begin Primer dato del sub-rango.
+ * @param end Dato siguiente al último del sub-rango.
+ * @return El mínimo o MSN_VOID_ARRAY_VALUE si el sub-rango no contiene datos válidos.
+ */
+float pdaRangeMin(const PdaRangeIndex * index, size_t begin, size_t end);
+
+/**
+ * @brief Máximo de los datos válidos del sub-rango [begin, end).
+ *
+ * @param index Índice.
+ * @param begin Primer dato del sub-rango.
+ * @param end Dato siguiente al último del sub-rango.
+ * @return El máximo o MSN_VOID_ARRAY_VALUE si el sub-rango no contiene datos válidos.
+ */
+float pdaRangeMax(const PdaRangeIndex * index, size_t begin, size_t end);
+
+/* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PDARANGEINDEX_H */
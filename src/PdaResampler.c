@@ -0,0 +1,235 @@
+/*
+ * Nombre del archivo: PdaResampler.c
+ * Versión: 0.1
+ * Descripción:
+ *  Remuestreo de datos de material particulado en intervalos de tiempo de varias resoluciones
+ *  (por ejemplo minuto, hora y día) en una sola pasada.
+ *
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo bajo los términos de la
+ * Licencia Pública General GNU publicada por la Free Software Foundation, ya sea la versión 3 de la
+ * Licencia, o (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil, pero SIN NINGUNA GARANTÍA; sin
+ * siquiera la garantía implícita de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU junto con este programa.
+ * Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ */
+
+/**
+ * @file PdaResampler.c
+ * @brief Implementación del remuestreo en varias resoluciones.
+ *
+ * Cuando llega un dato de un intervalo nuevo se cierran, de la resolución más fina a la más
+ * gruesa, todos los intervalos abiertos que no lo contienen. Cerrar un intervalo lo emite y lo
+ * combina en el intervalo de la resolución siguiente que contiene su inicio, abriéndolo si hace
+ * falta; así los resúmenes de cada resolución se emiten en orden cronológico y cada hora se emite
+ * después de su último minuto.
+ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "PdaResampler.h"
+
+/* === Macros definitions ====================================================================== */
+
+/**
+ * @brief Base de los porcentajes.
+ */
+#define PERCENT 100
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/* === Private function implementation ========================================================= */
+
+/**
+ * @brief Inicio del intervalo de ancho width que contiene timestamp, también para fechas
+ *        anteriores a la época.
+ */
+static int64_t bucketStart(int64_t timestamp, uint32_t width) {
+    int64_t w = (int64_t)width;
+    int64_t quotient = timestamp / w;
+    if (timestamp % w < 0)
+        quotient--;
+    return quotient * w;
+}
+
+/**
+ * @brief Abre un intervalo vacío en una resolución.
+ */
+static void openLevel(PdaResamplerLevel * level, int64_t start) {
+    level->open = true;
+    level->start = start;
+    level->childCount = 0;
+    level->completeChildren = 0;
+    pdaAccInit(&level->acc);
+}
+
+/**
+ * @brief Emite el intervalo abierto de la resolución index y lo combina en la siguiente.
+ */
+static void closeLevel(PdaResampler * resampler, size_t index) {
+    PdaResamplerLevel * level = &resampler->levels[index];
+    if (!level->open)
+        return;
+
+    PdaBucket bucket;
+    bucket.start = level->start;
+    bucket.width = level->width;
+    bucket.level = index;
+    pdaAccQuery(&level->acc, &bucket.stats);
+    bucket.expectedCount = level->width / resampler->samplePeriod;
+    bucket.childCount = level->childCount;
+    bucket.completeChildren = level->completeChildren;
+    bucket.complete =
+        bucket.stats.validCount * PERCENT >= bucket.expectedCount * PDA_RESAMPLER_COMPLETENESS;
+    if (resampler->emit != NULL)
+        resampler->emit(&bucket, resampler->context);
+
+    if (index + 1 < resampler->levelCount) {
+        PdaResamplerLevel * upper = &resampler->levels[index + 1];
+        int64_t start = bucketStart(level->start, upper->width);
+        if (upper->open && upper->start != start)
+            closeLevel(resampler, index + 1);
+        if (!upper->open)
+            openLevel(upper, start);
+        pdaAccMerge(&upper->acc, &level->acc);
+        upper->childCount++;
+        if (bucket.complete)
+            upper->completeChildren++;
+    }
+    level->open = false;
+}
+
+/**
+ * @brief Cierra los intervalos que no contienen timestamp y abre el intervalo fino que lo
+ *        contiene.
+ *
+ * @return Falso si timestamp es anterior al último intervalo fino abierto.
+ */
+static bool advance(PdaResampler * resampler, int64_t timestamp) {
+    if (resampler->started && timestamp < resampler->watermark)
+        return false;
+    for (size_t i = 0; i < resampler->levelCount; i++) {
+        PdaResamplerLevel * level = &resampler->levels[i];
+        if (level->open && level->start != bucketStart(timestamp, level->width))
+            closeLevel(resampler, i);
+    }
+    PdaResamplerLevel * finest = &resampler->levels[0];
+    if (!finest->open) {
+        openLevel(finest, bucketStart(timestamp, finest->width));
+        resampler->started = true;
+        resampler->watermark = finest->start;
+    }
+    return true;
+}
+
+/* === Public function implementation ========================================================== */
+
+/**
+ * @brief Configura un remuestreador.
+ *
+ * @param resampler Remuestreador a configurar.
+ * @param widths Anchos en segundos, crecientes y cada uno múltiplo del anterior.
+ * @param levelCount Cantidad de anchos.
+ * @param samplePeriod Período de muestreo en segundos; debe dividir a widths[0].
+ * @param emit Función que recibe cada intervalo cerrado.
+ * @param context Puntero que se entrega a emit.
+ * @return Verdadero si la configuración es válida.
+ */
+bool pdaResamplerInit(PdaResampler * resampler, const uint32_t widths[], size_t levelCount,
+                      uint32_t samplePeriod, PdaBucketFn emit, void * context) {
+    if (resampler == NULL || widths == NULL || levelCount == 0 ||
+        levelCount > PDA_RESAMPLER_MAX_LEVELS || samplePeriod == 0 || widths[0] == 0 ||
+        widths[0] % samplePeriod != 0)
+        return false;
+    for (size_t i = 1; i < levelCount; i++) {
+        if (widths[i] <= widths[i - 1] || widths[i] % widths[i - 1] != 0)
+            return false;
+    }
+
+    for (size_t i = 0; i < levelCount; i++) {
+        resampler->levels[i].width = widths[i];
+        resampler->levels[i].open = false;
+    }
+    resampler->levelCount = levelCount;
+    resampler->samplePeriod = samplePeriod;
+    resampler->lateCount = 0;
+    resampler->started = false;
+    resampler->watermark = 0;
+    resampler->emit = emit;
+    resampler->context = context;
+    return true;
+}
+
+/**
+ * @brief Incorpora un dato.
+ *
+ * @param resampler Remuestreador.
+ * @param timestamp Marca de tiempo, en segundos desde la época.
+ * @param value Dato de MP.
+ * @return Verdadero si el dato se incorporó; falso si llegó atrasado.
+ */
+bool pdaResamplerPush(PdaResampler * resampler, int64_t timestamp, float value) {
+    if (!advance(resampler, timestamp)) {
+        resampler->lateCount++;
+        return false;
+    }
+    pdaAccPush(&resampler->levels[0].acc, value);
+    return true;
+}
+
+/**
+ * @brief Incorpora un array de datos con sus marcas de tiempo.
+ *
+ * @param resampler Remuestreador.
+ * @param timestamps Marcas de tiempo, no decrecientes.
+ * @param values Datos de MP.
+ * @param n_data Número de elementos.
+ */
+void pdaResamplerPushBatch(PdaResampler * resampler, const int64_t * timestamps,
+                           const float * values, size_t n_data) {
+    PdaResamplerLevel * finest = &resampler->levels[0];
+    size_t i = 0;
+    while (timestamps != NULL && values != NULL && i < n_data) {
+        if (!advance(resampler, timestamps[i])) {
+            resampler->lateCount++;
+            i++;
+            continue;
+        }
+        // tramo de datos consecutivos del mismo intervalo fino
+        int64_t end = finest->start + (int64_t)finest->width;
+        size_t j = i + 1;
+        while (j < n_data && timestamps[j] >= finest->start && timestamps[j] < end)
+            j++;
+        pdaAccPushBatch(&finest->acc, values + i, j - i);
+        i = j;
+    }
+}
+
+/**
+ * @brief Emite todos los intervalos abiertos.
+ *
+ * @param resampler Remuestreador.
+ */
+void pdaResamplerFlush(PdaResampler * resampler) {
+    for (size_t i = 0; i < resampler->levelCount; i++)
+        closeLevel(resampler, i);
+}
+
+/* === End of documentation ==================================================================== */
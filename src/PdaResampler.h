@@ -0,0 +1,193 @@
+/*
+ * Nombre del archivo: PdaResampler.h
+ * Versión: 0.1
+ * Descripción:
+ *  Remuestreo de datos de material particulado en intervalos de tiempo de varias resoluciones
+ *  (por ejemplo minuto, hora y día) en una sola pasada.
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "ParticulateDataAnalyzer.h"
+#include "PdaAccumulator.h"
+
+#ifndef PDARESAMPLER_H
+#define PDARESAMPLER_H
+
+/**
+ * @file PdaResampler.h
+ * @brief Resúmenes por intervalo de tiempo en varias resoluciones y en una sola pasada.
+ *
+ * - pdaResamplerInit: Configura las resoluciones (anchos en segundos, cada uno múltiplo del
+ *   anterior), el período de muestreo y la función que recibe cada resumen.
+ * - pdaResamplerPush / pdaResamplerPushBatch: Incorporan datos con su marca de tiempo.
+ * - pdaResamplerFlush: Emite los intervalos abiertos al final del flujo.
+ *
+ * Solo la resolución más fina lee los datos, acumulándolos en un PdaAccumulator. Al cerrarse, cada
+ * intervalo se emite y su acumulador se combina con pdaAccMerge en el intervalo de la resolución
+ * siguiente, de modo que las horas se obtienen de los minutos y los días de las horas sin volver
+ * a recorrer los datos.
+ *
+ * Los intervalos se alinean a múltiplos de su ancho contados desde la época (UTC). Las marcas de
+ * tiempo deben ser no decrecientes; un dato anterior al intervalo abierto se descarta y se cuenta
+ * en lateCount. Los intervalos sin ningún dato no se emiten.
+ *
+ * Completitud: cada resumen informa los datos esperados (ancho / período de muestreo) y si los
+ * datos válidos alcanzan PDA_RESAMPLER_COMPLETENESS por ciento. Para las resoluciones superiores
+ * también se informa cuántos intervalos inferiores tuvieron datos y cuántos fueron completos (por
+ * ejemplo, 18 de 24 horas para un promedio diario).
+ */
+
+/* === Headers files inclusions ================================================================ */
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+/**
+ * @brief Cantidad máxima de resoluciones simultáneas.
+ */
+#define PDA_RESAMPLER_MAX_LEVELS 4
+
+/**
+ * @brief Porcentaje mínimo de datos válidos para considerar completo un intervalo.
+ */
+#define PDA_RESAMPLER_COMPLETENESS 75
+
+/**
+ * @brief Anchos habituales, en segundos.
+ */
+#define PDA_MINUTE_SECONDS 60
+#define PDA_HOUR_SECONDS   3600
+#define PDA_DAY_SECONDS    86400
+
+/* === Public data type declarations =========================================================== */
+
+/**
+ * @brief Resumen de un intervalo de tiempo.
+ */
+typedef struct {
+    int64_t start;           /**< Inicio del intervalo, en segundos desde la época. */
+    uint32_t width;          /**< Ancho del intervalo, en segundos. */
+    size_t level;            /**< Índice de la resolución en la configuración. */
+    PdaStats stats;          /**< Estadísticas de los datos del intervalo. */
+    size_t expectedCount;    /**< Datos esperados según el período de muestreo. */
+    size_t childCount;       /**< Intervalos de la resolución inferior con datos. */
+    size_t completeChildren; /**< Intervalos de la resolución inferior completos. */
+    bool complete;           /**< Los datos válidos alcanzan PDA_RESAMPLER_COMPLETENESS. */
+} PdaBucket;
+
+/**
+ * @brief Función que recibe cada intervalo cerrado.
+ *
+ * @param bucket Resumen del intervalo; solo es válido durante la llamada.
+ * @param context Puntero entregado a pdaResamplerInit.
+ */
+typedef void (*PdaBucketFn)(const PdaBucket * bucket, void * context);
+
+/**
+ * @brief Estado de un intervalo abierto en una resolución.
+ */
+typedef struct {
+    uint32_t width;          /**< Ancho del intervalo, en segundos. */
+    bool open;               /**< Hay un intervalo abierto. */
+    int64_t start;           /**< Inicio del intervalo abierto. */
+    PdaAccumulator acc;      /**< Datos del intervalo abierto. */
+    size_t childCount;       /**< Intervalos inferiores combinados. */
+    size_t completeChildren; /**< Intervalos inferiores completos combinados. */
+} PdaResamplerLevel;
+
+/**
+ * @brief Remuestreador en varias resoluciones. No reserva memoria dinámica.
+ */
+typedef struct {
+    PdaResamplerLevel levels[PDA_RESAMPLER_MAX_LEVELS]; /**< Resoluciones, de fina a gruesa. */
+    size_t levelCount;                                  /**< Resoluciones configuradas. */
+    uint32_t samplePeriod;                              /**< Período de muestreo, en segundos. */
+    size_t lateCount;                                   /**< Datos descartados por atrasados. */
+    bool started;                                       /**< Ya se recibió algún dato. */
+    int64_t watermark;                                  /**< Inicio del último intervalo fino. */
+    PdaBucketFn emit;                                   /**< Receptor de los resúmenes. */
+    void * context;                                     /**< Contexto del receptor. */
+} PdaResampler;
+
+/* === Public variable declarations ============================================================ */
+
+/* === Public function declarations ============================================================ */
+
+/**
+ * @brief Configura un remuestreador.
+ *
+ * @param resampler Remuestreador a configurar.
+ * @param widths Anchos en segundos, crecientes y cada uno múltiplo del anterior.
+ * @param levelCount Cantidad de anchos, entre 1 y PDA_RESAMPLER_MAX_LEVELS.
+ * @param samplePeriod Período de muestreo en segundos (1 para datos a 1 Hz); debe dividir a
+ *                     widths[0], para que cada intervalo espere una cantidad entera de datos.
+ * @param emit Función que recibe cada intervalo cerrado.
+ * @param context Puntero que se entrega a emit.
+ * @return Verdadero si la configuración es válida.
+ */
+bool pdaResamplerInit(PdaResampler * resampler, const uint32_t widths[], size_t levelCount,
+                      uint32_t samplePeriod, PdaBucketFn emit, void * context);
+
+/**
+ * @brief Incorpora un dato.
+ *
+ * @param resampler Remuestreador.
+ * @param timestamp Marca de tiempo, en segundos desde la época.
+ * @param value Dato de MP.
+ * @return Verdadero si el dato se incorporó (válido o no); falso si llegó atrasado.
+ */
+bool pdaResamplerPush(PdaResampler * resampler, int64_t timestamp, float value);
+
+/**
+ * @brief Incorpora un array de datos con sus marcas de tiempo.
+ *
+ * Los datos consecutivos del mismo intervalo fino se acumulan juntos con pdaAccPushBatch.
+ *
+ * @param resampler Remuestreador.
+ * @param timestamps Marcas de tiempo, no decrecientes.
+ * @param values Datos de MP.
+ * @param n_data Número de elementos.
+ */
+void pdaResamplerPushBatch(PdaResampler * resampler, const int64_t * timestamps,
+                           const float * values, size_t n_data);
+
+/**
+ * @brief Emite todos los intervalos abiertos, de la resolución más fina a la más gruesa.
+ *
+ * @param resampler Remuestreador.
+ */
+void pdaResamplerFlush(PdaResampler * resampler);
+
+/* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PDARESAMPLER_H */
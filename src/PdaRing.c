@@ -0,0 +1,322 @@
+/*
+ * Nombre del archivo: PdaRing.c
+ * Versión: 0.1
+ * Descripción:
+ *  Buffer circular sin bloqueos de un productor y un consumidor, para recibir datos de MP desde
+ *  una interrupción o un hilo y calcular sus estadísticas en otro sin copiarlos.
+ *
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo bajo los términos de la
+ * Licencia Pública General GNU publicada por la Free Software Foundation, ya sea la versión 3 de la
+ * Licencia, o (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil, pero SIN NINGUNA GARANTÍA; sin
+ * siquiera la garantía implícita de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU junto con este programa.
+ * Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ */
+
+/**
+ * @file PdaRing.c
+ * @brief Implementación del buffer circular SPSC.
+ *
+ * head y tail cuentan los datos agregados y liberados desde la creación, sin volver a cero: la
+ * cantidad pendiente es head - tail (la resta sin signo es correcta aun cuando desbordan) y la
+ * posición en el buffer es el índice enmascarado con capacity - 1. Solo el productor escribe head
+ * y solo el consumidor escribe tail. El productor publica head con release después de escribir
+ * el dato, y el consumidor lo lee con acquire antes de leerlo; lo mismo ocurre en sentido inverso
+ * con tail antes de que el productor reutilice un lugar.
+ *
+ * Cada lado guarda además la última copia leída del índice del otro lado (tailCache y headCache)
+ * y solo vuelve a leer el índice atómico cuando esa copia no alcanza, de modo que en régimen
+ * normal cada lado trabaja sobre su propia línea de caché.
+ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "PdaRing.h"
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* === Macros definitions ====================================================================== */
+
+/**
+ * @brief Tamaño de una línea de caché, para separar los índices del productor y del consumidor.
+ */
+#define CACHE_LINE_SIZE 64
+
+/**
+ * @brief valor inicial de contadores
+ */
+#define INI_COUNT 0
+
+/* === Private data type declarations ========================================================== */
+
+/**
+ * @brief Buffer circular. Los campos de cada lado ocupan su propia línea de caché.
+ */
+struct PdaRing {
+    float * samples; /**< Datos, con capacity lugares. */
+    size_t mask;     /**< capacity - 1. */
+    _Alignas(CACHE_LINE_SIZE) _Atomic size_t head; /**< Agregados; lo escribe el productor. */
+    size_t tailCache;                              /**< Copia de tail del productor. */
+    _Atomic size_t dropped;                        /**< Descartados por buffer lleno. */
+    _Alignas(CACHE_LINE_SIZE) _Atomic size_t tail; /**< Liberados; lo escribe el consumidor. */
+    size_t headCache;                              /**< Copia de head del consumidor. */
+};
+
+#ifdef USE_STATIC_MEM
+/**
+ * @brief Bloque de pdaRingPool: el buffer y sus datos, alineados a una línea de caché.
+ */
+typedef struct {
+    PdaRing ring;                                                        /**< Estado. */
+    _Alignas(CACHE_LINE_SIZE) float samples[PDA_RING_STATIC_CAPACITY]; /**< Datos. */
+} RingBlock;
+#endif
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+#ifdef USE_STATIC_MEM
+/**
+ * @brief Bloques de pdaRingPool.
+ */
+static RingBlock ringBlocks[PDA_RING_MAX_INSTANCES];
+
+PdaPool pdaRingPool = PDA_POOL_INITIALIZER("PdaRing", ringBlocks);
+#endif
+
+/* === Private variable definitions ============================================================ */
+
+/* === Private function implementation ========================================================= */
+
+/**
+ * @brief Reserva la estructura y los datos de un buffer.
+ *
+ * @param capacity Capacidad solicitada, potencia de dos.
+ * @return El buffer sin inicializar los índices, o NULL si no hay lugar.
+ */
+static PdaRing * allocateRing(size_t capacity) {
+#ifdef USE_STATIC_MEM
+    if (capacity > PDA_RING_STATIC_CAPACITY) {
+        pdaPoolReject(&pdaRingPool);
+        return NULL;
+    }
+    RingBlock * block = pdaPoolAcquire(&pdaRingPool);
+    if (block == NULL)
+        return NULL;
+    block->ring.samples = block->samples;
+    return &block->ring;
+#else
+    PdaRing * ring = aligned_alloc(CACHE_LINE_SIZE, sizeof(*ring));
+    if (ring == NULL)
+        return NULL;
+    size_t bytes = capacity * sizeof(float);
+    bytes = (bytes + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE * CACHE_LINE_SIZE;
+    ring->samples = aligned_alloc(CACHE_LINE_SIZE, bytes);
+    if (ring->samples == NULL) {
+        free(ring);
+        return NULL;
+    }
+    return ring;
+#endif
+}
+
+/* === Public function implementation ========================================================== */
+
+/**
+ * @brief Crea un buffer vacío.
+ *
+ * @param capacity Cantidad de datos que puede almacenar, potencia de dos.
+ * @return El buffer creado o NULL si capacity no es válida o no hay memoria disponible.
+ */
+PdaRing * pdaRingCreate(size_t capacity) {
+    if (capacity == 0 || (capacity & (capacity - 1)) != 0 ||
+        capacity > SIZE_MAX / 2 / sizeof(float))
+        return NULL;
+    PdaRing * ring = allocateRing(capacity);
+    if (ring == NULL)
+        return NULL;
+    ring->mask = capacity - 1;
+    atomic_init(&ring->head, INI_COUNT);
+    atomic_init(&ring->tail, INI_COUNT);
+    atomic_init(&ring->dropped, INI_COUNT);
+    ring->tailCache = INI_COUNT;
+    ring->headCache = INI_COUNT;
+    return ring;
+}
+
+/**
+ * @brief Libera un buffer creado con pdaRingCreate.
+ *
+ * @param ring Buffer a liberar; se ignora si es NULL.
+ */
+void pdaRingDestroy(PdaRing * ring) {
+    if (ring == NULL)
+        return;
+#ifdef USE_STATIC_MEM
+    pdaPoolRelease(&pdaRingPool, ring); // ring es el primer campo de su RingBlock
+#else
+    free(ring->samples);
+    free(ring);
+#endif
+}
+
+/**
+ * @brief Agrega un dato al buffer. Solo para el productor.
+ *
+ * @param ring Buffer.
+ * @param value Dato de MP.
+ * @return Verdadero si se agregó; falso si el buffer estaba lleno y el dato se descartó.
+ */
+bool pdaRingPush(PdaRing * ring, float value) {
+    size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    if (head - ring->tailCache > ring->mask) {
+        ring->tailCache = atomic_load_explicit(&ring->tail, memory_order_acquire);
+        if (head - ring->tailCache > ring->mask) {
+            size_t dropped = atomic_load_explicit(&ring->dropped, memory_order_relaxed);
+            atomic_store_explicit(&ring->dropped, dropped + 1, memory_order_relaxed);
+            return false;
+        }
+    }
+    ring->samples[head & ring->mask] = value;
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Agrega un bloque de datos al buffer. Solo para el productor.
+ *
+ * El bloque se copia con a lo sumo dos memcpy y se publica con una sola escritura de head.
+ *
+ * @param ring Buffer.
+ * @param data Datos a agregar.
+ * @param n_data Cantidad de datos.
+ * @return Cantidad de datos agregados.
+ */
+size_t pdaRingPushBatch(PdaRing * ring, const float * data, size_t n_data) {
+    if (data == NULL || n_data == 0)
+        return 0;
+    size_t capacity = ring->mask + 1;
+    size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    size_t space = capacity - (head - ring->tailCache);
+    if (space < n_data) {
+        ring->tailCache = atomic_load_explicit(&ring->tail, memory_order_acquire);
+        space = capacity - (head - ring->tailCache);
+    }
+    size_t count = n_data < space ? n_data : space;
+    if (count < n_data) {
+        size_t dropped = atomic_load_explicit(&ring->dropped, memory_order_relaxed);
+        atomic_store_explicit(&ring->dropped, dropped + n_data - count, memory_order_relaxed);
+    }
+    if (count == 0)
+        return 0;
+
+    size_t start = head & ring->mask;
+    size_t first = capacity - start < count ? capacity - start : count;
+    memcpy(ring->samples + start, data, first * sizeof(float));
+    memcpy(ring->samples, data + first, (count - first) * sizeof(float));
+    atomic_store_explicit(&ring->head, head + count, memory_order_release);
+    return count;
+}
+
+/**
+ * @brief Obtiene los datos disponibles sin copiarlos. Solo para el consumidor.
+ *
+ * @param ring Buffer.
+ * @param spans Los dos tramos de datos disponibles.
+ * @return Cantidad total de datos disponibles.
+ */
+size_t pdaRingPeek(PdaRing * ring, PdaRingSpan spans[2]) {
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    ring->headCache = atomic_load_explicit(&ring->head, memory_order_acquire);
+    size_t count = ring->headCache - tail;
+    size_t start = tail & ring->mask;
+    size_t first = ring->mask + 1 - start < count ? ring->mask + 1 - start : count;
+
+    spans[0].data = first > 0 ? ring->samples + start : NULL;
+    spans[0].count = first;
+    spans[1].data = count > first ? ring->samples : NULL;
+    spans[1].count = count - first;
+    return count;
+}
+
+/**
+ * @brief Libera los datos más antiguos. Solo para el consumidor.
+ *
+ * @param ring Buffer.
+ * @param count Cantidad de datos a liberar; se limita a los datos disponibles.
+ */
+void pdaRingRelease(PdaRing * ring, size_t count) {
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    if (ring->headCache - tail < count) {
+        ring->headCache = atomic_load_explicit(&ring->head, memory_order_acquire);
+        if (ring->headCache - tail < count)
+            count = ring->headCache - tail;
+    }
+    atomic_store_explicit(&ring->tail, tail + count, memory_order_release);
+}
+
+/**
+ * @brief Acumula todos los datos disponibles y los libera. Solo para el consumidor.
+ *
+ * @param ring Buffer.
+ * @param acc Acumulador donde se agregan los datos.
+ * @return Cantidad de datos procesados.
+ */
+size_t pdaRingDrain(PdaRing * ring, PdaAccumulator * acc) {
+    PdaRingSpan spans[2];
+    size_t count = pdaRingPeek(ring, spans);
+    if (count == 0)
+        return 0;
+    pdaAccPushBatch(acc, spans[0].data, spans[0].count);
+    pdaAccPushBatch(acc, spans[1].data, spans[1].count);
+    pdaRingRelease(ring, count);
+    return count;
+}
+
+/**
+ * @brief Retorna la capacidad del buffer.
+ *
+ * @param ring Buffer.
+ * @return Cantidad de datos que puede almacenar.
+ */
+size_t pdaRingCapacity(const PdaRing * ring) {
+    return ring->mask + 1;
+}
+
+/**
+ * @brief Retorna la cantidad de datos pendientes.
+ *
+ * @param ring Buffer.
+ * @return Datos agregados y todavía no liberados.
+ */
+size_t pdaRingCount(const PdaRing * ring) {
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    size_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    return head - tail;
+}
+
+/**
+ * @brief Retorna la cantidad de datos descartados por encontrar el buffer lleno.
+ *
+ * @param ring Buffer.
+ * @return Datos perdidos desde la creación del buffer.
+ */
+size_t pdaRingDropped(const PdaRing * ring) {
+    return atomic_load_explicit(&ring->dropped, memory_order_relaxed);
+}
+
+/* === End of documentation ==================================================================== */
@@ -0,0 +1,215 @@
+/*
+ * Nombre del archivo: PdaRing.h
+ * Versión: 0.1
+ * Descripción:
+ *  Buffer circular sin bloqueos de un productor y un consumidor, para recibir datos de MP desde
+ *  una interrupción o un hilo y calcular sus estadísticas en otro sin copiarlos.
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "PdaAccumulator.h"
+#include "PdaPool.h"
+
+#ifndef PDARING_H
+#define PDARING_H
+
+/**
+ * @file PdaRing.h
+ * @brief Buffer circular SPSC (un productor, un consumidor) sin bloqueos.
+ *
+ * Lado del productor (interrupción o hilo de adquisición):
+ * - pdaRingPush: Agrega un dato.
+ * - pdaRingPushBatch: Agrega un bloque de datos.
+ *
+ * Lado del consumidor (hilo de cálculo):
+ * - pdaRingPeek: Obtiene los datos disponibles como a lo sumo dos tramos contiguos del buffer.
+ * - pdaRingRelease: Libera los datos ya procesados.
+ * - pdaRingDrain: Acumula todos los datos disponibles en un PdaAccumulator y los libera.
+ *
+ * Creación y consulta:
+ * - pdaRingCreate / pdaRingDestroy: Crea y libera un buffer.
+ * - pdaRingCapacity, pdaRingCount, pdaRingDropped: Capacidad, datos pendientes y datos perdidos.
+ *
+ * El productor y el consumidor se sincronizan solo con lecturas y escrituras atómicas de C11
+ * (acquire/release) sobre dos índices; no hay mutex, secciones críticas ni instrucciones de
+ * lectura-modificación-escritura, por lo que pdaRingPush puede llamarse desde una interrupción,
+ * incluso en un Cortex-M0, y su duración no depende de lo que haga el consumidor. Si el buffer
+ * está lleno el dato nuevo se descarta y se cuenta en pdaRingDropped.
+ *
+ * pdaRingDrain pasa los tramos de pdaRingPeek directamente a pdaAccPushBatch, que usa los núcleos
+ * de PdaKernels.h sobre la memoria del buffer: los datos no se copian. Cada función debe llamarse
+ * siempre desde el mismo lado; pdaRingCreate y pdaRingDestroy no deben ejecutarse en paralelo con
+ * el uso del buffer.
+ *
+ * Con USE_STATIC_MEM los buffers se toman de pdaRingPool, con PDA_RING_MAX_INSTANCES buffers de
+ * hasta PDA_RING_STATIC_CAPACITY datos; sin ella se usa aligned_alloc.
+ */
+
+/* === Headers files inclusions ================================================================ */
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+#ifndef PDA_RING_MAX_INSTANCES
+/**
+ * @brief Cantidad de buffers disponibles con USE_STATIC_MEM.
+ */
+#define PDA_RING_MAX_INSTANCES 2
+#endif
+
+#ifndef PDA_RING_STATIC_CAPACITY
+/**
+ * @brief Capacidad máxima de cada buffer con USE_STATIC_MEM, en datos (potencia de dos).
+ */
+#define PDA_RING_STATIC_CAPACITY 1024
+#endif
+
+/* === Public data type declarations =========================================================== */
+
+/**
+ * @brief Buffer circular de un productor y un consumidor. Su contenido es privado del módulo.
+ */
+typedef struct PdaRing PdaRing;
+
+/**
+ * @brief Tramo contiguo de datos dentro del buffer.
+ */
+typedef struct {
+    const float * data; /**< Primer dato del tramo; NULL si el tramo está vacío. */
+    size_t count;       /**< Cantidad de datos del tramo. */
+} PdaRingSpan;
+
+/* === Public variable declarations ============================================================ */
+
+#ifdef USE_STATIC_MEM
+/**
+ * @brief Conjunto de buffers del modo sin memoria dinámica, para consultar su uso.
+ */
+extern PdaPool pdaRingPool;
+#endif
+
+/* === Public function declarations ============================================================ */
+
+/**
+ * @brief Crea un buffer vacío.
+ *
+ * @param capacity Cantidad de datos que puede almacenar; debe ser una potencia de dos y, con
+ *                 USE_STATIC_MEM, no mayor que PDA_RING_STATIC_CAPACITY.
+ * @return El buffer creado o NULL si capacity no es válida o no hay memoria disponible.
+ */
+PdaRing * pdaRingCreate(size_t capacity);
+
+/**
+ * @brief Libera un buffer creado con pdaRingCreate.
+ *
+ * @param ring Buffer a liberar; se ignora si es NULL.
+ */
+void pdaRingDestroy(PdaRing * ring);
+
+/**
+ * @brief Agrega un dato al buffer. Solo para el productor.
+ *
+ * @param ring Buffer.
+ * @param value Dato de MP, válido o no (la validación la hace el consumidor).
+ * @return Verdadero si se agregó; falso si el buffer estaba lleno y el dato se descartó.
+ */
+bool pdaRingPush(PdaRing * ring, float value);
+
+/**
+ * @brief Agrega un bloque de datos al buffer. Solo para el productor.
+ *
+ * @param ring Buffer.
+ * @param data Datos a agregar.
+ * @param n_data Cantidad de datos.
+ * @return Cantidad de datos agregados; los que no entran se descartan y se cuentan como perdidos.
+ */
+size_t pdaRingPushBatch(PdaRing * ring, const float * data, size_t n_data);
+
+/**
+ * @brief Obtiene los datos disponibles sin copiarlos. Solo para el consumidor.
+ *
+ * Los datos quedan en orden de llegada: primero spans[0] y luego spans[1], que solo no está vacío
+ * cuando los datos dan la vuelta al final del buffer. Los punteros son válidos hasta liberar los
+ * datos con pdaRingRelease.
+ *
+ * @param ring Buffer.
+ * @param spans Los dos tramos de datos disponibles.
+ * @return Cantidad total de datos disponibles.
+ */
+size_t pdaRingPeek(PdaRing * ring, PdaRingSpan spans[2]);
+
+/**
+ * @brief Libera los datos más antiguos para que el productor reutilice su lugar. Solo para el
+ *        consumidor.
+ *
+ * @param ring Buffer.
+ * @param count Cantidad de datos a liberar; se limita a los datos disponibles.
+ */
+void pdaRingRelease(PdaRing * ring, size_t count);
+
+/**
+ * @brief Acumula todos los datos disponibles y los libera. Solo para el consumidor.
+ *
+ * @param ring Buffer.
+ * @param acc Acumulador donde se agregan los datos con pdaAccPushBatch.
+ * @return Cantidad de datos procesados.
+ */
+size_t pdaRingDrain(PdaRing * ring, PdaAccumulator * acc);
+
+/**
+ * @brief Retorna la capacidad del buffer.
+ *
+ * @param ring Buffer.
+ * @return Cantidad de datos que puede almacenar.
+ */
+size_t pdaRingCapacity(const PdaRing * ring);
+
+/**
+ * @brief Retorna la cantidad de datos pendientes, que puede cambiar mientras se consulta.
+ *
+ * @param ring Buffer.
+ * @return Datos agregados y todavía no liberados.
+ */
+size_t pdaRingCount(const PdaRing * ring);
+
+/**
+ * @brief Retorna la cantidad de datos descartados por encontrar el buffer lleno.
+ *
+ * @param ring Buffer.
+ * @return Datos perdidos desde la creación del buffer.
+ */
+size_t pdaRingDropped(const PdaRing * ring);
+
+/* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PDARING_H */
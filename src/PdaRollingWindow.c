@@ -0,0 +1,331 @@
+/*
+ * Nombre del archivo: PdaRollingWindow.c
+ * Versión: 0.1
+ * Descripción:
+ *  Estadísticas sobre una ventana deslizante de los últimos N datos de material particulado con
+ *  costo constante por dato.
+ *
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo bajo los términos de la
+ * Licencia Pública General GNU publicada por la Free Software Foundation, ya sea la versión 3 de la
+ * Licencia, o (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil, pero SIN NINGUNA GARANTÍA; sin
+ * siquiera la garantía implícita de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU junto con este programa.
+ * Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ */
+
+/**
+ * @file PdaRollingWindow.c
+ * @brief Implementación de la ventana deslizante de estadísticas.
+ *
+ * La suma y la suma de cuadrados se llevan desplazadas respecto de un valor de referencia y en
+ * doble precisión. Como sumar y restar datos acumula error de redondeo, cada N datos agregados se
+ * recalculan desde el buffer con pdaReduce (O(N) cada N datos, es decir O(1) amortizado), y la
+ * referencia se mueve al promedio actual.
+ *
+ * Las colas monótonas guardan posiciones del buffer circular: la del mínimo mantiene valores
+ * crecientes y la del máximo valores decrecientes, por lo que su frente es siempre el extremo de
+ * la ventana. El dato descartado es el más antiguo, así que solo puede estar al frente de la cola.
+ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "PdaRollingWindow.h"
+#include "PdaKernels.h"
+#include <stdlib.h>
+
+/* === Macros definitions ====================================================================== */
+
+/**
+ * @brief valor inicial de contadores y posiciones
+ */
+#define INI_COUNT 0
+
+/**
+ * @brief valor inicial de sumas
+ */
+#define INI_SUM 0.0
+
+/* === Private data type declarations ========================================================== */
+
+/**
+ * @brief Cola doble circular de posiciones del buffer de datos.
+ */
+typedef struct {
+    size_t * items; /**< Posiciones almacenadas. */
+    size_t head;    /**< Índice del frente de la cola. */
+    size_t count;   /**< Cantidad de posiciones en la cola. */
+} MonotonicQueue;
+
+/**
+ * @brief Estado de la ventana deslizante.
+ */
+struct PdaRollingWindow {
+    size_t size;             /**< Capacidad de la ventana. */
+    size_t count;            /**< Datos presentes en la ventana. */
+    size_t next;             /**< Posición donde se escribirá el próximo dato. */
+    size_t validCount;       /**< Datos válidos presentes en la ventana. */
+    size_t sinceRebuild;     /**< Datos agregados desde el último recálculo de las sumas. */
+    double shift;            /**< Referencia de las sumas desplazadas. */
+    double sum;              /**< Suma de (dato - shift) de los datos válidos. */
+    double sumOfSquares;     /**< Suma de (dato - shift)^2 de los datos válidos. */
+    float * samples;         /**< Buffer circular de datos. */
+    MonotonicQueue minQueue; /**< Posiciones candidatas a mínimo, valores crecientes. */
+    MonotonicQueue maxQueue; /**< Posiciones candidatas a máximo, valores decrecientes. */
+};
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+#ifdef USE_STATIC_MEM
+/**
+ * @brief Bloque de pdaWindowPool: la ventana y sus buffers.
+ */
+typedef struct {
+    PdaRollingWindow window;                 /**< Estado de la ventana. */
+    float samples[PDA_WINDOW_STATIC_SIZE];   /**< Buffer circular de datos. */
+    size_t minItems[PDA_WINDOW_STATIC_SIZE]; /**< Posiciones de la cola del mínimo. */
+    size_t maxItems[PDA_WINDOW_STATIC_SIZE]; /**< Posiciones de la cola del máximo. */
+} WindowBlock;
+#endif
+
+/* === Public variable definitions ============================================================= */
+
+#ifdef USE_STATIC_MEM
+/**
+ * @brief Bloques de pdaWindowPool.
+ */
+static WindowBlock windowBlocks[PDA_WINDOW_MAX_INSTANCES];
+
+PdaPool pdaWindowPool = PDA_POOL_INITIALIZER("PdaRollingWindow", windowBlocks);
+#endif
+
+/* === Private variable definitions ============================================================ */
+
+/* === Private function implementation ========================================================= */
+
+/**
+ * @brief Posición física del elemento index de una cola.
+ */
+static size_t queueSlot(const PdaRollingWindow * window, const MonotonicQueue * queue,
+                        size_t index) {
+    size_t slot = queue->head + index;
+    return (slot >= window->size) ? slot - window->size : slot;
+}
+
+/**
+ * @brief Descarta el frente de la cola si corresponde a la posición indicada.
+ */
+static void queueEvict(const PdaRollingWindow * window, MonotonicQueue * queue, size_t position) {
+    if (queue->count > INI_COUNT && queue->items[queue->head] == position) {
+        queue->head = (queue->head + 1 == window->size) ? INI_COUNT : queue->head + 1;
+        queue->count--;
+    }
+}
+
+/**
+ * @brief Agrega una posición a la cola del mínimo, quitando las que ya no pueden ser mínimo.
+ */
+static void minQueuePush(PdaRollingWindow * window, size_t position) {
+    MonotonicQueue * queue = &window->minQueue;
+    float value = window->samples[position];
+    while (queue->count > INI_COUNT &&
+           window->samples[queue->items[queueSlot(window, queue, queue->count - 1)]] >= value)
+        queue->count--;
+    queue->items[queueSlot(window, queue, queue->count)] = position;
+    queue->count++;
+}
+
+/**
+ * @brief Agrega una posición a la cola del máximo, quitando las que ya no pueden ser máximo.
+ */
+static void maxQueuePush(PdaRollingWindow * window, size_t position) {
+    MonotonicQueue * queue = &window->maxQueue;
+    float value = window->samples[position];
+    while (queue->count > INI_COUNT &&
+           window->samples[queue->items[queueSlot(window, queue, queue->count - 1)]] <= value)
+        queue->count--;
+    queue->items[queueSlot(window, queue, queue->count)] = position;
+    queue->count++;
+}
+
+/**
+ * @brief Recalcula las sumas desde el buffer, con la referencia en el promedio actual.
+ *
+ * Los datos presentes ocupan siempre las posiciones [0, count) del buffer, por lo que se
+ * reducen en un único bloque contiguo.
+ */
+static void rebuildSums(PdaRollingWindow * window) {
+    PdaReduction reduction;
+    if (window->validCount > INI_COUNT)
+        window->shift += window->sum / window->validCount;
+    pdaReduce(window->samples, window->count, window->shift, &reduction);
+    window->sum = reduction.sum;
+    window->sumOfSquares = reduction.sumOfSquares;
+    window->sinceRebuild = INI_COUNT;
+}
+
+/* === Public function implementation ========================================================== */
+
+/**
+ * @brief Crea una ventana deslizante vacía.
+ *
+ * @param size Cantidad de datos de la ventana.
+ * @return La ventana creada o NULL si size es 0 o no hay memoria disponible.
+ */
+PdaRollingWindow * pdaWindowCreate(size_t size) {
+    if (size == INI_COUNT)
+        return NULL;
+#ifdef USE_STATIC_MEM
+    if (size > PDA_WINDOW_STATIC_SIZE) {
+        pdaPoolReject(&pdaWindowPool);
+        return NULL;
+    }
+    WindowBlock * block = pdaPoolAcquire(&pdaWindowPool);
+    if (block == NULL)
+        return NULL;
+    PdaRollingWindow * window = &block->window;
+    window->samples = block->samples;
+    window->minQueue.items = block->minItems;
+    window->maxQueue.items = block->maxItems;
+#else
+    PdaRollingWindow * window = malloc(sizeof(*window));
+    if (window == NULL)
+        return NULL;
+    window->samples = malloc(size * sizeof(float));
+    window->minQueue.items = malloc(size * sizeof(size_t));
+    window->maxQueue.items = malloc(size * sizeof(size_t));
+    if (window->samples == NULL || window->minQueue.items == NULL ||
+        window->maxQueue.items == NULL) {
+        pdaWindowDestroy(window);
+        return NULL;
+    }
+#endif
+    window->size = size;
+    pdaWindowReset(window);
+    return window;
+}
+
+/**
+ * @brief Libera una ventana creada con pdaWindowCreate.
+ *
+ * @param window Ventana a liberar; se ignora si es NULL.
+ */
+void pdaWindowDestroy(PdaRollingWindow * window) {
+    if (window == NULL)
+        return;
+#ifdef USE_STATIC_MEM
+    pdaPoolRelease(&pdaWindowPool, window); // window es el primer campo de su WindowBlock
+#else
+    free(window->samples);
+    free(window->minQueue.items);
+    free(window->maxQueue.items);
+    free(window);
+#endif
+}
+
+/**
+ * @brief Vacía la ventana sin liberarla.
+ *
+ * @param window Ventana.
+ */
+void pdaWindowReset(PdaRollingWindow * window) {
+    if (window == NULL)
+        return;
+    window->count = INI_COUNT;
+    window->next = INI_COUNT;
+    window->validCount = INI_COUNT;
+    window->sinceRebuild = INI_COUNT;
+    window->shift = INI_SUM;
+    window->sum = INI_SUM;
+    window->sumOfSquares = INI_SUM;
+    window->minQueue.head = INI_COUNT;
+    window->minQueue.count = INI_COUNT;
+    window->maxQueue.head = INI_COUNT;
+    window->maxQueue.count = INI_COUNT;
+}
+
+/**
+ * @brief Agrega un dato a la ventana, descartando el más antiguo si está llena.
+ *
+ * @param window Ventana.
+ * @param value Dato de MP.
+ * @return Verdadero si el dato es válido; falso si fue rechazado por maskIsDataTrue.
+ */
+bool pdaWindowPush(PdaRollingWindow * window, float value) {
+    if (window == NULL)
+        return false;
+
+    size_t position = window->next;
+    if (window->count == window->size) {
+        float oldest = window->samples[position];
+        if (maskIsDataTrue(oldest)) {
+            double delta = (double)oldest - window->shift;
+            window->sum -= delta;
+            window->sumOfSquares -= delta * delta;
+            window->validCount--;
+            queueEvict(window, &window->minQueue, position);
+            queueEvict(window, &window->maxQueue, position);
+        }
+    } else {
+        window->count++;
+    }
+
+    window->samples[position] = value;
+    window->next = (position + 1 == window->size) ? INI_COUNT : position + 1;
+
+    bool valid = maskIsDataTrue(value);
+    if (valid) {
+        if (window->validCount == INI_COUNT) {
+            // sin datos válidos en la ventana las sumas se reinician exactamente
+            window->shift = value;
+            window->sum = INI_SUM;
+            window->sumOfSquares = INI_SUM;
+        }
+        double delta = (double)value - window->shift;
+        window->sum += delta;
+        window->sumOfSquares += delta * delta;
+        window->validCount++;
+        minQueuePush(window, position);
+        maxQueuePush(window, position);
+    }
+
+    if (++window->sinceRebuild >= window->size)
+        rebuildSums(window);
+    return valid;
+}
+
+/**
+ * @brief Obtiene las estadísticas de los datos presentes en la ventana.
+ *
+ * @param window Ventana.
+ * @param stats Estructura donde se almacenan los resultados.
+ * @return Verdadero si la ventana contiene al menos un dato válido.
+ */
+bool pdaWindowQuery(const PdaRollingWindow * window, PdaStats * stats) {
+    if (window == NULL)
+        return false;
+
+    double mean = INI_SUM, m2 = INI_SUM;
+    float min = INI_SUM, max = INI_SUM;
+    if (window->validCount > INI_COUNT) {
+        double n = (double)window->validCount;
+        mean = window->shift + window->sum / n;
+        m2 = window->sumOfSquares - window->sum * window->sum / n;
+        min = window->samples[window->minQueue.items[window->minQueue.head]];
+        max = window->samples[window->maxQueue.items[window->maxQueue.head]];
+    }
+    return pdaStatsFromMoments(window->count, window->validCount, mean, m2, min, max, stats);
+}
+
+/* === End of documentation ==================================================================== */
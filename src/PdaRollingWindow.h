@@ -0,0 +1,147 @@
+/*
+ * Nombre del archivo: PdaRollingWindow.h
+ * Versión: 0.1
+ * Descripción:
+ *  Estadísticas sobre una ventana deslizante de los últimos N datos de material particulado con
+ *  costo constante por dato.
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "ParticulateDataAnalyzer.h"
+#include "PdaPool.h"
+
+#ifndef PDAROLLINGWINDOW_H
+#define PDAROLLINGWINDOW_H
+
+/**
+ * @file PdaRollingWindow.h
+ * @brief Promedio, desviación estándar, mínimo y máximo móviles sobre los últimos N datos.
+ *
+ * - pdaWindowCreate: Crea una ventana de N datos.
+ * - pdaWindowPush: Agrega un dato y descarta el más antiguo si la ventana está llena.
+ * - pdaWindowQuery: Obtiene las estadísticas de los datos presentes en la ventana.
+ * - pdaWindowReset: Vacía la ventana.
+ * - pdaWindowDestroy: Libera la ventana.
+ *
+ * Los datos se guardan en un buffer circular. La suma y la suma de cuadrados se actualizan al
+ * agregar y al descartar cada dato, y el mínimo y el máximo se mantienen con colas monótonas, por
+ * lo que el costo por dato es O(1) amortizado independientemente de N. Los datos rechazados por
+ * maskIsDataTrue ocupan su lugar en la ventana pero no cuentan en el divisor.
+ *
+ * Con USE_STATIC_MEM las ventanas se toman de pdaWindowPool, con PDA_WINDOW_MAX_INSTANCES
+ * ventanas de hasta PDA_WINDOW_STATIC_SIZE datos (4 + 2 * sizeof(size_t) bytes por dato).
+ */
+
+/* === Headers files inclusions ================================================================ */
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+#ifndef PDA_WINDOW_MAX_INSTANCES
+/**
+ * @brief Cantidad de ventanas disponibles con USE_STATIC_MEM.
+ */
+#define PDA_WINDOW_MAX_INSTANCES 1
+#endif
+
+#ifndef PDA_WINDOW_STATIC_SIZE
+/**
+ * @brief Tamaño máximo de cada ventana con USE_STATIC_MEM.
+ */
+#define PDA_WINDOW_STATIC_SIZE 256
+#endif
+
+/* === Public data type declarations =========================================================== */
+
+/**
+ * @brief Ventana deslizante de estadísticas. Su contenido es privado del módulo.
+ */
+typedef struct PdaRollingWindow PdaRollingWindow;
+
+/* === Public variable declarations ============================================================ */
+
+#ifdef USE_STATIC_MEM
+/**
+ * @brief Conjunto de ventanas del modo sin memoria dinámica, para consultar su uso.
+ */
+extern PdaPool pdaWindowPool;
+#endif
+
+/* === Public function declarations ============================================================ */
+
+/**
+ * @brief Crea una ventana deslizante vacía.
+ *
+ * @param size Cantidad de datos de la ventana (por ejemplo 3600 para 60 minutos a 1 Hz).
+ * @return La ventana creada o NULL si size es 0 o no hay memoria disponible.
+ */
+PdaRollingWindow * pdaWindowCreate(size_t size);
+
+/**
+ * @brief Libera una ventana creada con pdaWindowCreate.
+ *
+ * @param window Ventana a liberar; se ignora si es NULL.
+ */
+void pdaWindowDestroy(PdaRollingWindow * window);
+
+/**
+ * @brief Vacía la ventana sin liberarla.
+ *
+ * @param window Ventana.
+ */
+void pdaWindowReset(PdaRollingWindow * window);
+
+/**
+ * @brief Agrega un dato a la ventana, descartando el más antiguo si está llena.
+ *
+ * @param window Ventana.
+ * @param value Dato de MP.
+ * @return Verdadero si el dato es válido; falso si fue rechazado por maskIsDataTrue.
+ */
+bool pdaWindowPush(PdaRollingWindow * window, float value);
+
+/**
+ * @brief Obtiene las estadísticas de los datos presentes en la ventana.
+ *
+ * Los valores de error coinciden con los de computeParticulateStats aplicada al contenido
+ * actual de la ventana.
+ *
+ * @param window Ventana.
+ * @param stats Estructura donde se almacenan los resultados.
+ * @return Verdadero si la ventana contiene al menos un dato válido.
+ */
+bool pdaWindowQuery(const PdaRollingWindow * window, PdaStats * stats);
+
+/* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PDAROLLINGWINDOW_H */
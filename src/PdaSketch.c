@@ -0,0 +1,616 @@
+/*
+ * Nombre del archivo: PdaSketch.c
+ * Versión: 0.1
+ * Descripción:
+ *  Resumen de cuantiles de memoria acotada (KLL) para el análisis de datos de material
+ *  particulado.
+ *
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo bajo los términos de la
+ * Licencia Pública General GNU publicada por la Free Software Foundation, ya sea la versión 3 de la
+ * Licencia, o (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil, pero SIN NINGUNA GARANTÍA; sin
+ * siquiera la garantía implícita de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU junto con este programa.
+ * Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ */
+
+/**
+ * @file PdaSketch.c
+ * @brief Implementación del resumen de cuantiles KLL.
+ *
+ * Los niveles comparten un único buffer: el espacio libre queda al principio y el nivel 0 crece
+ * hacia abajo, de modo que agregar un dato es una escritura en items[--levels[0]] y agregar un
+ * nivel superior no mueve datos. La compactación de un nivel conserva la mitad de un tramo par y,
+ * si el nivel tenía una cantidad impar, deja el dato sobrante en el mismo nivel; así el peso total
+ * (suma de 2^h por dato) es siempre igual a validCount.
+ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "PdaSketch.h"
+#include "PdaByteOrder.h"
+#include <math.h>   // Para INFINITY e isnan
+#include <stdlib.h> // Para qsort
+#include <string.h> // Para memmove y memcpy
+
+/* === Macros definitions ====================================================================== */
+
+/**
+ * @brief Capacidad mínima de un nivel.
+ */
+#define MIN_LEVEL_WIDTH 8
+
+/**
+ * @brief Rango válido de los percentiles.
+ */
+#define PERCENTILE_MIN 0.0f
+#define PERCENTILE_MAX 100.0f
+
+/**
+ * @brief Identificador del formato binario.
+ */
+#define SKETCH_MAGIC "PDAS"
+
+/**
+ * @brief Posición de cada campo en el encabezado del formato binario.
+ */
+#define OFFSET_MAGIC      0
+#define OFFSET_VERSION    4
+#define OFFSET_K          6
+#define OFFSET_VALID      8
+#define OFFSET_REJECTED   16
+#define OFFSET_MIN        24
+#define OFFSET_MAX        28
+#define OFFSET_RANDOM     32
+#define OFFSET_NUM_LEVELS 36
+
+/**
+ * @brief Bytes por tamaño de nivel y por dato retenido en el formato binario.
+ */
+#define LEVEL_SIZE_BYTES 2
+#define ITEM_BYTES       4
+
+/**
+ * @brief Semilla usada si pdaSketchInit recibe 0, que anularía el generador xorshift.
+ */
+#define DEFAULT_SEED 0x9E3779B9u
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/* === Private function implementation ========================================================= */
+
+/**
+ * @brief Capacidad de un nivel situado depth niveles por debajo del más alto: K (2/3)^depth.
+ */
+static uint32_t levelCapacity(uint32_t depth) {
+    uint32_t capacity = PDA_SKETCH_K;
+    while (depth-- > 0 && capacity > MIN_LEVEL_WIDTH)
+        capacity = (2 * capacity + 2) / 3;
+    return capacity > MIN_LEVEL_WIDTH ? capacity : MIN_LEVEL_WIDTH;
+}
+
+/**
+ * @brief Suma de las capacidades de numLevels niveles.
+ */
+static uint32_t totalCapacity(uint32_t numLevels) {
+    uint32_t total = 0;
+    for (uint32_t depth = 0; depth < numLevels; depth++)
+        total += levelCapacity(depth);
+    return total;
+}
+
+/**
+ * @brief Cantidad de datos del nivel h.
+ */
+static uint32_t levelSize(const PdaSketch * sketch, uint32_t h) {
+    return (uint32_t)sketch->levels[h + 1] - sketch->levels[h];
+}
+
+/**
+ * @brief Cantidad de datos retenidos en todos los niveles.
+ */
+static uint32_t retained(const PdaSketch * sketch) {
+    return PDA_SKETCH_CAPACITY - sketch->levels[0];
+}
+
+/**
+ * @brief Bit pseudoaleatorio (xorshift32) que decide qué mitad conserva una compactación.
+ */
+static uint32_t randomBit(PdaSketch * sketch) {
+    uint32_t x = sketch->randomState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    sketch->randomState = x;
+    return x & 1u;
+}
+
+/**
+ * @brief Comparador para qsort.
+ */
+static int compareFloat(const void * a, const void * b) {
+    float x = *(const float *)a, y = *(const float *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Conserva la mitad de buf[0..n) en las primeras n / 2 posiciones.
+ */
+static void halveDown(PdaSketch * sketch, float * buf, uint32_t n) {
+    uint32_t j = randomBit(sketch);
+    for (uint32_t i = 0; i < n / 2; i++, j += 2)
+        buf[i] = buf[j];
+}
+
+/**
+ * @brief Conserva la mitad de buf[0..n) en las últimas n / 2 posiciones.
+ */
+static void halveUp(PdaSketch * sketch, float * buf, uint32_t n) {
+    uint32_t j = n - 1 - randomBit(sketch);
+    for (uint32_t i = n; i-- > n / 2; j -= 2)
+        buf[i] = buf[j];
+}
+
+/**
+ * @brief Mezcla dos tramos ordenados en out.
+ *
+ * out puede solaparse con b siempre que comience al menos na posiciones antes que b: cada
+ * escritura queda detrás de la próxima lectura de b.
+ */
+static void mergeSorted(const float * a, uint32_t na, const float * b, uint32_t nb, float * out) {
+    uint32_t i = 0, j = 0, k = 0;
+    while (i < na && j < nb)
+        out[k++] = (b[j] < a[i]) ? b[j++] : a[i++];
+    while (i < na)
+        out[k++] = a[i++];
+    while (j < nb)
+        out[k++] = b[j++];
+}
+
+/**
+ * @brief Agrega un nivel superior vacío; no mueve datos.
+ */
+static bool addTopLevel(PdaSketch * sketch) {
+    if (sketch->numLevels >= PDA_SKETCH_MAX_LEVELS)
+        return false;
+    sketch->numLevels++;
+    sketch->levels[sketch->numLevels] = PDA_SKETCH_CAPACITY;
+    sketch->capacity = totalCapacity(sketch->numLevels);
+    return true;
+}
+
+/**
+ * @brief Compacta el nivel level: la mitad de sus datos sube, con peso doble, al nivel siguiente.
+ *
+ * @param sketch Resumen a compactar; el nivel level + 1 debe existir.
+ * @param level Nivel a compactar, con al menos dos datos.
+ */
+static void compactLevel(PdaSketch * sketch, uint32_t level) {
+    float * items = sketch->items;
+    uint32_t rawBeg = sketch->levels[level];
+    uint32_t rawLim = sketch->levels[level + 1];
+    uint32_t popAbove = sketch->levels[level + 2] - rawLim;
+    uint32_t rawPop = rawLim - rawBeg;
+    uint32_t oddPop = rawPop & 1u;
+    uint32_t adjBeg = rawBeg + oddPop;
+    uint32_t adjPop = rawPop - oddPop;
+    uint32_t halfAdjPop = adjPop / 2;
+
+    if (level == 0)
+        qsort(items + adjBeg, adjPop, sizeof(float), compareFloat);
+    if (popAbove == 0) {
+        halveUp(sketch, items + adjBeg, adjPop);
+    } else {
+        halveDown(sketch, items + adjBeg, adjPop);
+        mergeSorted(items + adjBeg, halfAdjPop, items + rawLim, popAbove,
+                    items + adjBeg + halfAdjPop);
+    }
+
+    sketch->levels[level + 1] -= halfAdjPop;
+    if (oddPop) {
+        sketch->levels[level] = sketch->levels[level + 1] - 1;
+        items[sketch->levels[level]] = items[rawBeg];
+    } else {
+        sketch->levels[level] = sketch->levels[level + 1];
+    }
+
+    // los niveles inferiores se desplazan para ocupar el espacio liberado
+    if (level > 0) {
+        memmove(items + sketch->levels[0] + halfAdjPop, items + sketch->levels[0],
+                (rawBeg - sketch->levels[0]) * sizeof(float));
+        for (uint32_t h = 0; h < level; h++)
+            sketch->levels[h] += halfAdjPop;
+    }
+}
+
+/**
+ * @brief Compacta el nivel más bajo que alcanzó su capacidad.
+ *
+ * @param sketch Resumen a compactar.
+ * @param forced Si ningún nivel está lleno, compacta el más bajo con al menos dos datos.
+ * @return Falso si no hay nivel compactable o si se alcanzó PDA_SKETCH_MAX_LEVELS.
+ */
+static bool compress(PdaSketch * sketch, bool forced) {
+    uint32_t level = sketch->numLevels;
+    for (uint32_t h = 0; h < sketch->numLevels && level == sketch->numLevels; h++) {
+        if (levelSize(sketch, h) >= levelCapacity(sketch->numLevels - 1 - h))
+            level = h;
+    }
+    for (uint32_t h = 0; forced && h < sketch->numLevels && level == sketch->numLevels; h++) {
+        if (levelSize(sketch, h) >= 2)
+            level = h;
+    }
+    if (level == sketch->numLevels)
+        return false;
+    if (level == sketch->numLevels - 1 && !addTopLevel(sketch))
+        return false;
+    compactLevel(sketch, level);
+    return true;
+}
+
+/**
+ * @brief Agrega un dato al nivel 0, compactando antes si el resumen está lleno.
+ */
+static bool insertLevelZero(PdaSketch * sketch, float value) {
+    while (retained(sketch) >= sketch->capacity) {
+        if (!compress(sketch, false))
+            return false;
+    }
+    sketch->items[--sketch->levels[0]] = value;
+    return true;
+}
+
+/**
+ * @brief Mezcla un tramo ordenado de datos en el nivel h (h > 0).
+ *
+ * @param sketch Resumen destino; debe tener al menos count posiciones libres.
+ * @param h Nivel destino.
+ * @param run Datos ordenados a incorporar.
+ * @param count Cantidad de datos.
+ */
+static void insertSortedRun(PdaSketch * sketch, uint32_t h, const float * run, uint32_t count) {
+    uint32_t start = sketch->levels[0];
+    memmove(sketch->items + start - count, sketch->items + start,
+            (sketch->levels[h] - start) * sizeof(float));
+    for (uint32_t lvl = 0; lvl < h; lvl++)
+        sketch->levels[lvl] -= count;
+    uint32_t oldBeg = sketch->levels[h];
+    sketch->levels[h] -= count;
+    mergeSorted(run, count, sketch->items + oldBeg, sketch->levels[h + 1] - oldBeg,
+                sketch->items + sketch->levels[h]);
+}
+
+/**
+ * @brief Indica si un percentil está en el rango [0, 100]; rechaza también NaN.
+ */
+static bool percentileInRange(float percentile) {
+    return percentile >= PERCENTILE_MIN && percentile <= PERCENTILE_MAX;
+}
+
+/* === Public function implementation ========================================================== */
+
+/**
+ * @brief Inicializa un resumen vacío.
+ *
+ * @param sketch Resumen a inicializar.
+ * @param seed Semilla del generador de compactación.
+ */
+void pdaSketchInit(PdaSketch * sketch, uint32_t seed) {
+    if (sketch == NULL)
+        return;
+    sketch->validCount = 0;
+    sketch->rejectedCount = 0;
+    sketch->min = INFINITY;
+    sketch->max = -INFINITY;
+    sketch->randomState = (seed != 0) ? seed : DEFAULT_SEED;
+    sketch->numLevels = 1;
+    sketch->capacity = totalCapacity(1);
+    sketch->levels[0] = PDA_SKETCH_CAPACITY;
+    sketch->levels[1] = PDA_SKETCH_CAPACITY;
+}
+
+/**
+ * @brief Incorpora un dato al resumen.
+ *
+ * @param sketch Resumen a actualizar.
+ * @param value Dato a incorporar.
+ * @return Verdadero si el dato era válido y se incorporó.
+ */
+bool pdaSketchAdd(PdaSketch * sketch, float value) {
+    if (sketch == NULL)
+        return false;
+    if (!maskIsDataTrue(value)) {
+        sketch->rejectedCount++;
+        return false;
+    }
+    if (!insertLevelZero(sketch, value))
+        return false;
+    sketch->validCount++;
+    if (value < sketch->min)
+        sketch->min = value;
+    if (value > sketch->max)
+        sketch->max = value;
+    return true;
+}
+
+/**
+ * @brief Incorpora un array de datos al resumen.
+ *
+ * @param sketch Resumen a actualizar.
+ * @param data Array de datos flotantes.
+ * @param n_data Número de elementos en el array.
+ */
+void pdaSketchAddBatch(PdaSketch * sketch, const float * data, size_t n_data) {
+    for (size_t i = 0; sketch != NULL && data != NULL && i < n_data; i++)
+        pdaSketchAdd(sketch, data[i]);
+}
+
+/**
+ * @brief Combina otro resumen en sketch.
+ *
+ * Los datos de cada nivel de other se mezclan en el mismo nivel de sketch, conservando su peso,
+ * y luego se compacta hasta volver a la capacidad.
+ *
+ * @param sketch Resumen destino.
+ * @param other Resumen a incorporar.
+ * @return Verdadero si se combinó.
+ */
+bool pdaSketchMerge(PdaSketch * sketch, const PdaSketch * other) {
+    if (sketch == NULL || other == NULL)
+        return false;
+    while (sketch->numLevels < other->numLevels)
+        addTopLevel(sketch);
+
+    for (uint32_t i = other->levels[0]; i < other->levels[1]; i++) {
+        if (!insertLevelZero(sketch, other->items[i]))
+            return false;
+    }
+    for (uint32_t h = 1; h < other->numLevels; h++) {
+        uint32_t count = levelSize(other, h);
+        while (sketch->levels[0] < count) {
+            if (!compress(sketch, true))
+                return false;
+        }
+        if (count > 0)
+            insertSortedRun(sketch, h, other->items + other->levels[h], count);
+    }
+    while (retained(sketch) > sketch->capacity) {
+        if (!compress(sketch, false))
+            return false;
+    }
+
+    sketch->validCount += other->validCount;
+    sketch->rejectedCount += other->rejectedCount;
+    if (other->min < sketch->min)
+        sketch->min = other->min;
+    if (other->max > sketch->max)
+        sketch->max = other->max;
+    return true;
+}
+
+/**
+ * @brief Calcula un percentil aproximado.
+ *
+ * @param sketch Resumen a consultar.
+ * @param percentile Percentil en [0, 100].
+ * @return El percentil, MSN_VOID_ARRAY_VALUE o MSN_PERCENTILE_OUT_OF_RANGE.
+ */
+float pdaSketchPercentile(const PdaSketch * sketch, float percentile) {
+    float result = MSN_VOID_ARRAY_VALUE;
+    pdaSketchPercentiles(sketch, &percentile, 1, &result);
+    return result;
+}
+
+/**
+ * @brief Calcula varios percentiles aproximados en un solo recorrido del resumen.
+ *
+ * Recorre los datos retenidos en orden creciente, mezclando los niveles, y acumula sus pesos. El
+ * percentil p es el primer dato cuyo peso acumulado alcanza p / 100 * validCount.
+ *
+ * @param sketch Resumen a consultar.
+ * @param percentiles Percentiles solicitados, cada uno en [0, 100].
+ * @param count Cantidad de percentiles, como máximo PDA_MAX_PERCENTILES.
+ * @param results Array de count elementos donde se almacenan los resultados.
+ * @return Verdadero si había datos válidos y todos los percentiles estaban en rango.
+ */
+bool pdaSketchPercentiles(const PdaSketch * sketch, const float percentiles[], size_t count,
+                          float results[]) {
+    if (sketch == NULL || percentiles == NULL || results == NULL || count > PDA_MAX_PERCENTILES)
+        return false;
+
+    // percentiles interiores ordenados de forma creciente; 0 y 100 son el mínimo y el máximo
+    size_t order[PDA_MAX_PERCENTILES];
+    size_t pending = 0;
+    bool ok = (sketch->validCount > 0);
+    for (size_t k = 0; k < count; k++) {
+        float percentile = percentiles[k];
+        if (!percentileInRange(percentile)) {
+            results[k] = MSN_PERCENTILE_OUT_OF_RANGE;
+            ok = false;
+        } else if (sketch->validCount == 0) {
+            results[k] = MSN_VOID_ARRAY_VALUE;
+        } else if (percentile == PERCENTILE_MIN) {
+            results[k] = sketch->min;
+        } else if (percentile == PERCENTILE_MAX) {
+            results[k] = sketch->max;
+        } else {
+            size_t j = pending++;
+            while (j > 0 && percentiles[order[j - 1]] > percentile) {
+                order[j] = order[j - 1];
+                j--;
+            }
+            order[j] = k;
+        }
+    }
+    if (pending == 0)
+        return ok;
+
+    // el nivel 0 se ordena en una copia local para no modificar el resumen
+    float levelZero[PDA_SKETCH_CAPACITY];
+    uint32_t zeroSize = levelSize(sketch, 0);
+    memcpy(levelZero, sketch->items + sketch->levels[0], zeroSize * sizeof(float));
+    qsort(levelZero, zeroSize, sizeof(float), compareFloat);
+    const float * cursor[PDA_SKETCH_MAX_LEVELS];
+    const float * limit[PDA_SKETCH_MAX_LEVELS];
+    cursor[0] = levelZero;
+    limit[0] = levelZero + zeroSize;
+    for (uint32_t h = 1; h < sketch->numLevels; h++) {
+        cursor[h] = sketch->items + sketch->levels[h];
+        limit[h] = sketch->items + sketch->levels[h + 1];
+    }
+
+    uint64_t weight = 0;
+    size_t next = 0;
+    float value = sketch->max;
+    while (next < pending) {
+        uint32_t best = sketch->numLevels;
+        for (uint32_t h = 0; h < sketch->numLevels; h++) {
+            if (cursor[h] < limit[h] && (best == sketch->numLevels || *cursor[h] < *cursor[best]))
+                best = h;
+        }
+        if (best == sketch->numLevels)
+            break;
+        value = *cursor[best]++;
+        weight += (uint64_t)1 << best;
+        while (next < pending && (double)percentiles[order[next]] / PERCENTILE_MAX *
+                                         (double)sketch->validCount <=
+                                     (double)weight)
+            results[order[next++]] = value;
+    }
+    while (next < pending)
+        results[order[next++]] = value;
+    return ok;
+}
+
+/**
+ * @brief Tamaño en bytes del resumen serializado.
+ *
+ * @param sketch Resumen a consultar.
+ * @return Cantidad de bytes que escribe pdaSketchSerialize.
+ */
+size_t pdaSketchSerializedSize(const PdaSketch * sketch) {
+    if (sketch == NULL)
+        return 0;
+    return PDA_SKETCH_HEADER_SIZE + (size_t)sketch->numLevels * LEVEL_SIZE_BYTES +
+           (size_t)retained(sketch) * ITEM_BYTES;
+}
+
+/**
+ * @brief Serializa el resumen en little-endian.
+ *
+ * @param sketch Resumen a serializar.
+ * @param buffer Buffer destino.
+ * @param size Tamaño del buffer.
+ * @return Bytes escritos, o 0 si el buffer es demasiado chico.
+ */
+size_t pdaSketchSerialize(const PdaSketch * sketch, uint8_t * buffer, size_t size) {
+    size_t total = pdaSketchSerializedSize(sketch);
+    if (sketch == NULL || buffer == NULL || size < total)
+        return 0;
+
+    memset(buffer, 0, PDA_SKETCH_HEADER_SIZE);
+    memcpy(buffer + OFFSET_MAGIC, SKETCH_MAGIC, strlen(SKETCH_MAGIC));
+    pdaWriteLe(buffer + OFFSET_VERSION, PDA_SKETCH_VERSION, sizeof(uint16_t));
+    pdaWriteLe(buffer + OFFSET_K, PDA_SKETCH_K, sizeof(uint16_t));
+    pdaWriteLe(buffer + OFFSET_VALID, sketch->validCount, sizeof(uint64_t));
+    pdaWriteLe(buffer + OFFSET_REJECTED, sketch->rejectedCount, sizeof(uint64_t));
+    pdaWriteFloat(buffer + OFFSET_MIN, sketch->min);
+    pdaWriteFloat(buffer + OFFSET_MAX, sketch->max);
+    pdaWriteLe(buffer + OFFSET_RANDOM, sketch->randomState, sizeof(uint32_t));
+    buffer[OFFSET_NUM_LEVELS] = (uint8_t)sketch->numLevels;
+
+    uint8_t * cursor = buffer + PDA_SKETCH_HEADER_SIZE;
+    for (uint32_t h = 0; h < sketch->numLevels; h++, cursor += LEVEL_SIZE_BYTES)
+        pdaWriteLe(cursor, levelSize(sketch, h), LEVEL_SIZE_BYTES);
+    for (uint32_t i = sketch->levels[0]; i < PDA_SKETCH_CAPACITY; i++, cursor += ITEM_BYTES)
+        pdaWriteFloat(cursor, sketch->items[i]);
+    return total;
+}
+
+/**
+ * @brief Reconstruye un resumen serializado con pdaSketchSerialize.
+ *
+ * @param sketch Resumen destino.
+ * @param buffer Buffer origen.
+ * @param size Cantidad de bytes del buffer.
+ * @return Verdadero si el formato es válido.
+ */
+bool pdaSketchDeserialize(PdaSketch * sketch, const uint8_t * buffer, size_t size) {
+    if (sketch == NULL || buffer == NULL || size < PDA_SKETCH_HEADER_SIZE ||
+        memcmp(buffer + OFFSET_MAGIC, SKETCH_MAGIC, strlen(SKETCH_MAGIC)) != 0 ||
+        pdaReadLe(buffer + OFFSET_VERSION, sizeof(uint16_t)) != PDA_SKETCH_VERSION ||
+        pdaReadLe(buffer + OFFSET_K, sizeof(uint16_t)) != PDA_SKETCH_K)
+        return false;
+
+    uint32_t numLevels = buffer[OFFSET_NUM_LEVELS];
+    if (numLevels == 0 || numLevels > PDA_SKETCH_MAX_LEVELS ||
+        size < PDA_SKETCH_HEADER_SIZE + (size_t)numLevels * LEVEL_SIZE_BYTES)
+        return false;
+
+    // los niveles se ubican desde el final del buffer hacia el principio
+    uint16_t levels[PDA_SKETCH_MAX_LEVELS + 1];
+    const uint8_t * sizes = buffer + PDA_SKETCH_HEADER_SIZE;
+    uint32_t total = 0;
+    uint64_t weight = 0;
+    levels[numLevels] = PDA_SKETCH_CAPACITY;
+    for (uint32_t h = numLevels; h-- > 0;) {
+        uint32_t count = (uint32_t)pdaReadLe(sizes + h * LEVEL_SIZE_BYTES, LEVEL_SIZE_BYTES);
+        total += count;
+        if (total > PDA_SKETCH_CAPACITY)
+            return false;
+        levels[h] = (uint16_t)(PDA_SKETCH_CAPACITY - total);
+        weight += (uint64_t)count << h;
+    }
+    // la compactación es perezosa: un nivel puede exceder su propia capacidad, pero el total
+    // retenido nunca supera la suma de las capacidades de los niveles
+    uint64_t validCount = pdaReadLe(buffer + OFFSET_VALID, sizeof(uint64_t));
+    if (weight != validCount || total > totalCapacity(numLevels) ||
+        size != PDA_SKETCH_HEADER_SIZE + (size_t)numLevels * LEVEL_SIZE_BYTES +
+                    (size_t)total * ITEM_BYTES)
+        return false;
+
+    // los niveles 1 en adelante deben estar ordenados, como supone la mezcla de los percentiles
+    const uint8_t * items = sizes + numLevels * LEVEL_SIZE_BYTES;
+    for (uint32_t h = 0; h < numLevels; h++) {
+        float previous = -INFINITY;
+        for (uint32_t i = levels[h]; i < levels[h + 1]; i++) {
+            float item = pdaReadFloat(items + (i - levels[0]) * ITEM_BYTES);
+            if (isnan(item) || (h > 0 && item < previous))
+                return false;
+            previous = item;
+        }
+    }
+
+    sketch->validCount = validCount;
+    sketch->rejectedCount = pdaReadLe(buffer + OFFSET_REJECTED, sizeof(uint64_t));
+    sketch->min = pdaReadFloat(buffer + OFFSET_MIN);
+    sketch->max = pdaReadFloat(buffer + OFFSET_MAX);
+    sketch->randomState = (uint32_t)pdaReadLe(buffer + OFFSET_RANDOM, sizeof(uint32_t));
+    if (sketch->randomState == 0)
+        sketch->randomState = DEFAULT_SEED;
+    sketch->numLevels = numLevels;
+    sketch->capacity = totalCapacity(numLevels);
+    memcpy(sketch->levels, levels, sizeof(uint16_t) * (numLevels + 1));
+    for (uint32_t i = levels[0]; i < PDA_SKETCH_CAPACITY; i++, items += ITEM_BYTES)
+        sketch->items[i] = pdaReadFloat(items);
+    return true;
+}
+
+/* === End of documentation ==================================================================== */
@@ -0,0 +1,233 @@
+/*
+ * Nombre del archivo: PdaSketch.h
+ * Versión: 0.1
+ * Descripción:
+ *  Resumen de cuantiles de memoria acotada (KLL) para el análisis de datos de material
+ *  particulado.
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "ParticulateDataAnalyzer.h"
+#include "PdaPercentile.h"
+
+#ifndef PDASKETCH_H
+#define PDASKETCH_H
+
+/**
+ * @file PdaSketch.h
+ * @brief Resumen de cuantiles KLL (Karnin, Lang y Liberty) de tamaño fijo y combinable.
+ *
+ * - pdaSketchInit: Inicializa un resumen vacío.
+ * - pdaSketchAdd / pdaSketchAddBatch: Incorporan datos; los que no cumplen maskIsDataTrue solo se
+ *   cuentan como rechazados.
+ * - pdaSketchMerge: Combina dos resúmenes, por ejemplo de distintos sensores o intervalos.
+ * - pdaSketchPercentile / pdaSketchPercentiles: Consultan percentiles aproximados.
+ * - pdaSketchSerialize / pdaSketchDeserialize: Formato binario compacto para agregar resúmenes
+ *   horarios en diarios y mensuales.
+ *
+ * El resumen guarda como mucho PDA_SKETCH_CAPACITY datos, repartidos en niveles: cada dato del
+ * nivel h representa 2^h datos originales. Cuando se llena, el nivel más bajo que excede su
+ * capacidad se ordena y conserva al azar los elementos pares o impares, que suben al nivel
+ * siguiente. La capacidad de cada nivel decrece en un factor 2/3 desde el más alto, con un mínimo
+ * de 8, por lo que la memoria no depende de la cantidad de datos.
+ *
+ * Cota de error: con PDA_SKETCH_K = 200, el rango normalizado del percentil retornado difiere del
+ * solicitado en menos de PDA_SKETCH_RANK_ERROR (1,5 %) con probabilidad mayor a 99 %, tanto al
+ * agregar datos como después de combinar resúmenes. El error escala aproximadamente como 1/K. Los
+ * percentiles 0 y 100 son exactos (mínimo y máximo). No se interpola entre datos.
+ *
+ * El generador aleatorio de las compactaciones es determinista a partir de la semilla, de modo que
+ * la misma secuencia de datos produce siempre el mismo resumen.
+ */
+
+/* === Headers files inclusions ================================================================ */
+
+/* === Cabecera C++ ============================================================================ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* === Public macros definitions =============================================================== */
+
+#ifndef PDA_SKETCH_K
+/**
+ * @brief Capacidad del nivel más alto; controla el compromiso entre memoria y error.
+ */
+#define PDA_SKETCH_K 200
+#endif
+
+/**
+ * @brief Cantidad máxima de niveles; alcanza para más de K * 2^38 datos.
+ */
+#define PDA_SKETCH_MAX_LEVELS 40
+
+/**
+ * @brief Cota superior de datos retenidos: K / (1 - 2/3) más el redondeo y el mínimo por nivel.
+ */
+#define PDA_SKETCH_CAPACITY (3 * PDA_SKETCH_K + 9 * PDA_SKETCH_MAX_LEVELS)
+
+/**
+ * @brief Error de rango normalizado documentado para PDA_SKETCH_K = 200.
+ */
+#define PDA_SKETCH_RANK_ERROR 0.015
+
+/**
+ * @brief Versión del formato binario.
+ */
+#define PDA_SKETCH_VERSION 1
+
+/**
+ * @brief Tamaño del encabezado del formato binario, en bytes.
+ */
+#define PDA_SKETCH_HEADER_SIZE 40
+
+/* === Public data type declarations =========================================================== */
+
+/**
+ * @brief Resumen de cuantiles.
+ *
+ * Los datos retenidos ocupan items[levels[0] .. PDA_SKETCH_CAPACITY); el nivel h ocupa
+ * items[levels[h] .. levels[h + 1]). El nivel 0 está desordenado y los demás ordenados.
+ */
+typedef struct {
+    uint64_t validCount;                         /**< Datos válidos incorporados. */
+    uint64_t rejectedCount;                      /**< Datos descartados por maskIsDataTrue. */
+    float min;                                   /**< Mínimo exacto de los datos válidos. */
+    float max;                                   /**< Máximo exacto de los datos válidos. */
+    uint32_t randomState;                        /**< Estado del generador de compactación. */
+    uint32_t numLevels;                          /**< Niveles en uso. */
+    uint32_t capacity;                           /**< Suma de las capacidades de los niveles. */
+    uint16_t levels[PDA_SKETCH_MAX_LEVELS + 1];  /**< Inicio de cada nivel en items. */
+    float items[PDA_SKETCH_CAPACITY];            /**< Datos retenidos. */
+} PdaSketch;
+
+/* === Public variable declarations ============================================================ */
+
+/* === Public function declarations ============================================================ */
+
+/**
+ * @brief Inicializa un resumen vacío.
+ *
+ * @param sketch Resumen a inicializar.
+ * @param seed Semilla del generador de compactación; cualquier valor es válido.
+ */
+void pdaSketchInit(PdaSketch * sketch, uint32_t seed);
+
+/**
+ * @brief Incorpora un dato al resumen.
+ *
+ * @param sketch Resumen a actualizar.
+ * @param value Dato a incorporar.
+ * @return Verdadero si el dato era válido y se incorporó; falso si sketch es NULL, el dato era
+ *         inválido o el resumen alcanzó PDA_SKETCH_MAX_LEVELS.
+ */
+bool pdaSketchAdd(PdaSketch * sketch, float value);
+
+/**
+ * @brief Incorpora un array de datos al resumen.
+ *
+ * @param sketch Resumen a actualizar.
+ * @param data Array de datos flotantes.
+ * @param n_data Número de elementos en el array.
+ */
+void pdaSketchAddBatch(PdaSketch * sketch, const float * data, size_t n_data);
+
+/**
+ * @brief Combina otro resumen en sketch; el resultado resume la unión de ambos conjuntos.
+ *
+ * @param sketch Resumen destino.
+ * @param other Resumen a incorporar; no se modifica.
+ * @return Verdadero si se combinó; falso si algún resumen es NULL o si sketch alcanzó
+ *         PDA_SKETCH_MAX_LEVELS.
+ */
+bool pdaSketchMerge(PdaSketch * sketch, const PdaSketch * other);
+
+/**
+ * @brief Calcula un percentil aproximado.
+ *
+ * No modifica el resumen: ordena una copia del nivel 0 en la pila, de hasta PDA_SKETCH_CAPACITY
+ * datos, por lo que admite consultas concurrentes.
+ *
+ * @param sketch Resumen a consultar.
+ * @param percentile Percentil en [0, 100].
+ * @return El percentil, MSN_VOID_ARRAY_VALUE si sketch es NULL o no hay datos válidos, o
+ *         MSN_PERCENTILE_OUT_OF_RANGE si el percentil no está en [0, 100].
+ */
+float pdaSketchPercentile(const PdaSketch * sketch, float percentile);
+
+/**
+ * @brief Calcula varios percentiles aproximados en un solo recorrido del resumen.
+ *
+ * @param sketch Resumen a consultar.
+ * @param percentiles Percentiles solicitados, cada uno en [0, 100], en cualquier orden.
+ * @param count Cantidad de percentiles, como máximo PDA_MAX_PERCENTILES.
+ * @param results Array de count elementos donde se almacenan los resultados.
+ * @return Verdadero si había datos válidos y todos los percentiles estaban en rango.
+ */
+bool pdaSketchPercentiles(const PdaSketch * sketch, const float percentiles[], size_t count,
+                          float results[]);
+
+/**
+ * @brief Tamaño en bytes del resumen serializado.
+ *
+ * @param sketch Resumen a consultar.
+ * @return PDA_SKETCH_HEADER_SIZE más 2 bytes por nivel y 4 por dato retenido, o 0 si sketch es
+ *         NULL.
+ */
+size_t pdaSketchSerializedSize(const PdaSketch * sketch);
+
+/**
+ * @brief Serializa el resumen en little-endian.
+ *
+ * Formato: "PDAS", versión (u16), K (u16), validCount (u64), rejectedCount (u64), min (f32),
+ * max (f32), randomState (u32), numLevels (u8), 3 bytes reservados, tamaño de cada nivel (u16)
+ * y los datos retenidos (f32) desde el nivel 0.
+ *
+ * @param sketch Resumen a serializar.
+ * @param buffer Buffer destino.
+ * @param size Tamaño del buffer.
+ * @return Bytes escritos, o 0 si sketch o buffer es NULL o el buffer es demasiado chico.
+ */
+size_t pdaSketchSerialize(const PdaSketch * sketch, uint8_t * buffer, size_t size);
+
+/**
+ * @brief Reconstruye un resumen serializado con pdaSketchSerialize.
+ *
+ * @param sketch Resumen destino; no se modifica si el buffer es inválido.
+ * @param buffer Buffer origen.
+ * @param size Cantidad de bytes del buffer.
+ * @return Verdadero si el formato, la versión, K y los tamaños son válidos, el total retenido no
+ *         supera la capacidad de los niveles, los niveles 1 en adelante están ordenados y ningún
+ *         dato es NaN.
+ */
+bool pdaSketchDeserialize(PdaSketch * sketch, const uint8_t * buffer, size_t size);
+
+/* === End of documentation ==================================================================== */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PDASKETCH_H */
@@ -59,12 +59,17 @@
  * vacío de datos. 4.1 Prueba la función calculateStandardDeviation con un conjunto estándar de
  * datos. 4.2 Prueba calculateStandardDeviation con un conjunto vacío de datos. 4.3 Prueba
  * calculateStandardDeviation con datos que incluyen valores fuera de rango.
+ *       5.1 Prueba computeParticulateStats con un conjunto estándar de datos.
+ *       5.2 Prueba computeParticulateStats con datos fuera de rango y el conteo de descartados.
+ *       5.3 Prueba computeParticulateStats con un conjunto sin datos válidos.
+ *       5.4 Prueba findMaxValue y findMinValue cuando el primer dato es inválido.
  */
 
 /* === Headers files inclusions =============================================================== */
 
 #include "unity.h"
 #include "ParticulateDataAnalyzer.h"
+#include "PdaKernels.h"
 
 /* === Macros definitions ====================================================================== */
 
@@ -142,6 +147,18 @@
 /// @brief Máximo esperado para el conjunto de datos de MP que incluye ceros.
 #define EXPECTED_MAX_CERO_DATA_MP 10
 
+/// @brief Define un conjunto de datos de MP donde ningún valor es válido.
+#define SET_INVALID_DATA_MP                                                                        \
+    { 0.0, -3.0, 700.0, 0.05 }
+
+/// @brief Define un conjunto de datos de MP cuyo primer valor está fuera de rango.
+#define SET_FIRST_INVALID_DATA_MP                                                                  \
+    { 1000.0, 4.0, 8.0, 0.0 }
+/// @brief Máximo esperado para el conjunto cuyo primer valor está fuera de rango.
+#define EXPECTED_MAX_FIRST_INVALID_DATA_MP 8.0
+/// @brief Mínimo esperado para el conjunto cuyo primer valor está fuera de rango.
+#define EXPECTED_MIN_FIRST_INVALID_DATA_MP 4.0
+
 /* === Private data type declarations ========================================================== */
 
 /* === Private variable declarations =========================================================== */
@@ -444,4 +461,81 @@ void test_calculateStandardDeviation_withOutlierValues(void) {
     TEST_ASSERT_EQUAL_FLOAT(EXPECTED_STD_OUTLIER_DATA_MP, result);
 }
 
+// calcula todas las estadísticas en una sola pasada
+
+/** 5.1
+ * @brief Prueba computeParticulateStats con un conjunto estándar de datos.
+ *
+ * Verifica que la función de una sola pasada entregue los mismos resultados que las funciones
+ * individuales para un conjunto de datos sin valores fuera de rango.
+ *
+ * @test
+ * - Utiliza un conjunto estándar de datos.
+ * - Verifica promedio, máximo, mínimo, desviación estándar y conteos.
+ */
+void test_computeParticulateStats_standardData(void) {
+    float data[] = SET_STANDAR_DATA_2_MP;
+    PdaStats stats;
+    TEST_ASSERT_TRUE(computeParticulateStats(data, ARRAY_SIZE(data), &stats));
+    TEST_ASSERT_EQUAL_FLOAT(calculateAverage(data, ARRAY_SIZE(data)), stats.mean);
+    TEST_ASSERT_EQUAL_FLOAT(findMaxValue(data, ARRAY_SIZE(data)), stats.max);
+    TEST_ASSERT_EQUAL_FLOAT(findMinValue(data, ARRAY_SIZE(data)), stats.min);
+    TEST_ASSERT_EQUAL_FLOAT(EXPECTED_STD_STANDAR_DATA_2_MP, stats.stdDev);
+    TEST_ASSERT_EQUAL(ARRAY_SIZE(data), stats.validCount);
+    TEST_ASSERT_EQUAL(0, stats.rejectedCount);
+}
+
+/** 5.2
+ * @brief Prueba computeParticulateStats con datos que incluyen valores fuera de rango.
+ *
+ * @test
+ * - Utiliza un conjunto con valores atípicos.
+ * - Verifica las estadísticas de los datos válidos y el número de datos descartados.
+ */
+void test_computeParticulateStats_withOutlierValues(void) {
+    float data[] = SET_OUTLIER_DATA_MP;
+    PdaStats stats;
+    TEST_ASSERT_TRUE(computeParticulateStats(data, ARRAY_SIZE(data), &stats));
+    TEST_ASSERT_EQUAL_FLOAT(EXPECTED_MEAN_OUTLIER_DATA_MP, stats.mean);
+    TEST_ASSERT_EQUAL_FLOAT(EXPECTED_MAX_OUTLIER_DATA_MP, stats.max);
+    TEST_ASSERT_EQUAL_FLOAT(EXPECTED_MIN_OUTLIER_DATA_MP, stats.min);
+    TEST_ASSERT_EQUAL_FLOAT(EXPECTED_STD_OUTLIER_DATA_MP, stats.stdDev);
+    TEST_ASSERT_EQUAL(4, stats.validCount);
+    TEST_ASSERT_EQUAL(2, stats.rejectedCount);
+}
+
+/** 5.3
+ * @brief Prueba computeParticulateStats con un conjunto sin datos válidos.
+ *
+ * @test
+ * - Utiliza un conjunto donde todos los valores están fuera de rango.
+ * - Verifica que la función retorne falso y que los resultados indiquen datos vacíos.
+ */
+void test_computeParticulateStats_withoutValidData(void) {
+    float data[] = SET_INVALID_DATA_MP;
+    PdaStats stats;
+    TEST_ASSERT_FALSE(computeParticulateStats(data, ARRAY_SIZE(data), &stats));
+    TEST_ASSERT_EQUAL_FLOAT(EXPECTED_WARNING_EMPTY_DATA_MP, stats.mean);
+    TEST_ASSERT_EQUAL_FLOAT(EXPECTED_WARNING_EMPTY_DATA_MP, stats.max);
+    TEST_ASSERT_EQUAL_FLOAT(EXPECTED_WARNING_EMPTY_DATA_MP, stats.min);
+    TEST_ASSERT_EQUAL_FLOAT(MSN_NOT_DATA, stats.stdDev);
+    TEST_ASSERT_EQUAL(0, stats.validCount);
+    TEST_ASSERT_EQUAL(ARRAY_SIZE(data), stats.rejectedCount);
+}
+
+/** 5.4
+ * @brief Prueba findMaxValue y findMinValue cuando el primer dato es inválido.
+ *
+ * @test
+ * - Utiliza un conjunto cuyo primer valor supera el límite máximo.
+ * - Verifica que el primer valor no se utilice como máximo ni como mínimo.
+ */
+void test_findMaxMinValue_withFirstValueInvalid(void) {
+    float data[] = SET_FIRST_INVALID_DATA_MP;
+    TEST_ASSERT_EQUAL_FLOAT(EXPECTED_MAX_FIRST_INVALID_DATA_MP,
+                            findMaxValue(data, ARRAY_SIZE(data)));
+    TEST_ASSERT_EQUAL_FLOAT(EXPECTED_MIN_FIRST_INVALID_DATA_MP,
+                            findMinValue(data, ARRAY_SIZE(data)));
+}
+
 /* === End of documentation ==================================================================== */
@@ -0,0 +1,209 @@
+/*
+ * Nombre del archivo: test_Pda.cpp
+ * Descripción: Pruebas de la capa C++17 Pda.hpp.
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE FIUBA
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+
+/**
+ * @file  test_Pda.cpp
+ * @brief Pruebas de la capa C++17 Pda.hpp, comparada con las funciones de C.
+ *
+ * Ceedling solo compila pruebas en C, por lo que este programa se compila con g++ -std=c++17 y se
+ * ejecuta con make test-cpp; retorna 0 si todas las pruebas pasan.
+ *
+ * @test Pruebas implementadas:
+ *       1.1 Con datos float, pda::stats coincide con computeParticulateStats.
+ *       1.2 Con datos double, pda::stats coincide con computeParticulateStats.
+ *       1.3 Con códigos en décimas, pda::stats es idéntico a computeParticulateStatsQ16.
+ *       2.1 Un pda::Range propio valida los datos y los códigos con su rango.
+ *       2.2 Los conjuntos vacíos o sin datos válidos retornan los valores de error de C.
+ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "Pda.hpp"
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+/* === Macros definitions ====================================================================== */
+
+/// @brief Cantidad de datos de los conjuntos de prueba; no es múltiplo de PDA_REDUCE_BLOCK.
+#define TEST_DATA_SIZE 10007
+
+/// @brief Tolerancia relativa entre pda::stats y computeParticulateStats.
+#define TEST_TOLERANCE 1e-5f
+
+/// @brief Registra una falla si la condición es falsa.
+#define CHECK(condition)                                                                           \
+    do {                                                                                           \
+        if (!(condition)) {                                                                        \
+            std::printf("%s:%d: falla: %s\n", __FILE__, __LINE__, #condition);                    \
+            failures++;                                                                            \
+        }                                                                                          \
+    } while (0)
+
+/* === Private data type declarations ========================================================== */
+
+/// @brief Rango propio de las pruebas: (10; 200) µg/m³.
+using TestRange = pda::Range<100, 2000>;
+
+/* === Private variable definitions ============================================================ */
+
+/// @brief Cantidad de fallas registradas.
+static int failures = 0;
+
+/// @brief Datos de prueba, con valores dentro y fuera de rango.
+static std::vector<float> samples(TEST_DATA_SIZE);
+
+/* === Private function implementation ========================================================= */
+
+/**
+ * @brief Verifica si dos valores coinciden dentro de TEST_TOLERANCE relativa.
+ */
+static bool near(float actual, float expected) {
+    return std::fabs(actual - expected) <= TEST_TOLERANCE * std::fmax(1.0f, std::fabs(expected));
+}
+
+/**
+ * @brief Genera datos reproducibles en (-30; 530) µg/m³.
+ */
+static void fillSamples(void) {
+    std::uint32_t state = 9u;
+    for (float & value : samples) {
+        state = state * 1664525u + 1013904223u;
+        value = static_cast<float>(state >> 8) / static_cast<float>(1u << 24) * 560.0f - 30.0f;
+    }
+}
+
+/* === Public function implementation ========================================================== */
+
+/** 1.1
+ * @brief Con datos float, pda::stats coincide con computeParticulateStats.
+ */
+static void test_stats_float(void) {
+    PdaStats expected;
+    computeParticulateStats(samples.data(), samples.size(), &expected);
+    PdaStats actual = pda::stats(samples);
+    CHECK(actual.validCount == expected.validCount);
+    CHECK(actual.rejectedCount == expected.rejectedCount);
+    CHECK(near(actual.mean, expected.mean));
+    CHECK(near(actual.stdDev, expected.stdDev));
+    CHECK(actual.min == expected.min);
+    CHECK(actual.max == expected.max);
+}
+
+/** 1.2
+ * @brief Con datos double, pda::stats coincide con computeParticulateStats.
+ */
+static void test_stats_double(void) {
+    PdaStats expected;
+    computeParticulateStats(samples.data(), samples.size(), &expected);
+    std::vector<double> values(samples.begin(), samples.end());
+    PdaStats actual = pda::stats(values);
+    CHECK(actual.validCount == expected.validCount);
+    CHECK(actual.rejectedCount == expected.rejectedCount);
+    CHECK(near(actual.mean, expected.mean));
+    CHECK(near(actual.stdDev, expected.stdDev));
+    CHECK(actual.min == expected.min);
+    CHECK(actual.max == expected.max);
+}
+
+/** 1.3
+ * @brief Con códigos en décimas, pda::stats es idéntico a computeParticulateStatsQ16.
+ */
+static void test_stats_q16(void) {
+    std::vector<PdaQ16> codes(samples.size());
+    pdaQ16EncodeArray(samples.data(), samples.size(), codes.data());
+    PdaStats expected;
+    computeParticulateStatsQ16(codes.data(), codes.size(), &expected);
+    PdaStats actual = pda::stats(codes);
+    CHECK(actual.validCount == expected.validCount);
+    CHECK(actual.rejectedCount == expected.rejectedCount);
+    CHECK(actual.mean == expected.mean);
+    CHECK(actual.stdDev == expected.stdDev);
+    CHECK(actual.min == expected.min);
+    CHECK(actual.max == expected.max);
+}
+
+/** 2.1
+ * @brief Un pda::Range propio valida los datos y los códigos con su rango.
+ */
+static void test_stats_customRange(void) {
+    static_assert(TestRange::valid(10.5f) && !TestRange::valid(10.0f) && !TestRange::valid(200.0));
+    static_assert(TestRange::valid(std::uint16_t{100}) && !TestRange::valid(std::uint16_t{2000}));
+
+    std::vector<float> inRange;
+    for (float value : samples) {
+        if (value > 10.0 && value < 200.0)
+            inRange.push_back(value);
+    }
+    PdaStats expected;
+    computeParticulateStats(inRange.data(), inRange.size(), &expected);
+    PdaStats actual = pda::stats<TestRange>(samples);
+    CHECK(actual.validCount == inRange.size());
+    CHECK(actual.rejectedCount == samples.size() - inRange.size());
+    CHECK(near(actual.mean, expected.mean));
+    CHECK(near(actual.stdDev, expected.stdDev));
+    CHECK(actual.min == expected.min);
+    CHECK(actual.max == expected.max);
+
+    std::vector<PdaQ16> codes(samples.size());
+    pdaQ16EncodeArray(samples.data(), samples.size(), codes.data());
+    std::size_t validCodes = 0;
+    for (PdaQ16 code : codes)
+        validCodes += (code >= 100 && code < 2000);
+    CHECK(pda::stats<TestRange>(codes).validCount == validCodes);
+}
+
+/** 2.2
+ * @brief Los conjuntos vacíos o sin datos válidos retornan los valores de error de C.
+ */
+static void test_stats_errorValues(void) {
+    const float outliers[] = {1000.0f, 0.0f};
+    PdaStats expected;
+    computeParticulateStats(outliers, 2, &expected);
+    PdaStats invalid = pda::stats(outliers);
+    CHECK(invalid.validCount == 0 && invalid.rejectedCount == 2);
+    CHECK(invalid.mean == expected.mean && invalid.stdDev == expected.stdDev);
+    CHECK(invalid.min == expected.min && invalid.max == expected.max);
+
+    PdaStats none = pda::stats(static_cast<const float *>(nullptr), 0);
+    CHECK(none.mean == MSN_VOID_ARRAY_VALUE && none.min == MSN_VOID_ARRAY_VALUE);
+
+    std::array<float, 1> single{5.0f};
+    PdaStats one = pda::stats(single);
+    CHECK(one.mean == 5.0f && one.stdDev == MSN_DS_NOTDEFINI);
+}
+
+int main(void) {
+    fillSamples();
+    test_stats_float();
+    test_stats_double();
+    test_stats_q16();
+    test_stats_customRange();
+    test_stats_errorValues();
+    std::printf("%s\n", failures == 0 ? "OK" : "FALLAS");
+    return failures == 0 ? 0 : 1;
+}
+
+/* === End of documentation ==================================================================== */
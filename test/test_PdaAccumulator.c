@@ -0,0 +1,219 @@
+/*
+ * Nombre del archivo: test_PdaAccumulator.c
+ * Descripción: Pruebas del acumulador de estadísticas en flujo continuo (método de Welford).
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE FIUBA
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+
+/**
+ * @file  test_PdaAccumulator.c
+ * @brief Pruebas unitarias del módulo PdaAccumulator.
+ *
+ * @test Pruebas unitarias implementadas:
+ *       1.1 Un acumulador recién inicializado no tiene datos.
+ *       1.2 Agregar datos estándar uno a uno da las mismas estadísticas que las funciones clásicas.
+ *       1.3 Los datos fuera de rango se descartan y se cuentan.
+ *       1.4 Agregar por bloques equivale a agregar dato a dato.
+ *       1.5 Combinar dos acumuladores equivale a acumular todos los datos en uno.
+ *       1.6 La varianza es estable con promedios altos y dispersión pequeña.
+ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "unity.h"
+#include "ParticulateDataAnalyzer.h"
+#include "PdaKernels.h"
+#include "PdaAccumulator.h"
+
+/* === Macros definitions ====================================================================== */
+
+/// @brief Calcula el número de elementos en un arreglo estático.
+#define ARRAY_SIZE(arr) (sizeof(arr) / sizeof((arr)[0]))
+
+/// @brief Conjunto estándar de datos de MP.
+#define SET_STANDAR_DATA_2_MP                                                                      \
+    { 20.0, 30.0, 60, 8.0, 10.0 }
+/// @brief Desviación estándar esperada para el conjunto estándar.
+#define EXPECTED_STD_STANDAR_DATA_2_MP 21.13764
+/// @brief Promedio esperado para el conjunto estándar.
+#define EXPECTED_MEAN_STANDAR_DATA_2_MP 25.6
+
+/// @brief Conjunto de datos de MP con valores fuera de rango.
+#define SET_OUTLIER_DATA_MP                                                                        \
+    { 2.0, 1000.0, 600.0, 6.0, 8.0, 10.0, 0.0 }
+/// @brief Promedio esperado para el conjunto con valores fuera de rango.
+#define EXPECTED_MEAN_OUTLIER_DATA_MP 6.5
+/// @brief Desviación estándar esperada para el conjunto con valores fuera de rango.
+#define EXPECTED_STD_OUTLIER_DATA_MP 3.41565
+
+/// @brief Cantidad de datos de los conjuntos largos.
+#define LONG_DATA_SIZE 4099
+
+/// @brief Cantidad de datos de la prueba de estabilidad numérica.
+#define STABILITY_DATA_SIZE 1000000
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/// @brief Buffer de datos compartido por las pruebas.
+static float buffer[LONG_DATA_SIZE];
+
+/* === Private function implementation ========================================================= */
+
+/**
+ * @brief Llena el buffer con datos dentro y fuera de rango de forma reproducible.
+ */
+static void fillBuffer(void) {
+    uint32_t state = 2023u;
+    for (size_t i = 0; i < LONG_DATA_SIZE; i++) {
+        state = state * 1664525u + 1013904223u;
+        buffer[i] = (float)(state >> 8) / (float)(1u << 24) * 600.0f - 50.0f;
+    }
+}
+
+/**
+ * @brief Verifica que dos resultados estadísticos coincidan.
+ */
+static void assertStatsEqual(const PdaStats * expected, const PdaStats * actual) {
+    TEST_ASSERT_EQUAL(expected->validCount, actual->validCount);
+    TEST_ASSERT_EQUAL(expected->rejectedCount, actual->rejectedCount);
+    TEST_ASSERT_EQUAL_FLOAT(expected->mean, actual->mean);
+    TEST_ASSERT_EQUAL_FLOAT(expected->min, actual->min);
+    TEST_ASSERT_EQUAL_FLOAT(expected->max, actual->max);
+    TEST_ASSERT_EQUAL_FLOAT(expected->stdDev, actual->stdDev);
+}
+
+/* === Public function implementation ========================================================== */
+
+/** 1.1
+ * @brief Un acumulador recién inicializado no tiene datos.
+ */
+void test_pdaAccInit_isEmpty(void) {
+    PdaAccumulator acc;
+    PdaStats stats;
+    pdaAccInit(&acc);
+    TEST_ASSERT_FALSE(pdaAccQuery(&acc, &stats));
+    TEST_ASSERT_EQUAL_FLOAT(MSN_VOID_ARRAY_VALUE, stats.mean);
+    TEST_ASSERT_EQUAL_FLOAT(MSN_VOID_ARRAY_VALUE, stats.stdDev);
+    TEST_ASSERT_EQUAL(0, stats.validCount);
+}
+
+/** 1.2
+ * @brief Agregar datos estándar uno a uno da las mismas estadísticas que las funciones clásicas.
+ */
+void test_pdaAccPush_standardData(void) {
+    float data[] = SET_STANDAR_DATA_2_MP;
+    PdaAccumulator acc;
+    PdaStats stats;
+    pdaAccInit(&acc);
+    for (size_t i = 0; i < ARRAY_SIZE(data); i++)
+        TEST_ASSERT_TRUE(pdaAccPush(&acc, data[i]));
+    TEST_ASSERT_TRUE(pdaAccQuery(&acc, &stats));
+    TEST_ASSERT_EQUAL_FLOAT(EXPECTED_MEAN_STANDAR_DATA_2_MP, stats.mean);
+    TEST_ASSERT_EQUAL_FLOAT(EXPECTED_STD_STANDAR_DATA_2_MP, stats.stdDev);
+    TEST_ASSERT_EQUAL_FLOAT(findMinValue(data, ARRAY_SIZE(data)), stats.min);
+    TEST_ASSERT_EQUAL_FLOAT(findMaxValue(data, ARRAY_SIZE(data)), stats.max);
+}
+
+/** 1.3
+ * @brief Los datos fuera de rango se descartan y se cuentan.
+ */
+void test_pdaAccPush_withOutlierValues(void) {
+    float data[] = SET_OUTLIER_DATA_MP;
+    PdaAccumulator acc;
+    PdaStats stats;
+    pdaAccInit(&acc);
+    for (size_t i = 0; i < ARRAY_SIZE(data); i++)
+        pdaAccPush(&acc, data[i]);
+    TEST_ASSERT_TRUE(pdaAccQuery(&acc, &stats));
+    TEST_ASSERT_EQUAL_FLOAT(EXPECTED_MEAN_OUTLIER_DATA_MP, stats.mean);
+    TEST_ASSERT_EQUAL_FLOAT(EXPECTED_STD_OUTLIER_DATA_MP, stats.stdDev);
+    TEST_ASSERT_EQUAL(4, stats.validCount);
+    TEST_ASSERT_EQUAL(3, stats.rejectedCount);
+}
+
+/** 1.4
+ * @brief Agregar por bloques equivale a agregar dato a dato.
+ */
+void test_pdaAccPushBatch_matchesPush(void) {
+    PdaAccumulator single, batch;
+    PdaStats expected, actual, reference;
+    fillBuffer();
+    pdaAccInit(&single);
+    pdaAccInit(&batch);
+    for (size_t i = 0; i < LONG_DATA_SIZE; i++)
+        pdaAccPush(&single, buffer[i]);
+    // bloques de distintos tamaños, incluido uno vacío
+    pdaAccPushBatch(&batch, buffer, 0);
+    pdaAccPushBatch(&batch, buffer, 13);
+    pdaAccPushBatch(&batch, buffer + 13, 1000);
+    pdaAccPushBatch(&batch, buffer + 1013, LONG_DATA_SIZE - 1013);
+    pdaAccQuery(&single, &expected);
+    pdaAccQuery(&batch, &actual);
+    computeParticulateStats(buffer, LONG_DATA_SIZE, &reference);
+    assertStatsEqual(&expected, &actual);
+    assertStatsEqual(&reference, &actual);
+}
+
+/** 1.5
+ * @brief Combinar dos acumuladores equivale a acumular todos los datos en uno.
+ */
+void test_pdaAccMerge_matchesSingleAccumulator(void) {
+    PdaAccumulator whole, first, second;
+    PdaStats expected, actual;
+    fillBuffer();
+    pdaAccInit(&whole);
+    pdaAccInit(&first);
+    pdaAccInit(&second);
+    pdaAccPushBatch(&whole, buffer, LONG_DATA_SIZE);
+    pdaAccPushBatch(&first, buffer, 100);
+    pdaAccPushBatch(&second, buffer + 100, LONG_DATA_SIZE - 100);
+    pdaAccMerge(&first, &second);
+    pdaAccQuery(&whole, &expected);
+    pdaAccQuery(&first, &actual);
+    assertStatsEqual(&expected, &actual);
+}
+
+/** 1.6
+ * @brief La varianza es estable con promedios altos y dispersión pequeña.
+ *
+ * Alterna dos valores cercanos a 400 separados por 1/32; la desviación estándar debe ser 1/64
+ * aproximadamente (con la tolerancia de sqrt_binary_search), sin la pérdida de precisión de la
+ * suma de cuadrados directa.
+ */
+void test_pdaAccPush_isNumericallyStable(void) {
+    PdaAccumulator acc;
+    PdaStats stats;
+    pdaAccInit(&acc);
+    for (size_t i = 0; i < STABILITY_DATA_SIZE; i++)
+        pdaAccPush(&acc, (i % 2) ? 400.03125f : 400.0f);
+    pdaAccQuery(&acc, &stats);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, 400.015625, stats.mean);
+    TEST_ASSERT_FLOAT_WITHIN(1e-7, 0.015625, stats.stdDev);
+}
+
+/* === End of documentation ==================================================================== */
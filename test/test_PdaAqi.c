@@ -0,0 +1,201 @@
+/*
+ * Nombre del archivo: test_PdaAqi.c
+ * Descripción: Pruebas del promedio de 24 horas, el NowCast y el AQI incrementales.
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE FIUBA
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+
+/**
+ * @file  test_PdaAqi.c
+ * @brief Pruebas unitarias del módulo PdaAqi.
+ *
+ * @test Pruebas unitarias implementadas:
+ *       1.1 Las concentraciones en los cortes de las tablas dan el AQI y la categoría esperados.
+ *       1.2 Una estación sin horas suficientes informa los códigos de error.
+ *       1.3 El NowCast pondera las horas recientes y respeta la regla de 2 de 3 horas.
+ *       2.1 En una secuencia larga con horas faltantes, el promedio de 24 horas coincide con
+ *           calculateAverage y el NowCast con un cálculo directo de las últimas 12 horas.
+ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "unity.h"
+#include "ParticulateDataAnalyzer.h"
+#include "PdaAqi.h"
+#include <math.h> // Para pow
+
+/* === Macros definitions ====================================================================== */
+
+/// @brief Calcula el número de elementos en un arreglo estático.
+#define ARRAY_SIZE(arr) (sizeof(arr) / sizeof((arr)[0]))
+
+/// @brief Cantidad de horas de la prueba larga.
+#define LONG_HOURS 1000
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/// @brief Estación usada por cada prueba.
+static PdaAqiStation station;
+
+/// @brief Historia de promedios horarios de la prueba larga.
+static float history[LONG_HOURS];
+
+/* === Private function implementation ========================================================= */
+
+/**
+ * @brief NowCast calculado directamente sobre las 12 horas que terminan en end (exclusivo).
+ */
+static float referenceNowCast(const float * data, size_t end) {
+    size_t hours = (end < PDA_NOWCAST_HOURS) ? end : PDA_NOWCAST_HOURS;
+    float min = MP_MAX_VALUE, max = 0.0f;
+    for (size_t age = 0; age < hours; age++) {
+        float value = data[end - 1 - age];
+        if (!maskIsDataTrue(value))
+            continue;
+        min = (value < min) ? value : min;
+        max = (value > max) ? value : max;
+    }
+    double weight = (double)min / (double)max;
+    weight = (weight < 0.5) ? 0.5 : weight;
+    double numerator = 0.0, denominator = 0.0;
+    for (size_t age = 0; age < hours; age++) {
+        float value = data[end - 1 - age];
+        if (!maskIsDataTrue(value))
+            continue;
+        numerator += pow(weight, (double)age) * value;
+        denominator += pow(weight, (double)age);
+    }
+    return (float)(numerator / denominator);
+}
+
+/* === Public function implementation ========================================================== */
+
+void setUp(void) {
+    pdaAqiInit(&station, PDA_POLLUTANT_PM25);
+}
+
+/** 1.1
+ * @brief Las concentraciones en los cortes de las tablas dan el AQI y la categoría esperados.
+ */
+void test_pdaAqi_breakpoints(void) {
+    TEST_ASSERT_EQUAL(0, pdaAqi(PDA_POLLUTANT_PM25, 0.0f));
+    TEST_ASSERT_EQUAL(50, pdaAqi(PDA_POLLUTANT_PM25, 9.0f));
+    TEST_ASSERT_EQUAL(50, pdaAqi(PDA_POLLUTANT_PM25, 9.09f)); // se trunca a 9.0
+    TEST_ASSERT_EQUAL(51, pdaAqi(PDA_POLLUTANT_PM25, 9.1f));
+    TEST_ASSERT_EQUAL(56, pdaAqi(PDA_POLLUTANT_PM25, 12.0f));
+    TEST_ASSERT_EQUAL(101, pdaAqi(PDA_POLLUTANT_PM25, 35.5f));
+    TEST_ASSERT_EQUAL(500, pdaAqi(PDA_POLLUTANT_PM25, 325.4f));
+    TEST_ASSERT_EQUAL(500, pdaAqi(PDA_POLLUTANT_PM25, 400.0f));
+    TEST_ASSERT_EQUAL(50, pdaAqi(PDA_POLLUTANT_PM10, 54.9f));
+    TEST_ASSERT_EQUAL(100, pdaAqi(PDA_POLLUTANT_PM10, 154.0f));
+    TEST_ASSERT_EQUAL(151, pdaAqi(PDA_POLLUTANT_PM10, 255.0f));
+    TEST_ASSERT_EQUAL(MSN_VOID_ARRAY_VALUE, pdaAqi(PDA_POLLUTANT_PM25, -1.0f));
+    TEST_ASSERT_EQUAL(MSN_VOID_ARRAY_VALUE, pdaAqi(PDA_POLLUTANT_COUNT, 10.0f));
+
+    TEST_ASSERT_EQUAL(PDA_AQI_GOOD, pdaAqiCategory(50));
+    TEST_ASSERT_EQUAL(PDA_AQI_MODERATE, pdaAqiCategory(51));
+    TEST_ASSERT_EQUAL(PDA_AQI_VERY_UNHEALTHY, pdaAqiCategory(300));
+    TEST_ASSERT_EQUAL(PDA_AQI_HAZARDOUS, pdaAqiCategory(301));
+    TEST_ASSERT_EQUAL(PDA_AQI_NOT_AVAILABLE, pdaAqiCategory(MSN_NOT_DATA));
+    TEST_ASSERT_EQUAL_STRING("moderate", pdaAqiCategoryName(PDA_AQI_MODERATE));
+    TEST_ASSERT_EQUAL_STRING("n/a", pdaAqiCategoryName(PDA_AQI_NOT_AVAILABLE));
+}
+
+/** 1.2
+ * @brief Una estación sin horas suficientes informa los códigos de error.
+ */
+void test_pdaAqiQuery_insufficientHours(void) {
+    PdaAqiReport report;
+    TEST_ASSERT_FALSE(pdaAqiQuery(&station, &report));
+    TEST_ASSERT_EQUAL_FLOAT(MSN_VOID_ARRAY_VALUE, report.average24h);
+    TEST_ASSERT_EQUAL(PDA_AQI_NOT_AVAILABLE, report.category24h);
+
+    TEST_ASSERT_FALSE(pdaAqiPushHour(&station, 0.0f));
+    for (int h = 1; h < PDA_AQI_MIN_HOURS; h++)
+        TEST_ASSERT_TRUE(pdaAqiPushHour(&station, 20.0f));
+    TEST_ASSERT_TRUE(pdaAqiQuery(&station, &report)); // el NowCast ya puede calcularse
+    TEST_ASSERT_EQUAL(PDA_AQI_MIN_HOURS - 1, report.validHours);
+    TEST_ASSERT_EQUAL_FLOAT(MSN_NOT_DATA, report.average24h);
+    TEST_ASSERT_EQUAL(MSN_NOT_DATA, report.aqi24h);
+    TEST_ASSERT_EQUAL_FLOAT(20.0, report.nowCast);
+
+    pdaAqiPushHour(&station, 20.0f);
+    TEST_ASSERT_TRUE(pdaAqiQuery(&station, &report));
+    TEST_ASSERT_EQUAL_FLOAT(20.0, report.average24h);
+    TEST_ASSERT_EQUAL(pdaAqi(PDA_POLLUTANT_PM25, 20.0f), report.aqi24h);
+    TEST_ASSERT_EQUAL(PDA_AQI_MODERATE, report.category24h);
+}
+
+/** 1.3
+ * @brief El NowCast pondera las horas recientes y respeta la regla de 2 de 3 horas.
+ */
+void test_pdaAqiQuery_nowCast(void) {
+    PdaAqiReport report;
+    pdaAqiPushHour(&station, 20.0f);
+    pdaAqiPushHour(&station, 40.0f);
+    pdaAqiQuery(&station, &report);
+    TEST_ASSERT_EQUAL_FLOAT((40.0 + 0.5 * 20.0) / 1.5, report.nowCast);
+
+    pdaAqiPushHour(&station, MSN_VOID_ARRAY_VALUE);
+    pdaAqiQuery(&station, &report);
+    TEST_ASSERT_EQUAL_FLOAT((0.5 * 40.0 + 0.25 * 20.0) / 0.75, report.nowCast);
+
+    pdaAqiPushHour(&station, MSN_VOID_ARRAY_VALUE); // solo 1 de las 3 horas recientes
+    pdaAqiQuery(&station, &report);
+    TEST_ASSERT_EQUAL_FLOAT(MSN_NOT_DATA, report.nowCast);
+    TEST_ASSERT_EQUAL(PDA_AQI_NOT_AVAILABLE, report.categoryNow);
+}
+
+/** 2.1
+ * @brief En una secuencia larga con horas faltantes, el promedio de 24 horas coincide con
+ *        calculateAverage y el NowCast con un cálculo directo de las últimas 12 horas.
+ */
+void test_pdaAqiPushHour_matchesRecomputation(void) {
+    PdaAqiReport report;
+    uint32_t state = 7u;
+    for (size_t h = 0; h < LONG_HOURS; h++) {
+        state = state * 1664525u + 1013904223u;
+        history[h] = ((state >> 24) % 10 == 0) ? MSN_VOID_ARRAY_VALUE
+                                                : (float)(state >> 8) / (float)(1u << 24) * 150.0f;
+        pdaAqiPushHour(&station, history[h]);
+        pdaAqiQuery(&station, &report);
+
+        size_t start = (h + 1 < PDA_AQI_HOURS) ? 0 : h + 1 - PDA_AQI_HOURS;
+        size_t valid = 0;
+        for (size_t i = start; i <= h; i++)
+            valid += maskIsDataTrue(history[i]);
+        TEST_ASSERT_EQUAL(valid, report.validHours);
+        if (valid >= PDA_AQI_MIN_HOURS)
+            TEST_ASSERT_FLOAT_WITHIN(1e-3, calculateAverage(history + start, h + 1 - start),
+                                     report.average24h);
+        if (report.nowCast >= 0.0f)
+            TEST_ASSERT_FLOAT_WITHIN(1e-3, referenceNowCast(history, h + 1), report.nowCast);
+    }
+}
+
+/* === End of documentation ==================================================================== */
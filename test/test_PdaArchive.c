@@ -0,0 +1,185 @@
+/*
+ * Nombre del archivo: test_PdaArchive.c
+ * Descripción: Pruebas de la lectura de archivos binarios mapeados en memoria.
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE FIUBA
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+
+/**
+ * @file  test_PdaArchive.c
+ * @brief Pruebas unitarias del módulo PdaArchive.
+ *
+ * @test Pruebas unitarias implementadas:
+ *       1.1 Un archivo inexistente no se abre y un archivo vacío no tiene datos.
+ *       1.2 Un archivo de varios bloques da las estadísticas de computeParticulateStats y sus
+ *           bloques cubren todos los datos en orden.
+ *       1.3 Los bytes finales que no completan un dato se ignoran.
+ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "unity.h"
+#include "ParticulateDataAnalyzer.h"
+#include "PdaAccumulator.h"
+#include "PdaByteOrder.h"
+#include "PdaArchive.h"
+#include <stdio.h>  // Para fopen
+#include <stdlib.h> // Para mkstemp
+#include <string.h> // Para strcpy
+#include <unistd.h> // Para close y unlink
+
+/* === Macros definitions ====================================================================== */
+
+/// @brief Plantilla de la ruta de los archivos temporales.
+#define PATH_TEMPLATE "/tmp/test_PdaArchive_XXXXXX"
+
+/// @brief Datos del archivo de prueba: dos bloques completos y uno parcial.
+#define ARCHIVE_VALUES (2 * PDA_ARCHIVE_CHUNK_BYTES / sizeof(float) + 12345)
+
+/* === Private data type declarations ========================================================== */
+
+/**
+ * @brief Recorrido de los bloques entregados por pdaArchiveForEachChunk.
+ */
+typedef struct {
+    size_t chunks;
+    size_t values;
+    bool inOrder;
+} ChunkLog;
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/// @brief Ruta del archivo temporal de cada prueba.
+static char path[sizeof(PATH_TEMPLATE)];
+
+/// @brief Datos escritos en el archivo.
+static float values[ARCHIVE_VALUES];
+
+/* === Private function implementation ========================================================= */
+
+/**
+ * @brief Escribe n datos en little-endian seguidos de extra bytes sueltos.
+ */
+static void writeArchive(size_t n, size_t extra) {
+    FILE * file = fopen(path, "wb");
+    TEST_ASSERT_NOT_NULL(file);
+    uint8_t bytes[sizeof(float)];
+    for (size_t i = 0; i < n; i++) {
+        pdaWriteFloat(bytes, values[i]);
+        fwrite(bytes, sizeof(bytes), 1, file);
+    }
+    for (size_t i = 0; i < extra; i++)
+        fputc(0x7f, file);
+    fclose(file);
+}
+
+/**
+ * @brief Registra un bloque y verifica que continúe al anterior.
+ */
+static void logChunk(const float * data, size_t n_data, void * context) {
+    ChunkLog * log = context;
+    log->inOrder = log->inOrder && data[0] == values[log->values] &&
+                   data[n_data - 1] == values[log->values + n_data - 1];
+    log->chunks++;
+    log->values += n_data;
+}
+
+/* === Public function implementation ========================================================== */
+
+void setUp(void) {
+    strcpy(path, PATH_TEMPLATE);
+    int fd = mkstemp(path);
+    TEST_ASSERT_TRUE(fd >= 0);
+    close(fd);
+    uint32_t state = 5u;
+    for (size_t i = 0; i < ARCHIVE_VALUES; i++) {
+        state = state * 1664525u + 1013904223u;
+        values[i] = (float)(state >> 8) / (float)(1u << 24) * 520.0f - 10.0f;
+    }
+}
+
+void tearDown(void) {
+    unlink(path);
+}
+
+/** 1.1
+ * @brief Un archivo inexistente no se abre y un archivo vacío no tiene datos.
+ */
+void test_pdaArchiveOpen_missingAndEmpty(void) {
+    PdaArchive archive;
+    PdaStats stats;
+    TEST_ASSERT_FALSE(pdaArchiveOpen(&archive, "/nonexistent/archive.bin"));
+    TEST_ASSERT_TRUE(pdaArchiveOpen(&archive, path));
+    TEST_ASSERT_EQUAL(0, archive.count);
+    TEST_ASSERT_FALSE(pdaArchiveStats(&archive, &stats));
+    TEST_ASSERT_EQUAL_FLOAT(MSN_VOID_ARRAY_VALUE, stats.mean);
+    pdaArchiveClose(&archive);
+}
+
+/** 1.2
+ * @brief Un archivo de varios bloques da las estadísticas de computeParticulateStats y sus
+ *        bloques cubren todos los datos en orden.
+ */
+void test_pdaArchiveStats_matchesInMemory(void) {
+    PdaArchive archive;
+    PdaStats stats, expected;
+    ChunkLog log = {0, 0, true};
+    writeArchive(ARCHIVE_VALUES, 0);
+    TEST_ASSERT_TRUE(pdaArchiveOpen(&archive, path));
+    TEST_ASSERT_EQUAL(ARCHIVE_VALUES, archive.count);
+
+    TEST_ASSERT_TRUE(pdaArchiveForEachChunk(&archive, logChunk, &log));
+    TEST_ASSERT_EQUAL(3, log.chunks);
+    TEST_ASSERT_EQUAL(ARCHIVE_VALUES, log.values);
+    TEST_ASSERT_TRUE(log.inOrder);
+
+    TEST_ASSERT_TRUE(pdaArchiveStats(&archive, &stats)); // las páginas liberadas se releen
+    computeParticulateStats(values, ARCHIVE_VALUES, &expected);
+    TEST_ASSERT_EQUAL(expected.validCount, stats.validCount);
+    TEST_ASSERT_EQUAL(expected.rejectedCount, stats.rejectedCount);
+    TEST_ASSERT_EQUAL_FLOAT(expected.mean, stats.mean);
+    TEST_ASSERT_EQUAL_FLOAT(expected.min, stats.min);
+    TEST_ASSERT_EQUAL_FLOAT(expected.max, stats.max);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, expected.stdDev, stats.stdDev);
+    pdaArchiveClose(&archive);
+}
+
+/** 1.3
+ * @brief Los bytes finales que no completan un dato se ignoran.
+ */
+void test_pdaArchiveOpen_ignoresTrailingBytes(void) {
+    PdaArchive archive;
+    PdaStats stats;
+    writeArchive(3, 2);
+    TEST_ASSERT_TRUE(pdaArchiveOpen(&archive, path));
+    TEST_ASSERT_EQUAL(3, archive.count);
+    TEST_ASSERT_EQUAL(2, archive.trailingBytes);
+    pdaArchiveStats(&archive, &stats);
+    TEST_ASSERT_EQUAL(3, stats.validCount + stats.rejectedCount);
+    pdaArchiveClose(&archive);
+}
+
+/* === End of documentation ==================================================================== */
@@ -0,0 +1,230 @@
+/*
+ * Nombre del archivo: test_PdaBlockStore.c
+ * Descripción: Pruebas de los archivos de series por bloques.
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE FIUBA
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+
+/**
+ * @file  test_PdaBlockStore.c
+ * @brief Pruebas unitarias del módulo PdaBlockStore.
+ *
+ * @test Pruebas unitarias implementadas:
+ *       1.1 Un archivo inexistente, con otro identificador, truncado o con un pie que no coincide
+ *           con su tamaño no se abre.
+ *       1.2 Las estadísticas de todo el archivo coinciden con computeParticulateStats leyendo solo
+ *           el índice, en un único tramo.
+ *       1.3 Las estadísticas de rangos arbitrarios coinciden con computeParticulateStats y leen a
+ *           lo sumo dos bloques de datos y un tramo del índice.
+ *       1.4 Los rangos fuera del archivo dan el resultado de un rango vacío.
+ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "unity.h"
+#include "ParticulateDataAnalyzer.h"
+#include "PdaAccumulator.h"
+#include "PdaPartial.h"
+#include "PdaBlockStore.h"
+#include <stdio.h>  // Para fopen
+#include <stdlib.h> // Para mkstemp
+#include <string.h> // Para strcpy
+#include <unistd.h> // Para close y unlink
+
+/* === Macros definitions ====================================================================== */
+
+/// @brief Plantilla de la ruta de los archivos temporales.
+#define PATH_TEMPLATE "/tmp/test_PdaBlockStore_XXXXXX"
+
+/// @brief Datos por bloque de los archivos de prueba.
+#define TEST_BLOCK_VALUES 1000
+
+/// @brief Datos de la serie de prueba: varios bloques completos y uno parcial.
+#define SERIES_VALUES (25 * TEST_BLOCK_VALUES + 321)
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/// @brief Ruta del archivo temporal de cada prueba.
+static char path[sizeof(PATH_TEMPLATE)];
+
+/// @brief Datos de la serie; incluye datos fuera de rango.
+static float values[SERIES_VALUES];
+
+/// @brief Escritor usado por cada prueba.
+static PdaBlockWriter writer;
+
+/* === Private function implementation ========================================================= */
+
+/**
+ * @brief Escribe la serie de prueba en partes de distinto tamaño.
+ */
+static void writeSeries(void) {
+    const size_t parts[] = {1, 999, 1, 2500, 7};
+    size_t done = 0;
+    TEST_ASSERT_TRUE(pdaBlockWriterOpen(&writer, path, TEST_BLOCK_VALUES));
+    for (size_t p = 0; done < SERIES_VALUES; p = (p + 1) % 5) {
+        size_t count = (SERIES_VALUES - done < parts[p]) ? SERIES_VALUES - done : parts[p];
+        TEST_ASSERT_TRUE(pdaBlockWriterPush(&writer, values + done, count));
+        done += count;
+    }
+    TEST_ASSERT_TRUE(pdaBlockWriterClose(&writer));
+}
+
+/**
+ * @brief Verifica que un resultado coincida con computeParticulateStats sobre los mismos datos.
+ */
+static void assertStatsMatch(const float * data, size_t n, const PdaStats * stats) {
+    PdaStats expected;
+    computeParticulateStats(data, n, &expected);
+    TEST_ASSERT_EQUAL(expected.validCount, stats->validCount);
+    TEST_ASSERT_EQUAL(expected.rejectedCount, stats->rejectedCount);
+    TEST_ASSERT_EQUAL_FLOAT(expected.mean, stats->mean);
+    TEST_ASSERT_EQUAL_FLOAT(expected.min, stats->min);
+    TEST_ASSERT_EQUAL_FLOAT(expected.max, stats->max);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, expected.stdDev, stats->stdDev);
+}
+
+/* === Public function implementation ========================================================== */
+
+void setUp(void) {
+    strcpy(path, PATH_TEMPLATE);
+    int fd = mkstemp(path);
+    TEST_ASSERT_TRUE(fd >= 0);
+    close(fd);
+    uint32_t state = 17u;
+    for (size_t i = 0; i < SERIES_VALUES; i++) {
+        state = state * 1664525u + 1013904223u;
+        values[i] = (float)(state >> 8) / (float)(1u << 24) * 520.0f - 10.0f;
+    }
+}
+
+void tearDown(void) {
+    unlink(path);
+}
+
+/** 1.1
+ * @brief Un archivo inexistente, con otro identificador, truncado o con un pie que no coincide
+ *        con su tamaño no se abre.
+ */
+void test_pdaBlockOpen_rejectsInvalidFiles(void) {
+    PdaBlockFile file;
+    TEST_ASSERT_FALSE(pdaBlockOpen(&file, "/nonexistent/series.pdab"));
+    TEST_ASSERT_FALSE(pdaBlockOpen(&file, path)); // archivo vacío
+    TEST_ASSERT_FALSE(pdaBlockWriterOpen(&writer, path, 0));
+    TEST_ASSERT_FALSE(pdaBlockWriterOpen(&writer, path, PDA_BLOCK_MAX_VALUES + 1));
+
+    writeSeries();
+    FILE * stream = fopen(path, "r+b");
+    TEST_ASSERT_NOT_NULL(stream);
+    fputc('X', stream);
+    fclose(stream);
+    TEST_ASSERT_FALSE(pdaBlockOpen(&file, path));
+
+    writeSeries();
+    TEST_ASSERT_EQUAL(0, truncate(path, PDA_BLOCK_FILE_HEADER + PDA_PARTIAL_BLOB_SIZE));
+    TEST_ASSERT_FALSE(pdaBlockOpen(&file, path)); // sin pie
+
+    writeSeries();
+    stream = fopen(path, "r+b");
+    TEST_ASSERT_NOT_NULL(stream);
+    TEST_ASSERT_EQUAL(0, fseek(stream, -PDA_BLOCK_FILE_FOOTER, SEEK_END));
+    fputc(0x01, stream); // count ya no coincide con el tamaño del archivo
+    fclose(stream);
+    TEST_ASSERT_FALSE(pdaBlockOpen(&file, path));
+
+    TEST_ASSERT_TRUE(pdaBlockWriterOpen(&writer, path, TEST_BLOCK_VALUES));
+    TEST_ASSERT_TRUE(pdaBlockWriterClose(&writer));
+    TEST_ASSERT_TRUE(pdaBlockOpen(&file, path));
+    TEST_ASSERT_EQUAL(0, file.count);
+    pdaBlockClose(&file);
+}
+
+/** 1.2
+ * @brief Las estadísticas de todo el archivo coinciden con computeParticulateStats leyendo solo
+ *        el índice, en un único tramo.
+ */
+void test_pdaBlockStats_usesOnlySummaries(void) {
+    PdaBlockFile file;
+    PdaStats stats;
+    writeSeries();
+    TEST_ASSERT_TRUE(pdaBlockOpen(&file, path));
+    TEST_ASSERT_EQUAL(SERIES_VALUES, file.count);
+    TEST_ASSERT_EQUAL(26, file.blockCount);
+    TEST_ASSERT_TRUE(pdaBlockStats(&file, &stats));
+    assertStatsMatch(values, SERIES_VALUES, &stats);
+    TEST_ASSERT_EQUAL(0, file.blocksDecoded);
+    TEST_ASSERT_EQUAL(1, file.indexReads);
+    pdaBlockClose(&file);
+}
+
+/** 1.3
+ * @brief Las estadísticas de rangos arbitrarios coinciden con computeParticulateStats y leen a lo
+ *        sumo dos bloques de datos y un tramo del índice.
+ */
+void test_pdaBlockRangeStats_matchesSlices(void) {
+    PdaBlockFile file;
+    PdaStats stats;
+    writeSeries();
+    TEST_ASSERT_TRUE(pdaBlockOpen(&file, path));
+    uint32_t state = 3u;
+    for (int q = 0; q < 200; q++) {
+        state = state * 1664525u + 1013904223u;
+        size_t first = (state >> 8) % SERIES_VALUES;
+        state = state * 1664525u + 1013904223u;
+        size_t n = 1 + (state >> 8) % (SERIES_VALUES - first);
+        size_t decodedBefore = file.blocksDecoded;
+        size_t indexReadsBefore = file.indexReads;
+        pdaBlockRangeStats(&file, first, n, &stats);
+        assertStatsMatch(values + first, n, &stats);
+        TEST_ASSERT_TRUE(file.blocksDecoded - decodedBefore <= 2);
+        TEST_ASSERT_TRUE(file.indexReads - indexReadsBefore <= 1);
+    }
+    size_t decodedBefore = file.blocksDecoded;
+    pdaBlockRangeStats(&file, 3 * TEST_BLOCK_VALUES, 10 * TEST_BLOCK_VALUES, &stats);
+    assertStatsMatch(values + 3 * TEST_BLOCK_VALUES, 10 * TEST_BLOCK_VALUES, &stats);
+    TEST_ASSERT_EQUAL(decodedBefore, file.blocksDecoded);
+    pdaBlockClose(&file);
+}
+
+/** 1.4
+ * @brief Los rangos fuera del archivo dan el resultado de un rango vacío.
+ */
+void test_pdaBlockRangeStats_outOfRange(void) {
+    PdaBlockFile file;
+    PdaStats stats;
+    writeSeries();
+    TEST_ASSERT_TRUE(pdaBlockOpen(&file, path));
+    TEST_ASSERT_FALSE(pdaBlockRangeStats(&file, SERIES_VALUES - 5, 6, &stats));
+    TEST_ASSERT_EQUAL_FLOAT(MSN_VOID_ARRAY_VALUE, stats.mean);
+    TEST_ASSERT_FALSE(pdaBlockRangeStats(&file, SERIES_VALUES + 1, 0, &stats));
+    TEST_ASSERT_FALSE(pdaBlockRangeStats(&file, 10, 0, &stats));
+    TEST_ASSERT_EQUAL_FLOAT(MSN_VOID_ARRAY_VALUE, stats.mean);
+    pdaBlockClose(&file);
+}
+
+/* === End of documentation ==================================================================== */
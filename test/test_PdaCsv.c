@@ -0,0 +1,286 @@
+/*
+ * Nombre del archivo: test_PdaCsv.c
+ * Descripción: Pruebas del lector de CSV por bloques.
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE FIUBA
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+
+/**
+ * @file  test_PdaCsv.c
+ * @brief Pruebas unitarias del módulo PdaCsv.
+ *
+ * @test Pruebas unitarias implementadas:
+ *       1.1 pdaCsvParseFloat da el mismo resultado que strtof y rechaza campos que no son números.
+ *       1.2 Las configuraciones inválidas son rechazadas.
+ *       1.3 Un registro leído en bloques de cualquier tamaño coincide con computeParticulateStats
+ *           sobre cada columna elegida.
+ *       1.4 Las filas malformadas se cuentan y sus valores se descartan completos.
+ *       1.5 Un encabezado más largo que PDA_CSV_MAX_LINE se saltea como encabezado, sin contarse
+ *           como fila malformada ni saltear la primera fila de datos.
+ *       1.6 pdaCsvParseFloat no depende del separador decimal de LC_NUMERIC.
+ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "unity.h"
+#include "ParticulateDataAnalyzer.h"
+#include "PdaCsv.h"
+#include <locale.h> // Para setlocale
+#include <stdio.h>  // Para snprintf
+#include <stdlib.h> // Para strtof
+#include <string.h> // Para strlen
+
+/* === Macros definitions ====================================================================== */
+
+/// @brief Calcula el número de elementos en un arreglo estático.
+#define ARRAY_SIZE(arr) (sizeof(arr) / sizeof((arr)[0]))
+
+/// @brief Filas del registro de prueba.
+#define LOG_ROWS 3000
+
+/// @brief Capacidad del texto del registro de prueba.
+#define LOG_CAPACITY (LOG_ROWS * 64)
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/// @brief Lector usado por cada prueba.
+static PdaCsvParser parser;
+
+/// @brief Texto del registro de prueba.
+static char text[LOG_CAPACITY];
+
+/// @brief Valores de MP2.5 y MP10 escritos en el registro.
+static float pm25[LOG_ROWS], pm10[LOG_ROWS];
+
+/// @brief Columnas de MP2.5 y MP10 del registro (marca de tiempo, MP2.5, MP10, T, HR).
+static const size_t pmColumns[] = {1, 2};
+
+/// @brief Estado del generador pseudoaleatorio.
+static uint32_t randomState;
+
+/* === Private function implementation ========================================================= */
+
+/**
+ * @brief Generador congruencial lineal, para que las pruebas sean reproducibles.
+ */
+static uint32_t nextRandom(void) {
+    randomState = randomState * 1664525u + 1013904223u;
+    return randomState >> 8;
+}
+
+/**
+ * @brief Escribe el registro de prueba con CRLF y un encabezado, y retorna su largo.
+ */
+static size_t buildLog(void) {
+    size_t length = (size_t)snprintf(text, LOG_CAPACITY, "timestamp,pm25,pm10,temp,rh\r\n");
+    for (size_t i = 0; i < LOG_ROWS; i++) {
+        char field[32];
+        snprintf(field, sizeof(field), "%.1f", (double)(nextRandom() % 6000) / 10.0 - 50.0);
+        pm25[i] = strtof(field, NULL);
+        length += (size_t)snprintf(text + length, LOG_CAPACITY - length,
+                                   "2023-11-14T00:%02u:00Z,%s,%.3f,21.5,%u\r\n",
+                                   (unsigned)(i % 60), field, (double)(i % 700) * 0.75,
+                                   (unsigned)(i % 100));
+        pm10[i] = (float)((double)(i % 700) * 0.75);
+    }
+    return length;
+}
+
+/**
+ * @brief Verifica que una columna del lector coincida con computeParticulateStats.
+ */
+static void assertColumnMatches(size_t slot, const float * data, size_t n) {
+    PdaStats stats, expected;
+    computeParticulateStats(data, n, &expected);
+    pdaCsvQuery(&parser, slot, &stats);
+    TEST_ASSERT_EQUAL(expected.validCount, stats.validCount);
+    TEST_ASSERT_EQUAL(expected.rejectedCount, stats.rejectedCount);
+    TEST_ASSERT_EQUAL_FLOAT(expected.mean, stats.mean);
+    TEST_ASSERT_EQUAL_FLOAT(expected.min, stats.min);
+    TEST_ASSERT_EQUAL_FLOAT(expected.max, stats.max);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, expected.stdDev, stats.stdDev);
+}
+
+/* === Public function implementation ========================================================== */
+
+void setUp(void) {
+    randomState = 99u;
+}
+
+/** 1.1
+ * @brief pdaCsvParseFloat da el mismo resultado que strtof y rechaza campos que no son números.
+ */
+void test_pdaCsvParseFloat_matchesStrtof(void) {
+    static const char * const special[] = {"0",        "-0",      "12",        "12.5",
+                                           " 7.25 ",   "+3.",     ".5",        "1e3",
+                                           "2.5E-4",   "16777217", "123456789", "0.000001",
+                                           "1e-30",    "3.4e38",  "1e39",      "0.1",
+                                           "499.99",   "00012.50", "12345678901234567890123"};
+    static const char * const invalid[] = {"", " ", "-", ".", "1e", "1e+", "1.2.3", "12a",
+                                           "nan", "0x10", "1 2"};
+    float value;
+    for (size_t i = 0; i < ARRAY_SIZE(special); i++) {
+        const char * s = special[i];
+        TEST_ASSERT_TRUE(pdaCsvParseFloat(s, s + strlen(s), &value));
+        float expected = strtof(s, NULL);
+        TEST_ASSERT_EQUAL_MEMORY(&expected, &value, sizeof(float));
+    }
+    for (size_t i = 0; i < ARRAY_SIZE(invalid); i++) {
+        const char * s = invalid[i];
+        TEST_ASSERT_FALSE(pdaCsvParseFloat(s, s + strlen(s), &value));
+    }
+
+    char field[48];
+    for (int i = 0; i < 100000; i++) {
+        double x = (double)nextRandom() / (double)(1u << 24) * 1000.0 - 100.0;
+        snprintf(field, sizeof(field), (i % 2) ? "%.*f" : "%.*g", 1 + i % 9, x);
+        TEST_ASSERT_TRUE(pdaCsvParseFloat(field, field + strlen(field), &value));
+        float expected = strtof(field, NULL);
+        TEST_ASSERT_EQUAL_MEMORY(&expected, &value, sizeof(float));
+    }
+}
+
+/** 1.2
+ * @brief Las configuraciones inválidas son rechazadas.
+ */
+void test_pdaCsvInit_rejectsInvalidConfig(void) {
+    const size_t repeated[] = {1, 1};
+    const size_t outOfRange[] = {PDA_CSV_MAX_FIELDS};
+    const size_t tooMany[PDA_CSV_MAX_COLUMNS + 1] = {0, 1, 2, 3, 4, 5, 6, 7, 8};
+    TEST_ASSERT_FALSE(pdaCsvInit(&parser, repeated, ARRAY_SIZE(repeated), ',', 0));
+    TEST_ASSERT_FALSE(pdaCsvInit(&parser, outOfRange, 1, ',', 0));
+    TEST_ASSERT_FALSE(pdaCsvInit(&parser, tooMany, ARRAY_SIZE(tooMany), ',', 0));
+    TEST_ASSERT_FALSE(pdaCsvInit(&parser, pmColumns, 0, ',', 0));
+    TEST_ASSERT_FALSE(pdaCsvInit(&parser, pmColumns, ARRAY_SIZE(pmColumns), '\n', 0));
+    TEST_ASSERT_TRUE(pdaCsvInit(&parser, pmColumns, ARRAY_SIZE(pmColumns), ',', 0));
+    TEST_ASSERT_FALSE(pdaCsvQuery(&parser, ARRAY_SIZE(pmColumns), NULL));
+}
+
+/** 1.3
+ * @brief Un registro leído en bloques de cualquier tamaño coincide con computeParticulateStats
+ *        sobre cada columna elegida.
+ */
+void test_pdaCsvFeed_anyChunkSize(void) {
+    size_t length = buildLog();
+    const size_t chunkSizes[] = {1, 7, 64, 4096, LOG_CAPACITY};
+    for (size_t c = 0; c < ARRAY_SIZE(chunkSizes); c++) {
+        TEST_ASSERT_TRUE(pdaCsvInit(&parser, pmColumns, ARRAY_SIZE(pmColumns), ',', 1));
+        for (size_t done = 0; done < length; done += chunkSizes[c]) {
+            size_t size = (length - done < chunkSizes[c]) ? length - done : chunkSizes[c];
+            pdaCsvFeed(&parser, text + done, size);
+        }
+        pdaCsvFinish(&parser);
+        TEST_ASSERT_EQUAL(LOG_ROWS, parser.rows);
+        TEST_ASSERT_EQUAL(0, parser.malformedRows);
+        assertColumnMatches(0, pm25, LOG_ROWS);
+        assertColumnMatches(1, pm10, LOG_ROWS);
+    }
+}
+
+/** 1.4
+ * @brief Las filas malformadas se cuentan y sus valores se descartan completos.
+ */
+void test_pdaCsvFeed_malformedRows(void) {
+    char longLine[PDA_CSV_MAX_LINE + 16];
+    memset(longLine, '1', sizeof(longLine) - 1);
+    longLine[sizeof(longLine) - 2] = '\n';
+    longLine[sizeof(longLine) - 1] = '\0';
+    const char * rows[] = {"t,10.5,20.5,0,0\n", "t,11.5\n", "t,abc,30,0,0\n", "\n",
+                           "t,12.5,,0,0\n",     longLine,  "t,13.5,40.5"};
+    const float expected25[] = {10.5f, 13.5f};
+    const float expected10[] = {20.5f, 40.5f};
+    TEST_ASSERT_TRUE(pdaCsvInit(&parser, pmColumns, ARRAY_SIZE(pmColumns), ',', 0));
+    for (size_t i = 0; i < ARRAY_SIZE(rows); i++)
+        pdaCsvFeed(&parser, rows[i], strlen(rows[i]));
+    pdaCsvFinish(&parser);
+    TEST_ASSERT_EQUAL(2, parser.rows);
+    TEST_ASSERT_EQUAL(4, parser.malformedRows);
+    assertColumnMatches(0, expected25, ARRAY_SIZE(expected25));
+    assertColumnMatches(1, expected10, ARRAY_SIZE(expected10));
+}
+
+/** 1.5
+ * @brief Un encabezado más largo que PDA_CSV_MAX_LINE se saltea como encabezado, sin contarse
+ *        como fila malformada ni saltear la primera fila de datos.
+ */
+void test_pdaCsvFeed_longHeader(void) {
+    char log[PDA_CSV_MAX_LINE * 2 + 64];
+    size_t length = 0;
+    for (size_t column = 0; length < PDA_CSV_MAX_LINE + 8; column++)
+        length += (size_t)snprintf(log + length, sizeof(log) - length, "sensor_column_%02u,",
+                                   (unsigned)column);
+    log[length - 1] = '\n';
+    length += (size_t)snprintf(log + length, sizeof(log) - length, "t,10.5,20.5\nt,13.5,40.5\n");
+    const float expected25[] = {10.5f, 13.5f};
+    const float expected10[] = {20.5f, 40.5f};
+
+    const size_t chunkSizes[] = {1, 100, sizeof(log)};
+    for (size_t c = 0; c < ARRAY_SIZE(chunkSizes); c++) {
+        TEST_ASSERT_TRUE(pdaCsvInit(&parser, pmColumns, ARRAY_SIZE(pmColumns), ',', 1));
+        for (size_t done = 0; done < length; done += chunkSizes[c]) {
+            size_t size = (length - done < chunkSizes[c]) ? length - done : chunkSizes[c];
+            pdaCsvFeed(&parser, log + done, size);
+        }
+        pdaCsvFinish(&parser);
+        TEST_ASSERT_EQUAL(2, parser.rows);
+        TEST_ASSERT_EQUAL(0, parser.malformedRows);
+        assertColumnMatches(0, expected25, ARRAY_SIZE(expected25));
+        assertColumnMatches(1, expected10, ARRAY_SIZE(expected10));
+    }
+}
+
+/** 1.6
+ * @brief pdaCsvParseFloat no depende del separador decimal de LC_NUMERIC.
+ */
+void test_pdaCsvParseFloat_ignoresLocale(void) {
+    static const char * const locales[] = {"es_AR.UTF-8", "es_ES.UTF-8", "de_DE.UTF-8",
+                                           "fr_FR.UTF-8"};
+    static const char * const fields[] = {"12.5", "123.456789012", "2.5E-4", "0.000001234567"};
+    float expected[ARRAY_SIZE(fields)];
+    for (size_t i = 0; i < ARRAY_SIZE(fields); i++)
+        expected[i] = strtof(fields[i], NULL);
+
+    bool changed = false;
+    for (size_t i = 0; i < ARRAY_SIZE(locales) && !changed; i++)
+        changed = (setlocale(LC_NUMERIC, locales[i]) != NULL);
+    if (!changed)
+        TEST_IGNORE(); // el sistema no tiene una configuración regional con coma decimal
+
+    bool matches[ARRAY_SIZE(fields)];
+    for (size_t i = 0; i < ARRAY_SIZE(fields); i++) {
+        float value;
+        const char * s = fields[i];
+        matches[i] = pdaCsvParseFloat(s, s + strlen(s), &value) &&
+                     memcmp(&expected[i], &value, sizeof(float)) == 0;
+    }
+    setlocale(LC_NUMERIC, "C");
+    for (size_t i = 0; i < ARRAY_SIZE(fields); i++)
+        TEST_ASSERT_TRUE(matches[i]);
+}
+
+/* === End of documentation ==================================================================== */
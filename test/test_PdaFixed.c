@@ -0,0 +1,208 @@
+/*
+ * Nombre del archivo: test_PdaFixed.c
+ * Descripción: Pruebas de equivalencia de la API en punto fijo con la API en float.
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE FIUBA
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+
+/**
+ * @file  test_PdaFixed.c
+ * @brief Pruebas unitarias del módulo PdaFixed.
+ *
+ * @test Pruebas unitarias implementadas:
+ *       1.1 pdaFixIsValid coincide con maskIsDataTrue para todos los datos UQ9.7 y
+ *           pdaFixFromFloat conserva la validez.
+ *       1.2 pdaIsqrt32 retorna la raíz entera por defecto, incluso junto a cuadrados perfectos.
+ *       2.1 Sobre datos aleatorios, los resultados coinciden con la API en float y el promedio y
+ *           la desviación estándar son el redondeo exacto calculado en long double.
+ *       2.2 Los valores de error coinciden con los de la API en float.
+ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "unity.h"
+#include "ParticulateDataAnalyzer.h"
+#include "PdaFixed.h"
+#include <math.h>
+
+/* === Macros definitions ====================================================================== */
+
+/// @brief Calcula el número de elementos en un arreglo estático.
+#define ARRAY_SIZE(arr) (sizeof(arr) / sizeof((arr)[0]))
+
+/// @brief Mayor cantidad de datos admitida por la API en punto fijo.
+#define MAX_DATA_SIZE UINT16_MAX
+
+/// @brief Tolerancia frente a la API en float: medio bit de Q24.7 más el error de la API en float.
+#define FLOAT_TOLERANCE (0.5f / PDA_FIX_ONE + 1e-3f)
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/// @brief Estado del generador pseudoaleatorio.
+static uint32_t randomState;
+
+/// @brief Datos en punto fijo y su equivalente en float.
+static PdaFixSample samples[MAX_DATA_SIZE];
+static float values[MAX_DATA_SIZE];
+
+/* === Private function implementation ========================================================= */
+
+/**
+ * @brief Generador congruencial lineal, para que las pruebas sean reproducibles.
+ */
+static uint32_t nextRandom(void) {
+    randomState = randomState * 1664525u + 1013904223u;
+    return randomState >> 8;
+}
+
+/**
+ * @brief Verifica una cantidad de datos contra la API en float y contra el redondeo exacto.
+ */
+static void assertMatchesReference(uint16_t n) {
+    PdaFixStats fix;
+    PdaStats ref;
+    for (uint32_t i = 0; i < n; i++)
+        values[i] = (float)samples[i] / PDA_FIX_ONE;
+    computeParticulateStatsFix(samples, n, &fix);
+    computeParticulateStats(values, n, &ref);
+
+    TEST_ASSERT_EQUAL(ref.validCount, fix.validCount);
+    TEST_ASSERT_EQUAL(ref.rejectedCount, fix.rejectedCount);
+    TEST_ASSERT_EQUAL_FLOAT(ref.min, pdaFixToFloat(fix.min));
+    TEST_ASSERT_EQUAL_FLOAT(ref.max, pdaFixToFloat(fix.max));
+    TEST_ASSERT_FLOAT_WITHIN(FLOAT_TOLERANCE, ref.mean, pdaFixToFloat(fix.mean));
+    TEST_ASSERT_FLOAT_WITHIN(FLOAT_TOLERANCE, ref.stdDev, pdaFixToFloat(fix.stdDev));
+
+    long double sum = 0.0L, sumOfSquares = 0.0L, m = fix.validCount;
+    for (uint32_t i = 0; i < n; i++) {
+        if (pdaFixIsValid(samples[i])) {
+            sum += samples[i];
+            sumOfSquares += (long double)samples[i] * samples[i];
+        }
+    }
+    TEST_ASSERT_EQUAL((long long)floorl(sum / m + 0.5L), fix.mean);
+    if (fix.validCount > 1) {
+        long double variance = (m * sumOfSquares - sum * sum) / (m * (m - 1.0L));
+        TEST_ASSERT_EQUAL((long long)floorl(sqrtl(variance) + 0.5L), fix.stdDev);
+    }
+}
+
+/* === Public function implementation ========================================================== */
+
+void setUp(void) {
+    randomState = 77u;
+}
+
+/** 1.1
+ * @brief pdaFixIsValid coincide con maskIsDataTrue para todos los datos UQ9.7 y pdaFixFromFloat
+ *        conserva la validez.
+ */
+void test_pdaFixIsValid_matchesFloatMask(void) {
+    for (uint32_t raw = 0; raw <= UINT16_MAX; raw++) {
+        float value = (float)raw / PDA_FIX_ONE;
+        TEST_ASSERT_EQUAL(maskIsDataTrue(value), pdaFixIsValid((PdaFixSample)raw));
+        TEST_ASSERT_EQUAL(maskIsDataTrue(value), pdaFixIsValid(pdaFixFromFloat(value)));
+    }
+    TEST_ASSERT_EQUAL(PDA_FIX_MIN_RAW, pdaFixFromFloat(0.1001f));
+    TEST_ASSERT_EQUAL(PDA_FIX_MAX_RAW, pdaFixFromFloat(499.999f));
+    TEST_ASSERT_EQUAL(0, pdaFixFromFloat(NAN));
+    TEST_ASSERT_EQUAL(1600, pdaFixFromFloat(12.5f));
+}
+
+/** 1.2
+ * @brief pdaIsqrt32 retorna la raíz entera por defecto, incluso junto a cuadrados perfectos.
+ */
+void test_pdaIsqrt32_isFloorRoot(void) {
+    for (uint32_t r = 0; r <= UINT16_MAX; r += (r < 300) ? 1 : 97) {
+        uint32_t square = r * r;
+        TEST_ASSERT_EQUAL(r, pdaIsqrt32(square));
+        if (r > 0)
+            TEST_ASSERT_EQUAL(r - 1, pdaIsqrt32(square - 1));
+    }
+    TEST_ASSERT_EQUAL(UINT16_MAX, pdaIsqrt32(UINT32_MAX));
+    for (int i = 0; i < 100000; i++) {
+        uint32_t x = (nextRandom() << 8) ^ nextRandom();
+        uint64_t r = pdaIsqrt32(x);
+        TEST_ASSERT_TRUE(r * r <= x && (r + 1) * (r + 1) > x);
+    }
+}
+
+/** 2.1
+ * @brief Sobre datos aleatorios, los resultados coinciden con la API en float y el promedio y la
+ *        desviación estándar son el redondeo exacto calculado en long double.
+ */
+void test_computeParticulateStatsFix_matchesReference(void) {
+    const uint16_t sizes[] = {2, 3, 10, 100, 4097, MAX_DATA_SIZE};
+    for (uint32_t i = 0; i < MAX_DATA_SIZE; i++)
+        samples[i] = (PdaFixSample)nextRandom();
+    for (size_t s = 0; s < ARRAY_SIZE(sizes); s++)
+        assertMatchesReference(sizes[s]);
+
+    // valores extremos y varianza máxima
+    for (uint32_t i = 0; i < MAX_DATA_SIZE; i++)
+        samples[i] = (i % 2) ? PDA_FIX_MIN_RAW : PDA_FIX_MAX_RAW;
+    assertMatchesReference(2);
+    assertMatchesReference(MAX_DATA_SIZE);
+
+    // datos casi constantes: la varianza directa en float perdería todos los dígitos
+    for (uint32_t i = 0; i < MAX_DATA_SIZE; i++)
+        samples[i] = (PdaFixSample)(60000 + i % 3);
+    assertMatchesReference(MAX_DATA_SIZE);
+}
+
+/** 2.2
+ * @brief Los valores de error coinciden con los de la API en float.
+ */
+void test_computeParticulateStatsFix_errorValues(void) {
+    const PdaFixSample one[] = {1600};
+    const PdaFixSample invalid[] = {0, 5, PDA_FIX_MAX_RAW + 1};
+    const PdaFixSample single[] = {0, 1600, UINT16_MAX};
+    PdaFixStats stats;
+
+    TEST_ASSERT_FALSE(computeParticulateStatsFix(one, 0, &stats));
+    TEST_ASSERT_EQUAL_FLOAT(MSN_VOID_ARRAY_VALUE, pdaFixToFloat(stats.mean));
+    TEST_ASSERT_EQUAL_FLOAT(MSN_VOID_ARRAY_VALUE, pdaFixToFloat(stats.stdDev));
+
+    TEST_ASSERT_TRUE(computeParticulateStatsFix(one, 1, &stats));
+    TEST_ASSERT_EQUAL_FLOAT(12.5f, pdaFixToFloat(stats.mean));
+    TEST_ASSERT_EQUAL_FLOAT(MSN_DS_NOTDEFINI, pdaFixToFloat(stats.stdDev));
+
+    TEST_ASSERT_FALSE(computeParticulateStatsFix(invalid, ARRAY_SIZE(invalid), &stats));
+    TEST_ASSERT_EQUAL_FLOAT(MSN_VOID_ARRAY_VALUE, pdaFixToFloat(stats.max));
+    TEST_ASSERT_EQUAL_FLOAT(MSN_NOT_DATA, pdaFixToFloat(stats.stdDev));
+    TEST_ASSERT_EQUAL(3, stats.rejectedCount);
+
+    TEST_ASSERT_EQUAL_FLOAT(MSN_NOT_DATA,
+                            pdaFixToFloat(calculateStandardDeviationFix(single, 3)));
+    TEST_ASSERT_EQUAL(1600, calculateAverageFix(single, 3));
+    TEST_ASSERT_EQUAL(1600, findMaxValueFix(single, 3));
+    TEST_ASSERT_EQUAL(1600, findMinValueFix(single, 3));
+    TEST_ASSERT_FALSE(computeParticulateStatsFix(NULL, 3, &stats));
+}
+
+/* === End of documentation ==================================================================== */
@@ -0,0 +1,237 @@
+/*
+ * Nombre del archivo: test_PdaFleet.c
+ * Descripción: Pruebas de las estadísticas por sensor de una flota.
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE FIUBA
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+
+/**
+ * @file  test_PdaFleet.c
+ * @brief Pruebas unitarias del módulo PdaFleet.
+ *
+ * @test Pruebas unitarias implementadas:
+ *       1.1 Una flota se puede crear en una región del llamador solo si la región alcanza, y
+ *           una flota nueva no tiene sensores.
+ *       1.2 Con un lote desordenado, cada sensor coincide con computeParticulateStats sobre sus
+ *           datos.
+ *       1.3 Los datos de sensores que no entran en la flota y de PDA_FLEET_NO_SENSOR se
+ *           descartan.
+ *       1.4 pdaFleetSnapshot entrega cada sensor una vez y, al reiniciar, los sensores quedan
+ *           registrados y sin datos.
+ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "unity.h"
+#include "ParticulateDataAnalyzer.h"
+#include "PdaFleet.h"
+
+/* === Macros definitions ====================================================================== */
+
+/// @brief Calcula el número de elementos en un arreglo estático.
+#define ARRAY_SIZE(arr) (sizeof(arr) / sizeof((arr)[0]))
+
+/// @brief Cantidad de sensores de la flota de las pruebas.
+#define SENSOR_COUNT 40
+
+/// @brief Datos por sensor de la prueba de estadísticas.
+#define SAMPLES_PER_SENSOR 50
+
+/// @brief Cantidad total de pares de la prueba de estadísticas.
+#define SAMPLE_COUNT (SENSOR_COUNT * SAMPLES_PER_SENSOR)
+
+/// @brief Tamaño de la región estática de la prueba 1.1, en palabras de 8 bytes.
+#define STATIC_ARENA_WORDS 1024
+
+/* === Private data type declarations ========================================================== */
+
+/**
+ * @brief Registro de los sensores entregados por pdaFleetSnapshot.
+ */
+typedef struct {
+    size_t calls;               /**< Cantidad de sensores entregados. */
+    size_t seen[SENSOR_COUNT];  /**< Veces que se entregó cada sensor. */
+    float mean[SENSOR_COUNT];   /**< Promedio entregado de cada sensor. */
+    size_t valid[SENSOR_COUNT]; /**< Datos válidos entregados de cada sensor. */
+} SnapshotLog;
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/// @brief Flota usada por cada prueba.
+static PdaFleet * fleet;
+
+/// @brief Pares de la prueba de estadísticas.
+static PdaSensorSample samples[SAMPLE_COUNT];
+
+/// @brief Datos de un sensor, para calcular el resultado esperado.
+static float sensorData[SAMPLES_PER_SENSOR];
+
+/// @brief Región estática de la prueba 1.1.
+static uint64_t staticArena[STATIC_ARENA_WORDS];
+
+/* === Private function implementation ========================================================= */
+
+/**
+ * @brief Identificador del sensor número s de las pruebas (no consecutivos).
+ */
+static uint32_t sensorIdOf(size_t s) {
+    return (uint32_t)(1000 + 37 * s);
+}
+
+/**
+ * @brief Receptor de pdaFleetSnapshot que registra cada sensor en un SnapshotLog.
+ */
+static void logSensor(uint32_t sensorId, const PdaStats * stats, void * context) {
+    SnapshotLog * log = context;
+    size_t s = (sensorId - 1000) / 37;
+    log->calls++;
+    log->seen[s]++;
+    log->mean[s] = stats->mean;
+    log->valid[s] = stats->validCount;
+}
+
+/* === Public function implementation ========================================================== */
+
+void setUp(void) {
+    fleet = pdaFleetCreate(SENSOR_COUNT);
+}
+
+void tearDown(void) {
+    pdaFleetDestroy(fleet);
+}
+
+/** 1.1
+ * @brief Una flota se puede crear en una región del llamador solo si la región alcanza, y una
+ * flota nueva no tiene sensores.
+ */
+void test_pdaFleetCreate_emptyFleet(void) {
+    PdaStats stats;
+    TEST_ASSERT_EQUAL(0, pdaFleetArenaSize(0));
+    TEST_ASSERT_NULL(pdaFleetCreate(0));
+    TEST_ASSERT_NOT_NULL(fleet);
+    TEST_ASSERT_EQUAL(0, pdaFleetSensorCount(fleet));
+    TEST_ASSERT_FALSE(pdaFleetQuery(fleet, sensorIdOf(0), &stats));
+    TEST_ASSERT_EQUAL_FLOAT(MSN_VOID_ARRAY_VALUE, stats.mean);
+
+    size_t size = pdaFleetArenaSize(SENSOR_COUNT);
+    TEST_ASSERT_TRUE(size <= sizeof(staticArena));
+    TEST_ASSERT_NULL(pdaFleetCreateIn(staticArena, size - 1, SENSOR_COUNT));
+    PdaFleet * staticFleet = pdaFleetCreateIn(staticArena, sizeof(staticArena), SENSOR_COUNT);
+    TEST_ASSERT_EQUAL_PTR(staticArena, staticFleet);
+    const PdaSensorSample sample = {sensorIdOf(3), 12.5f};
+    TEST_ASSERT_EQUAL(1, pdaFleetIngest(staticFleet, &sample, 1));
+    TEST_ASSERT_TRUE(pdaFleetQuery(staticFleet, sensorIdOf(3), &stats));
+    TEST_ASSERT_EQUAL_FLOAT(12.5f, stats.mean);
+    pdaFleetDestroy(staticFleet);
+}
+
+/** 1.2
+ * @brief Con un lote desordenado, cada sensor coincide con computeParticulateStats sobre sus
+ * datos.
+ */
+void test_pdaFleetIngest_unsortedMatchesComputeParticulateStats(void) {
+    uint32_t state = 5u;
+    for (size_t i = 0; i < SAMPLE_COUNT; i++) {
+        state = state * 1664525u + 1013904223u;
+        // el dato i pertenece al sensor i % SENSOR_COUNT; algunos son inválidos
+        samples[i].sensorId = sensorIdOf(i % SENSOR_COUNT);
+        samples[i].value = (i % 13 == 0) ? 0.0f : 50.0f + (float)(state >> 8) / (1u << 24);
+    }
+    TEST_ASSERT_EQUAL(SAMPLE_COUNT / 2, pdaFleetIngest(fleet, samples, SAMPLE_COUNT / 2));
+    TEST_ASSERT_EQUAL(SAMPLE_COUNT / 2,
+                      pdaFleetIngest(fleet, samples + SAMPLE_COUNT / 2, SAMPLE_COUNT / 2));
+    TEST_ASSERT_EQUAL(SENSOR_COUNT, pdaFleetSensorCount(fleet));
+
+    for (size_t s = 0; s < SENSOR_COUNT; s++) {
+        PdaStats expected, actual;
+        for (size_t k = 0; k < SAMPLES_PER_SENSOR; k++)
+            sensorData[k] = samples[k * SENSOR_COUNT + s].value;
+        bool expectedValid = computeParticulateStats(sensorData, SAMPLES_PER_SENSOR, &expected);
+        TEST_ASSERT_EQUAL(expectedValid, pdaFleetQuery(fleet, sensorIdOf(s), &actual));
+        TEST_ASSERT_EQUAL(expected.validCount, actual.validCount);
+        TEST_ASSERT_EQUAL(expected.rejectedCount, actual.rejectedCount);
+        TEST_ASSERT_FLOAT_WITHIN(1e-4, expected.mean, actual.mean);
+        TEST_ASSERT_EQUAL_FLOAT(expected.min, actual.min);
+        TEST_ASSERT_EQUAL_FLOAT(expected.max, actual.max);
+        TEST_ASSERT_FLOAT_WITHIN(1e-5, expected.stdDev, actual.stdDev);
+    }
+}
+
+/** 1.3
+ * @brief Los datos de sensores que no entran en la flota y de PDA_FLEET_NO_SENSOR se descartan.
+ */
+void test_pdaFleetIngest_fullFleetRejectsNewSensors(void) {
+    // con USE_STATIC_MEM el conjunto puede tener una sola flota: se libera la de setUp
+    pdaFleetDestroy(fleet);
+    fleet = NULL;
+    PdaFleet * smallFleet = pdaFleetCreate(2);
+    TEST_ASSERT_NOT_NULL(smallFleet);
+    const PdaSensorSample batch[] = {
+        {10, 1.0f}, {20, 2.0f}, {30, 3.0f}, {PDA_FLEET_NO_SENSOR, 4.0f}, {30, 5.0f}, {10, 6.0f},
+    };
+    PdaStats stats;
+    TEST_ASSERT_EQUAL(3, pdaFleetIngest(smallFleet, batch, ARRAY_SIZE(batch)));
+    TEST_ASSERT_EQUAL(2, pdaFleetSensorCount(smallFleet));
+    TEST_ASSERT_FALSE(pdaFleetQuery(smallFleet, 30, &stats));
+    TEST_ASSERT_FALSE(pdaFleetQuery(smallFleet, PDA_FLEET_NO_SENSOR, &stats));
+    TEST_ASSERT_TRUE(pdaFleetQuery(smallFleet, 10, &stats));
+    TEST_ASSERT_EQUAL_FLOAT(3.5f, stats.mean);
+    TEST_ASSERT_EQUAL(2, stats.validCount);
+    pdaFleetDestroy(smallFleet);
+}
+
+/** 1.4
+ * @brief pdaFleetSnapshot entrega cada sensor una vez y, al reiniciar, los sensores quedan
+ * registrados y sin datos.
+ */
+void test_pdaFleetSnapshot_resetKeepsSensors(void) {
+    SnapshotLog log = {0};
+    PdaStats stats;
+    // lote ordenado por sensor: el sensor s recibe s + 1 datos iguales a s + 1
+    size_t count = 0;
+    for (size_t s = 0; s < SENSOR_COUNT; s++)
+        for (size_t k = 0; k <= s; k++)
+            samples[count++] = (PdaSensorSample){sensorIdOf(s), (float)(s + 1)};
+    TEST_ASSERT_EQUAL(count, pdaFleetIngest(fleet, samples, count));
+
+    TEST_ASSERT_EQUAL(SENSOR_COUNT, pdaFleetSnapshot(fleet, logSensor, &log, true));
+    TEST_ASSERT_EQUAL(SENSOR_COUNT, log.calls);
+    for (size_t s = 0; s < SENSOR_COUNT; s++) {
+        TEST_ASSERT_EQUAL(1, log.seen[s]);
+        TEST_ASSERT_EQUAL_FLOAT((float)(s + 1), log.mean[s]);
+        TEST_ASSERT_EQUAL(s + 1, log.valid[s]);
+    }
+
+    TEST_ASSERT_EQUAL(SENSOR_COUNT, pdaFleetSensorCount(fleet));
+    TEST_ASSERT_FALSE(pdaFleetQuery(fleet, sensorIdOf(7), &stats));
+    TEST_ASSERT_EQUAL(0, stats.validCount + stats.rejectedCount);
+    TEST_ASSERT_EQUAL_FLOAT(MSN_VOID_ARRAY_VALUE, stats.mean);
+    TEST_ASSERT_EQUAL(count, pdaFleetIngest(fleet, samples, count));
+    TEST_ASSERT_TRUE(pdaFleetQuery(fleet, sensorIdOf(7), &stats));
+    TEST_ASSERT_EQUAL(8, stats.validCount);
+}
+
+/* === End of documentation ==================================================================== */
@@ -0,0 +1,228 @@
+/*
+ * Nombre del archivo: test_PdaFrame.c
+ * Descripción: Pruebas de las estadísticas por canal de tramas intercaladas.
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE FIUBA
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+
+/**
+ * @file  test_PdaFrame.c
+ * @brief Pruebas unitarias del módulo PdaFrame.
+ *
+ * @test Pruebas unitarias implementadas:
+ *       1.1 Los argumentos inválidos se rechazan y un buffer vacío informa los códigos de error.
+ *       1.2 Cada canal float coincide con computeParticulateStats sobre el canal separado.
+ *       1.3 Cada canal aplica su propio rango de validez, también a los conteos enteros.
+ *       1.4 La variante con stride coincide con computeParticulateStats y las tramas
+ *           empaquetadas se leen sin alinear.
+ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "unity.h"
+#include "ParticulateDataAnalyzer.h"
+#include "PdaFrame.h"
+#include <string.h> // Para memcpy
+
+/* === Macros definitions ====================================================================== */
+
+/// @brief Calcula el número de elementos en un arreglo estático.
+#define ARRAY_SIZE(arr) (sizeof(arr) / sizeof((arr)[0]))
+
+/// @brief Cantidad de tramas de prueba.
+#define FRAME_COUNT 1000
+
+/// @brief Tamaño de una trama empaquetada: marca de tiempo de 1 byte seguida de un float.
+#define PACKED_FRAME_SIZE 5
+
+/* === Private data type declarations ========================================================== */
+
+/**
+ * @brief Trama de un sensor de MP con conteos de partículas.
+ */
+typedef struct {
+    uint32_t timestamp;
+    float pm1;
+    float pm25;
+    float pm10;
+    uint16_t count03;
+    uint32_t count10;
+} SensorFrame;
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/// @brief Tramas de prueba.
+static SensorFrame frames[FRAME_COUNT];
+
+/// @brief Canal separado, para comparar.
+static float channel[FRAME_COUNT];
+
+/// @brief Canales de MP con el rango de maskIsDataTrue.
+static const PdaChannel mpChannels[] = {
+    PDA_CHANNEL_MP(SensorFrame, pm1),
+    PDA_CHANNEL_MP(SensorFrame, pm25),
+    PDA_CHANNEL_MP(SensorFrame, pm10),
+};
+
+/* === Private function implementation ========================================================= */
+
+/**
+ * @brief Genera tramas con datos de MP en [-10, 510) y conteos en [0, 1000).
+ */
+static void fillFrames(void) {
+    uint32_t state = 23u;
+    for (size_t i = 0; i < FRAME_COUNT; i++) {
+        float * fields[] = {&frames[i].pm1, &frames[i].pm25, &frames[i].pm10};
+        for (size_t c = 0; c < ARRAY_SIZE(fields); c++) {
+            state = state * 1664525u + 1013904223u;
+            *fields[c] = (float)(state >> 8) / (float)(1u << 24) * 520.0f - 10.0f;
+        }
+        frames[i].timestamp = (uint32_t)i;
+        frames[i].count03 = (uint16_t)((state >> 4) % 1000u);
+        frames[i].count10 = (state >> 14) % 1000u;
+    }
+}
+
+/**
+ * @brief Verifica que dos resúmenes coincidan.
+ */
+static void assertStatsEqual(const PdaStats * expected, const PdaStats * actual) {
+    TEST_ASSERT_EQUAL(expected->validCount, actual->validCount);
+    TEST_ASSERT_EQUAL(expected->rejectedCount, actual->rejectedCount);
+    TEST_ASSERT_EQUAL_FLOAT(expected->mean, actual->mean);
+    TEST_ASSERT_EQUAL_FLOAT(expected->min, actual->min);
+    TEST_ASSERT_EQUAL_FLOAT(expected->max, actual->max);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, expected->stdDev, actual->stdDev);
+}
+
+/* === Public function implementation ========================================================== */
+
+void setUp(void) {
+    fillFrames();
+}
+
+/** 1.1
+ * @brief Los argumentos inválidos se rechazan y un buffer vacío informa los códigos de error.
+ */
+void test_computeFrameStats_invalidArguments(void) {
+    PdaStats stats[PDA_FRAME_MAX_CHANNELS + 1];
+    const PdaChannel badType = {0, (PdaChannelType)7, 0.0, 1.0};
+    const PdaChannel outside = {sizeof(SensorFrame) - 2, PDA_CHANNEL_F32, 0.0, 1.0};
+    TEST_ASSERT_FALSE(computeFrameStats(frames, FRAME_COUNT, sizeof(SensorFrame), mpChannels, 0,
+                                        stats));
+    TEST_ASSERT_FALSE(computeFrameStats(frames, FRAME_COUNT, sizeof(SensorFrame), mpChannels,
+                                        PDA_FRAME_MAX_CHANNELS + 1, stats));
+    TEST_ASSERT_FALSE(
+        computeFrameStats(frames, FRAME_COUNT, sizeof(SensorFrame), &badType, 1, stats));
+    TEST_ASSERT_FALSE(
+        computeFrameStats(frames, FRAME_COUNT, sizeof(SensorFrame), &outside, 1, stats));
+    TEST_ASSERT_FALSE(computeFrameStats(frames, FRAME_COUNT, sizeof(SensorFrame), mpChannels,
+                                        ARRAY_SIZE(mpChannels), NULL));
+
+    TEST_ASSERT_TRUE(computeFrameStats(NULL, FRAME_COUNT, sizeof(SensorFrame), mpChannels,
+                                       ARRAY_SIZE(mpChannels), stats));
+    TEST_ASSERT_EQUAL(0, stats[1].validCount);
+    TEST_ASSERT_EQUAL_FLOAT(MSN_VOID_ARRAY_VALUE, stats[1].mean);
+    TEST_ASSERT_EQUAL_FLOAT(MSN_VOID_ARRAY_VALUE, stats[1].stdDev);
+}
+
+/** 1.2
+ * @brief Cada canal float coincide con computeParticulateStats sobre el canal separado.
+ */
+void test_computeFrameStats_matchesDeinterleaved(void) {
+    PdaStats stats[ARRAY_SIZE(mpChannels)];
+    PdaStats expected;
+    TEST_ASSERT_TRUE(computeFrameStats(frames, FRAME_COUNT, sizeof(SensorFrame), mpChannels,
+                                       ARRAY_SIZE(mpChannels), stats));
+    for (size_t c = 0; c < ARRAY_SIZE(mpChannels); c++) {
+        for (size_t i = 0; i < FRAME_COUNT; i++)
+            memcpy(&channel[i], (const uint8_t *)&frames[i] + mpChannels[c].offset,
+                   sizeof(float));
+        computeParticulateStats(channel, FRAME_COUNT, &expected);
+        assertStatsEqual(&expected, &stats[c]);
+    }
+}
+
+/** 1.3
+ * @brief Cada canal aplica su propio rango de validez, también a los conteos enteros.
+ */
+void test_computeFrameStats_perChannelRanges(void) {
+    const PdaChannel channels[] = {
+        PDA_CHANNEL(SensorFrame, pm25, PDA_CHANNEL_F32, 100.0, 200.0),
+        PDA_CHANNEL(SensorFrame, count03, PDA_CHANNEL_U16, -1.0, 500.0),
+        PDA_CHANNEL(SensorFrame, count10, PDA_CHANNEL_U32, -1.0, 1000.0),
+    };
+    PdaStats stats[ARRAY_SIZE(channels)];
+    TEST_ASSERT_TRUE(computeFrameStats(frames, FRAME_COUNT, sizeof(SensorFrame), channels,
+                                       ARRAY_SIZE(channels), stats));
+
+    size_t valid25 = 0, valid03 = 0;
+    double sum03 = 0.0, sum10 = 0.0;
+    for (size_t i = 0; i < FRAME_COUNT; i++) {
+        valid25 += (frames[i].pm25 > 100.0f && frames[i].pm25 < 200.0f);
+        if (frames[i].count03 < 500) {
+            valid03++;
+            sum03 += frames[i].count03;
+        }
+        sum10 += frames[i].count10;
+    }
+    TEST_ASSERT_EQUAL(valid25, stats[0].validCount);
+    TEST_ASSERT_TRUE(stats[0].min > 100.0f && stats[0].max < 200.0f);
+    TEST_ASSERT_EQUAL(valid03, stats[1].validCount);
+    TEST_ASSERT_EQUAL(FRAME_COUNT - valid03, stats[1].rejectedCount);
+    TEST_ASSERT_EQUAL_FLOAT(sum03 / (double)valid03, stats[1].mean);
+    TEST_ASSERT_EQUAL(FRAME_COUNT, stats[2].validCount);
+    TEST_ASSERT_EQUAL_FLOAT(sum10 / FRAME_COUNT, stats[2].mean);
+}
+
+/** 1.4
+ * @brief La variante con stride coincide con computeParticulateStats y las tramas empaquetadas
+ *        se leen sin alinear.
+ */
+void test_computeParticulateStatsStrided_matchesContiguous(void) {
+    static uint8_t packed[FRAME_COUNT * PACKED_FRAME_SIZE];
+    const PdaChannel unaligned = {1, PDA_CHANNEL_F32, MP_MIN_VALUE, MP_MAX_VALUE};
+    PdaStats stats, expected;
+    for (size_t i = 0; i < FRAME_COUNT; i++) {
+        channel[i] = frames[i].pm10;
+        packed[i * PACKED_FRAME_SIZE] = (uint8_t)i;
+        memcpy(&packed[i * PACKED_FRAME_SIZE + 1], &channel[i], sizeof(float));
+    }
+    computeParticulateStats(channel, FRAME_COUNT, &expected);
+
+    TEST_ASSERT_TRUE(computeParticulateStatsStrided(&frames[0].pm10, FRAME_COUNT,
+                                                    sizeof(SensorFrame), MP_MIN_VALUE,
+                                                    MP_MAX_VALUE, &stats));
+    assertStatsEqual(&expected, &stats);
+    TEST_ASSERT_TRUE(
+        computeFrameStats(packed, FRAME_COUNT, PACKED_FRAME_SIZE, &unaligned, 1, &stats));
+    assertStatsEqual(&expected, &stats);
+    TEST_ASSERT_FALSE(computeParticulateStatsStrided(channel, FRAME_COUNT, sizeof(float), 600.0,
+                                                     700.0, &stats));
+    TEST_ASSERT_EQUAL_FLOAT(MSN_VOID_ARRAY_VALUE, stats.mean);
+}
+
+/* === End of documentation ==================================================================== */
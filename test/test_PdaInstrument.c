@@ -0,0 +1,237 @@
+/*
+ * Nombre del archivo: test_PdaInstrument.c
+ * Descripción: Pruebas unitarias de los contadores de instrumentación.
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE FIUBA
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+
+/**
+ * @file  test_PdaInstrument.c
+ * @brief Pruebas unitarias del módulo PdaInstrument.
+ *
+ * Las pruebas verifican los conteos exactos si el proyecto se compila con PDA_INSTRUMENT, y que
+ * todos los contadores queden en cero si no.
+ *
+ * @test Pruebas unitarias implementadas:
+ *       1.1 Una llamada registra los datos recorridos y separa los descartes bajos, altos y NaN,
+ *           tanto antes del primer dato válido como dentro de la reducción vectorial.
+ *       1.2 Cada función pública, y su variante 64, se registra en su propio contador.
+ *       1.3 Los contadores de varios hilos se suman en la instantánea.
+ *       1.4 El JSON exportado contiene los contadores y respeta el tamaño del buffer; sin
+ *           PDA_INSTRUMENT el texto queda vacío.
+ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "unity.h"
+#include "ParticulateDataAnalyzer.h"
+#include "PdaInstrument.h"
+#include <math.h>
+#include <pthread.h>
+#include <string.h>
+
+/* === Macros definitions ====================================================================== */
+
+/// @brief Calcula el número de elementos en un arreglo estático.
+#define ARRAY_SIZE(arr) (sizeof(arr) / sizeof((arr)[0]))
+
+/// @brief Cantidad de datos de los conjuntos largos, con resto para el núcleo escalar.
+#define LONG_DATA_SIZE 1003
+
+/// @brief Cantidad de hilos y de llamadas por hilo de la prueba concurrente.
+#define THREAD_COUNT 4
+#define CALLS_PER_THREAD 1000
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/// @brief Conjunto largo compartido por las pruebas.
+static float longData[LONG_DATA_SIZE];
+
+/// @brief Instantánea tomada en setUp.
+static PdaInstrSnapshot before;
+
+/* === Private function implementation ========================================================= */
+
+/**
+ * @brief Retorna los contadores de una función acumulados desde setUp.
+ */
+static PdaInstrCounters countersSinceSetUp(PdaInstrFunction function) {
+    PdaInstrSnapshot after;
+    pdaInstrSnapshot(&after);
+    PdaInstrCounters delta = after.functions[function];
+    const PdaInstrCounters * base = &before.functions[function];
+    delta.calls -= base->calls;
+    delta.scanned -= base->scanned;
+    delta.rejectedLow -= base->rejectedLow;
+    delta.rejectedHigh -= base->rejectedHigh;
+    delta.nanoseconds -= base->nanoseconds;
+    return delta;
+}
+
+/**
+ * @brief Verifica los contadores de una función, o que sean cero sin PDA_INSTRUMENT.
+ */
+static void assertCounters(PdaInstrFunction function, uint64_t calls, uint64_t scanned,
+                           uint64_t rejectedLow, uint64_t rejectedHigh) {
+    PdaInstrCounters delta = countersSinceSetUp(function);
+    if (!pdaInstrEnabled()) {
+        calls = scanned = rejectedLow = rejectedHigh = 0;
+    }
+    TEST_ASSERT_EQUAL_UINT64(calls, delta.calls);
+    TEST_ASSERT_EQUAL_UINT64(scanned, delta.scanned);
+    TEST_ASSERT_EQUAL_UINT64(rejectedLow, delta.rejectedLow);
+    TEST_ASSERT_EQUAL_UINT64(rejectedHigh, delta.rejectedHigh);
+}
+
+/**
+ * @brief Llama a computeParticulateStats repetidas veces desde un hilo.
+ */
+static void * statsWorker(void * arg) {
+    (void)arg;
+    PdaStats stats;
+    for (int i = 0; i < CALLS_PER_THREAD; i++)
+        computeParticulateStats(longData, LONG_DATA_SIZE, &stats);
+    return NULL;
+}
+
+/* === Public function implementation ========================================================== */
+
+void setUp(void) {
+    // cada décimo dato es bajo, alto o NaN, por turnos: 34 bajos, 34 altos y 33 NaN
+    for (int i = 0; i < LONG_DATA_SIZE; i++) {
+        longData[i] = 10.0f + (float)(i % 50);
+        if (i % 10 == 0) {
+            const float invalid[] = {0.05f, 500.0f, NAN};
+            longData[i] = invalid[(i / 10) % 3];
+        }
+    }
+    pdaInstrSnapshot(&before);
+}
+
+/** 1.1
+ * @brief Una llamada registra los datos recorridos y separa los descartes bajos, altos y NaN,
+ *        tanto antes del primer dato válido como dentro de la reducción vectorial.
+ */
+void test_pdaInstrRecord_splitsRejections(void) {
+    float leading[] = {0.0f, 600.0f, -3.0f, 12.0f, 500.0f, 0.05f, 25.0f};
+    TEST_ASSERT_EQUAL_FLOAT(18.5f, calculateAverage(leading, ARRAY_SIZE(leading)));
+    assertCounters(PDA_INSTR_CALCULATE_AVERAGE, 1, ARRAY_SIZE(leading), 3, 2);
+
+    calculateAverage(longData, LONG_DATA_SIZE);
+    assertCounters(PDA_INSTR_CALCULATE_AVERAGE, 2, ARRAY_SIZE(leading) + LONG_DATA_SIZE,
+                   3 + 34 + 33, 2 + 34);
+
+    // un conjunto sin datos válidos se registra completo antes de la reducción
+    float invalid[] = {NAN, 700.0f, 0.0f};
+    calculateAverage(invalid, ARRAY_SIZE(invalid));
+    assertCounters(PDA_INSTR_CALCULATE_AVERAGE, 3, ARRAY_SIZE(leading) + LONG_DATA_SIZE + 3,
+                   3 + 34 + 33 + 2, 2 + 34 + 1);
+}
+
+/** 1.2
+ * @brief Cada función pública, y su variante 64, se registra en su propio contador.
+ */
+void test_pdaInstrRecord_attributesEachFunction(void) {
+    PdaStats stats;
+    findMaxValue(longData, 10);
+    findMaxValue64(longData, 20);
+    findMinValue(longData, 10);
+    calculateStandardDeviation64(longData, 30);
+    computeParticulateStats(longData, 40, &stats);
+    computeParticulateStats(NULL, 40, &stats);
+
+    assertCounters(PDA_INSTR_FIND_MAX_VALUE, 2, 30, 2, 1);
+    assertCounters(PDA_INSTR_FIND_MIN_VALUE, 1, 10, 1, 0);
+    assertCounters(PDA_INSTR_CALCULATE_STANDARD_DEVIATION, 1, 30, 2, 1);
+    assertCounters(PDA_INSTR_COMPUTE_PARTICULATE_STATS, 2, 40, 3, 1);
+    assertCounters(PDA_INSTR_CALCULATE_AVERAGE, 0, 0, 0, 0);
+    const char * name = pdaInstrEnabled() ? "findMinValue" : "unknown";
+    TEST_ASSERT_EQUAL_STRING(name, pdaInstrFunctionName(PDA_INSTR_FIND_MIN_VALUE));
+    TEST_ASSERT_EQUAL_STRING("unknown", pdaInstrFunctionName(PDA_INSTR_FUNCTION_COUNT));
+}
+
+/** 1.3
+ * @brief Los contadores de varios hilos se suman en la instantánea.
+ */
+void test_pdaInstrSnapshot_sumsThreads(void) {
+    pthread_t threads[THREAD_COUNT];
+    for (int t = 0; t < THREAD_COUNT; t++)
+        TEST_ASSERT_EQUAL(0, pthread_create(&threads[t], NULL, statsWorker, NULL));
+    for (int t = 0; t < THREAD_COUNT; t++)
+        pthread_join(threads[t], NULL);
+
+    uint64_t calls = THREAD_COUNT * CALLS_PER_THREAD;
+    assertCounters(PDA_INSTR_COMPUTE_PARTICULATE_STATS, calls, calls * LONG_DATA_SIZE,
+                   calls * (34 + 33), calls * 34);
+
+    PdaInstrSnapshot after;
+    pdaInstrSnapshot(&after);
+    PdaInstrCounters delta = countersSinceSetUp(PDA_INSTR_COMPUTE_PARTICULATE_STATS);
+    if (pdaInstrEnabled()) {
+        TEST_ASSERT_GREATER_OR_EQUAL(before.threads + THREAD_COUNT, after.threads);
+        TEST_ASSERT_TRUE(delta.nanoseconds > 0);
+    } else {
+        TEST_ASSERT_EQUAL(0, after.threads);
+        TEST_ASSERT_EQUAL_UINT64(0, delta.nanoseconds);
+    }
+}
+
+/** 1.4
+ * @brief El JSON exportado contiene los contadores y respeta el tamaño del buffer; sin
+ *        PDA_INSTRUMENT el texto queda vacío.
+ */
+void test_pdaInstrExportJson_writesCounters(void) {
+    PdaInstrSnapshot snapshot;
+    memset(&snapshot, 0, sizeof(snapshot));
+    snapshot.threads = 3;
+    snapshot.functions[PDA_INSTR_FIND_MAX_VALUE].calls = 7;
+    snapshot.functions[PDA_INSTR_FIND_MAX_VALUE].rejectedHigh = 12345678901ull;
+
+    char buffer[1024];
+    size_t length = pdaInstrExportJson(&snapshot, buffer, sizeof(buffer));
+    if (!pdaInstrEnabled()) {
+        TEST_ASSERT_EQUAL(0, length);
+        TEST_ASSERT_EQUAL_STRING("", buffer);
+        return;
+    }
+    TEST_ASSERT_EQUAL(strlen(buffer), length);
+    TEST_ASSERT_NOT_NULL(strstr(buffer, "\"threads\": 3"));
+    TEST_ASSERT_NOT_NULL(strstr(buffer, "\"findMaxValue\": {\"calls\": 7, \"scanned\": 0, "
+                                        "\"rejectedLow\": 0, \"rejectedHigh\": 12345678901"));
+    TEST_ASSERT_NOT_NULL(strstr(buffer, "\"computeParticulateStats\": {"));
+    TEST_ASSERT_EQUAL('}', buffer[length - 1]);
+
+    char small[40];
+    memset(small, 'x', sizeof(small));
+    TEST_ASSERT_EQUAL(length, pdaInstrExportJson(&snapshot, small, sizeof(small)));
+    TEST_ASSERT_EQUAL(sizeof(small) - 1, strlen(small));
+    TEST_ASSERT_EQUAL(0, strncmp(buffer, small, sizeof(small) - 1));
+    TEST_ASSERT_EQUAL(length, pdaInstrExportJson(&snapshot, NULL, 0));
+}
+
+/* === End of documentation ==================================================================== */
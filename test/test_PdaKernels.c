@@ -0,0 +1,304 @@
+/*
+ * Nombre del archivo: test_PdaKernels.c
+ * Descripción: Pruebas de equivalencia entre los núcleos de reducción vectorizados y el núcleo
+ * escalar de referencia.
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE FIUBA
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+
+/**
+ * @file  test_PdaKernels.c
+ * @brief Pruebas unitarias del módulo PdaKernels.
+ *
+ * @test Pruebas unitarias implementadas:
+ *       1.1 El núcleo activo está soportado y puede forzarse el núcleo escalar.
+ *       1.2 Un identificador de núcleo inválido es rechazado.
+ *       2.1 Cada núcleo soportado coincide con el escalar en datos aleatorios de varios largos.
+ *       2.2 Cada núcleo soportado coincide con el escalar en datos adversos (NaN, infinitos,
+ *           bordes del rango, denormales).
+ *       2.3 Cada núcleo soportado coincide con el escalar con punteros no alineados.
+ *       3.1 En un conjunto de millones de datos, cada núcleo respeta la cota de error documentada
+ *           frente a una suma compensada en long double.
+ *       4.1 Cada núcleo entero soportado da exactamente el resultado escalar sobre datos
+ *           cuantizados, incluidos códigos inválidos y mayores que INT16_MAX.
+ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "unity.h"
+#include "ParticulateDataAnalyzer.h"
+#include "PdaKernels.h"
+#include "PdaQuantized.h"
+#include <math.h>
+#include <float.h>
+
+/* === Macros definitions ====================================================================== */
+
+/// @brief Cantidad de datos de los conjuntos aleatorios largos.
+#define RANDOM_DATA_SIZE 10007
+
+/// @brief Largo máximo de los conjuntos cortos, para recorrer todos los restos de bloque.
+#define SHORT_DATA_SIZE 67
+
+/// @brief Semilla del generador pseudoaleatorio de las pruebas.
+#define RANDOM_SEED 12345u
+
+/// @brief Valor de referencia usado para las sumas desplazadas.
+#define TEST_SHIFT 37.5
+
+/// @brief Cantidad de datos del conjunto grande: más de 2^24, donde una suma float se estanca.
+#define ARCHIVE_DATA_SIZE ((1u << 24) + 4099u)
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/// @brief Estado del generador pseudoaleatorio.
+static uint32_t randomState;
+
+/// @brief Buffer de datos compartido por las pruebas.
+static float buffer[RANDOM_DATA_SIZE + 1];
+
+/// @brief Buffer de datos cuantizados.
+static uint16_t codes[RANDOM_DATA_SIZE + 1];
+
+/// @brief Buffer del conjunto grande.
+static float archive[ARCHIVE_DATA_SIZE];
+
+/* === Private function implementation ========================================================= */
+
+/**
+ * @brief Generador congruencial lineal, para que las pruebas sean reproducibles.
+ */
+static uint32_t nextRandom(void) {
+    randomState = randomState * 1664525u + 1013904223u;
+    return randomState >> 8;
+}
+
+/**
+ * @brief Genera un dato en [-50, 550), de modo que una parte cae fuera del rango válido.
+ */
+static float randomSample(void) {
+    return (float)nextRandom() / (float)(1u << 24) * 600.0f - 50.0f;
+}
+
+/**
+ * @brief Verifica que dos sumas en doble precisión estén dentro de PDA_KERNEL_TOLERANCE.
+ */
+static void assertSumWithin(double expected, double actual) {
+    double scale = fabs(expected) > 1.0 ? fabs(expected) : 1.0;
+    TEST_ASSERT_TRUE(fabs(expected - actual) <= PDA_KERNEL_TOLERANCE * scale);
+}
+
+/**
+ * @brief Compara cada núcleo soportado con el escalar sobre un mismo conjunto de datos.
+ */
+static void assertKernelsMatchScalar(const float * data, size_t n_data) {
+    PdaReduction reference, result;
+    TEST_ASSERT_TRUE(pdaReduceWith(PDA_KERNEL_SCALAR, data, n_data, TEST_SHIFT, &reference));
+    for (int kernel = PDA_KERNEL_SSE2; kernel < PDA_KERNEL_COUNT; kernel++) {
+        if (!pdaReduceWith((PdaKernelId)kernel, data, n_data, TEST_SHIFT, &result))
+            continue;
+        TEST_ASSERT_EQUAL(reference.validCount, result.validCount);
+        assertSumWithin(reference.sum, result.sum);
+        assertSumWithin(reference.sumOfSquares, result.sumOfSquares);
+        if (reference.validCount > 0) {
+            TEST_ASSERT_TRUE(reference.min == result.min);
+            TEST_ASSERT_TRUE(reference.max == result.max);
+        }
+    }
+}
+
+/**
+ * @brief Compara cada núcleo entero soportado con el escalar sobre un mismo conjunto de códigos.
+ */
+static void assertQ16KernelsMatchScalar(const uint16_t * data, size_t n_data) {
+    PdaReductionQ16 reference, result;
+    TEST_ASSERT_TRUE(pdaReduceQ16With(PDA_KERNEL_SCALAR, data, n_data, &reference));
+    for (int kernel = PDA_KERNEL_SSE2; kernel < PDA_KERNEL_COUNT; kernel++) {
+        if (!pdaReduceQ16With((PdaKernelId)kernel, data, n_data, &result))
+            continue;
+        TEST_ASSERT_EQUAL(reference.validCount, result.validCount);
+        TEST_ASSERT_TRUE(reference.sum == result.sum);
+        TEST_ASSERT_TRUE(reference.sumOfSquares == result.sumOfSquares);
+        if (reference.validCount > 0) {
+            TEST_ASSERT_EQUAL(reference.min, result.min);
+            TEST_ASSERT_EQUAL(reference.max, result.max);
+        }
+    }
+}
+
+/**
+ * @brief Suma compensada (Kahan) en long double de los valores válidos desplazados.
+ */
+static void referenceSums(const float * data, size_t n_data, double shift, long double * sum,
+                          long double * sumOfSquares, long double * sumOfAbs) {
+    long double s = 0.0L, sc = 0.0L, q = 0.0L, qc = 0.0L, a = 0.0L;
+    for (size_t i = 0; i < n_data; i++) {
+        if (!maskIsDataTrue(data[i]))
+            continue;
+        long double delta = (long double)data[i] - shift;
+        long double y = delta - sc, t = s + y;
+        sc = (t - s) - y;
+        s = t;
+        y = delta * delta - qc;
+        t = q + y;
+        qc = (t - q) - y;
+        q = t;
+        a += fabsl(delta);
+    }
+    *sum = s;
+    *sumOfSquares = q;
+    *sumOfAbs = a;
+}
+
+/* === Public function implementation ========================================================== */
+
+void setUp(void) {
+    randomState = RANDOM_SEED;
+}
+
+/** 1.1
+ * @brief El núcleo activo está soportado y puede forzarse el núcleo escalar.
+ */
+void test_activeKernel_isSupported(void) {
+    PdaKernelId best = pdaActiveKernel();
+    TEST_ASSERT_TRUE(pdaKernelSupported(best));
+    TEST_ASSERT_TRUE(pdaSelectKernel(PDA_KERNEL_SCALAR));
+    TEST_ASSERT_EQUAL(PDA_KERNEL_SCALAR, pdaActiveKernel());
+    TEST_ASSERT_EQUAL_STRING("scalar", pdaKernelName(PDA_KERNEL_SCALAR));
+    TEST_ASSERT_TRUE(pdaSelectKernel(best));
+}
+
+/** 1.2
+ * @brief Un identificador de núcleo inválido es rechazado.
+ */
+void test_invalidKernel_isRejected(void) {
+    PdaReduction result;
+    TEST_ASSERT_FALSE(pdaKernelSupported(PDA_KERNEL_COUNT));
+    TEST_ASSERT_FALSE(pdaSelectKernel(PDA_KERNEL_COUNT));
+    TEST_ASSERT_FALSE(pdaReduceWith(PDA_KERNEL_COUNT, buffer, 1, TEST_SHIFT, &result));
+    TEST_ASSERT_EQUAL_STRING("unknown", pdaKernelName(PDA_KERNEL_COUNT));
+}
+
+/** 2.1
+ * @brief Cada núcleo soportado coincide con el escalar en datos aleatorios de varios largos.
+ */
+void test_kernels_matchScalar_onRandomData(void) {
+    for (size_t i = 0; i < RANDOM_DATA_SIZE; i++)
+        buffer[i] = randomSample();
+    for (size_t n = 0; n <= SHORT_DATA_SIZE; n++)
+        assertKernelsMatchScalar(buffer, n);
+    assertKernelsMatchScalar(buffer, RANDOM_DATA_SIZE);
+}
+
+/** 2.2
+ * @brief Cada núcleo soportado coincide con el escalar en datos adversos.
+ */
+void test_kernels_matchScalar_onAdversarialData(void) {
+    const float special[] = {NAN,
+                             INFINITY,
+                             -INFINITY,
+                             0.0f,
+                             -0.0f,
+                             FLT_MIN,
+                             FLT_TRUE_MIN,
+                             FLT_MAX,
+                             -FLT_MAX,
+                             (float)MP_MIN_VALUE,
+                             nextafterf((float)MP_MIN_VALUE, 0.0f),
+                             nextafterf((float)MP_MIN_VALUE, 1.0f),
+                             (float)MP_MAX_VALUE,
+                             nextafterf((float)MP_MAX_VALUE, 0.0f),
+                             nextafterf((float)MP_MAX_VALUE, 1000.0f),
+                             250.0f};
+    const size_t nSpecial = sizeof(special) / sizeof(special[0]);
+    for (size_t i = 0; i < RANDOM_DATA_SIZE; i++)
+        buffer[i] = special[nextRandom() % nSpecial];
+    for (size_t n = 0; n <= SHORT_DATA_SIZE; n++)
+        assertKernelsMatchScalar(buffer, n);
+    assertKernelsMatchScalar(buffer, RANDOM_DATA_SIZE);
+
+    // un conjunto sin datos válidos debe informar cero datos en todos los núcleos
+    for (size_t i = 0; i < SHORT_DATA_SIZE; i++)
+        buffer[i] = (i % 2) ? NAN : 0.0f;
+    assertKernelsMatchScalar(buffer, SHORT_DATA_SIZE);
+}
+
+/** 2.3
+ * @brief Cada núcleo soportado coincide con el escalar con punteros no alineados.
+ */
+void test_kernels_matchScalar_onUnalignedData(void) {
+    for (size_t i = 0; i < RANDOM_DATA_SIZE + 1; i++)
+        buffer[i] = randomSample();
+    assertKernelsMatchScalar(buffer + 1, RANDOM_DATA_SIZE);
+}
+
+/** 3.1
+ * @brief En un conjunto de millones de datos, cada núcleo respeta la cota de error documentada
+ *        frente a una suma compensada en long double.
+ */
+void test_kernels_errorBound_onArchiveData(void) {
+    long double sum, sumOfSquares, sumOfAbs;
+    PdaReduction result;
+    for (size_t i = 0; i < ARCHIVE_DATA_SIZE; i++)
+        archive[i] = randomSample();
+    referenceSums(archive, ARCHIVE_DATA_SIZE, TEST_SHIFT, &sum, &sumOfSquares, &sumOfAbs);
+
+    double levels = ceil(log2((double)ARCHIVE_DATA_SIZE / PDA_REDUCE_BLOCK));
+    double bound = (PDA_REDUCE_BLOCK + levels + 8) * ldexp(1.0, -53);
+    for (int kernel = PDA_KERNEL_SCALAR; kernel < PDA_KERNEL_COUNT; kernel++) {
+        if (!pdaReduceWith((PdaKernelId)kernel, archive, ARCHIVE_DATA_SIZE, TEST_SHIFT, &result))
+            continue;
+        TEST_ASSERT_TRUE(fabsl(result.sum - sum) <= bound * sumOfAbs);
+        TEST_ASSERT_TRUE(fabsl(result.sumOfSquares - sumOfSquares) <= bound * sumOfSquares);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, TEST_SHIFT + (double)(sum / result.validCount),
+                             calculateAverage64(archive, ARCHIVE_DATA_SIZE));
+}
+
+/** 4.1
+ * @brief Cada núcleo entero soportado da exactamente el resultado escalar sobre datos
+ *        cuantizados, incluidos códigos inválidos y mayores que INT16_MAX.
+ */
+void test_q16Kernels_matchScalar(void) {
+    const uint16_t special[] = {PDA_Q16_NO_DATA, PDA_Q16_MIN, PDA_Q16_MAX, PDA_Q16_MAX + 1,
+                                INT16_MAX,       0x8000,      UINT16_MAX,  2500};
+    for (size_t i = 0; i < RANDOM_DATA_SIZE + 1; i++)
+        codes[i] = (nextRandom() % 4 == 0) ? special[nextRandom() % 8]
+                                           : (uint16_t)(nextRandom() % (PDA_Q16_MAX + 1));
+    for (size_t n = 0; n <= SHORT_DATA_SIZE; n++)
+        assertQ16KernelsMatchScalar(codes, n);
+    assertQ16KernelsMatchScalar(codes, RANDOM_DATA_SIZE);
+    assertQ16KernelsMatchScalar(codes + 1, RANDOM_DATA_SIZE);
+
+    // todos los códigos en el máximo, para ejercitar el límite de las sumas de 32 bits
+    for (size_t i = 0; i < RANDOM_DATA_SIZE; i++)
+        codes[i] = PDA_Q16_MAX;
+    assertQ16KernelsMatchScalar(codes, RANDOM_DATA_SIZE);
+}
+
+/* === End of documentation ==================================================================== */
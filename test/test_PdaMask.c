@@ -0,0 +1,211 @@
+/*
+ * Nombre del archivo: test_PdaMask.c
+ * Descripción: Pruebas de la máscara de validez empaquetada y de las estadísticas enmascaradas.
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE FIUBA
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+
+/**
+ * @file  test_PdaMask.c
+ * @brief Pruebas unitarias del módulo PdaMask.
+ *
+ * @test Pruebas unitarias implementadas:
+ *       1.1 La máscara marca los datos válidos, apaga los bits finales y cuenta los válidos.
+ *       1.2 Cada núcleo soportado calcula la misma máscara que el escalar, incluso con NaN,
+ *           infinitos y los bordes del rango.
+ *       2.1 Las estadísticas enmascaradas coinciden con computeParticulateStats en datos con
+ *           largos tramos de ceros y de datos válidos.
+ *       2.2 Apagar bits de la máscara excluye esos datos de las estadísticas.
+ *       2.3 Conjuntos vacíos o sin datos marcados retornan los valores de error.
+ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "unity.h"
+#include "ParticulateDataAnalyzer.h"
+#include "PdaKernels.h"
+#include "PdaMask.h"
+#include <math.h>
+
+/* === Macros definitions ====================================================================== */
+
+/// @brief Calcula el número de elementos en un arreglo estático.
+#define ARRAY_SIZE(arr) (sizeof(arr) / sizeof((arr)[0]))
+
+/// @brief Conjunto de datos de MP con valores fuera de rango.
+#define SET_OUTLIER_DATA_MP                                                                        \
+    { 2.0, 1000.0, 600.0, 6.0, 0.0, 8.0, 10.0 }
+
+/// @brief Cantidad de datos de los conjuntos largos; no es múltiplo de 64.
+#define LONG_DATA_SIZE 10007
+
+/// @brief Largo de cada tramo de ceros (calentamiento o corte del sensor).
+#define ZERO_RUN 700
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/// @brief Datos de los conjuntos largos.
+static float buffer[LONG_DATA_SIZE];
+
+/// @brief Datos marcados, compactados, usados como referencia.
+static float compacted[LONG_DATA_SIZE];
+
+/// @brief Máscara bajo prueba.
+static uint64_t mask[PDA_MASK_WORDS(LONG_DATA_SIZE)];
+
+/// @brief Máscara de referencia.
+static uint64_t reference[PDA_MASK_WORDS(LONG_DATA_SIZE)];
+
+/* === Private function implementation ========================================================= */
+
+/**
+ * @brief Genera tramos que alternan ceros, datos válidos y datos en [-50, 550) mezclados, para
+ *        recorrer palabras nulas, completas y mixtas.
+ */
+static void fillDataWithZeroRuns(void) {
+    uint32_t state = 3u;
+    for (size_t i = 0; i < LONG_DATA_SIZE; i++) {
+        state = state * 1664525u + 1013904223u;
+        float u = (float)(state >> 8) / (float)(1u << 24);
+        size_t run = (i / ZERO_RUN) % 3;
+        buffer[i] = (run == 0) ? 0.0f : (run == 1) ? 1.0f + u * 450.0f : u * 600.0f - 50.0f;
+    }
+}
+
+/**
+ * @brief Verifica que dos resúmenes estadísticos coincidan.
+ */
+static void assertStatsEqual(const PdaStats * expected, const PdaStats * actual) {
+    TEST_ASSERT_EQUAL(expected->validCount, actual->validCount);
+    TEST_ASSERT_EQUAL(expected->rejectedCount, actual->rejectedCount);
+    TEST_ASSERT_EQUAL_FLOAT(expected->mean, actual->mean);
+    TEST_ASSERT_EQUAL_FLOAT(expected->min, actual->min);
+    TEST_ASSERT_EQUAL_FLOAT(expected->max, actual->max);
+    TEST_ASSERT_EQUAL_FLOAT(expected->stdDev, actual->stdDev);
+}
+
+/* === Public function implementation ========================================================== */
+
+/** 1.1
+ * @brief La máscara marca los datos válidos, apaga los bits finales y cuenta los válidos.
+ */
+void test_pdaMask_buildMarksValidData(void) {
+    const float data[] = SET_OUTLIER_DATA_MP;
+    uint64_t bits[1] = {UINT64_MAX};
+    TEST_ASSERT_EQUAL(4, pdaMaskBuild(data, ARRAY_SIZE(data), bits));
+    TEST_ASSERT_TRUE(bits[0] == 0x69u); // datos 0, 3, 5 y 6
+    TEST_ASSERT_EQUAL(4, pdaMaskCount(bits, ARRAY_SIZE(data)));
+    TEST_ASSERT_EQUAL(2, pdaMaskCount(bits, 4));
+}
+
+/** 1.2
+ * @brief Cada núcleo soportado calcula la misma máscara que el escalar.
+ */
+void test_pdaMask_kernelsMatchScalar(void) {
+    const float edges[] = {0.1f,  nextafterf(0.1f, 0.0f), 500.0f,   nextafterf(500.0f, 0.0f),
+                           NAN,   INFINITY,               -INFINITY, 1e-45f,
+                           -0.0f, 250.0f};
+    fillDataWithZeroRuns();
+    for (size_t i = 0; i < LONG_DATA_SIZE; i += 7)
+        buffer[i] = edges[(i / 7) % ARRAY_SIZE(edges)];
+
+    size_t expected, actual;
+    TEST_ASSERT_TRUE(pdaMaskBuildWith(PDA_KERNEL_SCALAR, buffer, LONG_DATA_SIZE, reference,
+                                      &expected));
+    for (int kernel = PDA_KERNEL_SSE2; kernel < PDA_KERNEL_COUNT; kernel++) {
+        if (!pdaMaskBuildWith((PdaKernelId)kernel, buffer, LONG_DATA_SIZE, mask, &actual))
+            continue;
+        TEST_ASSERT_EQUAL(expected, actual);
+        TEST_ASSERT_EQUAL_MEMORY(reference, mask, sizeof(mask));
+    }
+    TEST_ASSERT_FALSE(pdaMaskBuildWith(PDA_KERNEL_COUNT, buffer, LONG_DATA_SIZE, mask, NULL));
+}
+
+/** 2.1
+ * @brief Las estadísticas enmascaradas coinciden con computeParticulateStats.
+ */
+void test_pdaMask_statsMatchUnmasked(void) {
+    PdaStats expected, actual;
+    fillDataWithZeroRuns();
+    pdaMaskBuild(buffer, LONG_DATA_SIZE, mask);
+    TEST_ASSERT_TRUE(computeParticulateStats(buffer, LONG_DATA_SIZE, &expected));
+    TEST_ASSERT_TRUE(computeParticulateStatsMasked(buffer, mask, LONG_DATA_SIZE, &actual));
+    assertStatsEqual(&expected, &actual);
+
+    TEST_ASSERT_EQUAL_FLOAT(expected.mean, calculateAverageMasked(buffer, mask, LONG_DATA_SIZE));
+    TEST_ASSERT_EQUAL_FLOAT(expected.max, findMaxValueMasked(buffer, mask, LONG_DATA_SIZE));
+    TEST_ASSERT_EQUAL_FLOAT(expected.min, findMinValueMasked(buffer, mask, LONG_DATA_SIZE));
+    TEST_ASSERT_EQUAL_FLOAT(expected.stdDev,
+                            calculateStandardDeviationMasked(buffer, mask, LONG_DATA_SIZE));
+}
+
+/** 2.2
+ * @brief Apagar bits de la máscara excluye esos datos de las estadísticas.
+ */
+void test_pdaMask_clearedBitsAreExcluded(void) {
+    PdaStats expected, actual;
+    fillDataWithZeroRuns();
+    pdaMaskBuild(buffer, LONG_DATA_SIZE, mask);
+    for (size_t w = 0; w < ARRAY_SIZE(mask); w += 5)
+        mask[w] &= UINT64_C(0x00FF00FF00FF00FF);
+
+    size_t m = 0;
+    for (size_t i = 0; i < LONG_DATA_SIZE; i++) {
+        if ((mask[i / PDA_MASK_WORD_BITS] >> (i % PDA_MASK_WORD_BITS)) & 1u)
+            compacted[m++] = buffer[i];
+    }
+    TEST_ASSERT_EQUAL(m, pdaMaskCount(mask, LONG_DATA_SIZE));
+    computeParticulateStats(compacted, m, &expected);
+    TEST_ASSERT_TRUE(computeParticulateStatsMasked(buffer, mask, LONG_DATA_SIZE, &actual));
+    TEST_ASSERT_EQUAL(expected.validCount, actual.validCount);
+    TEST_ASSERT_EQUAL(LONG_DATA_SIZE - m, actual.rejectedCount);
+    TEST_ASSERT_EQUAL_FLOAT(expected.mean, actual.mean);
+    TEST_ASSERT_EQUAL_FLOAT(expected.min, actual.min);
+    TEST_ASSERT_EQUAL_FLOAT(expected.max, actual.max);
+    TEST_ASSERT_EQUAL_FLOAT(expected.stdDev, actual.stdDev);
+}
+
+/** 2.3
+ * @brief Conjuntos vacíos o sin datos marcados retornan los valores de error.
+ */
+void test_pdaMask_errorValues(void) {
+    float data[] = SET_OUTLIER_DATA_MP;
+    uint64_t none[1] = {0};
+    uint64_t one[1] = {1};
+    TEST_ASSERT_EQUAL_FLOAT(MSN_VOID_ARRAY_VALUE, calculateAverageMasked(NULL, none, 0));
+    TEST_ASSERT_EQUAL_FLOAT(MSN_VOID_ARRAY_VALUE,
+                            calculateStandardDeviationMasked(NULL, none, 0));
+    TEST_ASSERT_EQUAL_FLOAT(MSN_VOID_ARRAY_VALUE,
+                            findMaxValueMasked(data, none, ARRAY_SIZE(data)));
+    TEST_ASSERT_EQUAL_FLOAT(MSN_DS_NOTDEFINI, calculateStandardDeviationMasked(data, one, 1));
+    TEST_ASSERT_EQUAL_FLOAT(MSN_NOT_DATA,
+                            calculateStandardDeviationMasked(data, one, ARRAY_SIZE(data)));
+    TEST_ASSERT_EQUAL_FLOAT(2.0, calculateAverageMasked(data, one, ARRAY_SIZE(data)));
+}
+
+/* === End of documentation ==================================================================== */
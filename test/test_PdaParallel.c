@@ -0,0 +1,153 @@
+/*
+ * Nombre del archivo: test_PdaParallel.c
+ * Descripción: Pruebas de la reducción multihilo de datos de MP.
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE FIUBA
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+
+/**
+ * @file  test_PdaParallel.c
+ * @brief Pruebas unitarias del módulo PdaParallel.
+ *
+ * @test Pruebas unitarias implementadas:
+ *       1.1 Un array vacío no tiene datos válidos.
+ *       1.2 El modo normal coincide con computeParticulateStats para varias cantidades de hilos.
+ *       1.3 El modo determinista es idéntico bit a bit para cualquier cantidad de hilos.
+ *       1.4 El modo determinista es idéntico bit a bit para cualquier cantidad de hilos y de
+ *           bloques, con y sin un bloque parcial.
+ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "unity.h"
+#include "ParticulateDataAnalyzer.h"
+#include "PdaKernels.h"
+#include "PdaAccumulator.h"
+#include "PdaPartial.h"
+#include "PdaParallel.h"
+
+/* === Macros definitions ====================================================================== */
+
+/// @brief Cantidad de datos: varios bloques completos y uno parcial.
+#define LARGE_DATA_SIZE (5 * PDA_PARALLEL_CHUNK_SIZE + 123)
+
+/// @brief Cantidad máxima de hilos probada.
+#define MAX_TEST_THREADS 8
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/// @brief Datos de prueba.
+static float buffer[LARGE_DATA_SIZE];
+
+/* === Private function implementation ========================================================= */
+
+/**
+ * @brief Llena el buffer con datos reproducibles, con una parte fuera de rango.
+ */
+static void fillBuffer(void) {
+    uint32_t state = 31u;
+    for (size_t i = 0; i < LARGE_DATA_SIZE; i++) {
+        state = state * 1664525u + 1013904223u;
+        buffer[i] = (float)(state >> 8) / (float)(1u << 24) * 560.0f - 30.0f;
+    }
+}
+
+/* === Public function implementation ========================================================== */
+
+void setUp(void) {
+    fillBuffer();
+}
+
+/** 1.1
+ * @brief Un array vacío no tiene datos válidos.
+ */
+void test_computeParticulateStatsParallel_emptySet(void) {
+    PdaStats stats;
+    TEST_ASSERT_FALSE(computeParticulateStatsParallel(buffer, 0, NULL, &stats));
+    TEST_ASSERT_EQUAL_FLOAT(MSN_VOID_ARRAY_VALUE, stats.mean);
+}
+
+/** 1.2
+ * @brief El modo normal coincide con computeParticulateStats para varias cantidades de hilos.
+ */
+void test_computeParticulateStatsParallel_matchesSerial(void) {
+    PdaStats expected, actual;
+    computeParticulateStats(buffer, LARGE_DATA_SIZE, &expected);
+    for (unsigned threads = 0; threads <= MAX_TEST_THREADS; threads++) {
+        PdaParallelConfig config = {threads, false};
+        TEST_ASSERT_TRUE(
+            computeParticulateStatsParallel(buffer, LARGE_DATA_SIZE, &config, &actual));
+        TEST_ASSERT_EQUAL(expected.validCount, actual.validCount);
+        TEST_ASSERT_EQUAL(expected.rejectedCount, actual.rejectedCount);
+        TEST_ASSERT_EQUAL_FLOAT(expected.mean, actual.mean);
+        TEST_ASSERT_EQUAL_FLOAT(expected.min, actual.min);
+        TEST_ASSERT_EQUAL_FLOAT(expected.max, actual.max);
+        TEST_ASSERT_EQUAL_FLOAT(expected.stdDev, actual.stdDev);
+    }
+}
+
+/** 1.3
+ * @brief El modo determinista es idéntico bit a bit para cualquier cantidad de hilos.
+ */
+void test_pdaParallelReduce_deterministicIsBitIdentical(void) {
+    PdaPartial reference, partial;
+    PdaParallelConfig config = {1, true};
+    TEST_ASSERT_TRUE(pdaParallelReduce(buffer, LARGE_DATA_SIZE, &config, &reference));
+    for (unsigned threads = 2; threads <= MAX_TEST_THREADS; threads++) {
+        config.threadCount = threads;
+        TEST_ASSERT_TRUE(pdaParallelReduce(buffer, LARGE_DATA_SIZE, &config, &partial));
+        TEST_ASSERT_EQUAL(reference.validCount, partial.validCount);
+        TEST_ASSERT_EQUAL(reference.rejectedCount, partial.rejectedCount);
+        TEST_ASSERT_EQUAL_MEMORY(&reference.mean, &partial.mean, sizeof(double));
+        TEST_ASSERT_EQUAL_MEMORY(&reference.m2, &partial.m2, sizeof(double));
+        TEST_ASSERT_EQUAL_MEMORY(&reference.min, &partial.min, sizeof(float));
+        TEST_ASSERT_EQUAL_MEMORY(&reference.max, &partial.max, sizeof(float));
+    }
+}
+
+/** 1.4
+ * @brief El modo determinista es idéntico bit a bit para cualquier cantidad de hilos y de bloques,
+ * con y sin un bloque parcial.
+ */
+void test_pdaParallelReduce_deterministicAnyChunkCount(void) {
+    PdaPartial reference, partial;
+    for (size_t n_data = PDA_PARALLEL_CHUNK_SIZE / 2; n_data <= LARGE_DATA_SIZE;
+         n_data += PDA_PARALLEL_CHUNK_SIZE / 2) {
+        PdaParallelConfig config = {1, true};
+        TEST_ASSERT_TRUE(pdaParallelReduce(buffer, n_data, &config, &reference));
+        for (unsigned threads = 2; threads <= MAX_TEST_THREADS; threads++) {
+            config.threadCount = threads;
+            TEST_ASSERT_TRUE(pdaParallelReduce(buffer, n_data, &config, &partial));
+            TEST_ASSERT_EQUAL(reference.validCount, partial.validCount);
+            TEST_ASSERT_EQUAL_MEMORY(&reference.mean, &partial.mean, sizeof(double));
+            TEST_ASSERT_EQUAL_MEMORY(&reference.m2, &partial.m2, sizeof(double));
+        }
+    }
+}
+
+/* === End of documentation ==================================================================== */
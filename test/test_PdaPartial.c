@@ -0,0 +1,167 @@
+/*
+ * Nombre del archivo: test_PdaPartial.c
+ * Descripción: Pruebas de los agregados parciales combinables y su formato binario.
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE FIUBA
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+
+/**
+ * @file  test_PdaPartial.c
+ * @brief Pruebas unitarias del módulo PdaPartial.
+ *
+ * @test Pruebas unitarias implementadas:
+ *       1.1 Combinar los parciales de cada fragmento equivale a reducir los datos concatenados.
+ *       1.2 Combinar con un parcial vacío no modifica el resultado.
+ *       2.1 Un parcial serializado y reconstruido es idéntico al original.
+ *       2.2 El bloque binario comienza con el identificador y la versión del formato.
+ *       2.3 Un bloque con identificador incorrecto o M2 negativo es rechazado.
+ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "unity.h"
+#include "ParticulateDataAnalyzer.h"
+#include "PdaKernels.h"
+#include "PdaAccumulator.h"
+#include "PdaPartial.h"
+
+/* === Macros definitions ====================================================================== */
+
+/// @brief Cantidad de fragmentos (por ejemplo días) de la prueba de combinación.
+#define SHARD_COUNT 7
+
+/// @brief Cantidad de datos por fragmento.
+#define SHARD_SIZE 1440
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/// @brief Datos de todos los fragmentos, concatenados.
+static float buffer[SHARD_COUNT * SHARD_SIZE];
+
+/* === Private function implementation ========================================================= */
+
+/**
+ * @brief Llena el buffer con datos reproducibles, con una parte fuera de rango.
+ */
+static void fillBuffer(void) {
+    uint32_t state = 99u;
+    for (size_t i = 0; i < SHARD_COUNT * SHARD_SIZE; i++) {
+        state = state * 1664525u + 1013904223u;
+        buffer[i] = (float)(state >> 8) / (float)(1u << 24) * 560.0f - 30.0f;
+    }
+}
+
+/* === Public function implementation ========================================================== */
+
+/** 1.1
+ * @brief Combinar los parciales de cada fragmento equivale a reducir los datos concatenados.
+ */
+void test_pdaMerge_matchesConcatenatedData(void) {
+    PdaPartial total, shard;
+    PdaStats expected, actual;
+    fillBuffer();
+    pdaAccInit(&total);
+    for (size_t day = 0; day < SHARD_COUNT; day++) {
+        pdaPartialReduce(buffer + day * SHARD_SIZE, SHARD_SIZE, &shard);
+        total = pdaMerge(&total, &shard);
+    }
+    computeParticulateStats(buffer, SHARD_COUNT * SHARD_SIZE, &expected);
+    TEST_ASSERT_TRUE(pdaPartialQuery(&total, &actual));
+    TEST_ASSERT_EQUAL(expected.validCount, actual.validCount);
+    TEST_ASSERT_EQUAL(expected.rejectedCount, actual.rejectedCount);
+    TEST_ASSERT_EQUAL_FLOAT(expected.mean, actual.mean);
+    TEST_ASSERT_EQUAL_FLOAT(expected.min, actual.min);
+    TEST_ASSERT_EQUAL_FLOAT(expected.max, actual.max);
+    TEST_ASSERT_EQUAL_FLOAT(expected.stdDev, actual.stdDev);
+}
+
+/** 1.2
+ * @brief Combinar con un parcial vacío no modifica el resultado.
+ */
+void test_pdaMerge_withEmptyPartial(void) {
+    const float data[] = {2.0f, 4.0f, 0.0f};
+    PdaPartial partial, empty, merged;
+    pdaPartialReduce(data, 3, &partial);
+    TEST_ASSERT_FALSE(pdaPartialReduce(NULL, 0, &empty));
+    merged = pdaMerge(&empty, &partial);
+    TEST_ASSERT_EQUAL(2, merged.validCount);
+    TEST_ASSERT_EQUAL(1, merged.rejectedCount);
+    TEST_ASSERT_EQUAL_FLOAT(3.0, merged.mean);
+    TEST_ASSERT_EQUAL_FLOAT(2.0, merged.m2);
+    TEST_ASSERT_EQUAL_FLOAT(2.0, merged.min);
+    TEST_ASSERT_EQUAL_FLOAT(4.0, merged.max);
+}
+
+/** 2.1
+ * @brief Un parcial serializado y reconstruido es idéntico al original.
+ */
+void test_pdaPartialSerialize_roundTrip(void) {
+    PdaPartial original, restored;
+    uint8_t blob[PDA_PARTIAL_BLOB_SIZE];
+    fillBuffer();
+    pdaPartialReduce(buffer, SHARD_SIZE, &original);
+    pdaPartialSerialize(&original, blob);
+    TEST_ASSERT_TRUE(pdaPartialDeserialize(blob, &restored));
+    TEST_ASSERT_EQUAL(original.validCount, restored.validCount);
+    TEST_ASSERT_EQUAL(original.rejectedCount, restored.rejectedCount);
+    TEST_ASSERT_EQUAL_MEMORY(&original.mean, &restored.mean, sizeof(double));
+    TEST_ASSERT_EQUAL_MEMORY(&original.m2, &restored.m2, sizeof(double));
+    TEST_ASSERT_EQUAL_MEMORY(&original.min, &restored.min, sizeof(float));
+    TEST_ASSERT_EQUAL_MEMORY(&original.max, &restored.max, sizeof(float));
+}
+
+/** 2.2
+ * @brief El bloque binario comienza con el identificador y la versión del formato.
+ */
+void test_pdaPartialSerialize_layout(void) {
+    const float data[] = {1.0f};
+    const uint8_t header[] = {'P', 'D', 'A', 'P', PDA_PARTIAL_VERSION, 0, 0, 0, 1, 0};
+    PdaPartial partial;
+    uint8_t blob[PDA_PARTIAL_BLOB_SIZE];
+    pdaPartialReduce(data, 1, &partial);
+    pdaPartialSerialize(&partial, blob);
+    TEST_ASSERT_EQUAL_MEMORY(header, blob, sizeof(header));
+}
+
+/** 2.3
+ * @brief Un bloque con identificador incorrecto o M2 negativo es rechazado.
+ */
+void test_pdaPartialDeserialize_rejectsCorruptBlob(void) {
+    const float data[] = {1.0f, 3.0f};
+    PdaPartial partial, restored;
+    uint8_t blob[PDA_PARTIAL_BLOB_SIZE];
+    pdaPartialReduce(data, 2, &partial);
+    pdaPartialSerialize(&partial, blob);
+    blob[0] = 'X';
+    TEST_ASSERT_FALSE(pdaPartialDeserialize(blob, &restored));
+    partial.m2 = -1.0;
+    pdaPartialSerialize(&partial, blob);
+    TEST_ASSERT_FALSE(pdaPartialDeserialize(blob, &restored));
+}
+
+/* === End of documentation ==================================================================== */
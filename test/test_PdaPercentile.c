@@ -0,0 +1,202 @@
+/*
+ * Nombre del archivo: test_PdaPercentile.c
+ * Descripción: Pruebas del cálculo de mediana y percentiles por selección.
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE FIUBA
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+
+/**
+ * @file  test_PdaPercentile.c
+ * @brief Pruebas unitarias del módulo PdaPercentile.
+ *
+ * @test Pruebas unitarias implementadas:
+ *       1.1 Mediana de un conjunto impar y de un conjunto par.
+ *       1.2 Los datos fuera de rango no participan del percentil.
+ *       1.3 Con buffer scratch el array original no se modifica y sin él se permuta.
+ *       1.4 Conjuntos vacíos y percentiles fuera de rango retornan valores de error.
+ *       2.1 Varios percentiles en una llamada coinciden con un ordenamiento completo, sobre datos
+ *           aleatorios, ordenados, invertidos y con muchos repetidos.
+ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "unity.h"
+#include "ParticulateDataAnalyzer.h"
+#include "PdaPercentile.h"
+#include <stdlib.h> // Para qsort
+
+/* === Macros definitions ====================================================================== */
+
+/// @brief Calcula el número de elementos en un arreglo estático.
+#define ARRAY_SIZE(arr) (sizeof(arr) / sizeof((arr)[0]))
+
+/// @brief Conjunto estándar de datos de MP.
+#define SET_STANDAR_DATA_MP                                                                        \
+    { 10.0, 2.0, 8.0, 4.0, 6.0 }
+
+/// @brief Conjunto de datos de MP con valores fuera de rango.
+#define SET_OUTLIER_DATA_MP                                                                        \
+    { 2.0, 1000.0, 600.0, 6.0, 0.0, 8.0, 10.0 }
+
+/// @brief Cantidad de datos de los conjuntos largos.
+#define LONG_DATA_SIZE 10001
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/// @brief Datos de los conjuntos largos.
+static float buffer[LONG_DATA_SIZE];
+
+/// @brief Copia ordenada de los datos válidos, usada como referencia.
+static float sorted[LONG_DATA_SIZE];
+
+/// @brief Buffer de trabajo para pdaPercentiles.
+static float scratch[LONG_DATA_SIZE];
+
+/* === Private function implementation ========================================================= */
+
+/**
+ * @brief Comparador para qsort.
+ */
+static int compareFloat(const void * a, const void * b) {
+    float x = *(const float *)a, y = *(const float *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Percentil de referencia calculado sobre la copia ordenada de los datos válidos.
+ */
+static float referencePercentile(size_t m, float percentile) {
+    double position = (double)(m - 1) * percentile / 100.0;
+    size_t lower = (size_t)position;
+    double value = sorted[lower];
+    if (lower + 1 < m)
+        value += (position - lower) * ((double)sorted[lower + 1] - value);
+    return (float)value;
+}
+
+/**
+ * @brief Compara varios percentiles del buffer con la referencia ordenada.
+ */
+static void assertPercentilesMatchSort(void) {
+    const float percentiles[] = {98.0f, 50.0f, 0.0f, 95.0f, 100.0f, 25.0f, 75.0f, 99.9f};
+    float results[ARRAY_SIZE(percentiles)];
+    size_t m = 0;
+    for (size_t i = 0; i < LONG_DATA_SIZE; i++) {
+        if (maskIsDataTrue(buffer[i]))
+            sorted[m++] = buffer[i];
+    }
+    qsort(sorted, m, sizeof(float), compareFloat);
+    TEST_ASSERT_TRUE(pdaPercentiles(buffer, LONG_DATA_SIZE, percentiles, ARRAY_SIZE(percentiles),
+                                    results, scratch));
+    for (size_t k = 0; k < ARRAY_SIZE(percentiles); k++)
+        TEST_ASSERT_EQUAL_FLOAT(referencePercentile(m, percentiles[k]), results[k]);
+}
+
+/* === Public function implementation ========================================================== */
+
+/** 1.1
+ * @brief Mediana de un conjunto impar y de un conjunto par.
+ */
+void test_pdaPercentile_median(void) {
+    float odd[] = SET_STANDAR_DATA_MP;
+    float even[] = {4.0f, 1.0f, 3.0f, 2.0f};
+    TEST_ASSERT_EQUAL_FLOAT(6.0, pdaPercentile(odd, ARRAY_SIZE(odd), 50.0f, NULL));
+    TEST_ASSERT_EQUAL_FLOAT(2.5, pdaPercentile(even, ARRAY_SIZE(even), 50.0f, NULL));
+}
+
+/** 1.2
+ * @brief Los datos fuera de rango no participan del percentil.
+ */
+void test_pdaPercentile_withOutlierValues(void) {
+    float data[] = SET_OUTLIER_DATA_MP;
+    TEST_ASSERT_EQUAL_FLOAT(7.0, pdaPercentile(data, ARRAY_SIZE(data), 50.0f, NULL));
+    TEST_ASSERT_EQUAL_FLOAT(10.0, pdaPercentile(data, ARRAY_SIZE(data), 100.0f, NULL));
+}
+
+/** 1.3
+ * @brief Con buffer scratch el array original no se modifica y sin él se permuta.
+ */
+void test_pdaPercentile_scratchKeepsData(void) {
+    float data[] = SET_STANDAR_DATA_MP;
+    float original[] = SET_STANDAR_DATA_MP;
+    float work[ARRAY_SIZE(data)];
+    TEST_ASSERT_EQUAL_FLOAT(9.2, pdaPercentile(data, ARRAY_SIZE(data), 90.0f, work));
+    TEST_ASSERT_EQUAL_MEMORY(original, data, sizeof(data));
+
+    float outliers[] = SET_OUTLIER_DATA_MP;
+    float values[] = SET_OUTLIER_DATA_MP;
+    TEST_ASSERT_EQUAL_FLOAT(7.0, pdaPercentile(outliers, ARRAY_SIZE(outliers), 50.0f, NULL));
+    qsort(outliers, ARRAY_SIZE(outliers), sizeof(float), compareFloat);
+    qsort(values, ARRAY_SIZE(values), sizeof(float), compareFloat);
+    TEST_ASSERT_EQUAL_FLOAT_ARRAY(values, outliers, ARRAY_SIZE(values));
+}
+
+/** 1.4
+ * @brief Conjuntos vacíos y percentiles fuera de rango retornan valores de error.
+ */
+void test_pdaPercentile_errorValues(void) {
+    float data[] = SET_STANDAR_DATA_MP;
+    float invalid[] = {0.0f, 700.0f};
+    const float percentiles[] = {50.0f, 101.0f};
+    float results[ARRAY_SIZE(percentiles)];
+    TEST_ASSERT_EQUAL_FLOAT(MSN_VOID_ARRAY_VALUE, pdaPercentile(NULL, 0, 50.0f, NULL));
+    TEST_ASSERT_EQUAL_FLOAT(MSN_VOID_ARRAY_VALUE,
+                            pdaPercentile(invalid, ARRAY_SIZE(invalid), 50.0f, NULL));
+    TEST_ASSERT_EQUAL_FLOAT(MSN_PERCENTILE_OUT_OF_RANGE,
+                            pdaPercentile(data, ARRAY_SIZE(data), -1.0f, NULL));
+    TEST_ASSERT_FALSE(pdaPercentiles(data, ARRAY_SIZE(data), percentiles, ARRAY_SIZE(percentiles),
+                                     results, NULL));
+    TEST_ASSERT_EQUAL_FLOAT(6.0, results[0]);
+    TEST_ASSERT_EQUAL_FLOAT(MSN_PERCENTILE_OUT_OF_RANGE, results[1]);
+}
+
+/** 2.1
+ * @brief Varios percentiles en una llamada coinciden con un ordenamiento completo.
+ */
+void test_pdaPercentiles_matchFullSort(void) {
+    uint32_t state = 5u;
+    for (size_t i = 0; i < LONG_DATA_SIZE; i++) {
+        state = state * 1664525u + 1013904223u;
+        buffer[i] = (float)(state >> 8) / (float)(1u << 24) * 560.0f - 30.0f;
+    }
+    assertPercentilesMatchSort();
+
+    for (size_t i = 0; i < LONG_DATA_SIZE; i++)
+        buffer[i] = 0.5f + (float)i * 0.04f; // ordenado
+    assertPercentilesMatchSort();
+
+    for (size_t i = 0; i < LONG_DATA_SIZE; i++)
+        buffer[i] = 400.0f - (float)i * 0.03f; // invertido
+    assertPercentilesMatchSort();
+
+    for (size_t i = 0; i < LONG_DATA_SIZE; i++)
+        buffer[i] = (float)(1 + i % 4); // muchos repetidos
+    assertPercentilesMatchSort();
+}
+
+/* === End of documentation ==================================================================== */
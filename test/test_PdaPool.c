@@ -0,0 +1,200 @@
+/*
+ * Nombre del archivo: test_PdaPool.c
+ * Descripción: Pruebas de los conjuntos de bloques estáticos.
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE FIUBA
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+
+/**
+ * @file  test_PdaPool.c
+ * @brief Pruebas unitarias del módulo PdaPool.
+ *
+ * @test Pruebas unitarias implementadas:
+ *       1.1 Un conjunto entrega tantos bloques distintos como su capacidad y luego rechaza los
+ *           pedidos, contándolos e informándolos.
+ *       1.2 Los bloques devueltos se reutilizan y el uso registra el máximo histórico.
+ *       1.3 pdaPoolReject cuenta e informa un pedido rechazado por tamaño.
+ *       1.4 Con USE_STATIC_MEM las ventanas se toman de pdaWindowPool y, al agotarse o pedir una
+ *           ventana demasiado grande, pdaWindowCreate retorna NULL y el conjunto lo registra; sin
+ *           USE_STATIC_MEM las ventanas no dependen de los conjuntos.
+ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "unity.h"
+#include "PdaPool.h"
+#include "PdaRollingWindow.h"
+
+/* === Macros definitions ====================================================================== */
+
+/// @brief Cantidad de bloques del conjunto de las pruebas.
+#define TEST_POOL_BLOCKS 3
+
+/* === Private data type declarations ========================================================== */
+
+/**
+ * @brief Bloque del conjunto de las pruebas.
+ */
+typedef struct {
+    void * link;        /**< Lugar del enlace mientras el bloque está libre. */
+    uint32_t values[4]; /**< Contenido del bloque. */
+} TestBlock;
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/// @brief Bloques del conjunto de las pruebas.
+static TestBlock testBlocks[TEST_POOL_BLOCKS];
+
+/// @brief Conjunto de las pruebas.
+static PdaPool testPool;
+
+/// @brief Cantidad de rechazos informados.
+static size_t exhaustedCalls;
+
+/// @brief Último conjunto que informó un rechazo.
+static const PdaPool * exhaustedPool;
+
+/* === Private function implementation ========================================================= */
+
+/**
+ * @brief Registra los rechazos informados.
+ */
+static void onExhausted(const PdaPool * pool, void * context) {
+    size_t * calls = context;
+    (*calls)++;
+    exhaustedPool = pool;
+}
+
+/* === Public function implementation ========================================================== */
+
+void setUp(void) {
+    testPool = (PdaPool)PDA_POOL_INITIALIZER("test", testBlocks);
+    exhaustedCalls = 0;
+    exhaustedPool = NULL;
+    pdaPoolSetExhaustedHandler(onExhausted, &exhaustedCalls);
+}
+
+void tearDown(void) {
+    pdaPoolSetExhaustedHandler(NULL, NULL);
+}
+
+/** 1.1
+ * @brief Un conjunto entrega tantos bloques distintos como su capacidad y luego rechaza los
+ * pedidos, contándolos e informándolos.
+ */
+void test_pdaPoolAcquire_exhaustion(void) {
+    PdaPoolUsage usage;
+    TestBlock * blocks[TEST_POOL_BLOCKS];
+    for (size_t i = 0; i < TEST_POOL_BLOCKS; i++) {
+        blocks[i] = pdaPoolAcquire(&testPool);
+        TEST_ASSERT_NOT_NULL(blocks[i]);
+        for (size_t j = 0; j < i; j++)
+            TEST_ASSERT_TRUE(blocks[i] != blocks[j]);
+    }
+    TEST_ASSERT_NULL(pdaPoolAcquire(&testPool));
+    TEST_ASSERT_EQUAL(1, exhaustedCalls);
+    TEST_ASSERT_EQUAL_PTR(&testPool, exhaustedPool);
+    TEST_ASSERT_EQUAL_STRING("test", pdaPoolName(exhaustedPool));
+
+    pdaPoolUsage(&testPool, &usage);
+    TEST_ASSERT_EQUAL(TEST_POOL_BLOCKS, usage.capacity);
+    TEST_ASSERT_EQUAL(TEST_POOL_BLOCKS, usage.used);
+    TEST_ASSERT_EQUAL(1, usage.failures);
+}
+
+/** 1.2
+ * @brief Los bloques devueltos se reutilizan y el uso registra el máximo histórico.
+ */
+void test_pdaPoolRelease_reuse(void) {
+    PdaPoolUsage usage;
+    TestBlock * first = pdaPoolAcquire(&testPool);
+    TestBlock * second = pdaPoolAcquire(&testPool);
+    first->values[0] = 7;
+    pdaPoolRelease(&testPool, second);
+    pdaPoolRelease(&testPool, NULL);
+    TEST_ASSERT_EQUAL_PTR(second, pdaPoolAcquire(&testPool));
+    pdaPoolRelease(&testPool, second);
+    pdaPoolRelease(&testPool, first);
+
+    for (size_t round = 0; round < 10; round++) {
+        TestBlock * block = pdaPoolAcquire(&testPool);
+        TEST_ASSERT_NOT_NULL(block);
+        pdaPoolRelease(&testPool, block);
+    }
+    pdaPoolUsage(&testPool, &usage);
+    TEST_ASSERT_EQUAL(0, usage.used);
+    TEST_ASSERT_EQUAL(2, usage.highWater);
+    TEST_ASSERT_EQUAL(0, usage.failures);
+    TEST_ASSERT_EQUAL(0, exhaustedCalls);
+}
+
+/** 1.3
+ * @brief pdaPoolReject cuenta e informa un pedido rechazado por tamaño.
+ */
+void test_pdaPoolReject_countsFailure(void) {
+    PdaPoolUsage usage;
+    pdaPoolReject(&testPool);
+    pdaPoolUsage(&testPool, &usage);
+    TEST_ASSERT_EQUAL(0, usage.used);
+    TEST_ASSERT_EQUAL(1, usage.failures);
+    TEST_ASSERT_EQUAL(1, exhaustedCalls);
+}
+
+/** 1.4
+ * @brief Con USE_STATIC_MEM las ventanas se toman de pdaWindowPool y, al agotarse o pedir una
+ * ventana demasiado grande, pdaWindowCreate retorna NULL y el conjunto lo registra; sin
+ * USE_STATIC_MEM las ventanas no dependen de los conjuntos.
+ */
+void test_pdaWindowCreate_usesWindowPool(void) {
+    PdaRollingWindow * windows[PDA_WINDOW_MAX_INSTANCES];
+    for (size_t i = 0; i < PDA_WINDOW_MAX_INSTANCES; i++) {
+        windows[i] = pdaWindowCreate(PDA_WINDOW_STATIC_SIZE);
+        TEST_ASSERT_NOT_NULL(windows[i]);
+    }
+#ifdef USE_STATIC_MEM
+    PdaPoolUsage usage;
+    TEST_ASSERT_TRUE(pdaPoolStaticMem());
+    TEST_ASSERT_NULL(pdaWindowCreate(1));
+    for (size_t i = 0; i < PDA_WINDOW_MAX_INSTANCES; i++)
+        pdaWindowDestroy(windows[i]);
+    TEST_ASSERT_NULL(pdaWindowCreate(PDA_WINDOW_STATIC_SIZE + 1));
+    pdaPoolUsage(&pdaWindowPool, &usage);
+    TEST_ASSERT_EQUAL(0, usage.used);
+    TEST_ASSERT_EQUAL(2, usage.failures);
+    TEST_ASSERT_EQUAL(2, exhaustedCalls);
+    TEST_ASSERT_EQUAL_PTR(&pdaWindowPool, exhaustedPool);
+#else
+    TEST_ASSERT_FALSE(pdaPoolStaticMem());
+    PdaRollingWindow * extra = pdaWindowCreate(PDA_WINDOW_STATIC_SIZE + 1);
+    TEST_ASSERT_NOT_NULL(extra);
+    pdaWindowDestroy(extra);
+    for (size_t i = 0; i < PDA_WINDOW_MAX_INSTANCES; i++)
+        pdaWindowDestroy(windows[i]);
+    TEST_ASSERT_EQUAL(0, exhaustedCalls);
+#endif
+}
+
+/* === End of documentation ==================================================================== */
@@ -0,0 +1,157 @@
+/*
+ * Nombre del archivo: test_PdaQuantized.c
+ * Descripción: Pruebas de los datos cuantizados a 16 bits.
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE FIUBA
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+
+/**
+ * @file  test_PdaQuantized.c
+ * @brief Pruebas unitarias del módulo PdaQuantized.
+ *
+ * @test Pruebas unitarias implementadas:
+ *       1.1 La cuantización redondea a la décima, respeta los bordes del rango y codifica los
+ *           datos inválidos como PDA_Q16_NO_DATA.
+ *       1.2 pdaQ16IsValid coincide con maskIsDataTrue aplicada al valor decodificado, para todos
+ *           los códigos.
+ *       1.3 La cuantización conserva la validez y su error es a lo sumo media décima.
+ *       2.1 computeParticulateStatsQ16 coincide con computeParticulateStats sobre los datos
+ *           decodificados.
+ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "unity.h"
+#include "ParticulateDataAnalyzer.h"
+#include "PdaAccumulator.h"
+#include "PdaQuantized.h"
+#include <math.h>
+
+/* === Macros definitions ====================================================================== */
+
+/// @brief Calcula el número de elementos en un arreglo estático.
+#define ARRAY_SIZE(arr) (sizeof(arr) / sizeof((arr)[0]))
+
+/// @brief Cantidad de datos de los conjuntos aleatorios: varios bloques y un resto.
+#define RANDOM_DATA_SIZE 20011
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/// @brief Estado del generador pseudoaleatorio.
+static uint32_t randomState;
+
+/// @brief Datos originales, cuantizados y decodificados.
+static float values[RANDOM_DATA_SIZE];
+static PdaQ16 codes[RANDOM_DATA_SIZE];
+static float decoded[RANDOM_DATA_SIZE];
+
+/* === Private function implementation ========================================================= */
+
+/**
+ * @brief Genera un dato en [-50, 550), de modo que una parte cae fuera del rango válido.
+ */
+static float randomSample(void) {
+    randomState = randomState * 1664525u + 1013904223u;
+    return (float)(randomState >> 8) / (float)(1u << 24) * 600.0f - 50.0f;
+}
+
+/* === Public function implementation ========================================================== */
+
+void setUp(void) {
+    randomState = 2024u;
+}
+
+/** 1.1
+ * @brief La cuantización redondea a la décima, respeta los bordes del rango y codifica los datos
+ *        inválidos como PDA_Q16_NO_DATA.
+ */
+void test_pdaQ16Encode_roundsAndClamps(void) {
+    const float inputs[] = {0.1f,   0.12f,   0.15f, 12.34f, 12.35f, 499.9f,
+                            499.99f, 500.0f, -1.0f, NAN,    INFINITY};
+    const PdaQ16 expected[] = {1, 1, 2, 123, 124, 4999, 4999, PDA_Q16_NO_DATA,
+                               PDA_Q16_NO_DATA, PDA_Q16_NO_DATA, PDA_Q16_NO_DATA};
+    for (size_t i = 0; i < ARRAY_SIZE(inputs); i++)
+        TEST_ASSERT_EQUAL(expected[i], pdaQ16Encode(inputs[i]));
+    TEST_ASSERT_EQUAL_FLOAT(12.3f, pdaQ16Decode(123));
+    TEST_ASSERT_EQUAL_FLOAT(MSN_NOT_DATA, pdaQ16Decode(PDA_Q16_NO_DATA));
+    TEST_ASSERT_EQUAL_FLOAT(MSN_NOT_DATA, pdaQ16Decode(PDA_Q16_MAX + 1));
+}
+
+/** 1.2
+ * @brief pdaQ16IsValid coincide con maskIsDataTrue aplicada al valor decodificado, para todos
+ *        los códigos.
+ */
+void test_pdaQ16IsValid_matchesDecodedMask(void) {
+    for (uint32_t code = 0; code <= UINT16_MAX; code++)
+        TEST_ASSERT_EQUAL(maskIsDataTrue(pdaQ16Decode((PdaQ16)code)), pdaQ16IsValid((PdaQ16)code));
+}
+
+/** 1.3
+ * @brief La cuantización conserva la validez y su error es a lo sumo media décima.
+ */
+void test_pdaQ16EncodeArray_preservesValidity(void) {
+    for (size_t i = 0; i < RANDOM_DATA_SIZE; i++)
+        values[i] = randomSample();
+    pdaQ16EncodeArray(values, RANDOM_DATA_SIZE, codes);
+    pdaQ16DecodeArray(codes, RANDOM_DATA_SIZE, decoded);
+    for (size_t i = 0; i < RANDOM_DATA_SIZE; i++) {
+        TEST_ASSERT_EQUAL(maskIsDataTrue(values[i]), pdaQ16IsValid(codes[i]));
+        if (maskIsDataTrue(values[i]) && values[i] < 499.9f)
+            TEST_ASSERT_FLOAT_WITHIN(0.05f + 1e-4f, values[i], decoded[i]);
+    }
+}
+
+/** 2.1
+ * @brief computeParticulateStatsQ16 coincide con computeParticulateStats sobre los datos
+ *        decodificados.
+ */
+void test_computeParticulateStatsQ16_matchesDecoded(void) {
+    PdaStats stats, expected;
+    for (size_t i = 0; i < RANDOM_DATA_SIZE; i++)
+        values[i] = randomSample();
+    pdaQ16EncodeArray(values, RANDOM_DATA_SIZE, codes);
+    pdaQ16DecodeArray(codes, RANDOM_DATA_SIZE, decoded);
+
+    TEST_ASSERT_TRUE(computeParticulateStatsQ16(codes, RANDOM_DATA_SIZE, &stats));
+    computeParticulateStats(decoded, RANDOM_DATA_SIZE, &expected);
+    TEST_ASSERT_EQUAL(expected.validCount, stats.validCount);
+    TEST_ASSERT_EQUAL(expected.rejectedCount, stats.rejectedCount);
+    TEST_ASSERT_EQUAL_FLOAT(expected.mean, stats.mean);
+    TEST_ASSERT_EQUAL_FLOAT(expected.min, stats.min);
+    TEST_ASSERT_EQUAL_FLOAT(expected.max, stats.max);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, expected.stdDev, stats.stdDev);
+
+    // un array sin datos válidos da los mismos valores de error
+    for (size_t i = 0; i < 10; i++)
+        codes[i] = PDA_Q16_NO_DATA;
+    TEST_ASSERT_FALSE(computeParticulateStatsQ16(codes, 10, &stats));
+    TEST_ASSERT_EQUAL_FLOAT(MSN_VOID_ARRAY_VALUE, stats.mean);
+    TEST_ASSERT_EQUAL(10, stats.rejectedCount);
+}
+
+/* === End of documentation ==================================================================== */
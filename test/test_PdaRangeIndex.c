@@ -0,0 +1,190 @@
+/*
+ * Nombre del archivo: test_PdaRangeIndex.c
+ * Descripción: Pruebas del índice de consultas por rango.
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE FIUBA
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+
+/**
+ * @file  test_PdaRangeIndex.c
+ * @brief Pruebas unitarias del módulo PdaRangeIndex.
+ *
+ * @test Pruebas unitarias implementadas:
+ *       1.1 Todos los sub-rangos de un conjunto corto coinciden con computeParticulateStats,
+ *           para varios tamaños de bloque.
+ *       1.2 Sub-rangos inválidos, vacíos o sin datos válidos retornan los valores de error.
+ *       2.1 Sub-rangos aleatorios de un conjunto largo coinciden con computeParticulateStats; con
+ *           USE_STATIC_MEM los tamaños de bloque que superan PDA_RANGE_INDEX_STATIC_BLOCKS se
+ *           rechazan.
+ *       2.2 La memoria del índice decrece con el tamaño de bloque.
+ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "unity.h"
+#include "ParticulateDataAnalyzer.h"
+#include "PdaKernels.h"
+#include "PdaRangeIndex.h"
+
+/* === Macros definitions ====================================================================== */
+
+/// @brief Calcula el número de elementos en un arreglo estático.
+#define ARRAY_SIZE(arr) (sizeof(arr) / sizeof((arr)[0]))
+
+/// @brief Conjunto de datos de MP con valores fuera de rango.
+#define SET_OUTLIER_DATA_MP                                                                        \
+    { 2.0, 1000.0, 600.0, 6.0, 0.0, 8.0, 10.0 }
+
+/// @brief Cantidad de datos del conjunto largo.
+#define LONG_DATA_SIZE 10007
+
+/// @brief Cantidad de sub-rangos aleatorios consultados por tamaño de bloque.
+#define RANDOM_QUERIES 2000
+
+/// @brief Datos de un día a 1 Hz.
+#define DAY_SAMPLES 86400
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/// @brief Datos del conjunto largo.
+static float buffer[LONG_DATA_SIZE];
+
+/// @brief Índice bajo prueba; se libera en tearDown.
+static PdaRangeIndex * rangeIndex;
+
+/* === Private function implementation ========================================================= */
+
+/**
+ * @brief Verifica que un sub-rango coincida con computeParticulateStats sobre el sub-array.
+ */
+static void assertRangeMatches(const float * data, size_t begin, size_t end) {
+    PdaStats expected, actual;
+    bool valid = computeParticulateStats(data + begin, end - begin, &expected);
+    TEST_ASSERT_EQUAL(valid, pdaRangeStats(rangeIndex, begin, end, &actual));
+    TEST_ASSERT_EQUAL(expected.validCount, actual.validCount);
+    TEST_ASSERT_EQUAL(expected.rejectedCount, actual.rejectedCount);
+    TEST_ASSERT_EQUAL_FLOAT(expected.mean, actual.mean);
+    TEST_ASSERT_EQUAL_FLOAT(expected.min, actual.min);
+    TEST_ASSERT_EQUAL_FLOAT(expected.max, actual.max);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, expected.stdDev, actual.stdDev);
+}
+
+/* === Public function implementation ========================================================== */
+
+/**
+ * @brief Libera el índice creado por cada prueba.
+ */
+void tearDown(void) {
+    pdaRangeIndexDestroy(rangeIndex);
+    rangeIndex = NULL;
+}
+
+/** 1.1
+ * @brief Todos los sub-rangos de un conjunto corto coinciden con computeParticulateStats.
+ */
+void test_pdaRangeIndex_allShortRanges(void) {
+    const float data[] = SET_OUTLIER_DATA_MP;
+    for (size_t blockSize = 1; blockSize <= 3; blockSize++) {
+        rangeIndex = pdaRangeIndexCreate(data, ARRAY_SIZE(data), blockSize);
+        TEST_ASSERT_NOT_NULL(rangeIndex);
+        for (size_t begin = 0; begin <= ARRAY_SIZE(data); begin++) {
+            for (size_t end = begin; end <= ARRAY_SIZE(data); end++)
+                assertRangeMatches(data, begin, end);
+        }
+        pdaRangeIndexDestroy(rangeIndex);
+        rangeIndex = NULL;
+    }
+}
+
+/** 1.2
+ * @brief Sub-rangos inválidos, vacíos o sin datos válidos retornan los valores de error.
+ */
+void test_pdaRangeIndex_errorValues(void) {
+    const float data[] = SET_OUTLIER_DATA_MP;
+    PdaStats stats;
+    TEST_ASSERT_NULL(pdaRangeIndexCreate(NULL, 4, 1));
+    rangeIndex = pdaRangeIndexCreate(data, ARRAY_SIZE(data), 2);
+    TEST_ASSERT_FALSE(pdaRangeStats(rangeIndex, 3, 2, &stats));
+    TEST_ASSERT_EQUAL_FLOAT(MSN_VOID_ARRAY_VALUE, stats.mean);
+    TEST_ASSERT_EQUAL_FLOAT(MSN_VOID_ARRAY_VALUE, pdaRangeAverage(rangeIndex, 0, 8));
+    TEST_ASSERT_EQUAL_FLOAT(MSN_VOID_ARRAY_VALUE, pdaRangeMin(rangeIndex, 5, 5));
+    TEST_ASSERT_EQUAL_FLOAT(MSN_VOID_ARRAY_VALUE, pdaRangeMax(rangeIndex, 1, 3));
+    TEST_ASSERT_EQUAL_FLOAT(10.0, pdaRangeMax(rangeIndex, 0, 7));
+    TEST_ASSERT_EQUAL_FLOAT(6.5, pdaRangeAverage(rangeIndex, 0, 7));
+}
+
+/** 2.1
+ * @brief Sub-rangos aleatorios de un conjunto largo coinciden con computeParticulateStats; con
+ * USE_STATIC_MEM los tamaños de bloque que superan PDA_RANGE_INDEX_STATIC_BLOCKS se rechazan.
+ */
+void test_pdaRangeIndex_randomRanges(void) {
+    // el último tamaño de bloque entra en el índice estático con cualquier configuración
+    const size_t blockSizes[] = {1, 7, PDA_RANGE_DEFAULT_BLOCK,
+                                 LONG_DATA_SIZE / PDA_RANGE_INDEX_STATIC_BLOCKS + 1};
+    uint32_t state = 9u;
+    for (size_t i = 0; i < LONG_DATA_SIZE; i++) {
+        state = state * 1664525u + 1013904223u;
+        buffer[i] = (float)(state >> 8) / (float)(1u << 24) * 560.0f - 30.0f;
+    }
+    for (size_t b = 0; b < ARRAY_SIZE(blockSizes); b++) {
+        rangeIndex = pdaRangeIndexCreate(buffer, LONG_DATA_SIZE, blockSizes[b]);
+#ifdef USE_STATIC_MEM
+        if (LONG_DATA_SIZE / blockSizes[b] > PDA_RANGE_INDEX_STATIC_BLOCKS) {
+            TEST_ASSERT_NULL(rangeIndex);
+            continue;
+        }
+#endif
+        TEST_ASSERT_NOT_NULL(rangeIndex);
+        for (size_t q = 0; q < RANDOM_QUERIES; q++) {
+            state = state * 1664525u + 1013904223u;
+            size_t begin = (state >> 8) % LONG_DATA_SIZE;
+            state = state * 1664525u + 1013904223u;
+            size_t end = begin + (state >> 8) % (LONG_DATA_SIZE - begin + 1);
+            assertRangeMatches(buffer, begin, end);
+        }
+        assertRangeMatches(buffer, 0, LONG_DATA_SIZE);
+        pdaRangeIndexDestroy(rangeIndex);
+        rangeIndex = NULL;
+    }
+}
+
+/** 2.2
+ * @brief La memoria del índice decrece con el tamaño de bloque.
+ */
+void test_pdaRangeIndex_memoryIsBounded(void) {
+    size_t previous = pdaRangeIndexMemory(DAY_SAMPLES, 1);
+    for (size_t blockSize = 2; blockSize <= 256; blockSize *= 2) {
+        size_t memory = pdaRangeIndexMemory(DAY_SAMPLES, blockSize);
+        TEST_ASSERT_TRUE(memory < previous);
+        previous = memory;
+    }
+    TEST_ASSERT_TRUE(pdaRangeIndexMemory(DAY_SAMPLES, PDA_RANGE_DEFAULT_BLOCK) <
+                     2 * DAY_SAMPLES);
+}
+
+/* === End of documentation ==================================================================== */
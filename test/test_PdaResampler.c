@@ -0,0 +1,274 @@
+/*
+ * Nombre del archivo: test_PdaResampler.c
+ * Descripción: Pruebas del remuestreo en intervalos de tiempo de varias resoluciones.
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE FIUBA
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+
+/**
+ * @file  test_PdaResampler.c
+ * @brief Pruebas unitarias del módulo PdaResampler.
+ *
+ * @test Pruebas unitarias implementadas:
+ *       1.1 Las configuraciones inválidas son rechazadas.
+ *       1.2 Una hora de datos a 1 Hz produce 60 minutos y una hora que coinciden con
+ *           computeParticulateStats, en orden cronológico.
+ *       1.3 La completitud de cada intervalo respeta el umbral de 75 %.
+ *       1.4 Los datos atrasados se descartan y la carga por lotes equivale a la carga por dato.
+ *       2.1 Dos días de datos por minuto se agregan en horas y días a partir de las horas.
+ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "unity.h"
+#include "ParticulateDataAnalyzer.h"
+#include "PdaKernels.h"
+#include "PdaAccumulator.h"
+#include "PdaResampler.h"
+#include <string.h> // Para memcmp
+
+/* === Macros definitions ====================================================================== */
+
+/// @brief Calcula el número de elementos en un arreglo estático.
+#define ARRAY_SIZE(arr) (sizeof(arr) / sizeof((arr)[0]))
+
+/// @brief Inicio de un día UTC (2023-11-14 00:00:00).
+#define DAY_START 1699920000
+
+/// @brief Cantidad máxima de resúmenes registrados por prueba.
+#define MAX_RECORDS 4096
+
+/// @brief Datos de dos días a un dato por minuto.
+#define TWO_DAYS_MINUTES (2 * 24 * 60)
+
+/// @brief Capacidad de los buffers de datos: una hora a 1 Hz.
+#define MAX_DATA_SIZE PDA_HOUR_SECONDS
+
+/* === Private data type declarations ========================================================== */
+
+/**
+ * @brief Resúmenes emitidos durante una prueba.
+ */
+typedef struct {
+    PdaBucket buckets[MAX_RECORDS];
+    size_t count;
+} Recorder;
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/// @brief Remuestreador bajo prueba.
+static PdaResampler resampler;
+
+/// @brief Resúmenes emitidos por el remuestreador bajo prueba.
+static Recorder recorder;
+
+/// @brief Resúmenes emitidos por un segundo remuestreador, para comparar.
+static Recorder other;
+
+/// @brief Marcas de tiempo de los datos de prueba.
+static int64_t timestamps[MAX_DATA_SIZE];
+
+/// @brief Datos de prueba.
+static float values[MAX_DATA_SIZE];
+
+/// @brief Minuto, hora y día.
+static const uint32_t widths[] = {PDA_MINUTE_SECONDS, PDA_HOUR_SECONDS, PDA_DAY_SECONDS};
+
+/* === Private function implementation ========================================================= */
+
+/**
+ * @brief Registra un resumen emitido.
+ */
+static void record(const PdaBucket * bucket, void * context) {
+    Recorder * target = context;
+    TEST_ASSERT_TRUE(target->count < MAX_RECORDS);
+    target->buckets[target->count++] = *bucket;
+}
+
+/**
+ * @brief Genera datos en [-10, 510) con una marca de tiempo cada period segundos.
+ */
+static void fillData(size_t n, uint32_t period) {
+    uint32_t state = 17u;
+    for (size_t i = 0; i < n; i++) {
+        state = state * 1664525u + 1013904223u;
+        timestamps[i] = DAY_START + (int64_t)(i * period);
+        values[i] = (float)(state >> 8) / (float)(1u << 24) * 520.0f - 10.0f;
+    }
+}
+
+/**
+ * @brief Verifica que un resumen coincida con computeParticulateStats sobre sus datos.
+ */
+static void assertBucketMatches(const PdaBucket * bucket, const float * data, size_t n) {
+    PdaStats expected;
+    computeParticulateStats(data, n, &expected);
+    TEST_ASSERT_EQUAL(expected.validCount, bucket->stats.validCount);
+    TEST_ASSERT_EQUAL(expected.rejectedCount, bucket->stats.rejectedCount);
+    TEST_ASSERT_EQUAL_FLOAT(expected.mean, bucket->stats.mean);
+    TEST_ASSERT_EQUAL_FLOAT(expected.min, bucket->stats.min);
+    TEST_ASSERT_EQUAL_FLOAT(expected.max, bucket->stats.max);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, expected.stdDev, bucket->stats.stdDev);
+}
+
+/* === Public function implementation ========================================================== */
+
+/**
+ * @brief Vacía los registros antes de cada prueba.
+ */
+void setUp(void) {
+    recorder.count = 0;
+    other.count = 0;
+}
+
+/** 1.1
+ * @brief Las configuraciones inválidas son rechazadas.
+ */
+void test_pdaResampler_rejectsInvalidConfig(void) {
+    const uint32_t notMultiple[] = {60, 90};
+    const uint32_t decreasing[] = {3600, 60};
+    const uint32_t tooMany[] = {1, 2, 4, 8, 16};
+    TEST_ASSERT_FALSE(pdaResamplerInit(&resampler, notMultiple, 2, 1, record, &recorder));
+    TEST_ASSERT_FALSE(pdaResamplerInit(&resampler, decreasing, 2, 1, record, &recorder));
+    TEST_ASSERT_FALSE(pdaResamplerInit(&resampler, tooMany, ARRAY_SIZE(tooMany), 1, record,
+                                       &recorder));
+    TEST_ASSERT_FALSE(pdaResamplerInit(&resampler, widths, ARRAY_SIZE(widths), 0, record,
+                                       &recorder));
+    TEST_ASSERT_FALSE(pdaResamplerInit(&resampler, widths, ARRAY_SIZE(widths), 7, record,
+                                       &recorder));
+    TEST_ASSERT_FALSE(pdaResamplerInit(&resampler, widths, ARRAY_SIZE(widths), 2 * widths[0],
+                                       record, &recorder));
+    TEST_ASSERT_TRUE(pdaResamplerInit(&resampler, widths, ARRAY_SIZE(widths), 1, record,
+                                      &recorder));
+}
+
+/** 1.2
+ * @brief Una hora de datos a 1 Hz produce 60 minutos y una hora, en orden cronológico.
+ */
+void test_pdaResampler_oneHourAtOneHertz(void) {
+    fillData(PDA_HOUR_SECONDS, 1);
+    pdaResamplerInit(&resampler, widths, ARRAY_SIZE(widths), 1, record, &recorder);
+    pdaResamplerPushBatch(&resampler, timestamps, values, PDA_HOUR_SECONDS);
+    TEST_ASSERT_EQUAL(59, recorder.count); // el último minuto sigue abierto
+    pdaResamplerFlush(&resampler);
+    TEST_ASSERT_EQUAL(62, recorder.count);
+
+    for (size_t m = 0; m < 60; m++) {
+        const PdaBucket * minute = &recorder.buckets[m];
+        TEST_ASSERT_EQUAL(0, minute->level);
+        TEST_ASSERT_TRUE(minute->start == DAY_START + (int64_t)(m * PDA_MINUTE_SECONDS));
+        TEST_ASSERT_EQUAL(PDA_MINUTE_SECONDS, minute->expectedCount);
+        assertBucketMatches(minute, values + m * PDA_MINUTE_SECONDS, PDA_MINUTE_SECONDS);
+    }
+    const PdaBucket * hour = &recorder.buckets[60];
+    TEST_ASSERT_EQUAL(1, hour->level);
+    TEST_ASSERT_EQUAL(60, hour->childCount);
+    TEST_ASSERT_TRUE(hour->start == DAY_START);
+    assertBucketMatches(hour, values, PDA_HOUR_SECONDS);
+    TEST_ASSERT_EQUAL(2, recorder.buckets[61].level);
+    TEST_ASSERT_EQUAL(1, recorder.buckets[61].childCount);
+}
+
+/** 1.3
+ * @brief La completitud de cada intervalo respeta el umbral de 75 %.
+ */
+void test_pdaResampler_completeness(void) {
+    pdaResamplerInit(&resampler, widths, 2, 1, record, &recorder);
+    for (int s = 0; s < 45; s++) // 45 de 60: exactamente 75 %
+        pdaResamplerPush(&resampler, DAY_START + s, 20.0f);
+    for (int s = 0; s < 60; s++) // 44 válidos de 60
+        pdaResamplerPush(&resampler, DAY_START + 60 + s, (s < 44) ? 20.0f : 0.0f);
+    pdaResamplerPush(&resampler, DAY_START + 3 * 60, 20.0f);
+    pdaResamplerFlush(&resampler);
+
+    TEST_ASSERT_EQUAL(4, recorder.count);
+    TEST_ASSERT_TRUE(recorder.buckets[0].complete);
+    TEST_ASSERT_FALSE(recorder.buckets[1].complete);
+    TEST_ASSERT_EQUAL(16, recorder.buckets[1].stats.rejectedCount);
+    TEST_ASSERT_FALSE(recorder.buckets[2].complete);
+    const PdaBucket * hour = &recorder.buckets[3];
+    TEST_ASSERT_EQUAL(3, hour->childCount);
+    TEST_ASSERT_EQUAL(1, hour->completeChildren);
+    TEST_ASSERT_EQUAL(90, hour->stats.validCount);
+    TEST_ASSERT_EQUAL(PDA_HOUR_SECONDS, hour->expectedCount);
+    TEST_ASSERT_FALSE(hour->complete);
+}
+
+/** 1.4
+ * @brief Los datos atrasados se descartan y la carga por lotes equivale a la carga por dato.
+ */
+void test_pdaResampler_lateDataAndBatch(void) {
+    PdaResampler single;
+    fillData(PDA_HOUR_SECONDS, 1);
+    timestamps[1000] = DAY_START + 100; // atrasado: el minuto 1 ya se cerró
+    pdaResamplerInit(&resampler, widths, ARRAY_SIZE(widths), 1, record, &recorder);
+    pdaResamplerInit(&single, widths, ARRAY_SIZE(widths), 1, record, &other);
+    pdaResamplerPushBatch(&resampler, timestamps, values, PDA_HOUR_SECONDS);
+    for (size_t i = 0; i < PDA_HOUR_SECONDS; i++)
+        pdaResamplerPush(&single, timestamps[i], values[i]);
+    pdaResamplerFlush(&resampler);
+    pdaResamplerFlush(&single);
+
+    TEST_ASSERT_EQUAL(1, resampler.lateCount);
+    TEST_ASSERT_EQUAL(1, single.lateCount);
+    TEST_ASSERT_EQUAL(PDA_MINUTE_SECONDS - 1, recorder.buckets[16].stats.validCount +
+                                                  recorder.buckets[16].stats.rejectedCount);
+    TEST_ASSERT_EQUAL(other.count, recorder.count);
+    for (size_t i = 0; i < recorder.count; i++) {
+        TEST_ASSERT_TRUE(recorder.buckets[i].start == other.buckets[i].start);
+        TEST_ASSERT_EQUAL(recorder.buckets[i].stats.validCount,
+                          other.buckets[i].stats.validCount);
+        TEST_ASSERT_EQUAL_FLOAT(recorder.buckets[i].stats.mean, other.buckets[i].stats.mean);
+    }
+}
+
+/** 2.1
+ * @brief Dos días de datos por minuto se agregan en horas y días a partir de las horas.
+ */
+void test_pdaResampler_daysRollUpFromHours(void) {
+    fillData(TWO_DAYS_MINUTES, PDA_MINUTE_SECONDS);
+    pdaResamplerInit(&resampler, widths + 1, 2, PDA_MINUTE_SECONDS, record, &recorder);
+    pdaResamplerPushBatch(&resampler, timestamps, values, TWO_DAYS_MINUTES);
+    pdaResamplerFlush(&resampler);
+
+    TEST_ASSERT_EQUAL(2 * 24 + 2, recorder.count);
+    size_t day = 0;
+    for (size_t i = 0; i < recorder.count; i++) {
+        const PdaBucket * bucket = &recorder.buckets[i];
+        if (bucket->level == 0) {
+            TEST_ASSERT_EQUAL(60, bucket->expectedCount);
+            continue;
+        }
+        TEST_ASSERT_TRUE(bucket->start == DAY_START + (int64_t)(day * PDA_DAY_SECONDS));
+        TEST_ASSERT_EQUAL(24, bucket->childCount);
+        TEST_ASSERT_EQUAL(24 * 60, bucket->expectedCount);
+        assertBucketMatches(bucket, values + day * 24 * 60, 24 * 60);
+        day++;
+    }
+    TEST_ASSERT_EQUAL(2, day);
+}
+
+/* === End of documentation ==================================================================== */
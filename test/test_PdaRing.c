@@ -0,0 +1,241 @@
+/*
+ * Nombre del archivo: test_PdaRing.c
+ * Descripción: Pruebas del buffer circular de un productor y un consumidor.
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE FIUBA
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+
+/**
+ * @file  test_PdaRing.c
+ * @brief Pruebas unitarias del módulo PdaRing.
+ *
+ * @test Pruebas unitarias implementadas:
+ *       1.1 Solo se pueden crear buffers con capacidad potencia de dos y uno nuevo está vacío.
+ *       1.2 Con el buffer lleno los datos nuevos se descartan y se cuentan como perdidos.
+ *       1.3 Al dar la vuelta, pdaRingPeek retorna dos tramos en orden de llegada.
+ *       1.4 pdaRingDrain obtiene las mismas estadísticas que computeParticulateStats.
+ *       1.5 Con un productor y un consumidor en hilos distintos no se pierde ni se desordena
+ *           ningún dato.
+ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "unity.h"
+#include "ParticulateDataAnalyzer.h"
+#include "PdaAccumulator.h"
+#include "PdaRing.h"
+#include <pthread.h>
+
+/* === Macros definitions ====================================================================== */
+
+/// @brief Calcula el número de elementos en un arreglo estático.
+#define ARRAY_SIZE(arr) (sizeof(arr) / sizeof((arr)[0]))
+
+/// @brief Capacidad del buffer de las pruebas cortas.
+#define SMALL_CAPACITY 8
+
+/// @brief Capacidad del buffer de la prueba entre hilos, menor que el total para forzar vueltas.
+#define THREAD_CAPACITY 256
+
+/// @brief Cantidad de datos de la prueba entre hilos.
+#define THREAD_DATA_SIZE 200000
+
+/// @brief Tamaño de los bloques que agrega el productor con pdaRingPushBatch.
+#define THREAD_BATCH 37
+
+/// @brief Cantidad de datos de la prueba de estadísticas.
+#define STATS_DATA_SIZE 1000
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/// @brief Buffer usado por cada prueba.
+static PdaRing * ring;
+
+/// @brief Datos de la prueba de estadísticas.
+static float statsData[STATS_DATA_SIZE];
+
+/* === Private function implementation ========================================================= */
+
+/**
+ * @brief Dato número i de la prueba entre hilos, exacto en float.
+ */
+static float sequenceValue(size_t i) {
+    return (float)(i % 4096) * 0.125f;
+}
+
+/**
+ * @brief Productor de la prueba entre hilos: alterna datos sueltos y bloques, reintentando
+ *        mientras el buffer esté lleno.
+ */
+static void * producer(void * arg) {
+    PdaRing * target = arg;
+    float batch[THREAD_BATCH];
+    size_t next = 0;
+    while (next < THREAD_DATA_SIZE) {
+        if ((next / THREAD_BATCH) % 2 == 0) {
+            if (pdaRingPush(target, sequenceValue(next)))
+                next++;
+        } else {
+            size_t count = THREAD_DATA_SIZE - next < THREAD_BATCH ? THREAD_DATA_SIZE - next
+                                                                   : THREAD_BATCH;
+            for (size_t i = 0; i < count; i++)
+                batch[i] = sequenceValue(next + i);
+            size_t pushed = pdaRingPushBatch(target, batch, count);
+            next += pushed;
+        }
+    }
+    return NULL;
+}
+
+/* === Public function implementation ========================================================== */
+
+void setUp(void) {
+    ring = pdaRingCreate(SMALL_CAPACITY);
+}
+
+void tearDown(void) {
+    pdaRingDestroy(ring);
+}
+
+/** 1.1
+ * @brief Solo se pueden crear buffers con capacidad potencia de dos y uno nuevo está vacío.
+ */
+void test_pdaRingCreate_emptyRing(void) {
+    PdaRingSpan spans[2];
+    TEST_ASSERT_NULL(pdaRingCreate(0));
+    TEST_ASSERT_NULL(pdaRingCreate(12));
+    TEST_ASSERT_NOT_NULL(ring);
+    TEST_ASSERT_EQUAL(SMALL_CAPACITY, pdaRingCapacity(ring));
+    TEST_ASSERT_EQUAL(0, pdaRingCount(ring));
+    TEST_ASSERT_EQUAL(0, pdaRingPeek(ring, spans));
+    TEST_ASSERT_EQUAL(0, spans[0].count);
+    TEST_ASSERT_EQUAL(0, spans[1].count);
+}
+
+/** 1.2
+ * @brief Con el buffer lleno los datos nuevos se descartan y se cuentan como perdidos.
+ */
+void test_pdaRingPush_fullRingDropsNewData(void) {
+    const float data[] = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+    PdaRingSpan spans[2];
+    TEST_ASSERT_EQUAL(ARRAY_SIZE(data), pdaRingPushBatch(ring, data, ARRAY_SIZE(data)));
+    TEST_ASSERT_TRUE(pdaRingPush(ring, 7.0f));
+    TEST_ASSERT_TRUE(pdaRingPush(ring, 8.0f));
+    TEST_ASSERT_FALSE(pdaRingPush(ring, 9.0f));
+    TEST_ASSERT_EQUAL(0, pdaRingPushBatch(ring, data, ARRAY_SIZE(data)));
+    TEST_ASSERT_EQUAL(1 + ARRAY_SIZE(data), pdaRingDropped(ring));
+
+    pdaRingRelease(ring, 3);
+    TEST_ASSERT_EQUAL(3, pdaRingPushBatch(ring, data, ARRAY_SIZE(data)));
+    TEST_ASSERT_EQUAL(4 + ARRAY_SIZE(data), pdaRingDropped(ring));
+    TEST_ASSERT_EQUAL(SMALL_CAPACITY, pdaRingPeek(ring, spans));
+    TEST_ASSERT_EQUAL_FLOAT(4.0f, spans[0].data[0]);
+}
+
+/** 1.3
+ * @brief Al dar la vuelta, pdaRingPeek retorna dos tramos en orden de llegada.
+ */
+void test_pdaRingPeek_wrapAroundTwoSpans(void) {
+    const float first[] = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f};
+    const float second[] = {6.0f, 7.0f, 8.0f, 9.0f, 10.0f, 11.0f};
+    PdaRingSpan spans[2];
+    pdaRingPushBatch(ring, first, ARRAY_SIZE(first));
+    pdaRingRelease(ring, ARRAY_SIZE(first));
+    TEST_ASSERT_EQUAL(ARRAY_SIZE(second), pdaRingPushBatch(ring, second, ARRAY_SIZE(second)));
+
+    TEST_ASSERT_EQUAL(ARRAY_SIZE(second), pdaRingPeek(ring, spans));
+    TEST_ASSERT_EQUAL(SMALL_CAPACITY - ARRAY_SIZE(first), spans[0].count);
+    TEST_ASSERT_EQUAL(ARRAY_SIZE(second) - spans[0].count, spans[1].count);
+    TEST_ASSERT_EQUAL_FLOAT_ARRAY(second, spans[0].data, spans[0].count);
+    TEST_ASSERT_EQUAL_FLOAT_ARRAY(second + spans[0].count, spans[1].data, spans[1].count);
+
+    pdaRingRelease(ring, SMALL_CAPACITY); // se limita a los datos disponibles
+    TEST_ASSERT_EQUAL(0, pdaRingCount(ring));
+    TEST_ASSERT_EQUAL(0, pdaRingPeek(ring, spans));
+}
+
+/** 1.4
+ * @brief pdaRingDrain obtiene las mismas estadísticas que computeParticulateStats.
+ */
+void test_pdaRingDrain_matchesComputeParticulateStats(void) {
+    PdaRing * statsRing = pdaRingCreate(64);
+    PdaAccumulator acc;
+    PdaStats expected, actual;
+    uint32_t state = 11u;
+    pdaAccInit(&acc);
+    for (size_t i = 0; i < STATS_DATA_SIZE; i++) {
+        state = state * 1664525u + 1013904223u;
+        statsData[i] = (i % 17 == 0) ? 0.0f : (float)(state >> 8) / (1u << 24) * 550.0f;
+    }
+    // bloques de distinto tamaño para que el consumidor encuentre tramos partidos
+    size_t next = 0;
+    for (size_t block = 1; next < STATS_DATA_SIZE; block = block % 50 + 7) {
+        size_t count = STATS_DATA_SIZE - next < block ? STATS_DATA_SIZE - next : block;
+        TEST_ASSERT_EQUAL(count, pdaRingPushBatch(statsRing, statsData + next, count));
+        next += count;
+        TEST_ASSERT_EQUAL(count, pdaRingDrain(statsRing, &acc));
+    }
+
+    TEST_ASSERT_EQUAL(0, pdaRingDropped(statsRing));
+    TEST_ASSERT_TRUE(computeParticulateStats(statsData, STATS_DATA_SIZE, &expected));
+    TEST_ASSERT_TRUE(pdaAccQuery(&acc, &actual));
+    TEST_ASSERT_EQUAL(expected.validCount, actual.validCount);
+    TEST_ASSERT_EQUAL(expected.rejectedCount, actual.rejectedCount);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, expected.mean, actual.mean);
+    TEST_ASSERT_EQUAL_FLOAT(expected.min, actual.min);
+    TEST_ASSERT_EQUAL_FLOAT(expected.max, actual.max);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, expected.stdDev, actual.stdDev);
+    pdaRingDestroy(statsRing);
+}
+
+/** 1.5
+ * @brief Con un productor y un consumidor en hilos distintos no se pierde ni se desordena ningún
+ * dato.
+ */
+void test_pdaRing_producerConsumerThreads(void) {
+    PdaRing * threadRing = pdaRingCreate(THREAD_CAPACITY);
+    PdaRingSpan spans[2];
+    pthread_t thread;
+    size_t received = 0;
+    size_t mismatches = 0;
+    TEST_ASSERT_EQUAL(0, pthread_create(&thread, NULL, producer, threadRing));
+    while (received < THREAD_DATA_SIZE) {
+        size_t count = pdaRingPeek(threadRing, spans);
+        for (size_t s = 0; s < ARRAY_SIZE(spans); s++)
+            for (size_t i = 0; i < spans[s].count; i++)
+                mismatches += spans[s].data[i] != sequenceValue(received++);
+        pdaRingRelease(threadRing, count);
+    }
+    pthread_join(thread, NULL);
+    TEST_ASSERT_EQUAL(0, mismatches);
+    TEST_ASSERT_EQUAL(THREAD_DATA_SIZE, received);
+    TEST_ASSERT_EQUAL(0, pdaRingCount(threadRing));
+    pdaRingDestroy(threadRing);
+}
+
+/* === End of documentation ==================================================================== */
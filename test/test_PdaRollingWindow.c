@@ -0,0 +1,177 @@
+/*
+ * Nombre del archivo: test_PdaRollingWindow.c
+ * Descripción: Pruebas de la ventana deslizante de estadísticas de MP.
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE FIUBA
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+
+/**
+ * @file  test_PdaRollingWindow.c
+ * @brief Pruebas unitarias del módulo PdaRollingWindow.
+ *
+ * @test Pruebas unitarias implementadas:
+ *       1.1 No se puede crear una ventana de tamaño cero y una ventana nueva está vacía.
+ *       1.2 Con la ventana sin llenar, las estadísticas coinciden con las de los datos recibidos.
+ *       1.3 Al deslizar, el mínimo y el máximo salen de la ventana junto con su dato.
+ *       1.4 Los datos inválidos no cuentan en el divisor de la ventana.
+ *       1.5 En una secuencia larga la ventana coincide con computeParticulateStats sobre los
+ *           últimos N datos.
+ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "unity.h"
+#include "ParticulateDataAnalyzer.h"
+#include "PdaKernels.h"
+#include "PdaRollingWindow.h"
+
+/* === Macros definitions ====================================================================== */
+
+/// @brief Calcula el número de elementos en un arreglo estático.
+#define ARRAY_SIZE(arr) (sizeof(arr) / sizeof((arr)[0]))
+
+/// @brief Tamaño de la ventana de las pruebas cortas.
+#define SMALL_WINDOW 3
+
+/// @brief Tamaño de la ventana de la prueba larga.
+#define LONG_WINDOW 60
+
+/// @brief Cantidad de datos de la prueba larga.
+#define LONG_DATA_SIZE 5000
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/// @brief Ventana usada por cada prueba.
+static PdaRollingWindow * window;
+
+/// @brief Historia de datos de la prueba larga.
+static float history[LONG_DATA_SIZE];
+
+/* === Private function implementation ========================================================= */
+
+/* === Public function implementation ========================================================== */
+
+void setUp(void) {
+    window = pdaWindowCreate(SMALL_WINDOW);
+}
+
+void tearDown(void) {
+    pdaWindowDestroy(window);
+}
+
+/** 1.1
+ * @brief No se puede crear una ventana de tamaño cero y una ventana nueva está vacía.
+ */
+void test_pdaWindowCreate_emptyWindow(void) {
+    PdaStats stats;
+    TEST_ASSERT_NULL(pdaWindowCreate(0));
+    TEST_ASSERT_NOT_NULL(window);
+    TEST_ASSERT_FALSE(pdaWindowQuery(window, &stats));
+    TEST_ASSERT_EQUAL_FLOAT(MSN_VOID_ARRAY_VALUE, stats.mean);
+}
+
+/** 1.2
+ * @brief Con la ventana sin llenar, las estadísticas coinciden con las de los datos recibidos.
+ */
+void test_pdaWindowPush_partialWindow(void) {
+    PdaStats stats;
+    pdaWindowPush(window, 4.0f);
+    TEST_ASSERT_TRUE(pdaWindowQuery(window, &stats));
+    TEST_ASSERT_EQUAL_FLOAT(4.0, stats.mean);
+    TEST_ASSERT_EQUAL_FLOAT(MSN_DS_NOTDEFINI, stats.stdDev);
+    pdaWindowPush(window, 8.0f);
+    TEST_ASSERT_TRUE(pdaWindowQuery(window, &stats));
+    TEST_ASSERT_EQUAL_FLOAT(6.0, stats.mean);
+    TEST_ASSERT_EQUAL_FLOAT(4.0, stats.min);
+    TEST_ASSERT_EQUAL_FLOAT(8.0, stats.max);
+}
+
+/** 1.3
+ * @brief Al deslizar, el mínimo y el máximo salen de la ventana junto con su dato.
+ */
+void test_pdaWindowPush_extremesLeaveWindow(void) {
+    const float data[] = {1.0f, 9.0f, 5.0f, 6.0f, 7.0f};
+    PdaStats stats;
+    for (size_t i = 0; i < ARRAY_SIZE(data); i++)
+        pdaWindowPush(window, data[i]);
+    TEST_ASSERT_TRUE(pdaWindowQuery(window, &stats));
+    TEST_ASSERT_EQUAL_FLOAT(6.0, stats.mean);
+    TEST_ASSERT_EQUAL_FLOAT(5.0, stats.min);
+    TEST_ASSERT_EQUAL_FLOAT(7.0, stats.max);
+    TEST_ASSERT_EQUAL_FLOAT(1.0, stats.stdDev);
+}
+
+/** 1.4
+ * @brief Los datos inválidos no cuentan en el divisor de la ventana.
+ */
+void test_pdaWindowPush_invalidDataNotCounted(void) {
+    PdaStats stats;
+    pdaWindowPush(window, 10.0f);
+    TEST_ASSERT_FALSE(pdaWindowPush(window, 0.0f));
+    TEST_ASSERT_FALSE(pdaWindowPush(window, 900.0f));
+    TEST_ASSERT_TRUE(pdaWindowQuery(window, &stats));
+    TEST_ASSERT_EQUAL_FLOAT(10.0, stats.mean);
+    TEST_ASSERT_EQUAL(1, stats.validCount);
+    TEST_ASSERT_EQUAL(2, stats.rejectedCount);
+    TEST_ASSERT_EQUAL_FLOAT(MSN_NOT_DATA, stats.stdDev);
+    pdaWindowPush(window, 0.0f); // el único dato válido sale de la ventana
+    TEST_ASSERT_FALSE(pdaWindowQuery(window, &stats));
+    TEST_ASSERT_EQUAL(3, stats.rejectedCount);
+}
+
+/** 1.5
+ * @brief En una secuencia larga la ventana coincide con computeParticulateStats sobre los
+ * últimos N datos.
+ */
+void test_pdaWindowPush_matchesComputeParticulateStats(void) {
+    // con USE_STATIC_MEM el conjunto puede tener una sola ventana: se libera la de setUp
+    pdaWindowDestroy(window);
+    window = NULL;
+    PdaRollingWindow * longWindow = pdaWindowCreate(LONG_WINDOW);
+    TEST_ASSERT_NOT_NULL(longWindow);
+    PdaStats expected, actual;
+    uint32_t state = 7u;
+    for (size_t i = 0; i < LONG_DATA_SIZE; i++) {
+        state = state * 1664525u + 1013904223u;
+        // tramos de ceros simulan períodos de calentamiento o pérdida de señal
+        history[i] = ((i / 500) % 3 == 2) ? 0.0f : (float)(state >> 8) / (1u << 24) * 550.0f;
+        pdaWindowPush(longWindow, history[i]);
+        size_t first = (i + 1 > LONG_WINDOW) ? i + 1 - LONG_WINDOW : 0;
+        bool expectedValid = computeParticulateStats(history + first, i + 1 - first, &expected);
+        TEST_ASSERT_EQUAL(expectedValid, pdaWindowQuery(longWindow, &actual));
+        TEST_ASSERT_EQUAL(expected.validCount, actual.validCount);
+        TEST_ASSERT_EQUAL(expected.rejectedCount, actual.rejectedCount);
+        TEST_ASSERT_EQUAL_FLOAT(expected.mean, actual.mean);
+        TEST_ASSERT_EQUAL_FLOAT(expected.min, actual.min);
+        TEST_ASSERT_EQUAL_FLOAT(expected.max, actual.max);
+        TEST_ASSERT_FLOAT_WITHIN(1e-4, expected.stdDev, actual.stdDev);
+    }
+    pdaWindowDestroy(longWindow);
+}
+
+/* === End of documentation ==================================================================== */
@@ -0,0 +1,324 @@
+/*
+ * Nombre del archivo: test_PdaSketch.c
+ * Descripción: Pruebas del resumen de cuantiles de memoria acotada.
+ * Autor: Luis Gómez P.
+ * Derechos de Autor: (C) 2023 CESE FIUBA
+ * Licencia: GNU General Public License v3.0
+ *
+ * Este programa es software libre: puedes redistribuirlo y/o modificarlo
+ * bajo los términos de la Licencia Pública General GNU publicada por
+ * la Free Software Foundation, ya sea la versión 3 de la Licencia, o
+ * (a tu elección) cualquier versión posterior.
+ *
+ * Este programa se distribuye con la esperanza de que sea útil,
+ * pero SIN NINGUNA GARANTÍA; sin siquiera la garantía implícita
+ * de COMERCIABILIDAD o APTITUD PARA UN PROPÓSITO PARTICULAR. Ver la
+ * Licencia Pública General GNU para más detalles.
+ *
+ * Deberías haber recibido una copia de la Licencia Pública General GNU
+ * junto con este programa. Si no es así, visita <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-only
+ *
+ */
+
+/**
+ * @file  test_PdaSketch.c
+ * @brief Pruebas unitarias del módulo PdaSketch.
+ *
+ * @test Pruebas unitarias implementadas:
+ *       1.1 Con pocos datos el resumen es exacto y descarta los datos fuera de rango.
+ *       1.2 Resúmenes vacíos, percentiles fuera de rango y punteros NULL retornan valores de error.
+ *       1.3 Consultar percentiles no modifica el resumen.
+ *       2.1 Sobre 100000 datos el error de rango de los percentiles 1 a 99 respeta la cota.
+ *       2.2 La combinación de resúmenes parciales respeta la cota y suma los contadores.
+ *       3.1 La serialización reproduce el resumen y rechaza buffers inválidos.
+ *       3.2 La deserialización rechaza niveles que exceden la capacidad, niveles desordenados y
+ *           datos NaN.
+ */
+
+/* === Headers files inclusions =============================================================== */
+
+#include "unity.h"
+#include "ParticulateDataAnalyzer.h"
+#include "PdaPercentile.h"
+#include "PdaSketch.h"
+#include "PdaByteOrder.h"
+#include <math.h>   // Para NAN
+#include <stdlib.h> // Para qsort
+#include <string.h> // Para memcpy
+
+/* === Macros definitions ====================================================================== */
+
+/// @brief Calcula el número de elementos en un arreglo estático.
+#define ARRAY_SIZE(arr) (sizeof(arr) / sizeof((arr)[0]))
+
+/// @brief Conjunto de datos de MP con valores fuera de rango.
+#define SET_OUTLIER_DATA_MP                                                                        \
+    { 2.0, 1000.0, 600.0, 6.0, 0.0, 8.0, 10.0 }
+
+/// @brief Cantidad de datos de los conjuntos largos.
+#define LONG_DATA_SIZE 100000
+
+/// @brief Cantidad de resúmenes parciales combinados.
+#define PARTIAL_COUNT 10
+
+/// @brief Semilla de los resúmenes.
+#define SKETCH_SEED 7u
+
+/// @brief Posición de validCount en el encabezado del formato binario.
+#define BLOB_OFFSET_VALID 8
+
+/* === Private data type declarations ========================================================== */
+
+/* === Private variable declarations =========================================================== */
+
+/* === Private function declarations =========================================================== */
+
+/* === Public variable definitions ============================================================= */
+
+/* === Private variable definitions ============================================================ */
+
+/// @brief Datos de los conjuntos largos.
+static float buffer[LONG_DATA_SIZE];
+
+/// @brief Copia ordenada de los datos, usada como referencia.
+static float sorted[LONG_DATA_SIZE];
+
+/// @brief Resumen bajo prueba.
+static PdaSketch sketch;
+
+/// @brief Resumen auxiliar para combinaciones y deserialización.
+static PdaSketch other;
+
+/// @brief Buffer de serialización.
+static uint8_t blob[PDA_SKETCH_HEADER_SIZE + 2 * PDA_SKETCH_MAX_LEVELS + 4 * PDA_SKETCH_CAPACITY];
+
+/* === Private function implementation ========================================================= */
+
+/**
+ * @brief Posición en blob del primer dato del nivel h de un resumen serializado.
+ */
+static size_t blobLevelOffset(uint32_t numLevels, uint32_t h) {
+    size_t offset = PDA_SKETCH_HEADER_SIZE + 2 * (size_t)numLevels;
+    for (uint32_t lvl = 0; lvl < h; lvl++)
+        offset += 4 * pdaReadLe(blob + PDA_SKETCH_HEADER_SIZE + 2 * lvl, 2);
+    return offset;
+}
+
+/**
+ * @brief Comparador para qsort.
+ */
+static int compareFloat(const void * a, const void * b) {
+    float x = *(const float *)a, y = *(const float *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Genera datos válidos con una distribución sesgada hacia valores bajos.
+ */
+static void fillSkewedData(void) {
+    uint32_t state = 11u;
+    for (size_t i = 0; i < LONG_DATA_SIZE; i++) {
+        state = state * 1664525u + 1013904223u;
+        float u = (float)(state >> 8) / (float)(1u << 24);
+        buffer[i] = 5.0f + u * u * u * 300.0f;
+    }
+    memcpy(sorted, buffer, sizeof(buffer));
+    qsort(sorted, LONG_DATA_SIZE, sizeof(float), compareFloat);
+}
+
+/**
+ * @brief Primera posición de sorted cuyo valor cumple value < sorted[i] (o <= si inclusive).
+ */
+static size_t countBelow(float value, bool inclusive) {
+    size_t low = 0, high = LONG_DATA_SIZE;
+    while (low < high) {
+        size_t mid = (low + high) / 2;
+        if (sorted[mid] < value || (inclusive && sorted[mid] == value))
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    return low;
+}
+
+/**
+ * @brief Verifica que el rango normalizado de cada percentil del resumen respete la cota.
+ */
+static void assertRankErrorWithinBound(const PdaSketch * s) {
+    for (int p = 1; p < 100; p++) {
+        float value = pdaSketchPercentile(s, (float)p);
+        double target = p / 100.0;
+        double below = (double)countBelow(value, false) / LONG_DATA_SIZE;
+        double upTo = (double)countBelow(value, true) / LONG_DATA_SIZE;
+        TEST_ASSERT_TRUE(target >= below - PDA_SKETCH_RANK_ERROR);
+        TEST_ASSERT_TRUE(target <= upTo + PDA_SKETCH_RANK_ERROR);
+    }
+}
+
+/* === Public function implementation ========================================================== */
+
+/** 1.1
+ * @brief Con pocos datos el resumen es exacto y descarta los datos fuera de rango.
+ */
+void test_pdaSketch_exactForSmallSets(void) {
+    const float data[] = SET_OUTLIER_DATA_MP;
+    const float percentiles[] = {0.0f, 50.0f, 75.0f, 100.0f};
+    float results[ARRAY_SIZE(percentiles)];
+    pdaSketchInit(&sketch, SKETCH_SEED);
+    pdaSketchAddBatch(&sketch, data, ARRAY_SIZE(data));
+    TEST_ASSERT_EQUAL_UINT64(4, sketch.validCount);
+    TEST_ASSERT_EQUAL_UINT64(3, sketch.rejectedCount);
+    TEST_ASSERT_TRUE(pdaSketchPercentiles(&sketch, percentiles, ARRAY_SIZE(percentiles), results));
+    TEST_ASSERT_EQUAL_FLOAT(2.0, results[0]);
+    TEST_ASSERT_EQUAL_FLOAT(6.0, results[1]);
+    TEST_ASSERT_EQUAL_FLOAT(8.0, results[2]);
+    TEST_ASSERT_EQUAL_FLOAT(10.0, results[3]);
+}
+
+/** 1.2
+ * @brief Resúmenes vacíos, percentiles fuera de rango y punteros NULL retornan valores de error.
+ */
+void test_pdaSketch_errorValues(void) {
+    const float percentiles[] = {50.0f, 101.0f};
+    float results[ARRAY_SIZE(percentiles)];
+    pdaSketchInit(&sketch, SKETCH_SEED);
+    TEST_ASSERT_FALSE(pdaSketchAdd(&sketch, 0.0f));
+    TEST_ASSERT_EQUAL_FLOAT(MSN_VOID_ARRAY_VALUE, pdaSketchPercentile(&sketch, 50.0f));
+    TEST_ASSERT_TRUE(pdaSketchAdd(&sketch, 12.0f));
+    TEST_ASSERT_FALSE(pdaSketchPercentiles(&sketch, percentiles, ARRAY_SIZE(percentiles), results));
+    TEST_ASSERT_EQUAL_FLOAT(12.0, results[0]);
+    TEST_ASSERT_EQUAL_FLOAT(MSN_PERCENTILE_OUT_OF_RANGE, results[1]);
+
+    pdaSketchInit(NULL, SKETCH_SEED);
+    pdaSketchAddBatch(NULL, percentiles, ARRAY_SIZE(percentiles));
+    TEST_ASSERT_FALSE(pdaSketchAdd(NULL, 12.0f));
+    TEST_ASSERT_FALSE(pdaSketchMerge(NULL, &sketch));
+    TEST_ASSERT_FALSE(pdaSketchMerge(&sketch, NULL));
+    TEST_ASSERT_EQUAL_FLOAT(MSN_VOID_ARRAY_VALUE, pdaSketchPercentile(NULL, 50.0f));
+    TEST_ASSERT_EQUAL(0, pdaSketchSerializedSize(NULL));
+    TEST_ASSERT_EQUAL(0, pdaSketchSerialize(NULL, blob, sizeof(blob)));
+    TEST_ASSERT_FALSE(pdaSketchDeserialize(NULL, blob, sizeof(blob)));
+}
+
+/** 1.3
+ * @brief Consultar percentiles no modifica el resumen.
+ */
+void test_pdaSketch_queryIsConst(void) {
+    const float percentiles[] = {10.0f, 50.0f, 90.0f};
+    float first[ARRAY_SIZE(percentiles)], second[ARRAY_SIZE(percentiles)];
+    fillSkewedData();
+    pdaSketchInit(&sketch, SKETCH_SEED);
+    pdaSketchAddBatch(&sketch, buffer, LONG_DATA_SIZE / 10);
+    memcpy(&other, &sketch, sizeof(sketch));
+
+    const PdaSketch * query = &sketch;
+    TEST_ASSERT_TRUE(pdaSketchPercentiles(query, percentiles, ARRAY_SIZE(percentiles), first));
+    TEST_ASSERT_EQUAL_MEMORY(&other, &sketch, sizeof(sketch));
+    TEST_ASSERT_TRUE(pdaSketchPercentiles(query, percentiles, ARRAY_SIZE(percentiles), second));
+    TEST_ASSERT_EQUAL_FLOAT_ARRAY(first, second, ARRAY_SIZE(percentiles));
+    TEST_ASSERT_EQUAL_FLOAT(first[1], pdaSketchPercentile(query, 50.0f));
+}
+
+/** 2.1
+ * @brief Sobre 100000 datos el error de rango de los percentiles 1 a 99 respeta la cota.
+ */
+void test_pdaSketch_rankErrorBound(void) {
+    fillSkewedData();
+    pdaSketchInit(&sketch, SKETCH_SEED);
+    pdaSketchAddBatch(&sketch, buffer, LONG_DATA_SIZE);
+    TEST_ASSERT_EQUAL_UINT64(LONG_DATA_SIZE, sketch.validCount);
+    TEST_ASSERT_EQUAL_FLOAT(sorted[0], pdaSketchPercentile(&sketch, 0.0f));
+    TEST_ASSERT_EQUAL_FLOAT(sorted[LONG_DATA_SIZE - 1], pdaSketchPercentile(&sketch, 100.0f));
+    assertRankErrorWithinBound(&sketch);
+}
+
+/** 2.2
+ * @brief La combinación de resúmenes parciales respeta la cota y suma los contadores.
+ */
+void test_pdaSketch_mergeKeepsBound(void) {
+    const size_t part = LONG_DATA_SIZE / PARTIAL_COUNT;
+    fillSkewedData();
+    pdaSketchInit(&sketch, SKETCH_SEED);
+    for (size_t k = 0; k < PARTIAL_COUNT; k++) {
+        pdaSketchInit(&other, SKETCH_SEED + (uint32_t)k + 1);
+        pdaSketchAddBatch(&other, buffer + k * part, part);
+        pdaSketchAdd(&other, 900.0f);
+        TEST_ASSERT_TRUE(pdaSketchMerge(&sketch, &other));
+    }
+    TEST_ASSERT_EQUAL_UINT64(LONG_DATA_SIZE, sketch.validCount);
+    TEST_ASSERT_EQUAL_UINT64(PARTIAL_COUNT, sketch.rejectedCount);
+    TEST_ASSERT_EQUAL_FLOAT(sorted[0], sketch.min);
+    TEST_ASSERT_EQUAL_FLOAT(sorted[LONG_DATA_SIZE - 1], sketch.max);
+    assertRankErrorWithinBound(&sketch);
+}
+
+/** 3.1
+ * @brief La serialización reproduce el resumen y rechaza buffers inválidos.
+ */
+void test_pdaSketch_serializeRoundTrip(void) {
+    const float percentiles[] = {5.0f, 50.0f, 95.0f, 98.0f};
+    float expected[ARRAY_SIZE(percentiles)], actual[ARRAY_SIZE(percentiles)];
+    fillSkewedData();
+    pdaSketchInit(&sketch, SKETCH_SEED);
+    pdaSketchAddBatch(&sketch, buffer, LONG_DATA_SIZE);
+
+    size_t size = pdaSketchSerializedSize(&sketch);
+    TEST_ASSERT_TRUE(size <= sizeof(blob));
+    TEST_ASSERT_EQUAL(0, pdaSketchSerialize(&sketch, blob, size - 1));
+    TEST_ASSERT_EQUAL(size, pdaSketchSerialize(&sketch, blob, sizeof(blob)));
+    TEST_ASSERT_FALSE(pdaSketchDeserialize(&other, blob, size - 1));
+    TEST_ASSERT_TRUE(pdaSketchDeserialize(&other, blob, size));
+
+    TEST_ASSERT_TRUE(pdaSketchPercentiles(&sketch, percentiles, ARRAY_SIZE(percentiles), expected));
+    TEST_ASSERT_TRUE(pdaSketchPercentiles(&other, percentiles, ARRAY_SIZE(percentiles), actual));
+    TEST_ASSERT_EQUAL_FLOAT_ARRAY(expected, actual, ARRAY_SIZE(percentiles));
+    TEST_ASSERT_EQUAL_UINT64(sketch.validCount, other.validCount);
+
+    // el mismo resumen, con los mismos datos nuevos, evoluciona igual tras deserializarse
+    pdaSketchAddBatch(&sketch, buffer, LONG_DATA_SIZE / 2);
+    pdaSketchAddBatch(&other, buffer, LONG_DATA_SIZE / 2);
+    TEST_ASSERT_EQUAL(pdaSketchSerializedSize(&sketch), pdaSketchSerializedSize(&other));
+
+    blob[0] = 'X';
+    TEST_ASSERT_FALSE(pdaSketchDeserialize(&other, blob, size));
+}
+
+/** 3.2
+ * @brief La deserialización rechaza niveles que exceden la capacidad, niveles desordenados y
+ * datos NaN.
+ */
+void test_pdaSketchDeserialize_rejectsCraftedLevels(void) {
+    // un solo nivel con K + 1 datos supera la capacidad del resumen
+    pdaSketchInit(&sketch, SKETCH_SEED);
+    for (uint32_t i = 0; i < PDA_SKETCH_K; i++)
+        TEST_ASSERT_TRUE(pdaSketchAdd(&sketch, 10.0f + (float)i));
+    TEST_ASSERT_EQUAL(1, sketch.numLevels);
+    size_t size = pdaSketchSerialize(&sketch, blob, sizeof(blob));
+    TEST_ASSERT_TRUE(pdaSketchDeserialize(&other, blob, size));
+    pdaWriteLe(blob + PDA_SKETCH_HEADER_SIZE, PDA_SKETCH_K + 1, 2);
+    pdaWriteLe(blob + BLOB_OFFSET_VALID, PDA_SKETCH_K + 1, 8);
+    pdaWriteFloat(blob + size, 20.0f);
+    TEST_ASSERT_FALSE(pdaSketchDeserialize(&other, blob, size + 4));
+
+    // un nivel superior desordenado o un dato NaN
+    fillSkewedData();
+    pdaSketchInit(&sketch, SKETCH_SEED);
+    pdaSketchAddBatch(&sketch, buffer, LONG_DATA_SIZE);
+    size = pdaSketchSerialize(&sketch, blob, sizeof(blob));
+    uint32_t level = 1;
+    while (level < sketch.numLevels && sketch.levels[level + 1] - sketch.levels[level] < 2)
+        level++;
+    TEST_ASSERT_TRUE(level < sketch.numLevels);
+    size_t offset = blobLevelOffset(sketch.numLevels, level);
+    float first = pdaReadFloat(blob + offset);
+    pdaWriteFloat(blob + offset, sketch.max + 1.0f);
+    TEST_ASSERT_FALSE(pdaSketchDeserialize(&other, blob, size));
+    pdaWriteFloat(blob + offset, first);
+    TEST_ASSERT_TRUE(pdaSketchDeserialize(&other, blob, size));
+    pdaWriteFloat(blob + blobLevelOffset(sketch.numLevels, 0), NAN);
+    TEST_ASSERT_FALSE(pdaSketchDeserialize(&other, blob, size));
+}
+
+/* === End of documentation ==================================================================== */